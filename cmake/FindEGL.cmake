@@ -0,0 +1,49 @@
+###################################################################################################
+#
+# Jackal Engine
+# 2017 - Benjamin Carter (bencarterdev@outlook.com)
+#
+# This software is provided 'as-is', without any express or implied warranty.
+# In no event will the authors be held liable for any damages arising from the use of this software.
+#
+# Permission is granted to anyone to use this software for any purpose,
+# including commercial applications, and to alter it and redistribute it freely,
+# subject to the following restrictions:
+#
+# 1. The origin of this software must not be misrepresented;
+#    you must not claim that you wrote the original software.
+#    if  you use this software in a product, an acknowledgement
+#    in the product documentation would be appreciated but is not required.
+#
+# 2. Altered source versions must be plainly marked as such,
+#    and must not be misrepresented as being the original software.
+#
+# 3. This notice may not be removed or altered from any source distribution.
+#
+###################################################################################################
+
+####################
+# FindEGL
+####################
+set(EGL_SEARCH_PATHS /usr/local
+                     /usr
+                     /opt/local
+                     /opt)
+
+find_path(EGL_INCLUDE_DIR NAMES EGL/egl.h
+                          HINTS $ENV{EGLDIR}
+                          PATH_SUFFIXES include
+                          PATHS ${EGL_SEARCH_PATHS})
+
+find_library(EGL_LIBRARY_LOCATION NAMES EGL
+                                  HINTS $ENV{EGLDIR}
+                                  PATH_SUFFIXES lib lib64 lib/x86_64-linux-gnu
+                                  PATHS ${EGL_SEARCH_PATHS})
+
+if (EGL_LIBRARY_LOCATION)
+	set(EGL_LIBRARY ${EGL_LIBRARY_LOCATION} CACHE STRING "Where the EGL Library can be found")
+	set(EGL_LIBRARY "${EGL_LIBRARY_LOCATION}" CACHE INTERNAL "")
+endif()
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(EGL REQUIRED_VARS EGL_LIBRARY EGL_INCLUDE_DIR)
@@ -24,15 +24,33 @@
 
 #version 330 core 
 
+//====================
+// Constants
+//====================
+const int TILES_X      = 16; ///< The number of clusters across the screen, matching ClusteredLighting.
+const int TILES_Y      = 9;  ///< The number of clusters down the screen, matching ClusteredLighting.
+const int SLICES       = 24; ///< The number of depth slices, matching ClusteredLighting.
+const int LIGHT_TEXELS = 4;  ///< The number of texels that describe a clustered light.
+
 //====================
 // Structs
 //====================
 struct Material 
 {
-	sampler2D diffuse;   ///< The diffuse texture of the material.
-	sampler2D specular;  ///< The specularity texture of the material.
-	vec4 diffuse_colour; ///< The colouring applied to the diffuse texture.
-	float shininess;     ///< How shiny the specular effects will be on this material.
+#ifdef DIFFUSE_ARRAY
+	sampler2DArray diffuse;  ///< The array texture the diffuse texture was packed into.
+	float diffuse_layer;     ///< The layer of the diffuse texture within the array.
+#else
+	sampler2D diffuse;       ///< The diffuse texture of the material.
+#endif
+#ifdef SPECULAR_ARRAY
+	sampler2DArray specular; ///< The array texture the specularity texture was packed into.
+	float specular_layer;    ///< The layer of the specularity texture within the array.
+#else
+	sampler2D specular;      ///< The specularity texture of the material.
+#endif
+	vec4 diffuse_colour;     ///< The colouring applied to the diffuse texture.
+	float shininess;         ///< How shiny the specular effects will be on this material.
 };
 
 struct Light
@@ -48,6 +66,16 @@ struct DirectionalLight
 	vec3 direction; ///< The direction of the DirectionalLight object.
 };
 
+struct Clusters
+{
+	samplerBuffer lights;   ///< The position, colour and cone of every visible point and spot light.
+	usamplerBuffer grid;    ///< The offset and count of the light list of every cluster.
+	usamplerBuffer indices; ///< The light indices of every cluster.
+	vec2 screen_size;       ///< The size of the screen the clusters divide.
+	float near;             ///< The depth of the first slice.
+	float slice_scale;      ///< Converts the log of a depth into a slice.
+};
+
 //====================
 // Functions
 //====================
@@ -94,7 +122,8 @@ vec4 jackal_calculate_directional_light(DirectionalLight dir_light, vec3 world_n
 /// sources.
 ///
 /// @param material       The Material containing the specular texture.
-/// @param dir_light      The direction of the light on the specular texture.
+/// @param light          The light to retrieve the specularity from.
+/// @param direction      The direction the light is shining in.
 /// @param view_position  The position of the camera within the scene.
 /// @param frag_position  The position in model co-ordinates.
 /// @param world_normals  The normal of the vertex, in world co-ordinates.
@@ -102,13 +131,34 @@ vec4 jackal_calculate_directional_light(DirectionalLight dir_light, vec3 world_n
 /// @returns The effect of the specularity on a given pixel.
 ///
 ////////////////////////////////////////////////////////////
-vec4 jackal_calculate_specularity(Material material, DirectionalLight dir_light, vec3 view_position, vec3 frag_position, vec3 world_normals);
+vec4 jackal_calculate_specularity(Material material, Light light, vec3 direction, vec3 view_position, vec3 frag_position, vec3 world_normals);
+
+////////////////////////////////////////////////////////////
+/// @brief Calculates the effect of the clustered lights on a given pixel.
+///
+/// The cluster of the pixel is found from its screen position and
+/// view depth, only the point and spot lights assigned to that cluster
+/// are shaded. Each light fades to nothing at its range, and spot
+/// lights fade between the inner and outer angle of their cone.
+///
+/// @param material       The Material to calculate the specularity of.
+/// @param view_position  The position of the camera within the scene.
+/// @param frag_position  The position in world co-ordinates.
+/// @param world_normals  The normal of the vertex, in world co-ordinates.
+/// @param view_depth     The depth of the pixel in view space.
+/// @param diffuse        The accumulated diffuse effect of the lights.
+/// @param specular       The accumulated specular effect of the lights.
+///
+////////////////////////////////////////////////////////////
+void jackal_calculate_clustered_lights(Material material, vec3 view_position, vec3 frag_position, vec3 world_normals, float view_depth,
+	out vec4 diffuse, out vec4 specular);
 
 //====================
 // Uniform variables
 //====================
 uniform Material u_material;          ///< The Material object passed from the C++ code.
 uniform DirectionalLight u_dir_light; ///< The directional light passed from the C++ code.
+uniform Clusters u_clusters;          ///< The clustered point and spot lights passed from the C++ code.
 uniform vec3 u_view_position;         ///< The current view direction of the camera.
 
 //====================
@@ -119,6 +169,7 @@ in VS_OUT
 	vec2 uv_coords;
 	vec3 normals;
 	vec3 frag_position;
+	float view_depth;
 
 } fs_in;
 
@@ -131,14 +182,44 @@ out vec4 frag_colour; ///< The final colour of the fragment.
 void main()
 {
 	// Loading the textures.
-	vec4 diffuse_texture  = texture2D(u_material.diffuse, fs_in.uv_coords);
-	vec4 specular_texture = texture2D(u_material.specular, fs_in.uv_coords);
+#ifdef DIFFUSE_ARRAY
+	vec4 diffuse_texture = texture(u_material.diffuse, vec3(fs_in.uv_coords, u_material.diffuse_layer));
+#else
+	vec4 diffuse_texture = texture2D(u_material.diffuse, fs_in.uv_coords);
+#endif
 
+#ifdef LIGHTING
 	// Calculate the effects on the object.
-	vec4 diffuse = jackal_calculate_directional_light(u_dir_light, fs_in.normals) * diffuse_texture;
-	vec4 specular = jackal_calculate_specularity(u_material, u_dir_light, u_view_position, fs_in.frag_position, fs_in.normals) * specular_texture;
+	vec4 diffuse = jackal_calculate_directional_light(u_dir_light, fs_in.normals);
+
+#ifdef SPECULAR_MAP
+#ifdef SPECULAR_ARRAY
+	vec4 specular_texture = texture(u_material.specular, vec3(fs_in.uv_coords, u_material.specular_layer));
+#else
+	vec4 specular_texture = texture2D(u_material.specular, fs_in.uv_coords);
+#endif
+	vec4 specular = jackal_calculate_specularity(u_material, u_dir_light.light, u_dir_light.direction, u_view_position, fs_in.frag_position, fs_in.normals);
+#endif
+
+#ifdef CLUSTERED_LIGHTS
+	vec4 clustered_diffuse;
+	vec4 clustered_specular;
+	jackal_calculate_clustered_lights(u_material, u_view_position, fs_in.frag_position, fs_in.normals, fs_in.view_depth, clustered_diffuse, clustered_specular);
 
-	frag_colour = diffuse + specular; 
+	diffuse = vec4(diffuse.rgb + clustered_diffuse.rgb, 1.0);
+#ifdef SPECULAR_MAP
+	specular = vec4(specular.rgb + clustered_specular.rgb, 1.0);
+#endif
+#endif
+
+	frag_colour = diffuse * diffuse_texture;
+#ifdef SPECULAR_MAP
+	frag_colour += specular * specular_texture;
+#endif
+#else
+	// Without lighting, the material is shaded like the basic unlit shader.
+	frag_colour = vec4(diffuse_texture.rgb * u_material.diffuse_colour.rgb, 1.0);
+#endif
 }
 
 ////////////////////////////////////////////////////////////
@@ -165,15 +246,62 @@ vec4 jackal_calculate_directional_light(DirectionalLight dir_light, vec3 world_n
 }
 
 ////////////////////////////////////////////////////////////
-vec4 jackal_calculate_specularity(Material material, DirectionalLight dir_light, vec3 view_position, vec3 frag_position, vec3 world_normals)
+vec4 jackal_calculate_specularity(Material material, Light light, vec3 direction, vec3 view_position, vec3 frag_position, vec3 world_normals)
 {
 	vec3 normals = normalize(world_normals);
 
 	vec3 view_direction = normalize(view_position - frag_position);
-	vec3 reflect_direction = reflect(-dir_light.direction, normals);
+	vec3 reflect_direction = reflect(normalize(direction), normals);
 
 	float specularity = pow(max(dot(view_direction, reflect_direction), 0.0), material.shininess);
 	
-	vec4 result = dir_light.light.specularity * specularity;
+	vec4 result = light.specularity * specularity;
 	return vec4(result.rgb, 1.0);
 }
+
+////////////////////////////////////////////////////////////
+void jackal_calculate_clustered_lights(Material material, vec3 view_position, vec3 frag_position, vec3 world_normals, float view_depth,
+	out vec4 diffuse, out vec4 specular)
+{
+	diffuse = vec4(0.0);
+	specular = vec4(0.0);
+
+	// The slices are distributed exponentially, matching ClusteredLighting::assignSlice.
+	int slice = int(floor(log(max(view_depth, u_clusters.near) / u_clusters.near) * u_clusters.slice_scale));
+	ivec2 tile = ivec2(gl_FragCoord.xy / u_clusters.screen_size * vec2(TILES_X, TILES_Y));
+
+	slice = clamp(slice, 0, SLICES - 1);
+	tile = clamp(tile, ivec2(0), ivec2(TILES_X - 1, TILES_Y - 1));
+
+	uvec2 cluster = texelFetch(u_clusters.grid, (slice * TILES_Y + tile.y) * TILES_X + tile.x).xy;
+
+	for (uint i = 0u; i < cluster.y; ++i)
+	{
+		int index = int(texelFetch(u_clusters.indices, int(cluster.x + i)).r) * LIGHT_TEXELS;
+
+		vec4 position_range    = texelFetch(u_clusters.lights, index);
+		vec4 colour_intensity  = texelFetch(u_clusters.lights, index + 1);
+		vec4 specularity_inner = texelFetch(u_clusters.lights, index + 2);
+		vec4 direction_outer   = texelFetch(u_clusters.lights, index + 3);
+
+		vec3 to_light = position_range.xyz - frag_position;
+		float light_distance = length(to_light);
+
+		// Fades smoothly to nothing at the range of the light.
+		float ratio = light_distance / position_range.w;
+		float attenuation = clamp(1.0 - ratio * ratio * ratio * ratio, 0.0, 1.0);
+		attenuation = (attenuation * attenuation) / (light_distance * light_distance + 1.0);
+
+		// Point lights have no direction and a negative cone, so are never faded by it.
+		float cone = dot(-to_light / max(light_distance, 0.0001), direction_outer.xyz);
+		attenuation *= smoothstep(direction_outer.w, specularity_inner.w, cone);
+
+		Light light;
+		light.colour = vec4(colour_intensity.rgb, 1.0);
+		light.specularity = vec4(specularity_inner.rgb, 1.0);
+		light.intensity = colour_intensity.w * attenuation;
+
+		diffuse += jackal_calculate_light(light, -to_light, world_normals);
+		specular += jackal_calculate_specularity(material, light, -to_light, view_position, frag_position, world_normals) * attenuation;
+	}
+}
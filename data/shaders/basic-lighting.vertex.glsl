@@ -31,11 +31,17 @@ layout (location = 0) in vec3 position; // The world position of the vertices.
 layout (location = 1) in vec3 normal;   // Vertex normals of the mesh.
 layout (location = 2) in vec2 uv;       // UV co-ordinate of the mesh.
 
+// Constant for each draw, set by the vertex layout of the mesh.
+layout (location = 5) in vec3 position_scale;  // Scales quantised positions back to the bounds of the mesh.
+layout (location = 6) in vec3 position_offset; // The centre of the bounds of the mesh.
+layout (location = 7) in float octahedral;     // 1 if the normals are octahedral encoded.
+
 //====================
 // Uniforms
 //====================
 uniform mat4 u_mvp;
 uniform mat4 u_model;
+uniform mat4 u_view;
 
 //====================
 // Interfaces
@@ -45,17 +51,49 @@ out VS_OUT
 	vec2 uv_coords;
 	vec3 normals;
 	vec3 frag_position;
+	float view_depth;
 
 } vs_out;
 
 //====================
 // Functions
 //====================
+vec3 decode_normal()
+{
+	if (octahedral < 0.5)
+	{
+		return normal;
+	}
+
+	// The lower half of the octahedron is folded over the upper half.
+	vec3 n = vec3(normal.xy, 1.0 - abs(normal.x) - abs(normal.y));
+	float fold = max(-n.z, 0.0);
+	n.x += n.x >= 0.0 ? -fold : fold;
+	n.y += n.y >= 0.0 ? -fold : fold;
+
+	return normalize(n);
+}
+
 void main()
 {
+	vec3 local_position = position * position_scale + position_offset;
+	vec3 local_normal = decode_normal();
+
 	vs_out.uv_coords = uv;	 
-	vs_out.normals = mat3(transpose(inverse(u_model))) * normal;
-	vs_out.frag_position = vec3(u_model * vec4(position, 1.0));
+
+#ifdef LIGHTING
+	vs_out.normals = mat3(transpose(inverse(u_model))) * local_normal;
+	vs_out.frag_position = vec3(u_model * vec4(local_position, 1.0));
+#else
+	vs_out.normals = local_normal;
+	vs_out.frag_position = local_position;
+#endif
+
+#ifdef CLUSTERED_LIGHTS
+	vs_out.view_depth = (u_view * vec4(vs_out.frag_position, 1.0)).z;
+#else
+	vs_out.view_depth = 0.0;
+#endif
 	
-	gl_Position = u_mvp * vec4(position, 1.0);
+	gl_Position = u_mvp * vec4(local_position, 1.0);
 }
\ No newline at end of file
@@ -29,8 +29,13 @@
 //====================
 struct Material 
 {
-	sampler2D diffuse_texture; ///< The diffuse texture of the material.
-	vec4 diffuse_colour;       ///< The colouring applied to the diffuse texture.
+#ifdef DIFFUSE_ARRAY
+	sampler2DArray diffuse; ///< The array texture the diffuse texture was packed into.
+	float diffuse_layer;    ///< The layer of the diffuse texture within the array.
+#else
+	sampler2D diffuse;      ///< The diffuse texture of the material.
+#endif
+	vec4 diffuse_colour;    ///< The colouring applied to the diffuse texture.
 };
 
 //====================
@@ -54,7 +59,11 @@ out vec4 frag_colour; ///< The final colour of the fragment.
 //====================
 void main()
 {
-	vec4 diffuse_texture = texture2D(u_material.diffuse_texture, fs_in.uv_coords);
+#ifdef DIFFUSE_ARRAY
+	vec4 diffuse_texture = texture(u_material.diffuse, vec3(fs_in.uv_coords, u_material.diffuse_layer));
+#else
+	vec4 diffuse_texture = texture2D(u_material.diffuse, fs_in.uv_coords);
+#endif
 	vec3 diffuse = diffuse_texture.rgb * u_material.diffuse_colour.rgb;
 
 	frag_colour = vec4(diffuse, 1.0); 
@@ -31,6 +31,10 @@ layout (location = 0) in vec3 position; // The world position of the vertices.
 layout (location = 1) in vec3 normal;   // Vertex normals of the mesh.
 layout (location = 2) in vec2 uv;       // UV co-ordinate of the mesh.
 
+// Constant for each draw, set by the vertex layout of the mesh.
+layout (location = 5) in vec3 position_scale;  // Scales quantised positions back to the bounds of the mesh.
+layout (location = 6) in vec3 position_offset; // The centre of the bounds of the mesh.
+
 //====================
 // Uniforms
 //====================
@@ -51,5 +55,5 @@ out VS_OUT
 void main()
 {
 	vs_out.uv_coords = uv;	 
-	gl_Position = u_mvp * vec4(position, 1.0);
+	gl_Position = u_mvp * vec4(position * position_scale + position_offset, 1.0);
 }
\ No newline at end of file
@@ -0,0 +1,172 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __JACKAL_HEADLESS_CONTEXT_HPP__
+#define __JACKAL_HEADLESS_CONTEXT_HPP__
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/math/vector2.hpp>           // Storing the size of the framebuffer.
+#include <jackal/utils/context_settings.hpp> // Storing settings of OpenGL.
+#include <jackal/utils/non_copyable.hpp>     // The context should not be copied.
+
+//====================
+// Additional includes
+//====================
+#include <GL/glew.h>                         // Creating the offscreen framebuffer.
+
+namespace jackal
+{
+	class HeadlessContext final : NonCopyable
+	{
+	private:
+		//====================
+		// Member variables
+		//====================
+		void*    m_pDisplay;    ///< The EGL display the context was created upon.
+		void*    m_pContext;    ///< The EGL context, created without a surface.
+		GLuint   m_framebuffer; ///< The framebuffer that replaces the default framebuffer.
+		GLuint   m_colour;      ///< The colour attachment of the framebuffer.
+		GLuint   m_depth;       ///< The depth and stencil attachment of the framebuffer.
+		Vector2i m_size;        ///< The width and height of the framebuffer.
+
+	public:
+		//====================
+		// Ctor and dtor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Default constructor for the HeadlessContext object.
+		///
+		/// The default constructor sets all of the member variables to
+		/// default values, the context is not created until create is
+		/// invoked.
+		///
+		////////////////////////////////////////////////////////////
+		explicit HeadlessContext();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Destructor for the HeadlessContext object.
+		///
+		/// The destructor implicitly calls destroy, releasing the
+		/// framebuffer and the EGL context.
+		///
+		////////////////////////////////////////////////////////////
+		~HeadlessContext();
+
+		//====================
+		// Getters and setters
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves whether the context has been created.
+		///
+		/// @returns True if the EGL context was created successfully.
+		///
+		////////////////////////////////////////////////////////////
+		bool isCreated() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Makes the context current on the calling thread.
+		///
+		/// @param active  Whether the context should be made current or released.
+		///
+		/// @returns       True if the context was changed successfully.
+		///
+		////////////////////////////////////////////////////////////
+		bool setActive(bool active = true) const;
+
+		//====================
+		// Methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Creates the offscreen OpenGL context.
+		///
+		/// The context is created through EGL upon the surfaceless Mesa
+		/// platform when it is available, falling back to the default
+		/// display otherwise, no window system is required. Once created
+		/// the context is made current on the calling thread. If the engine
+		/// was built without EGL, this always fails.
+		///
+		/// @param settings  The contextual OpenGL settings to request.
+		///
+		/// @returns         True if the context was created successfully.
+		///
+		////////////////////////////////////////////////////////////
+		bool create(const ContextSettings_t& settings);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Creates the framebuffer that is rendered into.
+		///
+		/// A surfaceless context has no default framebuffer, so one is
+		/// created and left bound in its place. This must be invoked once
+		/// GLEW has been initialised for the context.
+		///
+		/// @param size      The width and height of the framebuffer.
+		/// @param settings  The depth and stencil settings of the framebuffer.
+		///
+		/// @returns         True if the framebuffer is complete.
+		///
+		////////////////////////////////////////////////////////////
+		bool createFramebuffer(const Vector2i& size, const ContextSettings_t& settings);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Destroys the framebuffer and the context.
+		////////////////////////////////////////////////////////////
+		void destroy();
+	};
+
+} // namespace jackal
+
+#endif//__JACKAL_HEADLESS_CONTEXT_HPP__
+
+////////////////////////////////////////////////////////////
+/// @author Benjamin Carter
+///
+/// @class jackal::HeadlessContext
+/// @ingroup core
+///
+/// The jackal::HeadlessContext is an OpenGL context that renders
+/// into an offscreen framebuffer instead of a window. It is used by
+/// the Window when the headless setting is enabled, so the rendering
+/// path can be run and measured on machines without a display or GPU,
+/// such as Mesa's llvmpipe on continuous integration servers.
+///
+/// The context is only available when the engine is built with EGL,
+/// which is detected by CMake. Due to the internal use of the class, it
+/// is not exposed to the lua scripting interface.
+///
+/// @code
+/// using namespace jackal;
+///
+/// ContextSettings_t settings(24, 8, 3, 3);
+///
+/// HeadlessContext context;
+/// if (context.create(settings))
+/// {
+///		glewInit();
+///		context.createFramebuffer(Vector2i(640, 480), settings);
+/// }
+/// @endcode
+///
+////////////////////////////////////////////////////////////
@@ -35,6 +35,8 @@
 //==================== 
 #include <jackal/math/vector2.hpp>            // Storing window size and position.
 #include <jackal/utils/context_settings.hpp>  // Storing settings of OpenGL.
+#include <jackal/utils/frame_timer.hpp>       // Timing the frames of a benchmark.
+#include <jackal/core/headless_context.hpp>   // Rendering without a visible window.
 
 //====================
 // Additional includes
@@ -62,6 +64,39 @@ namespace jackal
 		Vector2i          m_size;       ///< Width and height of the window.
 		ContextSettings_t m_settings;   ///< Various settings used by OpenGL.
 		bool              m_running;    ///< Whether the window is currently running.
+		bool              m_headless;   ///< Whether the window renders offscreen, without a visible window.
+		HeadlessContext   m_offscreen;  ///< The offscreen context used when the window is headless.
+		unsigned int      m_benchmark;  ///< The number of frames to time before closing, zero to run indefinitely.
+		std::string       m_output;     ///< The csv file the benchmark frame times are written to.
+		FrameTimer        m_timer;      ///< Times the frames of the benchmark.
+
+	private:
+		//====================
+		// Private methods
+		//==================== 
+		////////////////////////////////////////////////////////////
+		/// @brief Creates the offscreen context of a headless Window.
+		///
+		/// No SDL window is created, instead an EGL context renders into
+		/// an offscreen framebuffer of the requested size. This allows the
+		/// engine to run upon machines without a display.
+		///
+		/// @param settings  The contextual OpenGL settings of the Window.
+		///
+		/// @returns         True upon successful initialisation.
+		///
+		////////////////////////////////////////////////////////////
+		bool createHeadless(const ContextSettings_t& settings);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Writes the statistics of the benchmark.
+		///
+		/// The frame time statistics are written to the log and the
+		/// standard output, every individual frame time is written to
+		/// the benchmark csv file.
+		///
+		////////////////////////////////////////////////////////////
+		void reportBenchmark() const;
 
 	public:
 		//====================
@@ -203,6 +238,45 @@ namespace jackal
 		////////////////////////////////////////////////////////////
 		bool isRunning() const;
 
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves whether the Window is headless.
+		///
+		/// A headless Window renders into an offscreen framebuffer, there
+		/// is no visible window and no input events are polled.
+		///
+		/// @returns    True if the Window renders offscreen.
+		///
+		////////////////////////////////////////////////////////////
+		bool isHeadless() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Sets the number of frames to benchmark.
+		///
+		/// Once the number of frames has been rendered, the frame time
+		/// statistics are reported and the Window is closed. This must be
+		/// set before the Window is created.
+		///
+		/// @param frames    The number of frames to time, zero to run indefinitely.
+		/// @param output    The csv file to write the frame times to.
+		/// @param headless  Whether the Window should render offscreen.
+		///
+		////////////////////////////////////////////////////////////
+		void setBenchmark(unsigned int frames, const std::string& output, bool headless = false);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Makes the OpenGL context of the Window current.
+		///
+		/// An OpenGL context can only be current on a single thread at a
+		/// time, this is used to hand the context over to the render thread
+		/// and back again when the render thread is stopped.
+		///
+		/// @param active  Whether the context should be made current or released.
+		///
+		/// @returns       True if the context was changed successfully.
+		///
+		////////////////////////////////////////////////////////////
+		bool setActive(bool active = true) const;
+
 		//====================
 		// Methods
 		//==================== 
@@ -247,7 +321,8 @@ namespace jackal
 		/// So that input can be used within the application, it has to be
 		/// polled every frame so that the input can be read each frame of
 		/// the engine. This method will also poll the close window method, and
-		/// end the engine when the 'x' button is clicked.
+		/// end the engine when the 'x' button is clicked. When benchmarking,
+		/// this marks the end of each frame.
 		///
 		////////////////////////////////////////////////////////////
         void pollEvents();
@@ -278,7 +353,9 @@ namespace jackal
 		///
 		/// OpenGL utilises double buffers in order to smoothly render each
 		/// scene without any artifacting of render glitches. The swap method
-		/// should be called at the end of the current rendering frame.
+		/// should be called at the end of the current rendering frame. When
+		/// the render thread is running, the recorded frame is submitted
+		/// to it once the swap has been enqueued.
 		///
 		////////////////////////////////////////////////////////////
         void swap() const;
@@ -305,6 +382,11 @@ namespace jackal
 /// is the first instance that is initialised within the application and
 /// provides an access point to all the modules of the Jackal Engine.
 ///
+/// When the headless setting is enabled, no SDL window is created and
+/// the engine renders into an offscreen framebuffer instead, combined
+/// with the benchmark_frames setting, a fixed number of frames is timed
+/// and the statistics reported, before the window closes itself.
+///
 /// Additional windows should not be constructed, as it can corrupt the
 /// OpenGL context and cause undefined behavior. Specific elements of the
 /// Window object are exposed to the lua scripting interface for use.
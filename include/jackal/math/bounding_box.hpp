@@ -0,0 +1,196 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __JACKAL_BOUNDING_BOX_HPP__
+#define __JACKAL_BOUNDING_BOX_HPP__
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/math/vector3.hpp> // The corners of the box.
+#include <jackal/math/matrix4.hpp> // Transforming the box into another space.
+
+namespace jackal
+{
+	class BoundingBox final
+	{
+	public:
+		//====================
+		// Member variables
+		//====================
+		Vector3f minimum; ///< The corner of the box with the smallest co-ordinates.
+		Vector3f maximum; ///< The corner of the box with the largest co-ordinates.
+
+	public:
+		//====================
+		// Ctor and dtor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Default constructor for the BoundingBox object.
+		///
+		/// The default box is empty, the minimum is larger than the
+		/// maximum so that the first point expanded into the box
+		/// becomes both of its corners.
+		///
+		////////////////////////////////////////////////////////////
+		explicit BoundingBox();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Constructs a BoundingBox object from two corners.
+		///
+		/// @param minimum  The corner with the smallest co-ordinates.
+		/// @param maximum  The corner with the largest co-ordinates.
+		///
+		////////////////////////////////////////////////////////////
+		explicit BoundingBox(const Vector3f& minimum, const Vector3f& maximum);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Default destructor for the BoundingBox object.
+		////////////////////////////////////////////////////////////
+		~BoundingBox() = default;
+
+		//====================
+		// Getters and setters
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the centre of the box.
+		///
+		/// @returns The point halfway between both corners.
+		///
+		////////////////////////////////////////////////////////////
+		Vector3f getCentre() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the half size of the box along each axis.
+		///
+		/// @returns The distance from the centre to the maximum corner.
+		///
+		////////////////////////////////////////////////////////////
+		Vector3f getExtents() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the surface area of the box.
+		///
+		/// The surface area is used to estimate the cost of testing
+		/// a box when building a bounding volume hierarchy.
+		///
+		/// @returns The area of all six faces, zero if the box is invalid.
+		///
+		////////////////////////////////////////////////////////////
+		float getSurfaceArea() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Checks whether the box contains any points.
+		///
+		/// @returns True if a point has been expanded into the box.
+		///
+		////////////////////////////////////////////////////////////
+		bool isValid() const;
+
+		//====================
+		// Methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Grows the box so that it contains a point.
+		///
+		/// @param point  The point to contain.
+		///
+		////////////////////////////////////////////////////////////
+		void expand(const Vector3f& point);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Grows the box so that it contains another box.
+		///
+		/// Invalid boxes are ignored.
+		///
+		/// @param box  The box to contain.
+		///
+		////////////////////////////////////////////////////////////
+		void merge(const BoundingBox& box);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Checks whether two boxes overlap.
+		///
+		/// @param box  The box to check against.
+		///
+		/// @returns    True if the boxes share any space.
+		///
+		////////////////////////////////////////////////////////////
+		bool intersects(const BoundingBox& box) const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Checks whether another box is entirely within this box.
+		///
+		/// @param box  The box to check.
+		///
+		/// @returns    True if the box does not extend outside of this box.
+		///
+		////////////////////////////////////////////////////////////
+		bool contains(const BoundingBox& box) const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Transforms the box, producing a new box that contains it.
+		///
+		/// The centre is transformed and the extents are projected onto
+		/// each axis with the absolute values of the matrix, which is
+		/// far cheaper than transforming all eight corners.
+		///
+		/// @param matrix  The matrix to transform the box by.
+		///
+		/// @returns       The axis aligned box of the transformed box.
+		///
+		////////////////////////////////////////////////////////////
+		BoundingBox transform(const Matrix4& matrix) const;
+	};
+
+} // namespace jackal
+
+#endif//__JACKAL_BOUNDING_BOX_HPP__
+
+////////////////////////////////////////////////////////////
+/// @author Benjamin Carter
+///
+/// @class jackal::BoundingBox
+/// @ingroup math
+///
+/// The jackal::BoundingBox is an axis aligned box that contains
+/// a set of points, typically the vertices of a mesh. The boxes are
+/// used to test whether objects are visible before they are drawn,
+/// a box is always conservative, an object can only be rejected if
+/// its box is entirely outside of the view.
+///
+/// Due to the internal use of the class, it is not exposed to the
+/// lua scripting interface.
+///
+/// @code
+/// using namespace jackal;
+///
+/// BoundingBox box;
+/// box.expand(Vector3f(-1.0f, 0.0f, -1.0f));
+/// box.expand(Vector3f( 1.0f, 2.0f,  1.0f));
+///
+/// BoundingBox world = box.transform(transform.getTransformation());
+/// @endcode
+///
+////////////////////////////////////////////////////////////
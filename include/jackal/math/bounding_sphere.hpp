@@ -0,0 +1,116 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __JACKAL_BOUNDING_SPHERE_HPP__
+#define __JACKAL_BOUNDING_SPHERE_HPP__
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/math/vector3.hpp>      // The centre of the sphere.
+#include <jackal/math/bounding_box.hpp> // Fitting the sphere to a box.
+
+namespace jackal
+{
+	class BoundingSphere final
+	{
+	public:
+		//====================
+		// Member variables
+		//====================
+		Vector3f centre; ///< The centre of the sphere.
+		float    radius; ///< The radius of the sphere, negative when empty.
+
+	public:
+		//====================
+		// Ctor and dtor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Default constructor for the BoundingSphere object.
+		///
+		/// The default sphere is empty, it has a negative radius.
+		///
+		////////////////////////////////////////////////////////////
+		explicit BoundingSphere();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Constructs a BoundingSphere object from a centre and radius.
+		///
+		/// @param centre  The centre of the sphere.
+		/// @param radius  The radius of the sphere.
+		///
+		////////////////////////////////////////////////////////////
+		explicit BoundingSphere(const Vector3f& centre, float radius);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Constructs a BoundingSphere object that contains a box.
+		///
+		/// @param box  The box to contain.
+		///
+		////////////////////////////////////////////////////////////
+		explicit BoundingSphere(const BoundingBox& box);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Default destructor for the BoundingSphere object.
+		////////////////////////////////////////////////////////////
+		~BoundingSphere() = default;
+
+		//====================
+		// Getters and setters
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Checks whether the sphere contains any points.
+		///
+		/// @returns True if the radius is not negative.
+		///
+		////////////////////////////////////////////////////////////
+		bool isValid() const;
+	};
+
+} // namespace jackal
+
+#endif//__JACKAL_BOUNDING_SPHERE_HPP__
+
+////////////////////////////////////////////////////////////
+/// @author Benjamin Carter
+///
+/// @class jackal::BoundingSphere
+/// @ingroup math
+///
+/// The jackal::BoundingSphere is a sphere that contains a set
+/// of points. A sphere is cheaper to test than a box and does
+/// not change size as the object rotates, so it is commonly used
+/// as a first rejection test before the box is tested.
+///
+/// Due to the internal use of the class, it is not exposed to the
+/// lua scripting interface.
+///
+/// @code
+/// using namespace jackal;
+///
+/// BoundingSphere sphere(mesh.getBoundingBox());
+/// std::cout << sphere.radius << std::endl;
+/// @endcode
+///
+////////////////////////////////////////////////////////////
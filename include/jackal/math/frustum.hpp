@@ -0,0 +1,193 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __JACKAL_FRUSTUM_HPP__
+#define __JACKAL_FRUSTUM_HPP__
+
+//====================
+// C++ includes
+//====================
+#include <array>                           // Storing the six planes.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/math/vector4.hpp>         // Each plane is stored as a normal and distance.
+#include <jackal/math/matrix4.hpp>         // Extracting the planes from a view projection.
+#include <jackal/math/bounding_box.hpp>    // Testing boxes against the frustum.
+#include <jackal/math/bounding_sphere.hpp> // Testing spheres against the frustum.
+
+namespace jackal
+{
+	//====================
+	// Enumerations
+	//====================
+	enum class eFrustumPlane : int
+	{
+		LEFT,   ///< The left clipping plane.
+		RIGHT,  ///< The right clipping plane.
+		BOTTOM, ///< The bottom clipping plane.
+		TOP,    ///< The top clipping plane.
+		FRONT,  ///< The near clipping plane.
+		BACK,   ///< The far clipping plane.
+		COUNT   ///< The number of planes.
+	};
+
+	class Frustum final
+	{
+	public:
+		//====================
+		// Static variables
+		//====================
+		static const int PLANES = static_cast<int>(eFrustumPlane::COUNT); ///< The number of planes.
+
+	private:
+		//====================
+		// Member variables
+		//====================
+		std::array<Vector4f, PLANES> m_planes; ///< The planes of the frustum, with normals facing inwards.
+
+	public:
+		//====================
+		// Ctor and dtor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Default constructor for the Frustum object.
+		///
+		/// Every plane of the default frustum is empty, so every point
+		/// is contained within it.
+		///
+		////////////////////////////////////////////////////////////
+		explicit Frustum();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Constructs a Frustum object from a view projection matrix.
+		///
+		/// @param viewProjection  The view projection of the camera.
+		///
+		////////////////////////////////////////////////////////////
+		explicit Frustum(const Matrix4& viewProjection);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Default destructor for the Frustum object.
+		////////////////////////////////////////////////////////////
+		~Frustum() = default;
+
+		//====================
+		// Getters and setters
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves a plane of the frustum.
+		///
+		/// The x, y and z of the plane is its normal, facing into the
+		/// frustum, and w is its distance from the origin.
+		///
+		/// @param plane  The plane to retrieve.
+		///
+		/// @returns      The normalised plane.
+		///
+		////////////////////////////////////////////////////////////
+		const Vector4f& getPlane(eFrustumPlane plane) const;
+
+		//====================
+		// Methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Extracts the planes of the frustum from a view projection matrix.
+		///
+		/// Each plane is the sum or difference of the fourth row and
+		/// another row of the matrix, the planes are then normalised
+		/// so that distances can be compared against radii.
+		///
+		/// @param viewProjection  The view projection of the camera.
+		///
+		////////////////////////////////////////////////////////////
+		void extract(const Matrix4& viewProjection);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Checks whether a point is within the frustum.
+		///
+		/// @param point  The point to test.
+		///
+		/// @returns      True if the point is inside of every plane.
+		///
+		////////////////////////////////////////////////////////////
+		bool contains(const Vector3f& point) const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Checks whether a box is at least partially within the frustum.
+		///
+		/// Only the corner furthest along the normal of each plane is
+		/// tested, the box is rejected if that corner is outside.
+		///
+		/// @param box  The box to test.
+		///
+		/// @returns    True if the box may be visible.
+		///
+		////////////////////////////////////////////////////////////
+		bool intersects(const BoundingBox& box) const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Checks whether a sphere is at least partially within the frustum.
+		///
+		/// @param sphere  The sphere to test.
+		///
+		/// @returns       True if the sphere may be visible.
+		///
+		////////////////////////////////////////////////////////////
+		bool intersects(const BoundingSphere& sphere) const;
+	};
+
+} // namespace jackal
+
+#endif//__JACKAL_FRUSTUM_HPP__
+
+////////////////////////////////////////////////////////////
+/// @author Benjamin Carter
+///
+/// @class jackal::Frustum
+/// @ingroup math
+///
+/// The jackal::Frustum is the volume that can be seen by a
+/// camera, described by six inward facing planes. The planes are
+/// extracted directly from the view projection of the camera, so
+/// the frustum always matches what is rendered.
+///
+/// The tests are conservative, an object that intersects the
+/// frustum may still be off-screen near its corners, but an object
+/// that is rejected is never visible. Due to the internal use of
+/// the class, it is not exposed to the lua scripting interface.
+///
+/// @code
+/// using namespace jackal;
+///
+/// Frustum frustum(camera.getViewProjection());
+///
+/// if (frustum.intersects(mesh.getBoundingBox().transform(transform.getTransformation())))
+/// {
+///		mesh.render();
+/// }
+/// @endcode
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,139 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __JACKAL_RAY_HPP__
+#define __JACKAL_RAY_HPP__
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/math/vector3.hpp>         // The origin and direction of the ray.
+#include <jackal/math/bounding_box.hpp>    // Testing the ray against boxes.
+#include <jackal/math/bounding_sphere.hpp> // Testing the ray against spheres.
+
+namespace jackal
+{
+	class Ray final
+	{
+	public:
+		//====================
+		// Member variables
+		//====================
+		Vector3f origin;    ///< The point the ray starts from.
+		Vector3f direction; ///< The normalised direction of the ray.
+
+	public:
+		//====================
+		// Ctor and dtor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Default constructor for the Ray object.
+		///
+		/// The default ray starts at the origin and faces forward.
+		///
+		////////////////////////////////////////////////////////////
+		explicit Ray();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Constructs a Ray object from an origin and direction.
+		///
+		/// @param origin     The point the ray starts from.
+		/// @param direction  The direction of the ray, it is normalised.
+		///
+		////////////////////////////////////////////////////////////
+		explicit Ray(const Vector3f& origin, const Vector3f& direction);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Default destructor for the Ray object.
+		////////////////////////////////////////////////////////////
+		~Ray() = default;
+
+		//====================
+		// Getters and setters
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves a point along the ray.
+		///
+		/// @param distance  The distance from the origin.
+		///
+		/// @returns         The point at the distance along the ray.
+		///
+		////////////////////////////////////////////////////////////
+		Vector3f getPoint(float distance) const;
+
+		//====================
+		// Methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Checks whether the ray hits a box.
+		///
+		/// @param box       The box to test.
+		/// @param distance  Set to the distance of the first hit, zero if the origin is inside.
+		///
+		/// @returns         True if the ray hits the box.
+		///
+		////////////////////////////////////////////////////////////
+		bool intersects(const BoundingBox& box, float& distance) const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Checks whether the ray hits a sphere.
+		///
+		/// @param sphere    The sphere to test.
+		/// @param distance  Set to the distance of the first hit, zero if the origin is inside.
+		///
+		/// @returns         True if the ray hits the sphere.
+		///
+		////////////////////////////////////////////////////////////
+		bool intersects(const BoundingSphere& sphere, float& distance) const;
+	};
+
+} // namespace jackal
+
+#endif//__JACKAL_RAY_HPP__
+
+////////////////////////////////////////////////////////////
+/// @author Benjamin Carter
+///
+/// @class jackal::Ray
+/// @ingroup math
+///
+/// The jackal::Ray is a half line, used for picking objects
+/// under the cursor and for line of sight queries.
+///
+/// Due to the internal use of the class, it is not exposed to the
+/// lua scripting interface.
+///
+/// @code
+/// using namespace jackal;
+///
+/// Ray ray(camera.getTransform().getPosition(), Vector3f::forward());
+///
+/// float distance;
+/// if (ray.intersects(mesh.getBoundingBox(), distance))
+/// {
+///		std::cout << ray.getPoint(distance) << std::endl;
+/// }
+/// @endcode
+///
+////////////////////////////////////////////////////////////
@@ -25,6 +25,11 @@
 #ifndef __JACKAL_BUFFER_HPP__
 #define __JACKAL_BUFFER_HPP__
 
+//====================
+// Jackal includes
+//====================
+#include <jackal/rendering/vertex_layout.hpp> // Specifying the attributes of vertex buffers.
+
 //====================
 // Additional includes
 //====================
@@ -39,7 +44,9 @@ namespace jackal
 	{
 		VERTEX,
 		INDEX,
-		ARRAY
+		SHORT_INDEX,
+		ARRAY,
+		INDIRECT
 	};
 
 	class Buffer 
@@ -48,8 +55,9 @@ namespace jackal
 		//====================
 		// Member variables
 		//====================
-		GLuint      m_ID;   ///< Unique identifier for the buffer object.
-		eBufferType m_type; ///< The type of buffer being bound and populated.
+		GLuint       m_ID;     ///< Unique identifier for the buffer object.
+		eBufferType  m_type;   ///< The type of buffer being bound and populated.
+		VertexLayout m_layout; ///< The layout of the vertices within a vertex buffer.
 
 	public:
 		//====================
@@ -59,7 +67,8 @@ namespace jackal
 		/// @brief Default constructor for the Buffer object.
 		///
 		/// The default constructor sets all of the member variables to
-		/// default values. The default type for a buffer is of type eBufferType::VERTEX.
+		/// default values. The default type for a buffer is of type eBufferType::VERTEX,
+		/// with the standard vertex layout.
 		///
 		////////////////////////////////////////////////////////////
 		explicit Buffer();
@@ -75,6 +84,17 @@ namespace jackal
 		////////////////////////////////////////////////////////////
 		explicit Buffer(eBufferType type);
 
+		////////////////////////////////////////////////////////////
+		/// @brief Constructor for a vertex Buffer of a specific layout.
+		///
+		/// The size of each vertex and the attribute pointers that are
+		/// specified when the Buffer is bound are taken from the layout.
+		///
+		/// @param layout  The layout of the vertices within the Buffer.
+		///
+		////////////////////////////////////////////////////////////
+		explicit Buffer(const VertexLayout& layout);
+
 		////////////////////////////////////////////////////////////
 		/// @brief Destructor for the Buffer object. 
 		///
@@ -142,6 +162,16 @@ namespace jackal
 		////////////////////////////////////////////////////////////
 		eBufferType getType() const;
 
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the layout of the vertices within the Buffer.
+		///
+		/// The layout is only used by buffers of type eBufferType::VERTEX.
+		///
+		/// @returns The vertex layout of the Buffer object.
+		///
+		////////////////////////////////////////////////////////////
+		const VertexLayout& getLayout() const;
+
 		////////////////////////////////////////////////////////////
 		/// @brief Retrieves whether the current Buffer has been created.
 		///
@@ -185,21 +215,38 @@ namespace jackal
 		/// In order for the buffer to render or process information correctly,
 		/// the data and size of the data in question must be allocated for the
 		/// correct behavior. It should be noted that Buffer objects assigned to
-		/// the flag eBufferType::ARRAY do not need to be allocated.
+		/// the flag eBufferType::ARRAY do not need to be allocated. When the
+		/// data is null the storage is only reserved, and nothing is uploaded.
 		///
 		/// @param pData  The raw data to bind to the Buffer.
-		/// @param count  The amount of data to bind.
+		/// @param count  The amount of data to bind, in vertices for vertex buffers.
 		///
 		////////////////////////////////////////////////////////////
 		void allocate(const void* pData, int count);
 
+		////////////////////////////////////////////////////////////
+		/// @brief Updates a sub-range of the data allocated to the Buffer.
+		///
+		/// Unlike allocate, this method does not re-create the storage of
+		/// the Buffer, it simply overwrites a range of the existing storage.
+		/// The storage must have been allocated beforehand, passing a null
+		/// pointer to allocate will reserve storage without populating it.
+		///
+		/// @param pData   The raw data to copy into the Buffer.
+		/// @param offset  The element offset to start writing at.
+		/// @param count   The amount of data to write.
+		///
+		////////////////////////////////////////////////////////////
+		void update(const void* pData, int offset, int count);
+
 		////////////////////////////////////////////////////////////
 		/// @brief Binds a Buffer object for use.
 		///
 		/// A buffer must be bound in order for the rendering capabilities
 		/// to render correctly. Commonly only buffers that are assigned the
 		/// flag eBufferType::ARRAY will need to be constantly bound each
-		/// frame.
+		/// frame. Binding a vertex buffer specifies the attribute pointers
+		/// of its layout on the bound vertex array.
 		///
 		////////////////////////////////////////////////////////////
 		static void bind(const Buffer& buffer);
@@ -231,18 +278,20 @@ namespace jackal
 /// to make it easier to manipulate states and different Buffer binding types.
 ///
 /// The Buffer object can be used to bind behaviors of different types:
-/// vertices, indices and vertex arrays. Due to the low level aspects of the
+/// vertices, indices, vertex arrays and indirect draw commands. Due to the low level aspects of the
 /// class, it is not exposed to the lua scripting interface.
 ///
 /// @code
 /// using namespace jackal;
 ///
-/// // Create a new buffer object of type vertex.
-/// Buffer vbo(eBufferType::VERTEX);
+/// // Create a new vertex buffer of the compressed layout.
+/// Buffer vbo(VertexLayout::compressed());
 /// vbo.create();
 ///
-/// // Binds the information of a vertex vector container.
-/// vbo.allocate(vertices.data(), vertices.size());
+/// // Binds the information of an encoded vertex container.
+/// std::vector<unsigned char> encoded(vertices.size() * vbo.getLayout().getStride());
+/// vbo.getLayout().encode(vertices.data(), vertices.size(), box, encoded.data());
+/// vbo.allocate(encoded.data(), vertices.size());
 ///
 /// // Bind the Buffer object and render a mesh.
 /// vbo.bind();
@@ -0,0 +1,328 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __JACKAL_CLUSTERED_LIGHTING_HPP__
+#define __JACKAL_CLUSTERED_LIGHTING_HPP__
+
+//====================
+// C++ includes
+//====================
+#include <array>   // Storing the index lists of each depth slice.
+#include <cstddef> // Counting the visible lights.
+#include <cstdint> // Fixed width light indices.
+#include <vector>  // Storing the lights and the packed buffers.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/utils/singleton.hpp>      // ClusteredLighting is a singleton object.
+#include <jackal/math/bounding_sphere.hpp> // The view space bounds of each light.
+#include <jackal/math/matrix4.hpp>         // The view matrix the clusters were built from.
+#include <jackal/math/vector2.hpp>         // The size of the screen the clusters divide.
+
+//====================
+// Additional includes
+//====================
+#include <GL/glew.h> // Uploading the light lists to buffer textures.
+
+namespace jackal
+{
+	//====================
+	// Forward declarations
+	//====================
+	class Camera;
+	class DirectionalLight;
+	class PointLight;
+	class SpotLight;
+
+	class ClusteredLighting final : public Singleton<ClusteredLighting>
+	{
+	public:
+		//====================
+		// Static variables
+		//====================
+		static const int TILES_X      = 16;                          ///< The number of clusters across the screen.
+		static const int TILES_Y      = 9;                           ///< The number of clusters down the screen.
+		static const int SLICES       = 24;                          ///< The number of depth slices between the near and far plane.
+		static const int CLUSTERS     = TILES_X * TILES_Y * SLICES;  ///< The total number of clusters.
+		static const int LIGHT_TEXELS = 4;                           ///< The number of RGBA texels that describe a light.
+		static const int TEXTURE_UNIT = 2;                           ///< The first texture unit, following the material textures.
+
+	private:
+		//====================
+		// Friend classes
+		//====================
+		friend class Singleton<ClusteredLighting>;
+
+		//====================
+		// Enumerations
+		//====================
+		enum eBuffer : int
+		{
+			LIGHTS,  ///< The colour, position and cone of every light.
+			GRID,    ///< The offset and count of the index list of every cluster.
+			INDICES, ///< The light indices of every cluster, stored contiguously.
+			BUFFERS  ///< The number of buffers.
+		};
+
+		//====================
+		// Member variables
+		//====================
+		const DirectionalLight*                           m_pDirectional; ///< The light shading every pixel, may be null.
+		std::vector<const PointLight*>                    m_pointLights;  ///< The point lights within the scene.
+		std::vector<const SpotLight*>                     m_spotLights;   ///< The spot lights within the scene.
+		std::vector<BoundingSphere>                       m_bounds;       ///< The view space bounds of each uploaded light.
+		std::vector<float>                                m_lights;       ///< The packed data of each uploaded light.
+		std::array<std::vector<std::uint32_t>, SLICES>    m_slices;       ///< The index lists built by each depth slice job.
+		std::vector<std::uint32_t>                        m_grid;         ///< The offset and count of every cluster.
+		std::vector<std::uint32_t>                        m_indices;      ///< The index lists of every cluster.
+		Matrix4                                           m_view;         ///< The view matrix the clusters were built from.
+		Vector2f                                          m_screenSize;   ///< The size of the screen the clusters divide.
+		float                                             m_near;         ///< The depth of the first slice.
+		float                                             m_far;          ///< The depth of the last slice.
+		float                                             m_sliceScale;   ///< Converts the log of a depth into a slice.
+		std::array<GLuint, BUFFERS>                       m_buffers;      ///< The buffer objects holding the data.
+		std::array<GLuint, BUFFERS>                       m_textures;     ///< The buffer textures sampled by the shaders.
+
+	private:
+		//====================
+		// Ctor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Default constructor for the ClusteredLighting object.
+		////////////////////////////////////////////////////////////
+		explicit ClusteredLighting();
+
+		//====================
+		// Private methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Packs the lights and calculates their view space bounds.
+		///
+		/// Lights that lie entirely outside of the depth range of the
+		/// clusters are not uploaded.
+		///
+		////////////////////////////////////////////////////////////
+		void gatherLights();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Builds the index lists of every cluster within a depth slice.
+		///
+		/// Each slice only writes to its own index list and to its own
+		/// range of the grid, so the slices can be built in parallel.
+		///
+		/// @param slice   The depth slice to build.
+		/// @param scaleX  The horizontal scale of the projection matrix.
+		/// @param scaleY  The vertical scale of the projection matrix.
+		///
+		////////////////////////////////////////////////////////////
+		void assignSlice(int slice, float scaleX, float scaleY);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Uploads the packed buffers on the render thread.
+		///
+		/// The buffer textures are bound once, to the units following
+		/// TEXTURE_UNIT, as the material textures never use them.
+		///
+		////////////////////////////////////////////////////////////
+		void upload();
+
+	public:
+		//====================
+		// Dtor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Default destructor for the ClusteredLighting object.
+		////////////////////////////////////////////////////////////
+		~ClusteredLighting() = default;
+
+		//====================
+		// Getters and setters
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Sets the directional light that shades every pixel.
+		///
+		/// @param pLight  The directional light, or null for none.
+		///
+		////////////////////////////////////////////////////////////
+		void setDirectionalLight(const DirectionalLight* pLight);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the directional light that shades every pixel.
+		///
+		/// @returns The directional light, or null if there is none.
+		///
+		////////////////////////////////////////////////////////////
+		const DirectionalLight* getDirectionalLight() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the number of lights uploaded in the last update.
+		///
+		/// @returns The number of point and spot lights that reach the clusters.
+		///
+		////////////////////////////////////////////////////////////
+		std::size_t getVisibleCount() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the view matrix the clusters were built from.
+		///
+		/// @returns The view matrix of the camera in the last update.
+		///
+		////////////////////////////////////////////////////////////
+		const Matrix4& getView() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the size of the screen the clusters divide.
+		///
+		/// @returns The size of the camera in the last update.
+		///
+		////////////////////////////////////////////////////////////
+		const Vector2f& getScreenSize() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the depth of the first slice.
+		///
+		/// @returns The near plane of the camera in the last update.
+		///
+		////////////////////////////////////////////////////////////
+		float getNear() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the scale that converts a depth into a slice.
+		///
+		/// The slices are distributed exponentially, the slice of a depth
+		/// is floor(log(depth / near) * scale).
+		///
+		/// @returns The scale of the slices in the last update.
+		///
+		////////////////////////////////////////////////////////////
+		float getSliceScale() const;
+
+		//====================
+		// Methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Adds a point light to the scene.
+		///
+		/// The light is not owned, it must be removed before it is destroyed.
+		///
+		/// @param pLight  The point light to add.
+		///
+		////////////////////////////////////////////////////////////
+		void add(const PointLight* pLight);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Adds a spot light to the scene.
+		///
+		/// The light is not owned, it must be removed before it is destroyed.
+		///
+		/// @param pLight  The spot light to add.
+		///
+		////////////////////////////////////////////////////////////
+		void add(const SpotLight* pLight);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Removes a point light from the scene.
+		///
+		/// @param pLight  The point light to remove.
+		///
+		////////////////////////////////////////////////////////////
+		void remove(const PointLight* pLight);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Removes a spot light from the scene.
+		///
+		/// @param pLight  The spot light to remove.
+		///
+		////////////////////////////////////////////////////////////
+		void remove(const SpotLight* pLight);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Removes every light from the scene.
+		////////////////////////////////////////////////////////////
+		void clear();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Assigns the lights to the clusters of the camera.
+		///
+		/// The view frustum is divided into TILES_X by TILES_Y tiles on
+		/// screen and SLICES exponential depth slices. Every light is
+		/// tested against the view space bounds of each cluster, with a
+		/// job per depth slice on the ThreadPool, and the resulting index
+		/// lists are uploaded to buffer textures. This should be invoked
+		/// once per frame, before any lit objects are processed.
+		///
+		/// @param camera  The camera the scene is rendered from.
+		///
+		////////////////////////////////////////////////////////////
+		void update(const Camera& camera);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Destroys the buffers and buffer textures.
+		////////////////////////////////////////////////////////////
+		void destroy();
+	};
+
+} // namespace jackal
+
+#endif//__JACKAL_CLUSTERED_LIGHTING_HPP__
+
+////////////////////////////////////////////////////////////
+/// @author Benjamin Carter
+///
+/// @class jackal::ClusteredLighting
+/// @ingroup rendering
+///
+/// The jackal::ClusteredLighting divides the view frustum into a
+/// grid of clusters and, each frame, assigns every point and spot
+/// light to the clusters it can reach. The lit shaders find the
+/// cluster of each pixel and only shade the lights within it, so a
+/// scene with hundreds of small lights costs roughly the same per
+/// pixel as a scene with a few.
+///
+/// The light data and index lists are uploaded to buffer textures,
+/// rather than uniform arrays, so the number of lights is not limited
+/// by the uniform storage of the driver. Due to the internal use of
+/// the class, it is not exposed to the lua scripting interface.
+///
+/// @code
+/// using namespace jackal;
+///
+/// auto& lighting = ClusteredLighting::getInstance();
+/// lighting.setDirectionalLight(pSun);
+/// lighting.add(PointLight::create(Colour::white(), 2.0f, Vector3f::zero(), 5.0f));
+///
+/// while (window.isRunning())
+/// {
+///		lighting.update(Camera::getMain());
+///
+///		Material::bind(*material.get());
+///		material->process(transform);
+///		mesh.render();
+/// }
+///
+/// lighting.destroy();
+/// @endcode
+///
+////////////////////////////////////////////////////////////
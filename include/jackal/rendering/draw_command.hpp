@@ -0,0 +1,97 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __JACKAL_DRAW_COMMAND_HPP__
+#define __JACKAL_DRAW_COMMAND_HPP__
+
+//====================
+// Additional includes
+//====================
+#include <GL/glew.h> // OpenGL types.
+
+namespace jackal
+{
+	struct DrawCommand_t final
+	{
+		//====================
+		// Member variables
+		//====================
+		GLuint count;         ///< The number of indices to draw.
+		GLuint instanceCount; ///< The number of instances to draw.
+		GLuint firstIndex;    ///< The first index within the bound index buffer.
+		GLint  baseVertex;    ///< The value added to each index before fetching the vertex.
+		GLuint baseInstance;  ///< The first instance, used for fetching instanced attributes.
+
+		//====================
+		// Ctor and dtor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Default constructor for the DrawCommand_t object.
+		///
+		/// The default constructor creates a command that draws a single
+		/// instance of nothing.
+		///
+		////////////////////////////////////////////////////////////
+		explicit DrawCommand_t()
+			: count(0), instanceCount(1), firstIndex(0), baseVertex(0), baseInstance(0)
+		{
+		}
+
+		////////////////////////////////////////////////////////////
+		/// @brief Constructor for specifying the indices to draw.
+		///
+		/// This constructor creates a command that draws a single instance
+		/// of the specified index range.
+		///
+		/// @param count       The number of indices to draw.
+		/// @param firstIndex  The first index within the bound index buffer.
+		/// @param baseVertex  The value added to each index before fetching the vertex.
+		///
+		////////////////////////////////////////////////////////////
+		explicit DrawCommand_t(GLuint count, GLuint firstIndex, GLint baseVertex)
+			: count(count), instanceCount(1), firstIndex(firstIndex), baseVertex(baseVertex), baseInstance(0)
+		{
+		}
+	};
+
+	static_assert(sizeof(DrawCommand_t) == sizeof(GLuint) * 5, "DrawCommand_t must match the layout expected by OpenGL.");
+
+} // namespace jackal
+
+#endif//__JACKAL_DRAW_COMMAND_HPP__
+
+////////////////////////////////////////////////////////////
+/// @author Benjamin Carter
+///
+/// @class jackal::DrawCommand_t
+/// @ingroup rendering
+///
+/// The jackal::DrawCommand_t is a basic struct that mirrors the
+/// layout of the indirect draw commands consumed by OpenGL, an array
+/// of these commands can be uploaded to an indirect Buffer and drawn
+/// with a single call. Due to its simplicity and internal use, an
+/// example is not provided and it is not exposed to the lua scripting
+/// interface.
+///
+////////////////////////////////////////////////////////////
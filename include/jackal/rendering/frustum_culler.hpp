@@ -0,0 +1,222 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __JACKAL_FRUSTUM_CULLER_HPP__
+#define __JACKAL_FRUSTUM_CULLER_HPP__
+
+//====================
+// C++ includes
+//====================
+#include <cstddef>                      // Indexing the boxes.
+#include <cstdint>                      // Storing the visibility of each box.
+#include <vector>                       // Storing the boxes by component.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/math/bounding_box.hpp> // The world space bounds of each object.
+#include <jackal/math/frustum.hpp>      // The frustum the boxes are tested against.
+#include <jackal/math/matrix4.hpp>      // Projecting the boxes onto the screen.
+#include <jackal/math/vector2.hpp>      // The size of the screen the boxes are projected onto.
+
+namespace jackal
+{
+	class FrustumCuller final
+	{
+	public:
+		//====================
+		// Static variables
+		//====================
+		static const int WIDTH = 4;    ///< The number of boxes tested at once.
+		static const int GRAIN = 1024; ///< The minimum number of boxes culled by each thread.
+
+	private:
+		//====================
+		// Member variables
+		//====================
+		std::vector<float>         m_minX;    ///< The minimum x of each box.
+		std::vector<float>         m_minY;    ///< The minimum y of each box.
+		std::vector<float>         m_minZ;    ///< The minimum z of each box.
+		std::vector<float>         m_maxX;    ///< The maximum x of each box.
+		std::vector<float>         m_maxY;    ///< The maximum y of each box.
+		std::vector<float>         m_maxZ;    ///< The maximum z of each box.
+		std::vector<std::uint8_t>  m_visible; ///< Whether each box was visible when last culled.
+		std::vector<std::uint32_t> m_indices; ///< The indices of the visible boxes.
+		std::size_t                m_count;   ///< The number of boxes, not including padding.
+
+	private:
+		//====================
+		// Private methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Tests a range of boxes against the frustum.
+		///
+		/// The boxes are tested WIDTH at a time, when SSE is available
+		/// every plane is tested against four boxes with a single set of
+		/// instructions.
+		///
+		/// @param frustum  The frustum to test against.
+		/// @param begin    The first box, a multiple of WIDTH.
+		/// @param end      One past the last box, a multiple of WIDTH.
+		///
+		////////////////////////////////////////////////////////////
+		void cullRange(const Frustum& frustum, std::size_t begin, std::size_t end);
+
+	public:
+		//====================
+		// Ctor and dtor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Default constructor for the FrustumCuller object.
+		////////////////////////////////////////////////////////////
+		explicit FrustumCuller();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Default destructor for the FrustumCuller object.
+		////////////////////////////////////////////////////////////
+		~FrustumCuller() = default;
+
+		//====================
+		// Getters and setters
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Sets the world space bounds of a box.
+		///
+		/// This should be invoked whenever the object moves.
+		///
+		/// @param index  The index returned when the box was added.
+		/// @param box    The world space bounds of the object.
+		///
+		////////////////////////////////////////////////////////////
+		void set(std::size_t index, const BoundingBox& box);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the number of boxes within the culler.
+		///
+		/// @returns The number of boxes that have been added.
+		///
+		////////////////////////////////////////////////////////////
+		std::size_t getCount() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Checks whether a box was visible when last culled.
+		///
+		/// @param index  The index returned when the box was added.
+		///
+		/// @returns      True if the box intersects the frustum.
+		///
+		////////////////////////////////////////////////////////////
+		bool isVisible(std::size_t index) const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the size of a box projected onto the screen.
+		///
+		/// This is the feedback used to stream textures, an object is
+		/// only given the texture resolution it covers on screen. A box
+		/// that reaches behind the camera covers the whole screen.
+		///
+		/// @param index           The index returned when the box was added.
+		/// @param viewProjection  The view-projection matrix the box was culled with.
+		/// @param screenSize      The width and height of the screen, in pixels.
+		///
+		/// @returns               The larger of the width and height the box covers, in pixels.
+		///
+		////////////////////////////////////////////////////////////
+		float getScreenSize(std::size_t index, const Matrix4& viewProjection, const Vector2f& screenSize) const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the indices of the boxes that were visible when last culled.
+		///
+		/// @returns The visible indices, in ascending order.
+		///
+		////////////////////////////////////////////////////////////
+		const std::vector<std::uint32_t>& getVisible() const;
+
+		//====================
+		// Methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Adds a box to the culler.
+		///
+		/// @param box  The world space bounds of the object.
+		///
+		/// @returns    The index of the box.
+		///
+		////////////////////////////////////////////////////////////
+		std::size_t add(const BoundingBox& box);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Removes every box from the culler.
+		////////////////////////////////////////////////////////////
+		void clear();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Tests every box against a frustum.
+		///
+		/// Large sets of boxes are split across the workers of the
+		/// ThreadPool, the visible indices are gathered afterwards.
+		///
+		/// @param frustum  The frustum of the camera.
+		///
+		/// @returns        The number of visible boxes.
+		///
+		////////////////////////////////////////////////////////////
+		std::size_t cull(const Frustum& frustum);
+	};
+
+} // namespace jackal
+
+#endif//__JACKAL_FRUSTUM_CULLER_HPP__
+
+////////////////////////////////////////////////////////////
+/// @author Benjamin Carter
+///
+/// @class jackal::FrustumCuller
+/// @ingroup rendering
+///
+/// The jackal::FrustumCuller determines which objects of a
+/// scene are within the view of the camera, so objects that are
+/// off-screen are never submitted. The world space box of each
+/// object is stored by component, so four boxes can be loaded and
+/// tested against a plane at once.
+///
+/// Due to the internal use of the class, it is not exposed to the
+/// lua scripting interface.
+///
+/// @code
+/// using namespace jackal;
+///
+/// FrustumCuller culler;
+/// std::size_t index = culler.add(mesh.getBoundingBox().transform(transform.getTransformation()));
+///
+/// culler.cull(Frustum(camera.getViewProjection()));
+///
+/// if (culler.isVisible(index))
+/// {
+///		mesh.updateLod(culler.getScreenSize(index, camera.getViewProjection(), screenSize));
+///		mesh.render();
+/// }
+/// @endcode
+///
+////////////////////////////////////////////////////////////
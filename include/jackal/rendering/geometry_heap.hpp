@@ -0,0 +1,344 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __JACKAL_GEOMETRY_HEAP_HPP__
+#define __JACKAL_GEOMETRY_HEAP_HPP__
+
+//====================
+// C++ includes
+//====================
+#include <vector>                            // Storing the pages of the heap.
+#include <memory>                            // Pages own GL buffers, so they are stored by pointer.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/utils/singleton.hpp>         // GeometryHeap is a singleton object.
+#include <jackal/utils/range_allocator.hpp>   // Sub-allocating the vertex and index ranges of a page.
+#include <jackal/rendering/buffer.hpp>        // Each page is made from a vertex array, vertex and index buffer.
+#include <jackal/rendering/vertex_layout.hpp> // Each page stores vertices of a single layout.
+
+namespace jackal
+{
+	//====================
+	// Structures
+	//====================
+	struct GeometryRange_t final
+	{
+		//====================
+		// Member variables
+		//====================
+		int     page;        ///< The page the range is allocated within, -1 if unallocated.
+		GLint   baseVertex;  ///< The first vertex of the range within the page.
+		GLsizei vertexCount; ///< The number of vertices within the range.
+		GLuint  firstIndex;  ///< The first index of the range within the page.
+		GLsizei indexCount;  ///< The number of indices within the range.
+		GLenum  indexType;   ///< GL_UNSIGNED_SHORT or GL_UNSIGNED_INT, the type of the indices of the page.
+
+		//====================
+		// Ctor and dtor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Default constructor for the GeometryRange_t struct.
+		///
+		/// A default range is not allocated within any page of the heap.
+		///
+		////////////////////////////////////////////////////////////
+		explicit GeometryRange_t();
+
+		//====================
+		// Getters and setters
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Checks whether the range is allocated within the heap.
+		///
+		/// @returns True if the range refers to a page of the heap.
+		///
+		////////////////////////////////////////////////////////////
+		bool isValid() const;
+	};
+
+	class GeometryHeap final : public Singleton<GeometryHeap>
+	{
+	private:
+		//====================
+		// Friend classes
+		//====================
+		friend class Singleton<GeometryHeap>;
+
+		//====================
+		// Structures
+		//====================
+		struct Page_t
+		{
+			Buffer         vao;          ///< The vertex array that describes the vertex layout of the page.
+			Buffer         vbo;          ///< The vertex storage of the page.
+			Buffer         ibo;          ///< The index storage of the page.
+			RangeAllocator vertices;     ///< Allocator for the vertex storage.
+			RangeAllocator indices;      ///< Allocator for the index storage.
+			bool           shortIndices; ///< Whether the page stores 16-bit indices.
+
+			////////////////////////////////////////////////////////////
+			/// @brief Constructor for the Page_t struct.
+			///
+			/// @param layout        The layout of the vertices of the page.
+			/// @param shortIndices  Whether the page stores 16-bit indices.
+			///
+			////////////////////////////////////////////////////////////
+			explicit Page_t(const VertexLayout& layout, bool shortIndices);
+		};
+
+		//====================
+		// Member variables
+		//====================
+		std::vector<std::unique_ptr<Page_t>> m_pages;     ///< The pages of the heap.
+		int                                  m_boundPage; ///< The page whose vertex array is currently bound.
+
+	private:
+		//====================
+		// Ctor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Default constructor for the GeometryHeap object.
+		///
+		/// The heap does not create any pages upon construction, as an
+		/// OpenGL context may not exist yet. Pages are created lazily
+		/// when the first allocation occurs.
+		///
+		////////////////////////////////////////////////////////////
+		explicit GeometryHeap();
+
+		//====================
+		// Private methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Creates a new page within the heap.
+		///
+		/// The storage of the page is reserved up-front, the vertex
+		/// attributes of the page are bound to its vertex array once
+		/// and never changed again.
+		///
+		/// @param layout          The layout of the vertices of the page.
+		/// @param vertexCapacity  The number of vertices the page can store.
+		/// @param indexCapacity   The number of indices the page can store.
+		/// @param shortIndices    Whether the page stores 16-bit indices.
+		///
+		/// @returns The index of the newly created page.
+		///
+		////////////////////////////////////////////////////////////
+		int createPage(const VertexLayout& layout, int vertexCapacity, int indexCapacity, bool shortIndices);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Allocates and uploads a range within a page of a layout and index type.
+		///
+		/// @param layout        The layout the vertices are encoded with.
+		/// @param pVertices     The encoded vertices to upload.
+		/// @param vertexCount   The number of vertices to upload.
+		/// @param pIndices      The GLushort or GLuint indices to upload.
+		/// @param indexCount    The number of indices to upload.
+		/// @param shortIndices  Whether the indices are 16-bit.
+		/// @param range         The range that the geometry was allocated to.
+		///
+		/// @returns True if the geometry was allocated successfully.
+		///
+		////////////////////////////////////////////////////////////
+		bool allocateRange(const VertexLayout& layout, const void* pVertices, int vertexCount, const void* pIndices, int indexCount, bool shortIndices,
+			GeometryRange_t& range);
+
+	public:
+		//====================
+		// Static variables
+		//====================
+		static const int VERTICES_PER_PAGE  = 1 << 18; ///< The default vertex capacity of a page. (8MB for the standard layout)
+		static const int INDICES_PER_PAGE   = 1 << 20; ///< The default index capacity of a page. (4MB, 2MB for 16-bit pages)
+		static const int MAX_SHORT_VERTICES = 1 << 16; ///< Ranges with at most this many vertices are stored with 16-bit indices.
+
+		//====================
+		// Dtor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Default destructor for the GeometryHeap object.
+		////////////////////////////////////////////////////////////
+		~GeometryHeap() = default;
+
+		//====================
+		// Getters and setters
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the number of pages currently within the heap.
+		///
+		/// @returns The number of pages of the heap.
+		///
+		////////////////////////////////////////////////////////////
+		int getPageCount() const;
+
+		//====================
+		// Methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Allocates and uploads a vertex and index range.
+		///
+		/// The vertices and indices are placed in the first page of the
+		/// layout with enough free space for both of them, if no page can hold the
+		/// geometry a new page is created. Geometry that is larger than
+		/// a default page is given a page of its own. The indices are
+		/// relative to the first vertex of the range, the base vertex
+		/// offset is applied when the range is drawn. Ranges with no
+		/// more than MAX_SHORT_VERTICES vertices have their indices
+		/// narrowed and are placed in the pages of 16-bit indices.
+		///
+		/// @param layout       The layout the vertices are encoded with.
+		/// @param pVertices    The encoded vertices to upload.
+		/// @param vertexCount  The number of vertices to upload.
+		/// @param pIndices     The indices to upload.
+		/// @param indexCount   The number of indices to upload.
+		/// @param range        The range that the geometry was allocated to.
+		///
+		/// @returns True if the geometry was allocated successfully.
+		///
+		////////////////////////////////////////////////////////////
+		bool allocate(const VertexLayout& layout, const void* pVertices, int vertexCount, const GLuint* pIndices, int indexCount, GeometryRange_t& range);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Allocates and uploads a range with 16-bit indices.
+		///
+		/// The indices are uploaded as they are, such as straight from
+		/// a mapped .jmesh file. The range must have no more than
+		/// MAX_SHORT_VERTICES vertices.
+		///
+		/// @param layout       The layout the vertices are encoded with.
+		/// @param pVertices    The encoded vertices to upload.
+		/// @param vertexCount  The number of vertices to upload.
+		/// @param pIndices     The indices to upload.
+		/// @param indexCount   The number of indices to upload.
+		/// @param range        The range that the geometry was allocated to.
+		///
+		/// @returns True if the geometry was allocated successfully.
+		///
+		////////////////////////////////////////////////////////////
+		bool allocate(const VertexLayout& layout, const void* pVertices, int vertexCount, const GLushort* pIndices, int indexCount, GeometryRange_t& range);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Returns a range back to the heap.
+		///
+		/// The vertex and index storage of the range is returned to the
+		/// free list of its page and the range is reset to an unallocated
+		/// state. Freeing an unallocated range has no effect.
+		///
+		/// @param range  The range to free.
+		///
+		////////////////////////////////////////////////////////////
+		void free(GeometryRange_t& range);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Binds the vertex array of the page that a range belongs to.
+		///
+		/// The heap keeps track of the currently bound page, so binding
+		/// ranges that share a page will not result in redundant vertex
+		/// array switches.
+		///
+		/// @param range  The range to bind the page of.
+		///
+		////////////////////////////////////////////////////////////
+		void bind(const GeometryRange_t& range);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Binds the vertex array of a page of the heap.
+		///
+		/// The page is only bound if it is not already bound.
+		///
+		/// @param page  The index of the page to bind.
+		///
+		////////////////////////////////////////////////////////////
+		void bind(int page);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Unbinds the currently bound page of the heap.
+		///
+		/// This should be invoked before any code outside of the heap
+		/// binds a vertex array of its own.
+		///
+		////////////////////////////////////////////////////////////
+		void unbind();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Draws a range of the heap to the OpenGL context.
+		///
+		/// The page of the range is bound if required and the indices are
+		/// drawn with the base vertex of the range.
+		///
+		/// @param range  The range to draw.
+		///
+		////////////////////////////////////////////////////////////
+		void draw(const GeometryRange_t& range);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Destroys every page of the heap.
+		///
+		/// This must be invoked before the OpenGL context is destroyed,
+		/// any ranges that are still allocated become invalid.
+		///
+		////////////////////////////////////////////////////////////
+		void destroy();
+	};
+
+} // namespace jackal
+
+#endif//__JACKAL_GEOMETRY_HEAP_HPP__
+
+////////////////////////////////////////////////////////////
+/// @author Benjamin Carter
+///
+/// @class jackal::GeometryHeap
+/// @ingroup rendering
+///
+/// The jackal::GeometryHeap stores the vertices and indices of
+/// every renderable object within a small number of large buffers.
+/// Each page of the heap consists of a vertex buffer, an index buffer
+/// and a single vertex array for the VertexLayout of the page, ranges
+/// are handed out from the pages using a free list allocator. Meshes
+/// of different layouts never share a page.
+///
+/// As every mesh within a page shares the same vertex array, drawing
+/// several meshes in a row does not require the vertex array to be
+/// switched, and creating a mesh does not create any new OpenGL objects.
+/// Due to the internal use of the class, it is not exposed to the lua
+/// scripting interface.
+///
+/// @code
+/// using namespace jackal;
+///
+/// GeometryRange_t range;
+/// const VertexLayout& layout = VertexLayout::standard();
+/// std::vector<unsigned char> encoded(vertices.size() * layout.getStride());
+/// layout.encode(vertices.data(), vertices.size(), box, encoded.data());
+///
+/// if (GeometryHeap::getInstance().allocate(layout, encoded.data(), vertices.size(), indices.data(), indices.size(), range))
+/// {
+///		GeometryHeap::getInstance().draw(range);
+///		GeometryHeap::getInstance().free(range);
+/// }
+/// @endcode
+///
+////////////////////////////////////////////////////////////
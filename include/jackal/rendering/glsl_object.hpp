@@ -57,6 +57,7 @@ namespace jackal
 		GLenum      m_type;     ///< The type of shader this object is.
 		std::string m_filename; ///< The file location of the glsl shader.
 		std::string m_source;   ///< The source (file contents) of the shader.
+		std::string m_defines;  ///< The define directives injected after the version directive.
 		bool        m_compiled; ///< Whether the object has already been compiled.
 
 	private:
@@ -130,6 +131,25 @@ namespace jackal
 		////////////////////////////////////////////////////////////
 		std::string getFilename() const;
 
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the type of the glsl shader.
+		///
+		/// @returns The GL_VERTEX_SHADER or GL_FRAGMENT_SHADER type of the object.
+		///
+		////////////////////////////////////////////////////////////
+		GLenum getType() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the source of the glsl shader.
+		///
+		/// The source is released once the object has been compiled,
+		/// so the returned string is empty after compilation.
+		///
+		/// @returns The contents of the parsed shader file.
+		///
+		////////////////////////////////////////////////////////////
+		const std::string& getSource() const;
+
 		////////////////////////////////////////////////////////////
 		/// @brief Retrieves the compile state of the GLSL object.
 		///
@@ -141,6 +161,26 @@ namespace jackal
 		////////////////////////////////////////////////////////////
 		bool isCompiled() const;
 
+		////////////////////////////////////////////////////////////
+		/// @brief Sets the define directives injected into the source.
+		///
+		/// The defines are inserted after the version directive when the
+		/// shader is parsed, so they must be set before create is invoked.
+		/// They are retained so that a re-created object keeps its variant.
+		///
+		/// @param defines  The define directives, one per line.
+		///
+		////////////////////////////////////////////////////////////
+		void setDefines(const std::string& defines);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the define directives injected into the source.
+		///
+		/// @returns The define directives, one per line.
+		///
+		////////////////////////////////////////////////////////////
+		const std::string& getDefines() const;
+
 		//====================
 		// Methods
 		//====================
@@ -199,6 +239,29 @@ namespace jackal
 		///
 		////////////////////////////////////////////////////////////
 		void compile();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Submits the loaded shader to the driver for compilation.
+		///
+		/// Unlike compile, the status of the compilation is not queried,
+		/// so the driver is free to compile the shader in the background
+		/// while other objects are submitted. The result must be collected
+		/// with finish before the object is used.
+		///
+		////////////////////////////////////////////////////////////
+		void submit();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Collects the result of a submitted compilation.
+		///
+		/// Any syntax errors are sent to the external engine log file and
+		/// the object is destroyed. Querying the result blocks until the
+		/// driver has finished compiling the shader.
+		///
+		/// @returns True if the shader compiled successfully.
+		///
+		////////////////////////////////////////////////////////////
+		bool finish();
 	};
 
 } // namespace jackal 
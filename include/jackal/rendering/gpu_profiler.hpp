@@ -0,0 +1,302 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __JACKAL_GPU_PROFILER_HPP__
+#define __JACKAL_GPU_PROFILER_HPP__
+
+//====================
+// C++ includes
+//====================
+#include <array>                         // Storing the rolling samples and queries of a scope.
+#include <chrono>                        // Timing the CPU side of a scope.
+#include <memory>                        // Scopes are referenced by the render thread, so are stored by pointer.
+#include <mutex>                         // Samples are written by both the game and render thread.
+#include <string>                        // Naming each scope.
+#include <unordered_map>                 // Looking up a scope by its name.
+#include <vector>                        // Storing the scopes and the active scope stack.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/utils/singleton.hpp>    // GpuProfiler is a singleton object.
+#include <jackal/utils/non_copyable.hpp> // Profile scopes cannot be copied.
+
+//====================
+// Additional includes
+//====================
+#include <GL/glew.h>                     // Issuing the timer queries.
+
+namespace jackal
+{
+	//====================
+	// Structures
+	//====================
+	struct ProfileStatistics_t final
+	{
+		std::string name;       ///< The name of the scope.
+		double      cpuAverage; ///< The rolling average CPU time of the scope, in milliseconds.
+		double      cpuP95;     ///< The rolling 95th percentile CPU time of the scope, in milliseconds.
+		double      gpuAverage; ///< The rolling average GPU time of the scope, in milliseconds.
+		double      gpuP95;     ///< The rolling 95th percentile GPU time of the scope, in milliseconds.
+
+		////////////////////////////////////////////////////////////
+		/// @brief Default constructor for the ProfileStatistics_t object.
+		////////////////////////////////////////////////////////////
+		explicit ProfileStatistics_t();
+	};
+
+	class GpuProfiler final : public Singleton<GpuProfiler>
+	{
+	public:
+		//====================
+		// Static variables
+		//====================
+		static const int LATENCY = 4;   ///< The number of frames before a query result is read back.
+		static const int SAMPLES = 120; ///< The number of samples within the rolling window of a scope.
+
+	private:
+		//====================
+		// Friend classes
+		//====================
+		friend class Singleton<GpuProfiler>;
+
+		//====================
+		// Structures
+		//====================
+		struct Samples_t
+		{
+			std::array<double, SAMPLES> values; ///< The most recent samples, in milliseconds.
+			int                         count;  ///< The number of valid samples.
+			int                         next;   ///< The sample that will be overwritten next.
+
+			explicit Samples_t();
+			void push(double value);
+			double getAverage() const;
+			double getPercentile(double percentile) const;
+		};
+
+		struct Scope_t
+		{
+			std::string                  name;      ///< The name of the scope.
+			Samples_t                    cpu;       ///< The CPU time samples of the scope.
+			Samples_t                    gpu;       ///< The GPU time samples of the scope.
+			std::array<GLuint, LATENCY>  queries;   ///< A timer query for each frame in flight.
+			std::array<bool, LATENCY>    issued;    ///< Whether each query is waiting to be read back.
+			unsigned long long           lastFrame; ///< The last frame the scope issued a query.
+			bool                         warned;    ///< Whether nesting has been reported for the scope.
+
+			explicit Scope_t(const std::string& scopeName);
+		};
+
+		struct Active_t
+		{
+			int                                   scope; ///< The index of the active scope.
+			bool                                  gpu;   ///< Whether a timer query was issued for the scope.
+			std::chrono::steady_clock::time_point start; ///< The time the scope began.
+		};
+
+		//====================
+		// Member variables
+		//====================
+		std::vector<std::unique_ptr<Scope_t>> m_scopes;    ///< Every scope that has been profiled.
+		std::unordered_map<std::string, int>  m_lookup;    ///< Maps the name of a scope to its index.
+		std::vector<Active_t>                 m_stack;     ///< The scopes that have begun but not ended.
+		bool                                  m_gpuActive; ///< Whether a timer query is currently open.
+		bool                                  m_enabled;   ///< Whether scopes are being profiled.
+		unsigned long long                    m_frame;     ///< The frame currently being recorded.
+		mutable std::mutex                    m_mutex;     ///< Locks the samples of every scope.
+
+	private:
+		//====================
+		// Ctor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Default constructor for the GpuProfiler object.
+		////////////////////////////////////////////////////////////
+		explicit GpuProfiler();
+
+		//====================
+		// Private methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Reads back the result of a query, if it is available.
+		///
+		/// Invoked on the render thread before a query is reused, if
+		/// the result is still not available the sample is dropped rather
+		/// than stalling the pipeline.
+		///
+		/// @param scope  The scope that owns the query.
+		/// @param slot   The frame slot of the query.
+		///
+		////////////////////////////////////////////////////////////
+		void collect(Scope_t& scope, int slot);
+
+	public:
+		//====================
+		// Dtor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Default destructor for the GpuProfiler object.
+		////////////////////////////////////////////////////////////
+		~GpuProfiler() = default;
+
+		//====================
+		// Getters and setters
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Enables or disables profiling.
+		///
+		/// @param enabled  Whether scopes should be profiled.
+		///
+		////////////////////////////////////////////////////////////
+		void setEnabled(bool enabled);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves whether profiling is enabled.
+		///
+		/// @returns True if scopes are being profiled.
+		///
+		////////////////////////////////////////////////////////////
+		bool isEnabled() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the rolling statistics of every scope.
+		///
+		/// @returns The statistics of each scope, in the order they were first profiled.
+		///
+		////////////////////////////////////////////////////////////
+		std::vector<ProfileStatistics_t> getStatistics() const;
+
+		//====================
+		// Methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Begins timing a scope.
+		///
+		/// The CPU time is measured on the calling thread and a timer
+		/// query is recorded around the commands of the scope. Timer
+		/// queries cannot be nested, so a scope that begins within
+		/// another is only timed on the CPU. A scope only issues a
+		/// query the first time it begins each frame.
+		///
+		/// @param name  The name of the scope.
+		///
+		////////////////////////////////////////////////////////////
+		void beginScope(const std::string& name);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Ends the most recent scope.
+		////////////////////////////////////////////////////////////
+		void endScope();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Marks the end of the frame.
+		///
+		/// This should be invoked once per frame, after the window has
+		/// been swapped.
+		///
+		////////////////////////////////////////////////////////////
+		void endFrame();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Writes the statistics of every scope to the log.
+		////////////////////////////////////////////////////////////
+		void report() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Writes the statistics of every scope to a csv file.
+		///
+		/// @param filename  The location of the csv file to write.
+		///
+		/// @returns         True if the file was written successfully.
+		///
+		////////////////////////////////////////////////////////////
+		bool writeCSV(const std::string& filename) const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Destroys every timer query and scope.
+		////////////////////////////////////////////////////////////
+		void destroy();
+	};
+
+	struct ProfileScope_t final : NonCopyable
+	{
+		////////////////////////////////////////////////////////////
+		/// @brief Begins a scope of the GpuProfiler.
+		///
+		/// @param name  The name of the scope.
+		///
+		////////////////////////////////////////////////////////////
+		explicit ProfileScope_t(const std::string& name);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Ends the scope of the GpuProfiler.
+		////////////////////////////////////////////////////////////
+		~ProfileScope_t();
+	};
+
+} // namespace jackal
+
+#endif//__JACKAL_GPU_PROFILER_HPP__
+
+////////////////////////////////////////////////////////////
+/// @author Benjamin Carter
+///
+/// @class jackal::GpuProfiler
+/// @ingroup rendering
+///
+/// The jackal::GpuProfiler measures where the time of each frame
+/// is spent. Each named scope, typically a render pass, is timed on
+/// the CPU as it is recorded and on the GPU with a GL_TIME_ELAPSED
+/// query. Queries are read back several frames later so the profiler
+/// never stalls the pipeline, results that are still not ready are
+/// dropped.
+///
+/// Both timings are kept in a rolling window, the averages and 95th
+/// percentiles can be written to the log or a csv file. A scope whose
+/// CPU time exceeds its GPU time is bound by command submission, the
+/// opposite suggests it is bound by the GPU, commonly fill rate. Due to
+/// the internal use of the class, it is not exposed to the lua scripting
+/// interface.
+///
+/// @code
+/// using namespace jackal;
+///
+/// while (window.isRunning())
+/// {
+///		window.clear();
+///
+///		{
+///			ProfileScope_t scope("Opaque");
+///			mesh.render();
+///		}
+///
+///		window.swap();
+///		GpuProfiler::getInstance().endFrame();
+/// }
+///
+/// GpuProfiler::getInstance().report();
+/// @endcode
+///
+////////////////////////////////////////////////////////////
@@ -1,28 +1,90 @@
 #ifndef __JACKAL_GUI_TEXTURE_HPP__
 #define __JACKAL_GUI_TEXTURE_HPP__
 
-#include <jackal/rendering/texture.hpp>
-#include <GL/glew.h>
-#include <Awesomium/Surface.h>
+//====================
+// C++ includes
+//====================
+#include <vector>                       // Storing the regions painted since the last upload.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/rendering/texture.hpp> // GUITexture is a texture.
+
+//====================
+// Additional includes
+//====================
+#include <GL/glew.h>                    // Uploading the painted regions.
+#include <Awesomium/Surface.h>          // GUITexture is painted by Awesomium.
 
 namespace jackal
 {
 	class GUITexture : public Texture, public Awesomium::Surface
 	{
 	private:
-		unsigned char*  m_pBuffer;
+		//====================
+		// Member variables
+		//====================
+		unsigned char*                       m_pBuffer;   ///< The BGRA pixels painted by Awesomium.
+		mutable std::vector<Awesomium::Rect> m_dirty;     ///< The regions painted since the last upload.
+		mutable bool                         m_allocated; ///< Whether the texture storage has been specified.
+
+	private:
+		//====================
+		// Private methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Marks a region of the buffer as needing to be uploaded.
+		///
+		/// Overlapping regions are merged, and past a handful of regions
+		/// they are collapsed into their bounds, so a busy frame still
+		/// uploads in a few calls.
+		///
+		/// @param rect  The region that was painted.
+		///
+		////////////////////////////////////////////////////////////
+		void invalidate(const Awesomium::Rect& rect);
 
 	public:
+		//====================
+		// Ctor and dtor
+		//====================
 		explicit GUITexture(const Vector2i& size);
 		~GUITexture();
 
+		//====================
+		// Methods
+		//====================
 		void Paint(unsigned char* buffer, int src_row_span, const Awesomium::Rect& src_rect, const Awesomium::Rect& dest_rect) override;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Moves the pixels within a region of the buffer.
+		///
+		/// The pixels are moved in place, Awesomium paints the strip
+		/// that was scrolled into view afterwards.
+		///
+		/// @param dx         The distance to move the pixels horizontally.
+		/// @param dy         The distance to move the pixels vertically.
+		/// @param clip_rect  The region of the buffer to scroll.
+		///
+		////////////////////////////////////////////////////////////
 		void Scroll(int dx, int dy, const Awesomium::Rect& clip_rect) override;
 
+		////////////////////////////////////////////////////////////
+		/// @brief Binds a GUITexture object for use.
+		///
+		/// Only the regions painted since the last bind are uploaded, a
+		/// bind without any painting uploads nothing. The painted pixels
+		/// are copied when the bind is recorded, the upload itself runs
+		/// on the render thread.
+		///
+		/// @param texture  The texture to bind.
+		///
+		////////////////////////////////////////////////////////////
 		static void bind(const GUITexture& texture);
 		static void unbind();
 	};
 
 } // namespace jackal
 
-#endif//__JACKAL_GUI_TEXTURE_HPP__
\ No newline at end of file
+#endif//__JACKAL_GUI_TEXTURE_HPP__
@@ -33,8 +33,12 @@
 //====================
 // Jackal includes
 //====================
-#include <jackal/rendering/vertex.hpp> // Position, UV, and normals of individual vertices..
-#include <jackal/rendering/buffer.hpp> // Loading and generating buffers for OpenGL.
+#include <jackal/rendering/vertex.hpp>        // Position, UV, and normals of individual vertices..
+#include <jackal/rendering/geometry_heap.hpp> // The vertices and indices are stored within the geometry heap.
+#include <jackal/rendering/vertex_layout.hpp> // The layout the vertices are uploaded with.
+#include <jackal/rendering/mesh_lod.hpp>      // The levels of detail stored after the full detail indices.
+#include <jackal/math/bounding_box.hpp>       // The bounds of the vertices.
+#include <jackal/math/bounding_sphere.hpp>    // The bounds of the vertices.
 
 namespace jackal
 {
@@ -44,12 +48,47 @@ namespace jackal
 		//====================
 		// Member variables
 		//====================
-		Buffer                m_vao;        ///< The OpenGL vertex array buffer.
-		Buffer                m_vbo;        ///< The OpenGL vertex buffer object.
-		Buffer                m_ibo;        ///< The OpenGL index buffer object.
+		GeometryRange_t        m_range;      ///< The range of the geometry heap the object is stored in.
 
-		std::vector<Vertex_t> m_vertices;   ///< Vertices of the renderable object.
-		std::vector<GLuint>   m_indices;    ///< Indices of the renderable object.
+		std::vector<Vertex_t>  m_vertices;   ///< Vertices of the renderable object.
+		std::vector<GLuint>    m_indices;    ///< Indices of the renderable object.
+		BoundingBox            m_box;        ///< The local space box that contains every vertex.
+		BoundingSphere         m_sphere;     ///< The local space sphere that contains every vertex.
+		VertexLayout           m_layout;     ///< The layout the vertices are uploaded with.
+		BoundingBox            m_frame;      ///< The box positions are quantised within, the bounding box if invalid.
+		VertexLayout::Decode_t m_decode;     ///< The constants the vertex shader decodes the vertices with.
+		std::vector<GLuint>    m_lodIndices; ///< Indices of the coarser levels of detail, uploaded after the indices.
+		std::vector<MeshLod_t> m_lods;       ///< The range and error of each level of detail, full detail first.
+		int                    m_lod;        ///< The level of detail that is rendered.
+
+	protected:
+		//====================
+		// Protected methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Sets the bounds of the renderable object.
+		///
+		/// Renderable objects that do not store their own vertices,
+		/// such as a model made of several meshes, can set their bounds
+		/// explicitly.
+		///
+		/// @param box     The local space box of the object.
+		/// @param sphere  The local space sphere of the object.
+		///
+		////////////////////////////////////////////////////////////
+		void setBounds(const BoundingBox& box, const BoundingSphere& sphere);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Sets the levels of detail of the renderable object.
+		///
+		/// Renderable objects that draw several ranges, such as a model,
+		/// can describe their levels explicitly. Only the errors and index
+		/// counts of the levels are used to select a level.
+		///
+		/// @param lods  The levels of detail, full detail first.
+		///
+		////////////////////////////////////////////////////////////
+		void setLods(const std::vector<MeshLod_t>& lods);
 
 	public:
 		//====================
@@ -73,14 +112,161 @@ namespace jackal
 		///
 		/// @param vertices   The vertices to add to the IRenderable object.
 		/// @param indices    The indices to add to the IRenderable object.
+		/// @param layout     The layout to upload the vertices with.
+		/// @param frame      The box to quantise the positions within, the bounding box if invalid.
 		///
 		////////////////////////////////////////////////////////////
-		explicit IRenderable(const std::vector<Vertex_t>& vertices, const std::vector<GLuint>& indices);
+		explicit IRenderable(const std::vector<Vertex_t>& vertices, const std::vector<GLuint>& indices,
+			const VertexLayout& layout = VertexLayout::standard(), const BoundingBox& frame = BoundingBox());
 
 		////////////////////////////////////////////////////////////
-		/// @brief Default destructor for the IRenderable object.
+		/// @brief Move constructor for the IRenderable object.
+		///
+		/// The range of the geometry heap is transferred to the new object,
+		/// the moved from object will no longer refer to the heap.
+		///
+		/// @param renderable  The IRenderable object to move from.
+		///
 		////////////////////////////////////////////////////////////
-		virtual ~IRenderable() = default;
+		IRenderable(IRenderable&& renderable);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Destructor for the IRenderable object.
+		///
+		/// The destructor implicitly calls the destroy method, which returns
+		/// the range of the object back to the geometry heap.
+		///
+		////////////////////////////////////////////////////////////
+		virtual ~IRenderable();
+
+		//====================
+		// Operators
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Move assignment operator for the IRenderable object.
+		///
+		/// Any range currently held by this object is freed before the
+		/// range of the other object is transferred.
+		///
+		/// @param renderable  The IRenderable object to move from.
+		///
+		/// @returns A reference to this object.
+		///
+		////////////////////////////////////////////////////////////
+		IRenderable& operator=(IRenderable&& renderable);
+
+		//====================
+		// Getters and setters
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the range of the geometry heap the object is stored in.
+		///
+		/// The range will be invalid until the object has been created.
+		///
+		/// @returns The range of the geometry heap.
+		///
+		////////////////////////////////////////////////////////////
+		const GeometryRange_t& getRange() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the vertices of the renderable object.
+		///
+		/// A copy of the vertices is kept after the object is created,
+		/// so they can be used on the CPU, such as for occlusion culling.
+		///
+		/// @returns The vertices of the object.
+		///
+		////////////////////////////////////////////////////////////
+		const std::vector<Vertex_t>& getVertices() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the indices of the renderable object.
+		///
+		/// The indices of the coarser levels of detail are not included.
+		///
+		/// @returns The indices of the object, three for each triangle.
+		///
+		////////////////////////////////////////////////////////////
+		const std::vector<GLuint>& getIndices() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the box that contains every vertex.
+		///
+		/// The box is in local space and is calculated when the object
+		/// is created, it is invalid before then.
+		///
+		/// @returns The local space bounding box.
+		///
+		////////////////////////////////////////////////////////////
+		const BoundingBox& getBoundingBox() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the sphere that contains every vertex.
+		///
+		/// The sphere is in local space and is calculated when the object
+		/// is created, it is invalid before then.
+		///
+		/// @returns The local space bounding sphere.
+		///
+		////////////////////////////////////////////////////////////
+		const BoundingSphere& getBoundingSphere() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Sets the layout the vertices are uploaded with.
+		///
+		/// The layout is used the next time the object is created. Objects
+		/// that are drawn together with a single set of decode constants,
+		/// such as the meshes of a model, must quantise their positions
+		/// within the same frame.
+		///
+		/// @param layout  The layout to upload the vertices with.
+		/// @param frame   The box to quantise the positions within, the bounding box if invalid.
+		///
+		////////////////////////////////////////////////////////////
+		void setLayout(const VertexLayout& layout, const BoundingBox& frame = BoundingBox());
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the layout the vertices are uploaded with.
+		///
+		/// @returns The vertex layout of the object.
+		///
+		////////////////////////////////////////////////////////////
+		const VertexLayout& getLayout() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the constants the vertices are decoded with.
+		///
+		/// @returns The decode constants of the layout and frame.
+		///
+		////////////////////////////////////////////////////////////
+		const VertexLayout::Decode_t& getDecode() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the levels of detail of the renderable object.
+		///
+		/// An object without generated levels has a single level that
+		/// draws every index once it is created.
+		///
+		/// @returns The range and error of each level, full detail first.
+		///
+		////////////////////////////////////////////////////////////
+		const std::vector<MeshLod_t>& getLods() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Sets the level of detail that is rendered.
+		///
+		/// @param lod  The level to render, clamped to the levels of the object.
+		///
+		////////////////////////////////////////////////////////////
+		void setLod(int lod);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the level of detail that is rendered.
+		///
+		/// @returns The level that is rendered, 0 for full detail.
+		///
+		////////////////////////////////////////////////////////////
+		int getLod() const;
 
 		//====================
 		// Methods
@@ -141,16 +327,106 @@ namespace jackal
 		////////////////////////////////////////////////////////////
 		void addIndices(const std::vector<GLuint>& indices);
 
+		////////////////////////////////////////////////////////////
+		/// @brief Generates the levels of detail of the renderable object.
+		///
+		/// The triangles are simplified with the MeshSimplifier, each
+		/// level having half the triangles of the previous one. The
+		/// levels are uploaded the next time the object is created, so
+		/// this should be invoked once every vertex and index is added.
+		///
+		////////////////////////////////////////////////////////////
+		void generateLods();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Selects the level of detail for the size of the object on screen.
+		///
+		/// The coarsest level whose error projects to less than a pixel is
+		/// selected. A coarser level than the current one must fit within
+		/// a tighter threshold, so an object near the switching distance
+		/// doesn't alternate between two levels every frame.
+		///
+		/// @param screenSize  The size the object covers on screen in pixels, such as from FrustumCuller::getScreenSize.
+		/// @param current     The level currently rendered.
+		///
+		/// @returns           The level to render.
+		///
+		////////////////////////////////////////////////////////////
+		int selectLod(float screenSize, int current) const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Updates the rendered level of detail from the size of the object on screen.
+		///
+		/// This is the same as invoking setLod with the result of selectLod
+		/// and the current level, objects that are rendered in several
+		/// places should select a level for each place with selectLod.
+		///
+		/// @param screenSize  The size the object covers on screen in pixels.
+		///
+		////////////////////////////////////////////////////////////
+		void updateLod(float screenSize);
+
 		////////////////////////////////////////////////////////////
 		/// @brief Creates the IRenderable object, ready for rendering.
 		///
 		/// The create method simply encapsulates all of the behaviour needed
-		/// to bind the buffers and allocate their memory, once the IRenderable
-		/// object is bound, it can utilised to render objects the context.
+		/// to allocate the vertices and indices within the geometry heap, once
+		/// the IRenderable object is created, it can utilised to render objects
+		/// to the context. The bounds of the vertices are calculated as well,
+		/// and the vertices are encoded into the layout of the object. The
+		/// indices of any generated levels of detail follow the indices.
 		///
 		////////////////////////////////////////////////////////////
 		void create();
 
+		////////////////////////////////////////////////////////////
+		/// @brief Creates the IRenderable object from geometry stored elsewhere.
+		///
+		/// The geometry is allocated within the geometry heap straight
+		/// from the pointers, such as the blobs of a mapped .jmesh file,
+		/// and the bounds are taken as given. The vertices must already be
+		/// encoded in the layout of the object. No copy of the vertices or
+		/// indices is kept, so they aren't available on the CPU.
+		///
+		/// @param pVertices    The encoded vertices to allocate.
+		/// @param vertexCount  The number of vertices.
+		/// @param pIndices     The indices to allocate, the indices of every level of detail.
+		/// @param indexCount   The number of indices.
+		/// @param box          The local space box of the vertices.
+		/// @param sphere       The local space sphere of the vertices.
+		/// @param lods         The levels of detail within the indices, every index is a single level if empty.
+		///
+		////////////////////////////////////////////////////////////
+		void create(const void* pVertices, int vertexCount, const GLuint* pIndices, int indexCount,
+			const BoundingBox& box, const BoundingSphere& sphere, const std::vector<MeshLod_t>& lods = std::vector<MeshLod_t>());
+
+		////////////////////////////////////////////////////////////
+		/// @brief Creates the IRenderable object from geometry with 16-bit indices.
+		///
+		/// The same as the 32-bit overload, the indices are uploaded
+		/// without being widened.
+		///
+		/// @param pVertices    The encoded vertices to allocate.
+		/// @param vertexCount  The number of vertices, no more than GeometryHeap::MAX_SHORT_VERTICES.
+		/// @param pIndices     The indices to allocate, the indices of every level of detail.
+		/// @param indexCount   The number of indices.
+		/// @param box          The local space box of the vertices.
+		/// @param sphere       The local space sphere of the vertices.
+		/// @param lods         The levels of detail within the indices, every index is a single level if empty.
+		///
+		////////////////////////////////////////////////////////////
+		void create(const void* pVertices, int vertexCount, const GLushort* pIndices, int indexCount,
+			const BoundingBox& box, const BoundingSphere& sphere, const std::vector<MeshLod_t>& lods = std::vector<MeshLod_t>());
+
+		////////////////////////////////////////////////////////////
+		/// @brief Returns the geometry of the object back to the geometry heap.
+		///
+		/// Once destroyed, the object will not render until create is 
+		/// called once more.
+		///
+		////////////////////////////////////////////////////////////
+		void destroy();
+
 		////////////////////////////////////////////////////////////
 		/// @brief Pure virtual method for rendering the IRenderable object.
 		///
@@ -183,6 +459,12 @@ namespace jackal
 /// pure virtual design. This class does not provide the functionality
 /// for instance rendering meshes.
 ///
+/// The geometry of every renderable is sub-allocated from the global
+/// GeometryHeap, so renderable objects can be moved but not copied.
+/// Coarser levels of detail share the vertices of the object, their
+/// indices follow its indices within the same range, so a distant
+/// object only draws a fraction of its triangles.
+///
 /// Due to the internal use of the class, its methods and properties
 /// are not exposed to the lua scripting interface. Coding examples
 /// are provided in its subsequent child classes.
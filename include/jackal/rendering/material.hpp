@@ -34,6 +34,8 @@
 // Jackal includes
 //====================
 #include <jackal/utils/resource_handle.hpp> // A handle to the resource.
+#include <jackal/utils/async_handle.hpp>    // Requesting the shader and textures when loaded in the background.
+#include <jackal/utils/ext/json.hpp>        // Keeping the json file read by prepare.
 #include <jackal/rendering/shader.hpp>      // Load in and retain a shader.
 #include <jackal/rendering/texture.hpp>     // Load in and retain a texture.
 #include <jackal/math/colour.hpp>           // Default colour applied to the Material.
@@ -61,12 +63,46 @@ namespace jackal
 		//====================
 		// Member variables
 		//====================
-		int64_t                 m_ID;                                 ///< The unique ID of the material, generated from shader and textures.
 		ResourceHandle<Shader>  m_shader;                             ///< The shader attached to the material.
+		ResourceHandle<Shader>  m_variant;                            ///< The variant of the shader compiled with the material's keywords.
+		ResourceHandle<Shader>  m_fallback;                           ///< The shader rendered until the attached shader has compiled.
+		ResourceHandle<Shader>  m_fallbackVariant;                    ///< The variant of the fallback shader compiled with the material's keywords.
 		std::array<ResourceHandle<Texture>, MAX_TEXTURES> m_textures; ///< The diffuse texture attached to the material.
 		bool                    m_lighting;                           ///< Whether this Material uses the lighting calculations.
 		Colour                  m_colour;                             ///< Overlay colour applied to the material.
 		float                   m_shininess;                          ///< How shiny the specular effects are on this mesh.
+		nlohmann::json          m_document;                           ///< The json file read by prepare, until the following load.
+		AsyncHandle<Shader>     m_pendingShader;                      ///< The shader requested by prepare.
+		std::array<AsyncHandle<Texture>, MAX_TEXTURES> m_pendingTextures; ///< The textures requested by prepare.
+		bool                    m_prepared;                           ///< Whether the json file has been read by prepare.
+		mutable Shader*         m_pActive;                            ///< The shader chosen by the last bind, processed until the next bind.
+
+	private:
+		//====================
+		// Private methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the shader the Material should render with.
+		///
+		/// The variant of the attached shader is compiled in the background,
+		/// until it is ready the fallback shader is rendered instead.
+		///
+		/// @returns The variant if it is ready, otherwise the fallback.
+		///
+		////////////////////////////////////////////////////////////
+		Shader* getActiveShader() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Reads the json file of the Material.
+		///
+		/// The file is kept for the following load.
+		///
+		/// @param filename  The file directory of the data file.
+		///
+		/// @returns True if the file was read and parsed.
+		///
+		////////////////////////////////////////////////////////////
+		bool read(const std::string& filename);
 
 	public:
 		//====================
@@ -108,6 +144,16 @@ namespace jackal
 		////////////////////////////////////////////////////////////
 		int64_t getID() const;
 
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the array layer of one of the material's textures.
+		///
+		/// @param type  The texture to retrieve the layer of.
+		///
+		/// @returns The layer the texture was packed into, zero if it isn't packed.
+		///
+		////////////////////////////////////////////////////////////
+		float getLayer(eTextureType type) const;
+
 		////////////////////////////////////////////////////////////
 		/// @brief Retrieves the colour associated wtih this material
 		///
@@ -176,16 +222,42 @@ namespace jackal
 		//====================
 		// Methods
 		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Prepares the Material to be loaded in the background.
+		///
+		/// This is invoked on a worker thread. The json file is read and
+		/// the textures and shader it names are requested from the
+		/// resource manager, so they load in the background as well.
+		///
+		/// @param filename  The file directory of the data file.
+		///
+		/// @returns True if the file was read and parsed.
+		///
+		////////////////////////////////////////////////////////////
+		bool prepare(const std::string& filename) override;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Checks whether the requested textures and shader are still loading.
+		///
+		/// @returns True if any of the resources requested by prepare are pending.
+		///
+		////////////////////////////////////////////////////////////
+		bool hasPendingDependencies() const override;
+
 		////////////////////////////////////////////////////////////
 		/// @brief Loads in the data of the Material from an external json file.
 		///
 		/// So that the data is seperate from the application, the definition for
 		/// a material can be loaded in from an external json file. The Material
 		/// parsing will also utilising the parsing of shaders and textures from other
-		/// json sources. 
+		/// json sources. The "keywords" array selects the variant of the shader
+		/// to render with, "LIGHTING" is added when lighting is enabled. Until
+		/// the variant has compiled, the Material renders with the shader named
+		/// by "fallback-shader", or the basic unlit shader.
 		///
 		/// If the parsing of the material fails, a messages will be logged to the
-		/// external log and the application will continue.
+		/// external log and the application will continue. The json file is
+		/// only read if the material hasn't already been prepared.
 		///
 		/// @param filename  The file directory of the data file.
 		///
@@ -220,6 +292,18 @@ namespace jackal
 		////////////////////////////////////////////////////////////
 		void process(const Transform& transform);
 
+		////////////////////////////////////////////////////////////
+		/// @brief Requests the resolution the material is rendered at.
+		///
+		/// This should be invoked each frame the material is visible,
+		/// the streamed textures of the material are given the levels
+		/// that cover the size on screen.
+		///
+		/// @param pixels  The number of pixels across the object covers on screen.
+		///
+		////////////////////////////////////////////////////////////
+		void requestResolution(float pixels) const;
+
 		////////////////////////////////////////////////////////////
 		/// @brief Binds a material for use.
 		///
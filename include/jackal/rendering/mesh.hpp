@@ -56,15 +56,70 @@ namespace jackal
 		///
 		/// @param vertices The vertices of the mesh.
 		/// @param indices  The indices of the mesh.
+		/// @param layout   The layout to upload the vertices with.
+		/// @param frame    The box to quantise the positions within, the bounding box if invalid.
 		///
 		////////////////////////////////////////////////////////////
-		explicit Mesh(const std::vector<Vertex_t>& vertices, const std::vector<GLuint>& indices);
+		explicit Mesh(const std::vector<Vertex_t>& vertices, const std::vector<GLuint>& indices,
+			const VertexLayout& layout = VertexLayout::standard(), const BoundingBox& frame = BoundingBox());
+
+		////////////////////////////////////////////////////////////
+		/// @brief Constructor for the Mesh object from geometry stored elsewhere.
+		///
+		/// The geometry is allocated straight from the pointers and no
+		/// copy of it is kept, this is used for loading cooked meshes.
+		///
+		/// @param pVertices    The vertices of the mesh, encoded in the layout.
+		/// @param vertexCount  The number of vertices.
+		/// @param layout       The layout the vertices are encoded with.
+		/// @param frame        The box the positions were quantised within.
+		/// @param pIndices     The indices of the mesh, followed by the indices of each level of detail.
+		/// @param indexCount   The number of indices.
+		/// @param box          The local space box of the vertices.
+		/// @param sphere       The local space sphere of the vertices.
+		/// @param lods         The levels of detail within the indices, every index is a single level if empty.
+		///
+		////////////////////////////////////////////////////////////
+		explicit Mesh(const void* pVertices, int vertexCount, const VertexLayout& layout, const BoundingBox& frame,
+			const GLuint* pIndices, int indexCount, const BoundingBox& box, const BoundingSphere& sphere,
+			const std::vector<MeshLod_t>& lods = std::vector<MeshLod_t>());
+
+		////////////////////////////////////////////////////////////
+		/// @brief Constructor for the Mesh object from geometry with 16-bit indices.
+		///
+		/// @param pVertices    The vertices of the mesh, encoded in the layout.
+		/// @param vertexCount  The number of vertices, no more than GeometryHeap::MAX_SHORT_VERTICES.
+		/// @param layout       The layout the vertices are encoded with.
+		/// @param frame        The box the positions were quantised within.
+		/// @param pIndices     The indices of the mesh, followed by the indices of each level of detail.
+		/// @param indexCount   The number of indices.
+		/// @param box          The local space box of the vertices.
+		/// @param sphere       The local space sphere of the vertices.
+		/// @param lods         The levels of detail within the indices, every index is a single level if empty.
+		///
+		////////////////////////////////////////////////////////////
+		explicit Mesh(const void* pVertices, int vertexCount, const VertexLayout& layout, const BoundingBox& frame,
+			const GLushort* pIndices, int indexCount, const BoundingBox& box, const BoundingSphere& sphere,
+			const std::vector<MeshLod_t>& lods = std::vector<MeshLod_t>());
+
+		////////////////////////////////////////////////////////////
+		/// @brief Default move constructor for the Mesh object.
+		////////////////////////////////////////////////////////////
+		Mesh(Mesh&&) = default;
 
 		////////////////////////////////////////////////////////////
 		/// @brief Default destructor for the Mesh object.
 		////////////////////////////////////////////////////////////
 		~Mesh() = default;
 
+		//====================
+		// Operators
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Default move assignment operator for the Mesh object.
+		////////////////////////////////////////////////////////////
+		Mesh& operator=(Mesh&&) = default;
+
 		//====================
 		// Methods
 		//====================
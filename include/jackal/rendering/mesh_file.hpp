@@ -0,0 +1,332 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __JACKAL_MESH_FILE_HPP__
+#define __JACKAL_MESH_FILE_HPP__
+
+//====================
+// C++ includes
+//====================
+#include <cstddef> // Sizing the vertex and index blobs.
+#include <cstdint> // Fixed width file headers.
+#include <string>  // Opening and writing files by name.
+#include <vector>  // Storing the sub-mesh table.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/utils/mapped_file.hpp>         // The vertices and indices are read straight from the mapped file.
+#include <jackal/rendering/vertex_layout.hpp>   // The vertices are stored encoded in a vertex layout.
+#include <jackal/rendering/mesh_simplifier.hpp> // The most levels of detail a sub-mesh can store.
+#include <jackal/math/bounding_box.hpp>         // The bounds of the model and each sub-mesh.
+#include <jackal/math/bounding_sphere.hpp>      // The bounds of each sub-mesh.
+
+//====================
+// Additional includes
+//====================
+#include <GL/glew.h> // The indices are stored as GLuint.
+
+namespace jackal
+{
+	class MeshFile final : NonCopyable
+	{
+	public:
+		//====================
+		// Static variables
+		//====================
+		static const std::uint32_t MAGIC   = 0x48534D4Au; ///< Identifies a cooked mesh file, "JMSH".
+		static const std::uint32_t VERSION = 4;           ///< The version of the cooked mesh file layout.
+
+		//====================
+		// Structures
+		//====================
+		struct SubMesh_t
+		{
+			std::uint32_t          firstVertex;  ///< The first vertex of the sub-mesh within the vertex blob.
+			std::uint32_t          vertexCount;  ///< The number of vertices of the sub-mesh.
+			std::uint32_t          firstIndex;   ///< The first index of the sub-mesh within its index blob.
+			std::uint32_t          indexCount;   ///< The number of indices of the sub-mesh, including every level of detail.
+			bool                   shortIndices; ///< Whether the indices are within the 16-bit index blob.
+			BoundingBox            box;          ///< The local space box that contains every vertex of the sub-mesh.
+			BoundingSphere         sphere;       ///< The local space sphere that contains every vertex of the sub-mesh.
+			std::vector<MeshLod_t> lods;         ///< The levels of detail within the indices, full detail first.
+		};
+
+	private:
+		//====================
+		// Structures
+		//====================
+		struct Header_t
+		{
+			std::uint32_t magic;            ///< Always MAGIC.
+			std::uint32_t version;          ///< The layout version the file was written with.
+			std::uint32_t vertexLayout;     ///< The packed layout the vertices are encoded with.
+			std::uint32_t vertexStride;     ///< The size of a vertex of the layout.
+			std::uint32_t meshes;           ///< The number of sub-meshes in the table that follows the header.
+			std::uint32_t reserved;         ///< Keeps the offsets 8 byte aligned, always 0.
+			std::uint64_t vertexOffset;     ///< The offset of the vertex blob from the start of the file.
+			std::uint64_t vertexCount;      ///< The number of vertices within the vertex blob.
+			std::uint64_t indexOffset;      ///< The offset of the 32-bit index blob from the start of the file.
+			std::uint64_t indexCount;       ///< The number of indices within the 32-bit index blob.
+			std::uint64_t shortIndexOffset; ///< The offset of the 16-bit index blob from the start of the file.
+			std::uint64_t shortIndexCount;  ///< The number of indices within the 16-bit index blob.
+			float         minimum[3];       ///< The smallest corner of the box that contains every sub-mesh.
+			float         maximum[3];       ///< The largest corner of the box that contains every sub-mesh.
+		};
+
+		struct SubMeshHeader_t
+		{
+			std::uint32_t firstVertex;                             ///< The first vertex of the sub-mesh.
+			std::uint32_t vertexCount;                             ///< The number of vertices of the sub-mesh.
+			std::uint32_t firstIndex;                              ///< The first index of the sub-mesh within its index blob.
+			std::uint32_t indexCount;                              ///< The number of indices of the sub-mesh.
+			std::uint32_t shortIndices;                            ///< Non-zero if the indices are within the 16-bit index blob.
+			float         minimum[3];                              ///< The smallest corner of the box of the sub-mesh.
+			float         maximum[3];                              ///< The largest corner of the box of the sub-mesh.
+			float         centre[3];                               ///< The centre of the sphere of the sub-mesh.
+			float         radius;                                  ///< The radius of the sphere of the sub-mesh.
+			std::uint32_t lodCount;                                ///< The number of levels of detail, at least 1.
+			std::uint32_t lodFirstIndex[MeshSimplifier::MAX_LODS]; ///< The first index of each level, relative to the sub-mesh.
+			std::uint32_t lodIndexCount[MeshSimplifier::MAX_LODS]; ///< The number of indices of each level.
+			float         lodError[MeshSimplifier::MAX_LODS];      ///< The error of each level, in local space.
+		};
+
+		//====================
+		// Member variables
+		//====================
+		MappedFile             m_file;            ///< The mapped contents of the file.
+		const unsigned char*   m_pVertices;       ///< The vertex blob within the mapped file.
+		std::size_t            m_vertexCount;     ///< The number of vertices within the vertex blob.
+		const GLuint*          m_pIndices;        ///< The 32-bit index blob within the mapped file.
+		std::size_t            m_indexCount;      ///< The number of indices within the 32-bit index blob.
+		const GLushort*        m_pShortIndices;   ///< The 16-bit index blob within the mapped file.
+		std::size_t            m_shortIndexCount; ///< The number of indices within the 16-bit index blob.
+		VertexLayout           m_layout;          ///< The layout the vertices are encoded with.
+		std::vector<SubMesh_t> m_meshes;          ///< The sub-mesh table.
+		BoundingBox            m_box;             ///< The box that contains every sub-mesh.
+
+	public:
+		//====================
+		// Ctor and dtor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Default constructor for the MeshFile object.
+		////////////////////////////////////////////////////////////
+		explicit MeshFile();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Default destructor for the MeshFile object.
+		////////////////////////////////////////////////////////////
+		~MeshFile() = default;
+
+		//====================
+		// Getters and setters
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the vertex blob of the file.
+		///
+		/// The vertices point into the mapped file, they are only valid
+		/// while the file is open. Each vertex is encoded in the layout
+		/// of the file, so the first vertex of a sub-mesh is at
+		/// firstVertex * getLayout().getStride().
+		///
+		/// @returns The vertices of every sub-mesh.
+		///
+		////////////////////////////////////////////////////////////
+		const unsigned char* getVertices() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the number of vertices within the file.
+		///
+		/// @returns The number of vertices of every sub-mesh.
+		///
+		////////////////////////////////////////////////////////////
+		std::size_t getVertexCount() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the layout the vertices are encoded with.
+		///
+		/// Quantised positions are quantised within the bounding box of
+		/// the file.
+		///
+		/// @returns The vertex layout of the file.
+		///
+		////////////////////////////////////////////////////////////
+		const VertexLayout& getLayout() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the 32-bit index blob of the file.
+		///
+		/// The indices of each sub-mesh are relative to its first vertex,
+		/// and point into the mapped file.
+		///
+		/// @returns The indices of the sub-meshes with too many vertices for 16-bit indices.
+		///
+		////////////////////////////////////////////////////////////
+		const GLuint* getIndices() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the number of indices within the 32-bit index blob.
+		///
+		/// @returns The number of 32-bit indices.
+		///
+		////////////////////////////////////////////////////////////
+		std::size_t getIndexCount() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the 16-bit index blob of the file.
+		///
+		/// The indices of each sub-mesh are relative to its first vertex,
+		/// and point into the mapped file.
+		///
+		/// @returns The indices of the sub-meshes with shortIndices set.
+		///
+		////////////////////////////////////////////////////////////
+		const GLushort* getShortIndices() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the number of indices within the 16-bit index blob.
+		///
+		/// @returns The number of 16-bit indices.
+		///
+		////////////////////////////////////////////////////////////
+		std::size_t getShortIndexCount() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the sub-mesh table of the file.
+		///
+		/// @returns The range and bounds of each sub-mesh.
+		///
+		////////////////////////////////////////////////////////////
+		const std::vector<SubMesh_t>& getSubMeshes() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the box that contains every sub-mesh.
+		///
+		/// @returns The local space bounding box of the model.
+		///
+		////////////////////////////////////////////////////////////
+		const BoundingBox& getBoundingBox() const;
+
+		//====================
+		// Methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Maps and validates a cooked mesh file.
+		///
+		/// The header and sub-mesh table are validated against the size
+		/// of the file, no vertex data is read. This method can make use
+		/// of the virtual file system.
+		///
+		/// @param filename  The file name of the .jmesh file.
+		///
+		/// @returns         True if the file is a valid cooked mesh.
+		///
+		////////////////////////////////////////////////////////////
+		bool open(const std::string& filename);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Unmaps the file and clears the sub-mesh table.
+		////////////////////////////////////////////////////////////
+		void close();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Writes a cooked mesh file.
+		///
+		/// The vertex and index blobs are aligned to 16 bytes within the
+		/// file. The ranges of the sub-meshes must lie within the blobs,
+		/// their bounds are calculated from their vertices. Sub-meshes
+		/// with few enough vertices have their indices stored as 16-bit.
+		/// The vertices are encoded in the layout, with positions
+		/// quantised within the box of every sub-mesh. A sub-mesh without
+		/// levels of detail is stored with every index as a single level.
+		///
+		/// @param filename  The path of the file to write.
+		/// @param vertices  The vertices of every sub-mesh.
+		/// @param indices   The indices of every sub-mesh, relative to the first vertex of their sub-mesh.
+		/// @param meshes    The range and levels of detail of each sub-mesh.
+		/// @param layout    The layout to encode the vertices with.
+		///
+		/// @returns         True if the file was written.
+		///
+		////////////////////////////////////////////////////////////
+		static bool write(const std::string& filename, const std::vector<Vertex_t>& vertices,
+			const std::vector<GLuint>& indices, std::vector<SubMesh_t> meshes, const VertexLayout& layout = VertexLayout::standard());
+	};
+
+} // namespace jackal
+
+#endif//__JACKAL_MESH_FILE_HPP__
+
+////////////////////////////////////////////////////////////
+/// @author Benjamin Carter
+///
+/// @class jackal::MeshFile
+/// @ingroup rendering
+///
+/// The jackal::MeshFile reads the .jmesh files written by the
+/// jackal_meshcook tool. A .jmesh file holds a model that has already
+/// been imported, triangulated, optimised and simplified into levels of
+/// detail offline. Its vertices are stored already encoded in a
+/// VertexLayout and its indices as GLushort, or as GLuint for
+/// sub-meshes with more than 65536 vertices, so loading it is a matter
+/// of mapping the file and handing the blobs straight to the geometry
+/// heap. No importing, conversion, simplification or bounds calculation
+/// is done at runtime.
+///
+/// Models load .jmesh files automatically when their file has the
+/// .jmesh extension. Due to the low level aspects of the class, it is
+/// not exposed to the lua scripting interface.
+///
+/// @code
+/// using namespace jackal;
+///
+/// MeshFile file;
+/// if (file.open("~assets/models/box.jmesh"))
+/// {
+///		const VertexLayout& layout = file.getLayout();
+///		for (const auto& mesh : file.getSubMeshes())
+///		{
+///			const unsigned char* pVertices = file.getVertices() + mesh.firstVertex * layout.getStride();
+///
+///			GeometryRange_t range;
+///			if (mesh.shortIndices)
+///			{
+///				GeometryHeap::getInstance().allocate(layout, pVertices, mesh.vertexCount,
+///					file.getShortIndices() + mesh.firstIndex, mesh.indexCount, range);
+///			}
+///			else
+///			{
+///				GeometryHeap::getInstance().allocate(layout, pVertices, mesh.vertexCount,
+///					file.getIndices() + mesh.firstIndex, mesh.indexCount, range);
+///			}
+///
+///			// The coarsest level of detail.
+///			range.firstIndex += mesh.lods.back().firstIndex;
+///			range.indexCount = mesh.lods.back().indexCount;
+///		}
+/// }
+/// @endcode
+///
+////////////////////////////////////////////////////////////
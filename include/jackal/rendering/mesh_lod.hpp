@@ -0,0 +1,90 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __JACKAL_MESH_LOD_HPP__
+#define __JACKAL_MESH_LOD_HPP__
+
+//====================
+// Additional includes
+//====================
+#include <GL/glew.h> // OpenGL types.
+
+namespace jackal
+{
+	struct MeshLod_t final
+	{
+		//====================
+		// Member variables
+		//====================
+		GLuint  firstIndex; ///< The first index of the level, relative to the first index of the mesh.
+		GLsizei indexCount; ///< The number of indices of the level.
+		float   error;      ///< How far the surface of the level may be from the full detail mesh, in local space.
+
+		//====================
+		// Ctor and dtor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Default constructor for the MeshLod_t object.
+		///
+		/// The default level doesn't draw anything.
+		///
+		////////////////////////////////////////////////////////////
+		explicit MeshLod_t()
+			: firstIndex(0), indexCount(0), error(0.0f)
+		{
+		}
+
+		////////////////////////////////////////////////////////////
+		/// @brief Constructor for specifying the indices of the level.
+		///
+		/// @param firstIndex  The first index of the level, relative to the first index of the mesh.
+		/// @param indexCount  The number of indices of the level.
+		/// @param error       How far the surface may be from the full detail mesh, in local space.
+		///
+		////////////////////////////////////////////////////////////
+		explicit MeshLod_t(GLuint firstIndex, GLsizei indexCount, float error)
+			: firstIndex(firstIndex), indexCount(indexCount), error(error)
+		{
+		}
+	};
+
+} // namespace jackal
+
+#endif//__JACKAL_MESH_LOD_HPP__
+
+////////////////////////////////////////////////////////////
+/// @author Benjamin Carter
+///
+/// @class jackal::MeshLod_t
+/// @ingroup rendering
+///
+/// The jackal::MeshLod_t is a basic struct that describes a level of
+/// detail of a mesh. Every level shares the vertices of the mesh and
+/// its indices follow the indices of the full detail mesh within the
+/// same range of the geometry heap, so switching levels only changes
+/// which indices are drawn. Due to its simplicity and internal use,
+/// an example is not provided and it is not exposed to the lua
+/// scripting interface.
+///
+////////////////////////////////////////////////////////////
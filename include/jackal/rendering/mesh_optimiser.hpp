@@ -0,0 +1,175 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __JACKAL_MESH_OPTIMISER_HPP__
+#define __JACKAL_MESH_OPTIMISER_HPP__
+
+//====================
+// C++ includes
+//====================
+#include <cstddef> // Counting the vertices of a mesh.
+#include <vector>  // Reordering the vertices and indices in place.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/rendering/vertex.hpp> // Reordering vertices and measuring the facing of triangles.
+
+//====================
+// Additional includes
+//====================
+#include <GL/glew.h> // The indices are stored as GLuint.
+
+namespace jackal
+{
+	class MeshOptimiser final
+	{
+	public:
+		//====================
+		// Static variables
+		//====================
+		static const unsigned int CACHE_SIZE = 16; ///< The size of the FIFO post-transform cache that is optimised for.
+
+		//====================
+		// Structures
+		//====================
+		struct Statistics_t
+		{
+			float acmr; ///< The average cache miss ratio, vertices transformed per triangle. 0.5 is ideal, 3 is the worst.
+			float atvr; ///< The average transform to vertex ratio, vertices transformed per vertex. 1 is ideal.
+		};
+
+	public:
+		//====================
+		// Ctor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief The MeshOptimiser only provides static methods.
+		////////////////////////////////////////////////////////////
+		MeshOptimiser() = delete;
+
+		//====================
+		// Methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Reorders the triangles for the post-transform vertex cache.
+		///
+		/// Triangles are emitted with the Tipsify algorithm, each step
+		/// fans around a vertex and moves on to the neighbouring vertex
+		/// that is still within the cache and has the most triangles
+		/// left. The algorithm runs in linear time, so it is fast
+		/// enough to run when a model is imported.
+		///
+		/// @param indices      The triangles to reorder, three indices each.
+		/// @param vertexCount  The number of vertices the indices refer to.
+		///
+		////////////////////////////////////////////////////////////
+		static void optimiseVertexCache(std::vector<GLuint>& indices, std::size_t vertexCount);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Reorders clusters of triangles to reduce overdraw.
+		///
+		/// The triangles are split into clusters that each keep a cache
+		/// miss ratio within the threshold of the whole mesh, then the
+		/// clusters facing out from the centre of the mesh are drawn
+		/// first, as they tend to occlude the rest from any direction.
+		/// This should be invoked after optimiseVertexCache.
+		///
+		/// @param indices    The triangles to reorder, three indices each.
+		/// @param vertices   The vertices the indices refer to.
+		/// @param threshold  How much worse the cache miss ratio may become, 1.05 allows 5%.
+		///
+		////////////////////////////////////////////////////////////
+		static void optimiseOverdraw(std::vector<GLuint>& indices, const std::vector<Vertex_t>& vertices, float threshold = 1.05f);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Reorders the vertices in the order they are first used.
+		///
+		/// The vertices are fetched from memory close to the order they
+		/// are transformed in, and vertices no triangle refers to are
+		/// removed. The indices are remapped to the new order.
+		///
+		/// @param vertices  The vertices to reorder.
+		/// @param indices   The triangles that refer to the vertices.
+		///
+		////////////////////////////////////////////////////////////
+		static void optimiseVertexFetch(std::vector<Vertex_t>& vertices, std::vector<GLuint>& indices);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Optimises a mesh for the vertex cache, overdraw and vertex fetch.
+		///
+		/// @param vertices  The vertices of the mesh.
+		/// @param indices   The triangles of the mesh, three indices each.
+		///
+		////////////////////////////////////////////////////////////
+		static void optimise(std::vector<Vertex_t>& vertices, std::vector<GLuint>& indices);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Measures how well the triangles use the vertex cache.
+		///
+		/// The triangles are drawn through a simulated FIFO cache of
+		/// CACHE_SIZE vertices.
+		///
+		/// @param indices      The triangles to measure, three indices each.
+		/// @param vertexCount  The number of vertices the indices refer to.
+		///
+		/// @returns            The ACMR and ATVR of the triangles.
+		///
+		////////////////////////////////////////////////////////////
+		static Statistics_t analyse(const std::vector<GLuint>& indices, std::size_t vertexCount);
+	};
+
+} // namespace jackal
+
+#endif//__JACKAL_MESH_OPTIMISER_HPP__
+
+////////////////////////////////////////////////////////////
+/// @author Benjamin Carter
+///
+/// @class jackal::MeshOptimiser
+/// @ingroup rendering
+///
+/// The jackal::MeshOptimiser reorders the triangles and vertices of
+/// a mesh so the GPU does less work drawing it, without changing what
+/// is drawn. Triangles that share vertices are drawn together so the
+/// transformed vertices are reused from the post-transform cache,
+/// clusters of triangles facing outwards are drawn first so fewer
+/// pixels are shaded and then hidden, and the vertices are stored in
+/// the order they are fetched.
+///
+/// Models are optimised when they are imported or cooked. Due to the
+/// internal use of the class, it is not exposed to the lua scripting
+/// interface.
+///
+/// @code
+/// using namespace jackal;
+///
+/// MeshOptimiser::Statistics_t before = MeshOptimiser::analyse(indices, vertices.size());
+/// MeshOptimiser::optimise(vertices, indices);
+/// MeshOptimiser::Statistics_t after = MeshOptimiser::analyse(indices, vertices.size());
+///
+/// std::cout << "ACMR " << before.acmr << " -> " << after.acmr << "\n";
+/// @endcode
+///
+////////////////////////////////////////////////////////////
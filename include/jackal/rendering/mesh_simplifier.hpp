@@ -0,0 +1,143 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __JACKAL_MESH_SIMPLIFIER_HPP__
+#define __JACKAL_MESH_SIMPLIFIER_HPP__
+
+//====================
+// C++ includes
+//====================
+#include <cstddef> // Sizing the simplified index list.
+#include <vector>  // Storing the vertices and indices.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/rendering/vertex.hpp>   // The positions of the triangles being simplified.
+#include <jackal/rendering/mesh_lod.hpp> // The levels of detail that are generated.
+
+//====================
+// Additional includes
+//====================
+#include <GL/glew.h> // The indices are stored as GLuint.
+
+namespace jackal
+{
+	class MeshSimplifier final
+	{
+	public:
+		//====================
+		// Static variables
+		//====================
+		static const int MAX_LODS      = 4;   ///< The most levels of detail a mesh is given, including the full detail mesh.
+		static const int MIN_TRIANGLES = 128; ///< Meshes with fewer triangles are not given coarser levels.
+
+	public:
+		//====================
+		// Ctor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief The MeshSimplifier only provides static methods.
+		////////////////////////////////////////////////////////////
+		MeshSimplifier() = delete;
+
+		//====================
+		// Methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Reduces the number of triangles of a mesh.
+		///
+		/// Edges are collapsed cheapest first, the cost of a collapse is
+		/// the quadric error of the surface around it. A vertex is only
+		/// ever collapsed onto a neighbouring vertex, so the simplified
+		/// triangles refer to the same vertices. Vertices on the border
+		/// of the mesh or on a seam of its attributes are never moved, so
+		/// no holes or uv seams open up, and collapses that would flip a
+		/// triangle are rejected.
+		///
+		/// @param vertices     The vertices the indices refer to.
+		/// @param indices      The triangles to simplify, three indices each.
+		/// @param targetCount  The number of indices to reduce the mesh to.
+		/// @param error        The largest distance a collapse moved the surface, in local space.
+		///
+		/// @returns            The simplified triangles, more than targetCount if the mesh couldn't be reduced further.
+		///
+		////////////////////////////////////////////////////////////
+		static std::vector<GLuint> simplify(const std::vector<Vertex_t>& vertices, const std::vector<GLuint>& indices,
+			std::size_t targetCount, float& error);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Generates the levels of detail of a mesh.
+		///
+		/// Each level has half the triangles of the previous one and is
+		/// optimised for the vertex cache. The first level is the mesh
+		/// itself, the indices of the coarser levels are returned so they
+		/// can be stored after its indices. Levels stop being generated
+		/// once the mesh can no longer be meaningfully reduced.
+		///
+		/// @param vertices    The vertices of the mesh.
+		/// @param indices     The triangles of the full detail mesh.
+		/// @param lodIndices  The triangles of every coarser level.
+		/// @param lods        The range and error of every level, full detail first.
+		///
+		////////////////////////////////////////////////////////////
+		static void generateLods(const std::vector<Vertex_t>& vertices, const std::vector<GLuint>& indices,
+			std::vector<GLuint>& lodIndices, std::vector<MeshLod_t>& lods);
+	};
+
+} // namespace jackal
+
+#endif//__JACKAL_MESH_SIMPLIFIER_HPP__
+
+////////////////////////////////////////////////////////////
+/// @author Benjamin Carter
+///
+/// @class jackal::MeshSimplifier
+/// @ingroup rendering
+///
+/// The jackal::MeshSimplifier generates coarser versions of a mesh
+/// for drawing it in the distance. It uses quadric error metrics, each
+/// vertex accumulates the planes of the triangles around it and a
+/// collapse is costed by the squared distance of the new vertex to
+/// those planes, so flat areas are reduced first and silhouettes are
+/// kept for as long as possible.
+///
+/// Levels of detail are generated when a model is imported or cooked.
+/// Due to the internal use of the class, it is not exposed to the lua
+/// scripting interface.
+///
+/// @code
+/// using namespace jackal;
+///
+/// std::vector<GLuint> lodIndices;
+/// std::vector<MeshLod_t> lods;
+/// MeshSimplifier::generateLods(vertices, indices, lodIndices, lods);
+///
+/// for (const auto& lod : lods)
+/// {
+///		std::cout << lod.indexCount / 3 << " triangles, error " << lod.error << "\n";
+/// }
+/// @endcode
+///
+////////////////////////////////////////////////////////////
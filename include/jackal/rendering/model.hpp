@@ -28,6 +28,7 @@
 //====================
 // C++ includes
 //====================
+#include <memory>                             // Keeping the cooked file opened by prepare.
 #include <vector>                             // Container for the meshes.
 
 //====================
@@ -36,6 +37,9 @@
 #include <jackal/utils/resource.hpp>          // Model is a type of resource.
 #include <jackal/rendering/irenderable.hpp>   // Model is a renderable object.
 #include <jackal/rendering/mesh.hpp>          // Each model can be constructed of several meshes.
+#include <jackal/rendering/buffer.hpp>        // Storing the draw commands of the meshes.
+#include <jackal/rendering/draw_command.hpp>  // Drawing every mesh of a page with a single call.
+#include <jackal/rendering/mesh_file.hpp>     // Loading cooked models.
 #include <jackal/utils/resource_handle.hpp>   // Retrieving a handle to the Model object.
 
 //====================
@@ -53,7 +57,24 @@ namespace jackal
 		//====================
 		// Member variables
 		//====================
-		std::vector<Mesh> m_meshes; ///< The individual meshes of the model.
+		struct Batch_t
+		{
+			int    page;      ///< The page of the geometry heap the meshes are stored in.
+			int    first;     ///< The first draw command of the batch.
+			int    count;     ///< The number of draw commands within the batch.
+			GLenum indexType; ///< The type of the indices of the page.
+		};
+
+		std::vector<Mesh>           m_meshes;       ///< The individual meshes of the model.
+		std::vector<DrawCommand_t>  m_commands;     ///< A draw command for each mesh, grouped by page.
+		std::vector<Batch_t>        m_batches;      ///< The commands that can be drawn with a single call.
+		std::vector<int>            m_lodBatches;   ///< The first batch of each level of detail, followed by the number of batches.
+		Buffer                      m_indirect;     ///< The draw commands, when indirect drawing is supported.
+		std::vector<GLsizei>        m_counts;       ///< Index counts of each command, when indirect drawing is unsupported.
+		std::vector<const GLvoid*>  m_offsets;      ///< Index offsets of each command, when indirect drawing is unsupported.
+		std::vector<GLint>          m_baseVertices; ///< Base vertices of each command, when indirect drawing is unsupported.
+		std::unique_ptr<MeshFile>   m_pFile;        ///< The cooked file opened by prepare, until the following load.
+		bool                        m_prepared;     ///< Whether the model has been imported or opened by prepare.
 
 	private:
 		//====================
@@ -88,6 +109,31 @@ namespace jackal
 		////////////////////////////////////////////////////////////
 		void convert(aiMesh* pMesh, const aiScene* pScene);
 
+		////////////////////////////////////////////////////////////
+		/// @brief Loads a model that was cooked by jackal_meshcook.
+		///
+		/// The vertices and indices of each sub-mesh are allocated
+		/// straight from the mapped .jmesh file, the bounds are read
+		/// from the file rather than calculated.
+		///
+		/// @param file  The opened .jmesh file.
+		///
+		////////////////////////////////////////////////////////////
+		void loadCooked(const MeshFile& file);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Groups the meshes of the model into batches.
+		///
+		/// A draw command is created for every mesh and the commands are
+		/// grouped by the page of the geometry heap they are stored in, each
+		/// group can then be submitted with a single draw call. When indirect
+		/// drawing is supported the commands are uploaded to the GPU. The
+		/// commands are repeated for every level of detail, the error of a
+		/// level of the model is the largest error of its meshes.
+		///
+		////////////////////////////////////////////////////////////
+		void createBatches();
+
 	public:
 		//====================
 		// Ctor and dtor
@@ -109,6 +155,21 @@ namespace jackal
 		//====================
 		// Methods
 		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Prepares the Model to be loaded in the background.
+		///
+		/// This is invoked on a worker thread. External models are imported
+		/// and converted, including generating their levels of detail, and
+		/// cooked models are opened. The meshes are uploaded by the
+		/// following load.
+		///
+		/// @param filename The file location of the model to prepare.
+		///
+		/// @returns True if the model was imported or opened.
+		///
+		////////////////////////////////////////////////////////////
+		bool prepare(const std::string& filename) override;
+
 		////////////////////////////////////////////////////////////
 		/// @brief Loads an external model and processes it into the correct format.
 		///
@@ -116,7 +177,10 @@ namespace jackal
 		/// filename and load the external model. If the model is successfully
 		/// loaded, it will be converted to a format that the Jackal Engine
 		/// can utilise and render. The filename can utilise the virtual
-		/// file system.
+		/// file system. Files with the .jmesh extension are cooked and
+		/// skip the import entirely, imported models are uploaded with
+		/// the compressed vertex layout and given levels of detail. The
+		/// model is only imported if it hasn't already been prepared.
 		///
 		/// @param filename The file location of the model to load.
 		///
@@ -142,9 +206,11 @@ namespace jackal
 		////////////////////////////////////////////////////////////
 		/// @brief Renders the model to the OpenGL context.
 		///
-		/// When the model is rendered, it will loop through each mesh
-		/// that the model is constructed of and render them to the 
-		/// context.
+		/// When the model is rendered, every mesh that shares a page of
+		/// the geometry heap is rendered with a single multi-draw call. 
+		/// glMultiDrawElementsIndirect is used when available, otherwise
+		/// the commands are submitted with glMultiDrawElementsBaseVertex.
+		/// Only the batches of the current level of detail are drawn.
 		///
 		////////////////////////////////////////////////////////////
 		void render() override;
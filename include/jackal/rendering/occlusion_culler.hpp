@@ -0,0 +1,254 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __JACKAL_OCCLUSION_CULLER_HPP__
+#define __JACKAL_OCCLUSION_CULLER_HPP__
+
+//====================
+// C++ includes
+//====================
+#include <cstddef>                      // Indexing the tiles and boxes.
+#include <cstdint>                      // Storing the visibility of each box.
+#include <vector>                       // Storing the depth buffer and triangles.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/math/matrix4.hpp>      // Projecting the occluders and occludees.
+#include <jackal/math/bounding_box.hpp> // The world space bounds of each occludee.
+
+namespace jackal
+{
+	//====================
+	// Forward declarations
+	//====================
+	class IRenderable;
+
+	class OcclusionCuller final
+	{
+	public:
+		//====================
+		// Static variables
+		//====================
+		static const int TILE_WIDTH = 64;  ///< The width of each tile, in pixels.
+		static const int TILE_HEIGHT = 32; ///< The height of each tile, in pixels.
+
+	private:
+		//====================
+		// Structures
+		//====================
+		struct Triangle_t
+		{
+			float x[3]; ///< The screen space x of each vertex.
+			float y[3]; ///< The screen space y of each vertex.
+			float z[3]; ///< The normalised device depth of each vertex.
+		};
+
+		//====================
+		// Member variables
+		//====================
+		int                                m_width;          ///< The width of the depth buffer, a multiple of TILE_WIDTH.
+		int                                m_height;         ///< The height of the depth buffer, a multiple of TILE_HEIGHT.
+		int                                m_tilesX;         ///< The number of tiles along the x axis.
+		int                                m_tilesY;         ///< The number of tiles along the y axis.
+		std::vector<float>                 m_depth;          ///< The depth buffer, stored row by row.
+		std::vector<Triangle_t>            m_triangles;      ///< The projected triangles of every occluder.
+		std::vector<std::vector<int>>      m_bins;           ///< The triangles that overlap each tile.
+		Matrix4                            m_viewProjection; ///< The view projection of the current frame.
+
+	private:
+		//====================
+		// Private methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Rasterises the triangles binned within a tile.
+		///
+		/// When SSE is available, four pixels of a row are tested
+		/// and written at once.
+		///
+		/// @param tile  The index of the tile to rasterise.
+		///
+		////////////////////////////////////////////////////////////
+		void rasteriseTile(int tile);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the depth of a pixel.
+		///
+		/// @param x  The x co-ordinate of the pixel.
+		/// @param y  The y co-ordinate of the pixel.
+		///
+		/// @returns  A pointer to the depth of the pixel.
+		///
+		////////////////////////////////////////////////////////////
+		const float* getPixel(int x, int y) const;
+
+	public:
+		//====================
+		// Ctor and dtor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Constructor for the OcclusionCuller object.
+		///
+		/// The size is rounded up to a whole number of tiles. The depth
+		/// buffer only needs to be large enough to represent the major
+		/// occluders of the scene, it is far smaller than the window.
+		///
+		/// @param width   The width of the depth buffer.
+		/// @param height  The height of the depth buffer.
+		///
+		////////////////////////////////////////////////////////////
+		explicit OcclusionCuller(int width = 320, int height = 192);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Default destructor for the OcclusionCuller object.
+		////////////////////////////////////////////////////////////
+		~OcclusionCuller() = default;
+
+		//====================
+		// Getters and setters
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the width of the depth buffer.
+		///
+		/// @returns The width in pixels.
+		///
+		////////////////////////////////////////////////////////////
+		int getWidth() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the height of the depth buffer.
+		///
+		/// @returns The height in pixels.
+		///
+		////////////////////////////////////////////////////////////
+		int getHeight() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the number of occluder triangles this frame.
+		///
+		/// @returns The number of triangles that will be rasterised.
+		///
+		////////////////////////////////////////////////////////////
+		std::size_t getTriangleCount() const;
+
+		//====================
+		// Methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Clears the depth buffer and occluders for a new frame.
+		///
+		/// @param viewProjection  The view projection of the camera.
+		///
+		////////////////////////////////////////////////////////////
+		void begin(const Matrix4& viewProjection);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Adds the triangles of an occluder.
+		///
+		/// The triangles are projected and binned into every tile they
+		/// overlap. Triangles that cross the near plane are discarded,
+		/// which can only make the culler less aggressive. Occluders
+		/// should be low polygon meshes that are entirely solid.
+		///
+		/// @param renderable  The mesh to draw into the depth buffer.
+		/// @param model       The model matrix of the mesh.
+		///
+		////////////////////////////////////////////////////////////
+		void addOccluder(const IRenderable& renderable, const Matrix4& model);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Rasterises every occluder into the depth buffer.
+		///
+		/// Each tile is rasterised by a worker of the ThreadPool, as the
+		/// tiles do not overlap no synchronisation is needed.
+		///
+		////////////////////////////////////////////////////////////
+		void rasterise();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Checks whether a box may be visible.
+		///
+		/// The nearest depth of the box is compared against the depth
+		/// buffer across the screen rectangle it covers. A box that
+		/// crosses the near plane is always visible. This is safe to
+		/// invoke from multiple threads once the occluders have been
+		/// rasterised.
+		///
+		/// @param box  The world space bounds of the occludee.
+		///
+		/// @returns    False if the box is entirely hidden by the occluders.
+		///
+		////////////////////////////////////////////////////////////
+		bool isVisible(const BoundingBox& box) const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Tests a set of boxes across the worker threads.
+		///
+		/// @param boxes    The world space bounds of each occludee.
+		/// @param visible  Set to whether each box may be visible.
+		///
+		/// @returns        The number of boxes that may be visible.
+		///
+		////////////////////////////////////////////////////////////
+		std::size_t cull(const std::vector<BoundingBox>& boxes, std::vector<std::uint8_t>& visible) const;
+	};
+
+} // namespace jackal
+
+#endif//__JACKAL_OCCLUSION_CULLER_HPP__
+
+////////////////////////////////////////////////////////////
+/// @author Benjamin Carter
+///
+/// @class jackal::OcclusionCuller
+/// @ingroup rendering
+///
+/// The jackal::OcclusionCuller rejects objects that are hidden
+/// behind other objects, before they are submitted to OpenGL. A
+/// small number of low polygon occluders, such as walls and floors,
+/// are rasterised into a small depth buffer on the CPU, the bounds
+/// of each object are then tested against it.
+///
+/// The depth buffer is split into tiles that are rasterised in
+/// parallel, and the rasteriser uses SSE when it is available. As
+/// it never touches the GPU, it can run on machines without one.
+/// Due to the internal use of the class, it is not exposed to the
+/// lua scripting interface.
+///
+/// @code
+/// using namespace jackal;
+///
+/// OcclusionCuller culler;
+///
+/// culler.begin(camera.getViewProjection());
+/// culler.addOccluder(wall, wallTransform.getTransformation());
+/// culler.rasterise();
+///
+/// if (culler.isVisible(mesh.getBoundingBox().transform(transform.getTransformation())))
+/// {
+///		mesh.render();
+/// }
+/// @endcode
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,178 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __JACKAL_POINT_LIGHT_HPP__
+#define __JACKAL_POINT_LIGHT_HPP__
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/rendering/ilight.hpp> // PointLight is a type of light.
+#include <jackal/math/vector3.hpp>     // Stores the position of the light.
+
+namespace jackal
+{
+	class PointLight final : public ILight
+	{
+	private:
+		//====================
+		// Member variables
+		//====================
+		Vector3f m_position; ///< The world position the light shines from.
+		float    m_range;    ///< The distance at which the light has no effect.
+
+	private:
+		//====================
+		// Private methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Initialises the member variables of the PointLight object.
+		///
+		/// This method is invoked by the subsequent create method, it is used
+		/// to initialise all of the member variables to specified values.
+		/// If the creation or initialisation fails, the object will return a null
+		/// value.
+		///
+		/// @param colour     The colour of the light.
+		/// @param intensity  The intensity of the light upon the scene.
+		/// @param position   The world position of the light.
+		/// @param range      The distance at which the light has no effect.
+		///
+		/// @returns True if the light initialises the variables correctly.
+		///
+		////////////////////////////////////////////////////////////
+		bool init(const Colour& colour, float intensity, const Vector3f& position, float range);
+
+	public:
+		//====================
+		// Ctor and dtor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Default constructor for the PointLight object.
+		////////////////////////////////////////////////////////////
+		explicit PointLight();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Default destructor for the PointLight object.
+		////////////////////////////////////////////////////////////
+		~PointLight() = default;
+
+		//====================
+		// Getters and setters
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the position of the PointLight object.
+		///
+		/// @returns The world position the light shines from.
+		///
+		////////////////////////////////////////////////////////////
+		Vector3f getPosition() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Sets the position of the PointLight object.
+		///
+		/// @param position  The new world position of the light.
+		///
+		////////////////////////////////////////////////////////////
+		void setPosition(const Vector3f& position);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the range of the PointLight object.
+		///
+		/// The light fades to nothing at its range, so it is only
+		/// assigned to the clusters within this distance.
+		///
+		/// @returns The distance at which the light has no effect.
+		///
+		////////////////////////////////////////////////////////////
+		float getRange() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Sets the range of the PointLight object.
+		///
+		/// The light fades to nothing at its range, so it is only
+		/// assigned to the clusters within this distance.
+		///
+		/// @param range  The new distance at which the light has no effect.
+		///
+		////////////////////////////////////////////////////////////
+		void setRange(float range);
+
+		//====================
+		// Methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Binding the point light to a lua object for scripting.
+		///
+		/// So that point lights can be referenced within scripts, they need
+		/// to be exposed as lua objects for additional functionality. This allows
+		/// this light to be manipulated within scripts for additional behavior.
+		///
+		/// @returns The component as a lua object.
+		///
+		////////////////////////////////////////////////////////////
+		sol::table lua_asObject() const override;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Creates a new PointLight object and initialises it for use.
+		///
+		/// This method is a simple wrapper around retrieving a PointLight
+		/// object from the pools and initializing its member variables to the
+		/// defined values. If the pool fails to retrieve a resource or the
+		/// initialization fails, the method will return a null value.
+		///
+		/// @param colour     The colour of the light.
+		/// @param intensity  The intensity of the light upon the scene.
+		/// @param position   The world position of the light.
+		/// @param range      The distance at which the light has no effect.
+		///
+		/// @returns A PointLight from the pool if initialisation was successful.
+		///
+		////////////////////////////////////////////////////////////
+		static PointLight* create(const Colour& colour, float intensity, const Vector3f& position, float range);
+	};
+
+} // namespace jackal
+
+#endif//__JACKAL_POINT_LIGHT_HPP__
+
+////////////////////////////////////////////////////////////
+/// @author Benjamin Carter
+///
+/// @class jackal::PointLight
+/// @ingroup rendering
+///
+/// The jackal::PointLight shines equally in every direction from
+/// a single position, such as a bulb or a torch. Its effect fades
+/// with distance and reaches nothing at its range, which bounds the
+/// light so it is only shaded by the clusters it can reach.
+///
+/// @code
+/// using namespace jackal;
+///
+/// PointLight* pLight = PointLight::create(Colour::white(), 2.0f, Vector3f(0.0f, 1.0f, 0.0f), 5.0f);
+/// ClusteredLighting::getInstance().add(pLight);
+/// @endcode
+///
+////////////////////////////////////////////////////////////
@@ -28,6 +28,7 @@
 //====================
 // C++ includes
 //====================
+#include <cstdint>                           // Storing the key of the program within the cache.
 #include <vector>                            // Container for different shader objects.
 
 //====================
@@ -45,7 +46,27 @@ namespace jackal
 		//====================
 		GLuint                  m_ID;       ///< The unique ID of the Program object.
 		std::vector<GLSLObject> m_shaders;  ///< All of the glsl shaders attached to the Program.
+		std::string             m_defines;  ///< The define directives injected into every attached shader.
+		std::uint64_t           m_key;      ///< The hash of the sources, used to store the linked binary.
 		bool                    m_compiled; ///< Whether the shaders have already been compiled.
+		bool                    m_pending;  ///< Whether the shaders have been submitted but not checked.
+		bool                    m_cached;   ///< Whether the linked binary should be stored in the cache.
+
+	private:
+		//====================
+		// Private methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Collects the compile and link status of a submitted Program.
+		///
+		/// Any errors are logged and the Program is destroyed, otherwise
+		/// the shaders are detached and the binary is stored in the cache.
+		/// Querying the status blocks until the driver has finished.
+		///
+		/// @returns    True if the shaders compiled and linked successfully.
+		///
+		////////////////////////////////////////////////////////////
+		bool finish();
 
 	public:
 		//====================
@@ -88,6 +109,46 @@ namespace jackal
 
 		std::vector<GLSLObject>& getShaders();
 
+		////////////////////////////////////////////////////////////
+		/// @brief Sets the define directives injected into attached shaders.
+		///
+		/// Only shaders attached after this method is invoked receive the
+		/// defines, they are used to compile variants of the same glsl files.
+		///
+		/// @param defines  The define directives, one per line.
+		///
+		////////////////////////////////////////////////////////////
+		void setDefines(const std::string& defines);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves whether the Program has been linked successfully.
+		///
+		/// @returns   True if the Program can be bound.
+		///
+		////////////////////////////////////////////////////////////
+		bool isCompiled() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves whether the Program has been submitted but not polled.
+		///
+		/// @returns   True if the driver may still be compiling the Program.
+		///
+		////////////////////////////////////////////////////////////
+		bool isPending() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves whether the driver compiles shaders in the background.
+		///
+		/// When GL_KHR_parallel_shader_compile is present, the driver is
+		/// allowed to use as many compiler threads as it wants and the
+		/// completion of each Program can be polled without blocking. This
+		/// must be invoked on the thread that owns the context.
+		///
+		/// @returns   True if GL_KHR_parallel_shader_compile is supported.
+		///
+		////////////////////////////////////////////////////////////
+		static bool isParallelCompileSupported();
+
 		//====================
 		// Methods
 		//====================
@@ -161,6 +222,34 @@ namespace jackal
 		////////////////////////////////////////////////////////////
 		bool recompile();
 
+		////////////////////////////////////////////////////////////
+		/// @brief Submits the Program and its shaders without waiting for them.
+		///
+		/// Every attached shader is submitted to the driver and the Program
+		/// is linked, but neither status is queried, so many Programs can
+		/// be submitted back to back while the driver compiles them. The
+		/// Program is not use-able until poll returns true. A Program loaded
+		/// from the cache is linked immediately and is never pending.
+		///
+		/// @returns    False if the Program could not be submitted.
+		///
+		////////////////////////////////////////////////////////////
+		bool submit();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Checks whether a submitted Program has finished compiling.
+		///
+		/// When GL_KHR_parallel_shader_compile is supported, the completion
+		/// status is queried and the method returns false while the driver
+		/// is still working. Otherwise the status is collected immediately,
+		/// which blocks until the driver has finished. Check isCompiled
+		/// afterwards to find out whether the Program linked successfully.
+		///
+		/// @returns    True once the Program is no longer pending.
+		///
+		////////////////////////////////////////////////////////////
+		bool poll();
+
 		////////////////////////////////////////////////////////////
 		/// @brief Bind the specified Program object.
 		///
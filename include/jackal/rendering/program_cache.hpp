@@ -0,0 +1,283 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __JACKAL_PROGRAM_CACHE_HPP__
+#define __JACKAL_PROGRAM_CACHE_HPP__
+
+//====================
+// C++ includes
+//====================
+#include <cstdint> // Fixed width hashes and file headers.
+#include <string>  // Storing the cache directory and driver description.
+#include <vector>  // Hashing the glsl objects of a program.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/utils/singleton.hpp>       // ProgramCache is a singleton object.
+#include <jackal/rendering/glsl_object.hpp> // Hashing the sources of each glsl object.
+
+//====================
+// Additional includes
+//====================
+#include <GL/glew.h> // Retrieving and loading program binaries.
+
+namespace jackal
+{
+	//====================
+	// Forward declarations
+	//====================
+	class ConfigFile;
+
+	class ProgramCache final : public Singleton<ProgramCache>
+	{
+	public:
+		//====================
+		// Static variables
+		//====================
+		static const std::uint32_t MAGIC   = 0x4A50524Du; ///< Identifies a program binary file, "JPRM".
+		static const std::uint32_t VERSION = 1;           ///< The version of the program binary file layout.
+
+	private:
+		//====================
+		// Friend classes
+		//====================
+		friend class Singleton<ProgramCache>;
+
+		//====================
+		// Structures
+		//====================
+		struct Header_t
+		{
+			std::uint32_t magic;   ///< Always MAGIC.
+			std::uint32_t version; ///< The layout version the file was written with.
+			std::uint64_t key;     ///< The hash the program binary was stored under.
+			std::uint32_t format;  ///< The driver specific format of the program binary.
+			std::uint32_t length;  ///< The length of the program binary, in bytes.
+		};
+
+		//====================
+		// Member variables
+		//====================
+		std::string  m_directory; ///< The directory the program binaries are stored in.
+		std::string  m_driver;    ///< The vendor, renderer and version of the driver.
+		bool         m_enabled;   ///< Whether the cache has been enabled.
+		bool         m_queried;   ///< Whether the driver has been queried for support.
+		bool         m_supported; ///< Whether the driver can retrieve program binaries.
+		unsigned int m_hits;      ///< The number of programs loaded from the cache.
+		unsigned int m_misses;    ///< The number of programs that had to be compiled.
+
+	private:
+		//====================
+		// Ctor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Default constructor for the ProgramCache object.
+		///
+		/// The cache is enabled and stores the program binaries within
+		/// the cache/programs directory until it is created from a config.
+		///
+		////////////////////////////////////////////////////////////
+		explicit ProgramCache();
+
+		//====================
+		// Private methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Queries the driver for program binary support.
+		///
+		/// This must be invoked on the thread that owns the context, it
+		/// is deferred until the first program is compiled.
+		///
+		////////////////////////////////////////////////////////////
+		void queryDriver();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the location of the program binary of a key.
+		///
+		/// @param key  The hash of the program.
+		///
+		/// @returns    The file the program binary is stored within.
+		///
+		////////////////////////////////////////////////////////////
+		std::string getFilename(std::uint64_t key) const;
+
+	public:
+		//====================
+		// Dtor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Default destructor for the ProgramCache object.
+		////////////////////////////////////////////////////////////
+		~ProgramCache() = default;
+
+		//====================
+		// Getters and setters
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Enables or disables the cache.
+		///
+		/// @param enabled  Whether program binaries should be stored and loaded.
+		///
+		////////////////////////////////////////////////////////////
+		void setEnabled(bool enabled);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves whether the cache is enabled and supported.
+		///
+		/// This must be invoked on the thread that owns the context.
+		///
+		/// @returns True if program binaries are stored and loaded.
+		///
+		////////////////////////////////////////////////////////////
+		bool isEnabled();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Sets the directory the program binaries are stored in.
+		///
+		/// @param directory  The directory, it is created when the first binary is stored.
+		///
+		////////////////////////////////////////////////////////////
+		void setDirectory(const std::string& directory);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the directory the program binaries are stored in.
+		///
+		/// @returns The directory of the cache.
+		///
+		////////////////////////////////////////////////////////////
+		const std::string& getDirectory() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the number of programs loaded from the cache.
+		///
+		/// @returns The number of cache hits since the application started.
+		///
+		////////////////////////////////////////////////////////////
+		unsigned int getHits() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the number of programs that had to be compiled.
+		///
+		/// This includes the program binaries rejected by the driver.
+		///
+		/// @returns The number of cache misses since the application started.
+		///
+		////////////////////////////////////////////////////////////
+		unsigned int getMisses() const;
+
+		//====================
+		// Methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Loads the settings of the cache from the config file.
+		///
+		/// The settings are read from the ShaderCache section.
+		///
+		/// @param config  The config file to read the settings from.
+		///
+		////////////////////////////////////////////////////////////
+		void create(const ConfigFile& config);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Hashes the sources of a program.
+		///
+		/// The type and source of every glsl object is hashed with the
+		/// vendor, renderer and version of the driver, so a driver update
+		/// never loads a stale binary. The objects must not have been
+		/// compiled, as compilation releases their sources.
+		///
+		/// @param shaders  The glsl objects attached to the program.
+		///
+		/// @returns        The key of the program within the cache.
+		///
+		////////////////////////////////////////////////////////////
+		std::uint64_t hash(const std::vector<GLSLObject>& shaders);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Loads a program binary from the cache.
+		///
+		/// A binary the driver rejects is removed from the cache, the
+		/// program is left unlinked so it can be compiled from source.
+		///
+		/// @param program  The program to load the binary into.
+		/// @param key      The hash of the program.
+		///
+		/// @returns        True if the program was linked from the cache.
+		///
+		////////////////////////////////////////////////////////////
+		bool load(GLuint program, std::uint64_t key);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Stores the binary of a linked program within the cache.
+		///
+		/// The binary is written to a temporary file which is then renamed,
+		/// so an interrupted write never leaves a truncated entry.
+		///
+		/// @param program  The linked program to store.
+		/// @param key      The hash of the program.
+		///
+		/// @returns        True if the binary was stored.
+		///
+		////////////////////////////////////////////////////////////
+		bool save(GLuint program, std::uint64_t key);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Removes every program binary from the cache.
+		////////////////////////////////////////////////////////////
+		void clear();
+	};
+
+} // namespace jackal
+
+#endif//__JACKAL_PROGRAM_CACHE_HPP__
+
+////////////////////////////////////////////////////////////
+/// @author Benjamin Carter
+///
+/// @class jackal::ProgramCache
+/// @ingroup rendering
+///
+/// The jackal::ProgramCache stores the binary of every linked
+/// program on disk, so later launches can load it with
+/// glProgramBinary instead of compiling and linking the glsl
+/// sources again. Entries are keyed by a hash of the sources and the
+/// driver description, a binary the driver rejects is deleted and
+/// the program is rebuilt from source.
+///
+/// The Program class uses the cache automatically, it is disabled
+/// when the driver does not support program binaries. Due to the
+/// internal use of the class, it is not exposed to the lua scripting
+/// interface.
+///
+/// @code
+/// using namespace jackal;
+///
+/// ProgramCache::getInstance().create(config);
+///
+/// // Compiled from source on the first launch, loaded from the cache afterwards.
+/// auto shader = Shader::find("~assets/shaders/basic-lighting-shader.json");
+/// @endcode
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,219 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __JACKAL_RENDER_COMMAND_BUFFER_HPP__
+#define __JACKAL_RENDER_COMMAND_BUFFER_HPP__
+
+//====================
+// C++ includes
+//====================
+#include <cstddef>                        // Sizes and alignment of the recorded commands.
+#include <memory>                         // Owning the memory blocks of the buffer.
+#include <new>                            // Placement new of the recorded commands.
+#include <type_traits>                    // Retrieving the stored type of the command.
+#include <utility>                        // Forwarding the command into the buffer.
+#include <vector>                         // Storing the memory blocks of the buffer.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/utils/non_copyable.hpp> // Recorded commands cannot be copied.
+
+namespace jackal
+{
+	class RenderCommandBuffer final : NonCopyable
+	{
+	private:
+		//====================
+		// Structures
+		//====================
+		struct Header_t
+		{
+			void        (*pExecute)(void*); ///< Invokes the recorded command.
+			void        (*pDestroy)(void*); ///< Destroys the recorded command.
+			std::size_t size;               ///< The size of the header and command, in bytes.
+		};
+
+		struct Block_t
+		{
+			std::unique_ptr<unsigned char[]> pMemory;  ///< The memory of the block.
+			std::size_t                      capacity; ///< The size of the block, in bytes.
+			std::size_t                      used;     ///< The number of bytes recorded into the block.
+		};
+
+		//====================
+		// Member variables
+		//====================
+		std::vector<Block_t> m_blocks;  ///< The memory blocks commands are recorded into.
+		std::size_t          m_current; ///< The block that is currently being recorded into.
+		std::size_t          m_count;   ///< The number of commands that have been recorded.
+
+	private:
+		//====================
+		// Private methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Reserves memory for a new command.
+		///
+		/// Memory is reserved from the current block, if the block is full
+		/// the next block is used, allocating a new block if required. Blocks
+		/// are kept between frames so recording does not allocate once the
+		/// buffer has warmed up.
+		///
+		/// @param size  The number of bytes to reserve.
+		///
+		/// @returns A pointer to the reserved memory.
+		///
+		////////////////////////////////////////////////////////////
+		void* allocate(std::size_t size);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Visits every recorded command in order.
+		///
+		/// Each command is optionally executed before being destroyed, the
+		/// buffer is then reset ready for the next frame.
+		///
+		/// @param execute  Whether the commands should be executed.
+		///
+		////////////////////////////////////////////////////////////
+		void consume(bool execute);
+
+	public:
+		//====================
+		// Static variables
+		//====================
+		static const std::size_t BLOCK_SIZE = 64 * 1024; ///< The size of each memory block, in bytes.
+
+		//====================
+		// Ctor and dtor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Default constructor for the RenderCommandBuffer object.
+		///
+		/// The default constructor sets all of the member variables to
+		/// default values, no memory is allocated until a command is recorded.
+		///
+		////////////////////////////////////////////////////////////
+		explicit RenderCommandBuffer();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Destructor for the RenderCommandBuffer object.
+		///
+		/// Any commands that have not been executed are destroyed without
+		/// being executed.
+		///
+		////////////////////////////////////////////////////////////
+		~RenderCommandBuffer();
+
+		//====================
+		// Getters and setters
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the number of recorded commands.
+		///
+		/// @returns The number of commands waiting to be executed.
+		///
+		////////////////////////////////////////////////////////////
+		std::size_t getCount() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Checks whether any commands have been recorded.
+		///
+		/// @returns True if there are no commands waiting to be executed.
+		///
+		////////////////////////////////////////////////////////////
+		bool isEmpty() const;
+
+		//====================
+		// Methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Records a command into the buffer.
+		///
+		/// The command is any callable object, commonly a lambda, which is
+		/// moved into the memory of the buffer. Any state the command needs
+		/// should be captured by value, as it will be executed at a later
+		/// point in time, potentially on another thread.
+		///
+		/// @param command  The command to record.
+		///
+		////////////////////////////////////////////////////////////
+		template <typename F>
+		void record(F&& command);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Executes every recorded command in order.
+		///
+		/// Once executed, the commands are destroyed and the buffer is
+		/// reset, ready to record the next frame.
+		///
+		////////////////////////////////////////////////////////////
+		void execute();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Destroys every recorded command without executing it.
+		////////////////////////////////////////////////////////////
+		void clear();
+	};
+
+	//====================
+	// Jackal includes
+	//====================
+	#include <jackal/rendering/render_command_buffer.inl> // Class inline definition.
+
+} // namespace jackal
+
+#endif//__JACKAL_RENDER_COMMAND_BUFFER_HPP__
+
+////////////////////////////////////////////////////////////
+/// @author Benjamin Carter
+///
+/// @class jackal::RenderCommandBuffer
+/// @ingroup rendering
+///
+/// The jackal::RenderCommandBuffer records a stream of rendering
+/// commands that are executed at a later point in time. Commands are
+/// type-erased callables that are stored contiguously within large
+/// memory blocks, so recording a command is a simple copy into memory
+/// rather than a heap allocation.
+///
+/// Command buffers are used by the RenderThread, the game thread records
+/// one buffer while the render thread executes the other. Due to the internal
+/// use of the class, it is not exposed to the lua scripting interface.
+///
+/// @code
+/// using namespace jackal;
+///
+/// RenderCommandBuffer buffer;
+///
+/// GLuint id = texture.getID();
+/// buffer.record([id]() {
+///		glBindTexture(GL_TEXTURE_2D, id);
+/// });
+///
+/// // Later, on the thread that owns the OpenGL context.
+/// buffer.execute();
+/// @endcode
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,50 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//====================
+// Methods
+//====================
+////////////////////////////////////////////////////////////
+template <typename F>
+void RenderCommandBuffer::record(F&& command)
+{
+	using Command = typename std::decay<F>::type;
+
+	static_assert(alignof(Command) <= alignof(std::max_align_t), "Over-aligned render commands are not supported.");
+
+	// The command is stored directly after its header, both are kept aligned to the maximum alignment.
+	const std::size_t alignment = alignof(std::max_align_t);
+	const std::size_t headerSize = ((sizeof(Header_t) + alignment - 1) / alignment) * alignment;
+	const std::size_t size = ((headerSize + sizeof(Command) + alignment - 1) / alignment) * alignment;
+
+	unsigned char* pMemory = static_cast<unsigned char*>(this->allocate(size));
+
+	Header_t* pHeader = new (pMemory) Header_t();
+	pHeader->pExecute = [](void* pCommand) { (*static_cast<Command*>(pCommand))(); };
+	pHeader->pDestroy = [](void* pCommand) { static_cast<Command*>(pCommand)->~Command(); };
+	pHeader->size = size;
+
+	new (pMemory + headerSize) Command(std::forward<F>(command));
+	m_count++;
+}
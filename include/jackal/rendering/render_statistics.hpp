@@ -0,0 +1,303 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __JACKAL_RENDER_STATISTICS_HPP__
+#define __JACKAL_RENDER_STATISTICS_HPP__
+
+//====================
+// C++ includes
+//====================
+#include <array>                      // Storing a value for every counter.
+#include <atomic>                     // Counters are incremented by both the game and render thread.
+#include <cstdint>                    // Fixed width counter values.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/utils/singleton.hpp> // RenderStatistics is a singleton object.
+
+namespace jackal
+{
+	//====================
+	// Forward declarations
+	//====================
+	class ConfigFile;
+
+	//====================
+	// Enumerations
+	//====================
+	enum class eRenderCounter : int
+	{
+		DRAW_CALLS,    ///< The number of draw calls issued.
+		TRIANGLES,     ///< The number of triangles submitted.
+		PROGRAM_BINDS, ///< The number of shader programs bound.
+		TEXTURE_BINDS, ///< The number of textures bound.
+		BUFFER_BYTES,  ///< The number of bytes uploaded to buffers.
+		UNIFORM_CALLS, ///< The number of uniforms set.
+		COUNT          ///< The number of counters.
+	};
+
+	class RenderStatistics final : public Singleton<RenderStatistics>
+	{
+	private:
+		//====================
+		// Friend classes
+		//====================
+		friend class Singleton<RenderStatistics>;
+
+		//====================
+		// Static variables
+		//====================
+		static const int COUNTERS = static_cast<int>(eRenderCounter::COUNT); ///< The number of counters.
+
+		//====================
+		// Member variables
+		//====================
+		std::array<std::atomic<std::uint64_t>, COUNTERS> m_recorded; ///< The counters of the frame being recorded by the game thread.
+		std::array<std::atomic<std::uint64_t>, COUNTERS> m_executed; ///< The counters of the frame being executed by the render thread.
+		std::array<std::atomic<std::uint64_t>, COUNTERS> m_previous; ///< The counters of the last completed frame.
+		std::array<std::uint64_t, COUNTERS>              m_budgets;  ///< The budget of each counter, zero is unlimited.
+		std::atomic<unsigned int>                        m_exceeded; ///< The number of frames that exceeded a budget.
+
+	private:
+		//====================
+		// Ctor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Default constructor for the RenderStatistics object.
+		///
+		/// Every counter starts at zero and every budget is unlimited.
+		///
+		////////////////////////////////////////////////////////////
+		explicit RenderStatistics();
+
+		//====================
+		// Private methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Completes a frame once its commands have executed.
+		///
+		/// The counters the render thread incremented whilst executing
+		/// the frame are added to those recorded for it, the totals are
+		/// then stored and checked against the budgets.
+		///
+		/// @param recorded  The counters recorded by the game thread for the frame.
+		///
+		////////////////////////////////////////////////////////////
+		void completeFrame(const std::array<std::uint64_t, COUNTERS>& recorded);
+
+	public:
+		//====================
+		// Dtor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Default destructor for the RenderStatistics object.
+		////////////////////////////////////////////////////////////
+		~RenderStatistics() = default;
+
+		//====================
+		// Getters and setters
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves a counter of the last completed frame.
+		///
+		/// @param counter  The counter to retrieve.
+		///
+		/// @returns        The value of the counter.
+		///
+		////////////////////////////////////////////////////////////
+		std::uint64_t get(eRenderCounter counter) const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Sets the per-frame budget of a counter.
+		///
+		/// @param counter  The counter to set the budget of.
+		/// @param budget   The maximum value of the counter per frame, zero is unlimited.
+		///
+		////////////////////////////////////////////////////////////
+		void setBudget(eRenderCounter counter, std::uint64_t budget);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the per-frame budget of a counter.
+		///
+		/// @param counter  The counter to retrieve the budget of.
+		///
+		/// @returns        The maximum value of the counter per frame, zero is unlimited.
+		///
+		////////////////////////////////////////////////////////////
+		std::uint64_t getBudget(eRenderCounter counter) const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the number of frames that exceeded a budget.
+		///
+		/// @returns The number of frames since the application started.
+		///
+		////////////////////////////////////////////////////////////
+		unsigned int getExceededFrames() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the draw calls of the last frame.
+		///
+		/// @returns The number of draw calls issued in the last frame.
+		///
+		////////////////////////////////////////////////////////////
+		std::uint64_t getDrawCalls() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the triangles of the last frame.
+		///
+		/// @returns The number of triangles submitted in the last frame.
+		///
+		////////////////////////////////////////////////////////////
+		std::uint64_t getTriangles() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the program binds of the last frame.
+		///
+		/// @returns The number of programs bound in the last frame.
+		///
+		////////////////////////////////////////////////////////////
+		std::uint64_t getProgramBinds() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the texture binds of the last frame.
+		///
+		/// @returns The number of textures bound in the last frame.
+		///
+		////////////////////////////////////////////////////////////
+		std::uint64_t getTextureBinds() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the bytes uploaded to buffers of the last frame.
+		///
+		/// @returns The number of bytes uploaded in the last frame.
+		///
+		////////////////////////////////////////////////////////////
+		std::uint64_t getBufferBytes() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the uniform calls of the last frame.
+		///
+		/// @returns The number of uniforms set in the last frame.
+		///
+		////////////////////////////////////////////////////////////
+		std::uint64_t getUniformCalls() const;
+
+		//====================
+		// Methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Increments a counter of the current frame.
+		///
+		/// This is safe to invoke from both the game and render thread,
+		/// work counted on the render thread belongs to the frame it is
+		/// executing rather than the frame being recorded.
+		///
+		/// @param counter  The counter to increment.
+		/// @param amount   The amount to increment the counter by.
+		///
+		////////////////////////////////////////////////////////////
+		void add(eRenderCounter counter, std::uint64_t amount = 1);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Checks whether the last frame exceeded any budget.
+		///
+		/// @returns True if any counter exceeded its budget.
+		///
+		////////////////////////////////////////////////////////////
+		bool exceedsBudget() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Loads the budget of each counter from the config file.
+		///
+		/// The budgets are read from the RenderBudget section, any budget
+		/// that is zero, or missing, is unlimited.
+		///
+		/// @param config  The config file to read the budgets from.
+		///
+		////////////////////////////////////////////////////////////
+		void loadBudgets(const ConfigFile& config);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Marks the end of the frame.
+		///
+		/// The counters of the frame are stored so they can be queried,
+		/// and checked against the budgets, before being reset for the
+		/// next frame. When the render thread is running, the frame is
+		/// only completed once its commands have executed, so the values
+		/// queried lag a frame behind.
+		///
+		////////////////////////////////////////////////////////////
+		void endFrame();
+	};
+
+} // namespace jackal
+
+#endif//__JACKAL_RENDER_STATISTICS_HPP__
+
+////////////////////////////////////////////////////////////
+/// @author Benjamin Carter
+///
+/// @class jackal::RenderStatistics
+/// @ingroup rendering
+///
+/// The jackal::RenderStatistics counts the work submitted each
+/// frame: draw calls, triangles, program and texture binds, bytes
+/// uploaded to buffers and uniforms set. The counters are incremented
+/// by the rendering classes themselves, and the values of the last
+/// completed frame can be queried from C++ or lua. Counters incremented
+/// on the render thread are kept apart from those recorded by the game
+/// thread, so each frame reports the work it actually executed.
+///
+/// Each counter can be given a per-frame budget, loaded from the
+/// RenderBudget section of the config file, so automated performance
+/// runs can fail when a level submits more work than it should.
+///
+/// C++ Code example:
+/// @code
+/// using namespace jackal;
+///
+/// auto& statistics = RenderStatistics::getInstance();
+/// statistics.setBudget(eRenderCounter::DRAW_CALLS, 2000);
+///
+/// window.swap();
+/// statistics.endFrame();
+///
+/// if (statistics.exceedsBudget())
+/// {
+///		std::cout << statistics.getDrawCalls() << std::endl;
+/// }
+/// @endcode
+///
+/// Lua Code example:
+/// @code
+/// local statistics = RenderStatistics.get()
+///
+/// print(statistics.draw_calls)
+/// print(statistics.triangles)
+///
+/// statistics:set_budget(RenderCounter.DRAW_CALLS, 2000)
+/// @endcode
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,260 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __JACKAL_RENDER_THREAD_HPP__
+#define __JACKAL_RENDER_THREAD_HPP__
+
+//====================
+// C++ includes
+//====================
+#include <array>                                      // Storing the double-buffered command buffers.
+#include <condition_variable>                         // Signalling between the game and render thread.
+#include <future>                                     // Waiting on tasks invoked on the render thread.
+#include <mutex>                                      // Locking the shared state of the threads.
+#include <thread>                                     // The thread that owns the OpenGL context.
+#include <vector>                                     // Storing the tasks waiting to be invoked.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/utils/singleton.hpp>                 // RenderThread is a singleton object.
+#include <jackal/rendering/render_command_buffer.hpp> // Recording the commands of each frame.
+
+namespace jackal
+{
+	//====================
+	// Forward declarations
+	//====================
+	class Window;
+
+	class RenderThread final : public Singleton<RenderThread>
+	{
+	private:
+		//====================
+		// Friend classes
+		//====================
+		friend class Singleton<RenderThread>;
+
+		//====================
+		// Member variables
+		//====================
+		std::array<RenderCommandBuffer, 2>      m_buffers;   ///< The buffer being recorded and the buffer being executed.
+		int                                     m_recording; ///< The buffer the game thread is recording into.
+		bool                                    m_pending;   ///< Whether a submitted frame is waiting to be executed.
+		bool                                    m_executing; ///< Whether tasks taken from the queue are still executing.
+		bool                                    m_running;   ///< Whether the render thread has been started.
+		bool                                    m_stopping;  ///< Whether the render thread has been asked to stop.
+		std::vector<std::packaged_task<void()>> m_tasks;     ///< Tasks that the game thread is waiting upon.
+		Window*                                 m_pWindow;   ///< The window whose context is owned by the thread.
+		std::thread                             m_thread;    ///< The thread that executes the commands.
+		std::thread::id                         m_threadID;  ///< The identifier of the render thread.
+		std::mutex                              m_mutex;     ///< Locks the state shared between the threads.
+		std::condition_variable                 m_condition; ///< Signals that the shared state has changed.
+
+	private:
+		//====================
+		// Ctor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Default constructor for the RenderThread object.
+		///
+		/// The thread is not started upon construction, until it is
+		/// started every command is executed immediately on the calling
+		/// thread.
+		///
+		////////////////////////////////////////////////////////////
+		explicit RenderThread();
+
+		//====================
+		// Private methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief The entry point of the render thread.
+		///
+		/// The thread takes ownership of the OpenGL context and waits
+		/// for frames and tasks to be submitted, executing them in the
+		/// order they were submitted.
+		///
+		////////////////////////////////////////////////////////////
+		void run();
+
+	public:
+		//====================
+		// Dtor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Destructor for the RenderThread object.
+		///
+		/// The destructor implicitly calls stop, so the thread is always
+		/// joined before the application exits.
+		///
+		////////////////////////////////////////////////////////////
+		~RenderThread();
+
+		//====================
+		// Getters and setters
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves whether the render thread has been started.
+		///
+		/// @returns True if commands are being executed on the render thread.
+		///
+		////////////////////////////////////////////////////////////
+		bool isRunning() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves whether the calling thread is the render thread.
+		///
+		/// @returns True if invoked from the render thread.
+		///
+		////////////////////////////////////////////////////////////
+		bool isRenderThread() const;
+
+		//====================
+		// Methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Starts the render thread.
+		///
+		/// The OpenGL context of the window is released by the calling
+		/// thread and made current on the render thread. From this point
+		/// onwards, OpenGL must only be used through enqueued or invoked
+		/// commands.
+		///
+		/// @param window  The window whose context the thread will own.
+		///
+		/// @returns True if the thread was started successfully.
+		///
+		////////////////////////////////////////////////////////////
+		bool start(Window& window);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Stops the render thread.
+		///
+		/// Any recorded commands are executed before the thread is joined,
+		/// the OpenGL context is then made current on the calling thread
+		/// once more.
+		///
+		////////////////////////////////////////////////////////////
+		void stop();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Records a command into the current frame.
+		///
+		/// The command will be executed on the render thread once the
+		/// frame has been submitted. If the render thread is not running,
+		/// or this is invoked from the render thread, the command is
+		/// executed immediately. State should be captured by value.
+		///
+		/// @param command  The command to record.
+		///
+		////////////////////////////////////////////////////////////
+		template <typename F>
+		void enqueue(F&& command);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Executes a command on the render thread and waits for it.
+		///
+		/// This is used for work that must complete before the game thread
+		/// can continue, such as creating the OpenGL objects of a resource.
+		/// Any frame already submitted is executed before the command. If
+		/// the render thread is not running, or this is invoked from the
+		/// render thread, the command is executed immediately.
+		///
+		/// @param command  The command to execute.
+		///
+		////////////////////////////////////////////////////////////
+		template <typename F>
+		void invoke(F&& command);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Submits the recorded frame to the render thread.
+		///
+		/// The game thread waits for the render thread to finish the
+		/// previous frame, the command buffers are then swapped so the
+		/// game thread can record the next frame whilst the submitted
+		/// frame is executed.
+		///
+		////////////////////////////////////////////////////////////
+		void submit();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Waits for the render thread to finish all submitted work.
+		///
+		/// Both the submitted frame and any invoked tasks, including those
+		/// already taken from the queue, must have finished executing.
+		///
+		////////////////////////////////////////////////////////////
+		void flush();
+	};
+
+	//====================
+	// Jackal includes
+	//====================
+	#include <jackal/rendering/render_thread.inl> // Class inline definition.
+
+} // namespace jackal
+
+#endif//__JACKAL_RENDER_THREAD_HPP__
+
+////////////////////////////////////////////////////////////
+/// @author Benjamin Carter
+///
+/// @class jackal::RenderThread
+/// @ingroup rendering
+///
+/// The jackal::RenderThread owns the OpenGL context and executes
+/// the rendering commands recorded by the game thread. Each frame
+/// is recorded into a RenderCommandBuffer, when the frame is submitted
+/// the buffers are swapped, so the game thread can simulate and record
+/// frame N + 1 while the render thread executes frame N.
+///
+/// The rendering classes (Material, Shader, Texture and IRenderable)
+/// enqueue their OpenGL calls rather than calling OpenGL directly, when
+/// the thread has not been started the commands are executed immediately,
+/// so single threaded behaviour is unchanged. Due to the internal use of
+/// the class, it is not exposed to the lua scripting interface.
+///
+/// @code
+/// using namespace jackal;
+///
+/// RenderThread::getInstance().start(window);
+///
+/// while (window.isRunning())
+/// {
+///		window.clear();
+///
+///		// Record the frame.
+///		Material::bind(*material.get());
+///		material->process(transform);
+///		mesh.render();
+///
+///		// Submits the frame to the render thread.
+///		window.swap();
+/// }
+///
+/// RenderThread::getInstance().stop();
+/// @endcode
+///
+////////////////////////////////////////////////////////////
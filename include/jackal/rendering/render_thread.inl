@@ -0,0 +1,61 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//====================
+// Methods
+//====================
+////////////////////////////////////////////////////////////
+template <typename F>
+void RenderThread::enqueue(F&& command)
+{
+	if (!m_running || this->isRenderThread())
+	{
+		command();
+		return;
+	}
+
+	m_buffers[m_recording].record(std::forward<F>(command));
+}
+
+////////////////////////////////////////////////////////////
+template <typename F>
+void RenderThread::invoke(F&& command)
+{
+	if (!m_running || this->isRenderThread())
+	{
+		command();
+		return;
+	}
+
+	std::packaged_task<void()> task(std::forward<F>(command));
+	std::future<void> result = task.get_future();
+
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		m_tasks.push_back(std::move(task));
+	}
+
+	m_condition.notify_all();
+	result.wait();
+}
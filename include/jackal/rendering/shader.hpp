@@ -25,6 +25,15 @@
 #ifndef __JACKAL_SHADER_HPP__
 #define __JACKAL_SHADER_HPP__ 
 
+//====================
+// C++ includes
+//====================
+#include <atomic>        // Checking whether the shader is ready from the game thread.
+#include <cstdint>       // Masking the keywords of a variant.
+#include <string>        // Naming the keywords of a variant.
+#include <unordered_map> // Caching the variants by their keyword mask.
+#include <vector>        // Storing the keywords declared by the shader.
+
 //====================
 // Jackal includes
 //====================
@@ -32,6 +41,7 @@
 #include <jackal/rendering/program.hpp>     // The Program to attach shader files to.
 #include <jackal/rendering/uniform.hpp>     // Adding uniforms to the shaders.
 #include <jackal/utils/resource_handle.hpp> // Returning a handle to a Shader instance.
+#include <jackal/utils/ext/json.hpp>        // Storing the constant uniforms until the program has linked.
 
 namespace jackal
 {
@@ -43,12 +53,39 @@ namespace jackal
 
 	class Shader final : public Resource
 	{
+	public:
+		//====================
+		// Static variables
+		//====================
+		static const unsigned int MAX_KEYWORDS = 32; ///< The number of keywords that fit within a variant mask.
+
 	private:
 		//====================
 		// Member variables
 		//====================
-		Program m_program; ///< The Program to attach shaders to and compile.
-		Uniform m_uniform; ///< Uniform class for communication between C++ and GLSL.
+		Program                                                     m_program;    ///< The Program to attach shaders to and compile.
+		Uniform                                                     m_uniform;    ///< Uniform class for communication between C++ and GLSL.
+		nlohmann::json                                              m_constants;  ///< The constant uniforms, set once the program has linked.
+		std::string                                                 m_filename;   ///< The json file the shader was loaded from.
+		std::vector<std::string>                                    m_keywords;   ///< The keywords declared by the json file, in bit order.
+		std::unordered_map<std::uint32_t, ResourceHandle<Shader>>   m_variants;   ///< The variants of this shader, keyed by their keyword mask.
+		std::uint32_t                                               m_mask;       ///< The keywords defined when this shader was compiled.
+		std::atomic<bool>                                           m_ready;      ///< Whether the program has linked and can be bound.
+		nlohmann::json                                              m_precompile; ///< The keyword sets to compile once the program has been submitted.
+		bool                                                        m_prepared;   ///< Whether the files have been read by prepare.
+
+	private:
+		//====================
+		// Private methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Sets the constant uniforms and marks the Shader as ready.
+		///
+		/// This must be invoked on the render thread once the program
+		/// has linked successfully.
+		///
+		////////////////////////////////////////////////////////////
+		void applyConstants();
 
 	public:
 		//====================
@@ -97,9 +134,87 @@ namespace jackal
 		////////////////////////////////////////////////////////////
 		std::vector<GLSLObject>& getShaders();
 
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the json file the Shader was loaded from.
+		///
+		/// Every variant of a shader shares the json file of the shader
+		/// it was created from.
+		///
+		/// @returns The file name of the json file.
+		///
+		////////////////////////////////////////////////////////////
+		const std::string& getFilename() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves whether the Shader can be used for rendering.
+		///
+		/// Shaders are compiled in the background after they have been
+		/// loaded, the shader is not ready until a later poll finds that
+		/// the driver has finished linking it. A shader that failed to
+		/// compile is never ready.
+		///
+		/// @returns True if the Shader has linked successfully.
+		///
+		////////////////////////////////////////////////////////////
+		bool isReady() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the keywords this Shader was compiled with.
+		///
+		/// Each bit refers to a keyword, in the order they are declared
+		/// within the json file of the shader.
+		///
+		/// @returns The keyword mask of this variant.
+		///
+		////////////////////////////////////////////////////////////
+		std::uint32_t getMask() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Converts a list of keywords into a keyword mask.
+		///
+		/// Keywords that are not declared by the shader are ignored, so
+		/// a material can enable features that only some shaders support.
+		///
+		/// @param keywords  The names of the keywords to enable.
+		///
+		/// @returns         The keyword mask of the enabled keywords.
+		///
+		////////////////////////////////////////////////////////////
+		std::uint32_t getKeywordMask(const std::vector<std::string>& keywords) const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves a variant of the Shader compiled with a keyword mask.
+		///
+		/// The variant is loaded from the same json file with a define for
+		/// each keyword in the mask, and compiled on demand the first time it
+		/// is requested. The variant is cached by its mask, so each permutation
+		/// is only compiled once. The variant stays alive with this Shader,
+		/// so the caller should retain both handles.
+		///
+		/// @param mask  The keyword mask of the variant.
+		///
+		/// @returns     The handle to the variant.
+		///
+		////////////////////////////////////////////////////////////
+		ResourceHandle<Shader> getVariant(std::uint32_t mask);
+
 		//====================
 		// Methods
 		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Reads the files of a shader.
+		///
+		/// This is invoked on a worker thread when the shader is loaded in
+		/// the background. The json file is parsed and the glsl files are
+		/// read, the program is submitted by the following load.
+		///
+		/// @param filename   The file directory of the json file.
+		///
+		/// @returns          True if the json file was read and parsed.
+		///
+		////////////////////////////////////////////////////////////
+		bool prepare(const std::string& filename) override;
+
 		////////////////////////////////////////////////////////////
 		/// @brief Loads the data associated with this shader.
 		///
@@ -107,7 +222,12 @@ namespace jackal
 		/// that stores the information of a Shader in a serialized format,
 		/// this is so the different shader objects can be used between application
 		/// instances and allow quick-swapping of variables without
-		/// compilation.
+		/// compilation. The "keywords" array declares the features that can be
+		/// compiled into a variant, and the "precompile" array lists the keyword
+		/// sets that are compiled ahead of time rather than on demand.
+		/// The glsl files are submitted to the driver but not
+		/// waited upon, the Shader is not ready until it has been polled.
+		/// The files are only read if the shader hasn't been prepared.
 		///
 		/// @param filename   The file directory of the json file.
 		///
@@ -176,6 +296,28 @@ namespace jackal
 		////////////////////////////////////////////////////////////
 		bool recompile();
 
+		////////////////////////////////////////////////////////////
+		/// @brief Checks whether the driver has finished compiling the Shader.
+		///
+		/// The check is enqueued on the render thread and never blocks, when
+		/// GL_KHR_parallel_shader_compile is not supported the status is
+		/// collected on the render thread instead, still a frame later than
+		/// the load. Materials poll their shader every time they are bound.
+		///
+		////////////////////////////////////////////////////////////
+		void poll();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Blocks until the driver has finished compiling the Shader.
+		///
+		/// This should only be used for shaders that must be available
+		/// immediately, such as the fallback shader of a Material.
+		///
+		/// @returns True if the Shader is ready for use.
+		///
+		////////////////////////////////////////////////////////////
+		bool wait();
+
 		////////////////////////////////////////////////////////////
 		/// @brief Processes the uniforms attached to the shader.
 		///
@@ -225,6 +367,15 @@ namespace jackal
 /// and update the uniform variables contained within glsl shaders
 /// to apply the behavior to subsequent meshes that render.
 ///
+/// A shader json file can declare keywords, each variant of the
+/// shader is compiled with a define for every keyword it enables so
+/// that unused features are compiled out of the glsl rather than
+/// branched on. Variants are cached by their keyword mask.
+///
+/// Shaders loaded from json files are compiled in the background,
+/// materials render with a fallback shader until isReady returns
+/// true, so that loading many shaders doesn't stall the frame.
+///
 /// Due to the internal use of the shaders, they are not exposed
 /// to the lua scripting inteface. To alter the appearance of objects
 /// with the shader, calls to the Material instance should be made through
@@ -0,0 +1,241 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __JACKAL_SPOT_LIGHT_HPP__
+#define __JACKAL_SPOT_LIGHT_HPP__
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/rendering/ilight.hpp>     // SpotLight is a type of light.
+#include <jackal/math/vector3.hpp>         // Stores the position and direction of the light.
+#include <jackal/math/bounding_sphere.hpp> // Bounding the cone of the light.
+
+namespace jackal
+{
+	class SpotLight final : public ILight
+	{
+	private:
+		//====================
+		// Member variables
+		//====================
+		Vector3f m_position;   ///< The world position the light shines from.
+		Vector3f m_direction;  ///< The direction the cone of the light faces.
+		float    m_range;      ///< The distance at which the light has no effect.
+		float    m_innerAngle; ///< The angle, in degrees, within which the light is at full intensity.
+		float    m_outerAngle; ///< The angle, in degrees, beyond which the light has no effect.
+
+	private:
+		//====================
+		// Private methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Initialises the member variables of the SpotLight object.
+		///
+		/// This method is invoked by the subsequent create method, it is used
+		/// to initialise all of the member variables to specified values.
+		/// If the creation or initialisation fails, the object will return a null
+		/// value.
+		///
+		/// @param colour      The colour of the light.
+		/// @param intensity   The intensity of the light upon the scene.
+		/// @param position    The world position of the light.
+		/// @param direction   The direction of the cone.
+		/// @param range       The distance at which the light has no effect.
+		/// @param innerAngle  The angle, in degrees, within which the light is at full intensity.
+		/// @param outerAngle  The angle, in degrees, beyond which the light has no effect.
+		///
+		/// @returns True if the light initialises the variables correctly.
+		///
+		////////////////////////////////////////////////////////////
+		bool init(const Colour& colour, float intensity, const Vector3f& position, const Vector3f& direction,
+			float range, float innerAngle, float outerAngle);
+
+	public:
+		//====================
+		// Ctor and dtor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Default constructor for the SpotLight object.
+		////////////////////////////////////////////////////////////
+		explicit SpotLight();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Default destructor for the SpotLight object.
+		////////////////////////////////////////////////////////////
+		~SpotLight() = default;
+
+		//====================
+		// Getters and setters
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the position of the SpotLight object.
+		///
+		/// @returns The world position the light shines from.
+		///
+		////////////////////////////////////////////////////////////
+		Vector3f getPosition() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Sets the position of the SpotLight object.
+		///
+		/// @param position  The new world position of the light.
+		///
+		////////////////////////////////////////////////////////////
+		void setPosition(const Vector3f& position);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the direction of the SpotLight object.
+		///
+		/// @returns The direction the cone of the light faces.
+		///
+		////////////////////////////////////////////////////////////
+		Vector3f getDirection() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Sets the direction of the SpotLight object.
+		///
+		/// @param direction  The new direction of the cone, it is normalised.
+		///
+		////////////////////////////////////////////////////////////
+		void setDirection(const Vector3f& direction);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the range of the SpotLight object.
+		///
+		/// @returns The distance at which the light has no effect.
+		///
+		////////////////////////////////////////////////////////////
+		float getRange() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Sets the range of the SpotLight object.
+		///
+		/// @param range  The new distance at which the light has no effect.
+		///
+		////////////////////////////////////////////////////////////
+		void setRange(float range);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the inner angle of the SpotLight object.
+		///
+		/// @returns The angle, in degrees, within which the light is at full intensity.
+		///
+		////////////////////////////////////////////////////////////
+		float getInnerAngle() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the outer angle of the SpotLight object.
+		///
+		/// @returns The angle, in degrees, beyond which the light has no effect.
+		///
+		////////////////////////////////////////////////////////////
+		float getOuterAngle() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Sets the angles of the cone of the SpotLight object.
+		///
+		/// The light fades between the inner and outer angle, the
+		/// inner angle is clamped so it never exceeds the outer angle.
+		///
+		/// @param innerAngle  The angle, in degrees, within which the light is at full intensity.
+		/// @param outerAngle  The angle, in degrees, beyond which the light has no effect.
+		///
+		////////////////////////////////////////////////////////////
+		void setAngles(float innerAngle, float outerAngle);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the smallest sphere that bounds the cone.
+		///
+		/// A wide cone is bounded by a sphere around its base, a narrow
+		/// cone by the sphere that passes through its apex and base.
+		///
+		/// @returns The world space bounds of the light.
+		///
+		////////////////////////////////////////////////////////////
+		BoundingSphere getBoundingSphere() const;
+
+		//====================
+		// Methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Binding the spot light to a lua object for scripting.
+		///
+		/// So that spot lights can be referenced within scripts, they need
+		/// to be exposed as lua objects for additional functionality. This allows
+		/// this light to be manipulated within scripts for additional behavior.
+		///
+		/// @returns The component as a lua object.
+		///
+		////////////////////////////////////////////////////////////
+		sol::table lua_asObject() const override;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Creates a new SpotLight object and initialises it for use.
+		///
+		/// This method is a simple wrapper around retrieving a SpotLight
+		/// object from the pools and initializing its member variables to the
+		/// defined values. If the pool fails to retrieve a resource or the
+		/// initialization fails, the method will return a null value.
+		///
+		/// @param colour      The colour of the light.
+		/// @param intensity   The intensity of the light upon the scene.
+		/// @param position    The world position of the light.
+		/// @param direction   The direction of the cone.
+		/// @param range       The distance at which the light has no effect.
+		/// @param innerAngle  The angle, in degrees, within which the light is at full intensity.
+		/// @param outerAngle  The angle, in degrees, beyond which the light has no effect.
+		///
+		/// @returns A SpotLight from the pool if initialisation was successful.
+		///
+		////////////////////////////////////////////////////////////
+		static SpotLight* create(const Colour& colour, float intensity, const Vector3f& position, const Vector3f& direction,
+			float range, float innerAngle, float outerAngle);
+	};
+
+} // namespace jackal
+
+#endif//__JACKAL_SPOT_LIGHT_HPP__
+
+////////////////////////////////////////////////////////////
+/// @author Benjamin Carter
+///
+/// @class jackal::SpotLight
+/// @ingroup rendering
+///
+/// The jackal::SpotLight shines a cone of light from a single
+/// position, such as a torch or a street lamp. The light is at full
+/// intensity within the inner angle and fades to nothing at the
+/// outer angle and at its range.
+///
+/// @code
+/// using namespace jackal;
+///
+/// SpotLight* pLight = SpotLight::create(Colour::white(), 2.0f, Vector3f(0.0f, 3.0f, 0.0f),
+///		-Vector3f::up(), 8.0f, 20.0f, 30.0f);
+///
+/// ClusteredLighting::getInstance().add(pLight);
+/// @endcode
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,300 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __JACKAL_STREAM_BUFFER_HPP__
+#define __JACKAL_STREAM_BUFFER_HPP__
+
+//====================
+// C++ includes
+//====================
+#include <array>                          // Storing a fence for each region of the buffer.
+#include <vector>                         // Staging memory when persistent mapping is unsupported.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/utils/non_copyable.hpp> // The buffer owns a GL object and mapped memory.
+
+//====================
+// Additional includes
+//====================
+#include <GL/glew.h>                      // OpenGL functionality.
+
+namespace jackal
+{
+	//====================
+	// Enumerations
+	//====================
+	enum class eStreamTarget : GLenum
+	{
+		VERTEX       = GL_ARRAY_BUFFER,
+		INDEX        = GL_ELEMENT_ARRAY_BUFFER,
+		UNIFORM      = GL_UNIFORM_BUFFER,
+		INDIRECT     = GL_DRAW_INDIRECT_BUFFER,
+		TEXTURE      = GL_TEXTURE_BUFFER,
+		PIXEL_UNPACK = GL_PIXEL_UNPACK_BUFFER
+	};
+
+	class StreamBuffer final : NonCopyable
+	{
+	public:
+		//====================
+		// Static variables
+		//====================
+		static const int REGIONS = 3; ///< The number of frames that can be in flight at once.
+
+	private:
+		//====================
+		// Member variables
+		//====================
+		GLuint                     m_ID;         ///< Unique identifier for the buffer object.
+		eStreamTarget              m_target;     ///< The target the buffer is bound to.
+		GLsizeiptr                 m_size;       ///< The size of a single region, in bytes.
+		int                        m_region;     ///< The region that is currently being written to.
+		GLsizeiptr                 m_head;       ///< The write position within the current region.
+		GLsizeiptr                 m_flushed;    ///< The write position that has been uploaded. (fallback only)
+		bool                       m_persistent; ///< Whether the buffer is persistently mapped.
+		unsigned char*             m_pMapped;    ///< The persistently mapped memory of every region.
+		std::vector<unsigned char> m_staging;    ///< Staging memory that is uploaded when flushed. (fallback only)
+		std::array<GLsync, REGIONS> m_fences;    ///< Fences signalled when the GPU has finished reading each region.
+
+	private:
+		//====================
+		// Private methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Blocks until the GPU has finished reading a region.
+		///
+		/// In the common case the region was submitted two frames ago
+		/// and the fence has already been signalled, so this will not
+		/// block at all.
+		///
+		/// @param region  The region to wait for.
+		///
+		////////////////////////////////////////////////////////////
+		void wait(int region);
+
+	public:
+		//====================
+		// Ctor and dtor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Default constructor for the StreamBuffer object.
+		///
+		/// The default constructor sets all of the member variables to
+		/// default values, the buffer must be created before it can be
+		/// written to.
+		///
+		////////////////////////////////////////////////////////////
+		explicit StreamBuffer();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Destructor for the StreamBuffer object.
+		///
+		/// The destructor implicitly calls the destroy method, which
+		/// unmaps and deletes the buffer object.
+		///
+		////////////////////////////////////////////////////////////
+		~StreamBuffer();
+
+		//====================
+		// Getters and setters
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Returns the unique ID of the StreamBuffer object.
+		///
+		/// @returns The ID of the StreamBuffer object.
+		///
+		////////////////////////////////////////////////////////////
+		GLuint getID() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the size of a single region of the buffer.
+		///
+		/// The size of a region is the amount of data that can be written
+		/// each frame.
+		///
+		/// @returns The size of a region, in bytes.
+		///
+		////////////////////////////////////////////////////////////
+		GLsizeiptr getSize() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves whether the buffer is persistently mapped.
+		///
+		/// Persistent mapping requires OpenGL 4.4 or ARB_buffer_storage,
+		/// when unavailable the buffer falls back to orphaning and uploading
+		/// the written data with glBufferSubData.
+		///
+		/// @returns True if the buffer is persistently mapped.
+		///
+		////////////////////////////////////////////////////////////
+		bool isPersistent() const;
+
+		//====================
+		// Methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Creates the buffer object and its storage.
+		///
+		/// When persistent mapping is supported, storage for every region
+		/// is created immutably and mapped once for the lifetime of the
+		/// buffer. Otherwise a single region is allocated on the GPU and
+		/// written data is staged in client memory.
+		///
+		/// @param target  The target the buffer will be bound to.
+		/// @param size    The number of bytes that can be written each frame.
+		///
+		/// @returns True if the buffer was created successfully.
+		///
+		////////////////////////////////////////////////////////////
+		bool create(eStreamTarget target, GLsizeiptr size);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Destroys the buffer object.
+		///
+		/// Any pending fences are deleted and the storage is unmapped.
+		///
+		////////////////////////////////////////////////////////////
+		void destroy();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Begins writing a new frame of data.
+		///
+		/// The region that is about to be written is waited upon, so that
+		/// data still being read by the GPU is never overwritten. Without
+		/// persistent mapping the storage of the buffer is orphaned instead.
+		///
+		////////////////////////////////////////////////////////////
+		void beginFrame();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Finishes writing the current frame of data.
+		///
+		/// A fence is inserted after the commands that read the current
+		/// region and the buffer moves to the next region. This should be
+		/// invoked once every draw call using the data has been submitted.
+		///
+		////////////////////////////////////////////////////////////
+		void endFrame();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Reserves memory within the current region.
+		///
+		/// The returned pointer can be written to directly with memcpy. The
+		/// offset refers to the position of the data within the buffer object
+		/// and is what should be passed to any draw or bind calls.
+		///
+		/// @param size       The number of bytes to reserve.
+		/// @param offset     The offset of the reserved memory within the buffer.
+		/// @param alignment  The alignment of the reserved memory, in bytes.
+		///
+		/// @returns A pointer to the reserved memory, or null if the region is full.
+		///
+		////////////////////////////////////////////////////////////
+		void* map(GLsizeiptr size, GLintptr& offset, GLsizeiptr alignment = 16);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Copies data into the current region.
+		///
+		/// A convenience method that reserves memory and copies the data
+		/// into it.
+		///
+		/// @param pData      The data to copy.
+		/// @param size       The number of bytes to copy.
+		/// @param alignment  The alignment of the data, in bytes.
+		///
+		/// @returns The offset of the data within the buffer, or -1 if the region is full.
+		///
+		////////////////////////////////////////////////////////////
+		GLintptr write(const void* pData, GLsizeiptr size, GLsizeiptr alignment = 16);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Makes written data visible to the GPU.
+		///
+		/// Persistently mapped buffers are coherent, so this method does
+		/// nothing. Without persistent mapping, all data written since the
+		/// last flush is uploaded with glBufferSubData. This must be invoked
+		/// before issuing any draw calls that read the data.
+		///
+		////////////////////////////////////////////////////////////
+		void flush();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Binds a StreamBuffer object to its target.
+		///
+		/// @param buffer  The StreamBuffer to bind.
+		///
+		////////////////////////////////////////////////////////////
+		static void bind(const StreamBuffer& buffer);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Unbinds the target of a StreamBuffer object.
+		///
+		/// @param buffer  The StreamBuffer whose target to unbind.
+		///
+		////////////////////////////////////////////////////////////
+		static void unbind(const StreamBuffer& buffer);
+	};
+
+} // namespace jackal
+
+#endif//__JACKAL_STREAM_BUFFER_HPP__
+
+////////////////////////////////////////////////////////////
+/// @author Benjamin Carter
+///
+/// @class jackal::StreamBuffer
+/// @ingroup rendering
+///
+/// The jackal::StreamBuffer is used for data that is re-written
+/// every frame, such as instance matrices, particles, interface
+/// quads and uniform blocks. The buffer is split into three regions
+/// that are written in turn, so the CPU can write one frame while the
+/// GPU is still reading the previous two, fences are used to ensure
+/// a region is never overwritten while in use.
+///
+/// When persistent mapping is available the regions are mapped once
+/// and written with plain memcpy, otherwise the buffer orphans its
+/// storage each frame and uploads the written data when flushed. Due
+/// to the low level aspects of the class, it is not exposed to the lua
+/// scripting interface.
+///
+/// @code
+/// using namespace jackal;
+///
+/// StreamBuffer instances;
+/// instances.create(eStreamTarget::VERTEX, sizeof(Matrix4) * 1024);
+///
+/// // Each frame.
+/// instances.beginFrame();
+///
+/// GLintptr offset = instances.write(matrices.data(), sizeof(Matrix4) * matrices.size());
+/// instances.flush();
+///
+/// // Issue draw calls that read from the offset.
+/// instances.endFrame();
+/// @endcode
+///
+////////////////////////////////////////////////////////////
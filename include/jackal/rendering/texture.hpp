@@ -25,12 +25,19 @@
 #ifndef __JACKAL_TEXTURE_HPP__
 #define __JACKAL_TEXTURE_HPP__
 
+//====================
+// C++ includes
+//====================
+#include <atomic>                           // The image is uploaded on the render thread.
+#include <future>                           // Waiting on the image to be decoded.
+
 //====================
 // Jackal includes
 //====================
 #include <jackal/utils/resource.hpp>        // Texture loads data from disk.
 #include <jackal/math/vector2.hpp>          // Storing the size of the texture as a vector.
 #include <jackal/utils/resource_handle.hpp> // A handle to the Texture resource.
+#include <jackal/utils/ext/json.hpp>        // Keeping the json file read by prepare.
 
 //====================
 // Additional includes
@@ -54,16 +61,35 @@ namespace jackal
 		NEAREST = GL_NEAREST
 	};
 
+	//====================
+	// Forward declarations
+	//====================
+	class TextureArray;
+
 	class Texture : public Resource
 	{
 	private:
+		//====================
+		// Friend classes
+		//====================
+		friend class TextureUploader;
+
 		//====================
 		// Member variables
 		//====================
-		GLuint    m_ID;     ///< The unique ID of the texture.
-		Vector2i  m_size;   ///< The width and height of the texture.
-		eWrapMode m_mode;   ///< How the texture wraps onto the rendering mesh.
-		eFilter   m_filter; ///< How the image will filter on the texture.
+		GLuint            m_ID;       ///< The unique ID of the texture.
+		Vector2i          m_size;     ///< The width and height of the texture.
+		eWrapMode         m_mode;     ///< How the texture wraps onto the rendering mesh.
+		eFilter           m_filter;   ///< How the image will filter on the texture.
+		std::string       m_image;    ///< The file name of the image the texture was loaded from.
+		std::atomic<bool> m_ready;    ///< Whether the image has been uploaded.
+		std::future<void> m_decode;   ///< The task decoding the image on the thread pool.
+		bool              m_packed;   ///< Whether the image is packed into an array texture.
+		bool              m_streamed; ///< Whether the levels of the image are streamed on demand.
+		TextureArray*     m_pArray;   ///< The array texture the image was packed into.
+		int               m_layer;    ///< The layer of the array texture the image was packed into.
+		nlohmann::json    m_document; ///< The json file read by prepare, until the following load.
+		bool              m_prepared; ///< Whether the json file has been read by prepare.
 
 	protected:
 		//====================
@@ -88,21 +114,47 @@ namespace jackal
 		////////////////////////////////////////////////////////////
 		/// @brief Loads and formats an image from memory.
 		///
-		/// This method will load in an image from the specified file
-		/// directory and format it into a format that OpenGL can understand
-		/// and utilise. If the image fails to be found or cannot convert,
-		/// the method will return false and log an error message. This
-		/// method can make used of the virtual file system
+		/// This method will find the image within the virtual file system
+		/// and decode it on the thread pool, converting it into a format
+		/// that OpenGL can understand and utilise. The decoded image is
+		/// queued on the TextureUploader, until it has been uploaded the
+		/// placeholder texture is bound in its place. If the image cannot
+		/// be found, the method will return false and log an error message.
+		/// Images with the .jtex extension are cooked, their compressed
+		/// levels are mapped and uploaded without decoding.
 		///
 		/// @param filename   The file name of the image to load.
 		/// @param wrapMode   How the texture will be applied to the mesh.
 		/// @param filter     The image filtering applied to the texture.
 		///
-		/// @returns          True if the image loaded and formatted successfully.
+		/// @returns          True if the image was found and is being decoded.
 		///
 		////////////////////////////////////////////////////////////
 		bool loadFromFile(const std::string& filename, eWrapMode wrapMode, eFilter filter);
 
+		////////////////////////////////////////////////////////////
+		/// @brief Marks the image of the texture as uploaded.
+		///
+		/// This is invoked by the TextureUploader on the render thread.
+		///
+		/// @param size  The width and height of the uploaded image.
+		///
+		////////////////////////////////////////////////////////////
+		void onUploaded(const Vector2i& size);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Assigns the layer the image was packed into.
+		///
+		/// This is invoked by the TextureUploader on the render thread,
+		/// before the image is marked as uploaded. The layer of a previous
+		/// image is returned to its array.
+		///
+		/// @param pArray  The array texture the image was packed into.
+		/// @param layer   The layer of the array texture.
+		///
+		////////////////////////////////////////////////////////////
+		void onPacked(TextureArray* pArray, int layer);
+
 	public:
 		//====================
 		// Ctor and dtor
@@ -119,8 +171,10 @@ namespace jackal
 		////////////////////////////////////////////////////////////
 		/// @brief Destructor for the Texture object.
 		///
-		/// When the texture object is destroyed, it will de-allocate the
-		/// GPU memory that is associated with the ID of this texture.
+		/// When the texture object is destroyed, it will wait for its
+		/// image to finish decoding, discard any pending upload and
+		/// de-allocate the GPU memory that is associated with the ID of
+		/// this texture.
 		///
 		////////////////////////////////////////////////////////////
 		virtual ~Texture();
@@ -140,16 +194,74 @@ namespace jackal
 		////////////////////////////////////////////////////////////
 		GLuint getID() const;
 
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the file name of the image the Texture was loaded from.
+		///
+		/// @returns The file name of the image, empty if the Texture wasn't loaded from a file.
+		///
+		////////////////////////////////////////////////////////////
+		const std::string& getImage() const;
+
 		////////////////////////////////////////////////////////////
 		/// @brief Retrieves the width and height of the Texture object.
 		///
 		/// The width and height refer to the size (in pixels) of the 
-		/// original image file passed in.
+		/// original image file passed in. The size is zero until the
+		/// image has been uploaded.
 		///
 		/// @returns The size of the texture image.
 		////////////////////////////////////////////////////////////
 		Vector2i getSize() const;
 
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves whether the image of the Texture has been uploaded.
+		///
+		/// Images are decoded and uploaded in the background, until then
+		/// binding the texture binds the placeholder texture instead.
+		///
+		/// @returns True if the image has been uploaded.
+		///
+		////////////////////////////////////////////////////////////
+		bool isReady() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves whether the image is packed into an array texture.
+		///
+		/// Packed textures don't upload to their own texture object, they
+		/// must be sampled as a layer of a sampler2DArray.
+		///
+		/// @returns True if the image is packed into an array texture.
+		///
+		////////////////////////////////////////////////////////////
+		bool isPacked() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the array texture the image was packed into.
+		///
+		/// @returns The array texture, or null until the image has been uploaded.
+		///
+		////////////////////////////////////////////////////////////
+		const TextureArray* getArray() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the layer of the array texture the image was packed into.
+		///
+		/// @returns The layer of the array texture, zero until the image has been uploaded.
+		///
+		////////////////////////////////////////////////////////////
+		int getLayer() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves whether the levels of the image are streamed on demand.
+		///
+		/// Only cooked images are streamed, their larger levels are only
+		/// resident while the texture is visible at that size.
+		///
+		/// @returns True if the image is streamed by the TextureStreamer.
+		///
+		////////////////////////////////////////////////////////////
+		bool isStreamed() const;
+
 		////////////////////////////////////////////////////////////
 		/// @brief Retrieves the wrap mode of the texture.
 		///
@@ -188,12 +300,26 @@ namespace jackal
 		////////////////////////////////////////////////////////////
 		void create();
 
+		////////////////////////////////////////////////////////////
+		/// @brief Reads the json file of a Texture object.
+		///
+		/// This is invoked on a worker thread when the texture is loaded
+		/// in the background, the file is kept for the following load.
+		///
+		/// @param filename  The file location of the json file.
+		///
+		/// @returns         True if the file was read and parsed.
+		///
+		////////////////////////////////////////////////////////////
+		bool prepare(const std::string& filename) override;
+
 		////////////////////////////////////////////////////////////
 		/// @brief Loads the data for a Texture object.
 		///
 		/// The data for a texture is commonly stored within a json file,
 		/// when this method is invoked, it will parse the json and set
-		/// the appropriate values and parameters.
+		/// the appropriate values and parameters. The json file is only
+		/// read if the texture hasn't already been prepared.
 		///
 		/// @param filename  The file location of the json file.
 		///
@@ -221,6 +347,8 @@ namespace jackal
 		///
 		/// When a Texture object is bound, it will utilise the rendering
 		/// behavior defined for the texture within the next rendering loop.
+		/// The placeholder texture is bound while the image is loading,
+		/// packed textures bind their array texture instead.
 		///
 		/// @param texture   The texture to bind.
 		/// @param location  Which location to bind the texture to.
@@ -259,6 +387,12 @@ namespace jackal
 /// be set as data. Due to the internal use of textures, their functionality is
 /// not exposed to the lua scripting interface.
 ///
+/// Unless the description sets "pack" to false, the image is packed
+/// into a layer of a shared TextureArray, so it must be sampled by a
+/// shader variant compiled with the array keywords. Cooked images are
+/// streamed by the TextureStreamer instead, unless the description
+/// sets "stream" to false.
+///
 /// C++ Code example:
 /// @code
 /// using namespace jackal;
@@ -0,0 +1,221 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __JACKAL_TEXTURE_ARRAY_HPP__
+#define __JACKAL_TEXTURE_ARRAY_HPP__
+
+//====================
+// C++ includes
+//====================
+#include <vector>                            // Storing the free layers of the array.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/utils/non_copyable.hpp>     // TextureArray owns a GL object and cannot be copied.
+#include <jackal/rendering/texture.hpp>      // Sharing the wrap modes and filters of textures.
+#include <jackal/rendering/texture_file.hpp> // The format of every layer.
+
+namespace jackal
+{
+	class TextureArray final : NonCopyable
+	{
+	private:
+		//====================
+		// Member variables
+		//====================
+		GLuint           m_ID;     ///< The unique ID of the array texture.
+		Vector2i         m_size;   ///< The width and height of every layer.
+		eTextureFormat   m_format; ///< The format of every layer.
+		int              m_levels; ///< The number of mip levels of every layer.
+		eWrapMode        m_mode;   ///< How every layer wraps onto the rendering mesh.
+		eFilter          m_filter; ///< How every layer is filtered.
+		int              m_layers; ///< The number of layers within the array.
+		std::vector<int> m_free;   ///< The layers that haven't been allocated.
+
+	public:
+		//====================
+		// Ctor and dtor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Default constructor for the TextureArray object.
+		///
+		/// No storage is allocated until the array is created.
+		///
+		////////////////////////////////////////////////////////////
+		explicit TextureArray();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Destructor for the TextureArray object.
+		///
+		/// The destructor implicitly calls the destroy method, which
+		/// deletes the array texture.
+		///
+		////////////////////////////////////////////////////////////
+		~TextureArray();
+
+		//====================
+		// Getters and setters
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the unique ID of the array texture.
+		///
+		/// @returns The ID of the array texture.
+		///
+		////////////////////////////////////////////////////////////
+		GLuint getID() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the size of every layer.
+		///
+		/// @returns The width and height of every layer, in texels.
+		///
+		////////////////////////////////////////////////////////////
+		Vector2i getSize() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the format of every layer.
+		///
+		/// @returns The format of the array.
+		///
+		////////////////////////////////////////////////////////////
+		eTextureFormat getFormat() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the number of mip levels of every layer.
+		///
+		/// @returns The number of mip levels.
+		///
+		////////////////////////////////////////////////////////////
+		int getLevels() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves whether every layer has been allocated.
+		///
+		/// @returns True if no more textures can be packed into the array.
+		///
+		////////////////////////////////////////////////////////////
+		bool isFull() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves whether a texture can be packed into the array.
+		///
+		/// Only textures with the same size, format, mip levels and
+		/// sampling share an array, as every layer is sampled alike.
+		///
+		/// @param size    The width and height of the texture.
+		/// @param format  The format of the texture.
+		/// @param levels  The number of mip levels of the texture.
+		/// @param mode    The wrap mode of the texture.
+		/// @param filter  The filter of the texture.
+		///
+		/// @returns       True if the texture matches every layer.
+		///
+		////////////////////////////////////////////////////////////
+		bool matches(const Vector2i& size, eTextureFormat format, int levels, eWrapMode mode, eFilter filter) const;
+
+		//====================
+		// Methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Allocates the storage of the array.
+		///
+		/// This must be invoked on the render thread. Immutable storage
+		/// is used when supported.
+		///
+		/// @param size    The width and height of every layer.
+		/// @param format  The format of every layer.
+		/// @param levels  The number of mip levels of every layer.
+		/// @param mode    How every layer wraps onto the rendering mesh.
+		/// @param filter  How every layer is filtered.
+		/// @param layers  The number of layers to allocate.
+		///
+		/// @returns       True if the storage was allocated.
+		///
+		////////////////////////////////////////////////////////////
+		bool create(const Vector2i& size, eTextureFormat format, int levels, eWrapMode mode, eFilter filter, int layers);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Deletes the array texture.
+		////////////////////////////////////////////////////////////
+		void destroy();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Allocates a layer of the array.
+		///
+		/// @returns The allocated layer, or -1 if the array is full.
+		///
+		////////////////////////////////////////////////////////////
+		int allocate();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Returns a layer to the array.
+		///
+		/// @param layer  The layer to return.
+		///
+		////////////////////////////////////////////////////////////
+		void release(int layer);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Binds a TextureArray object for use.
+		///
+		/// Binding the array already bound to a location is skipped, so
+		/// materials that share an array share a single bind.
+		///
+		/// @param array     The array to bind.
+		/// @param location  Which location to bind the array to.
+		///
+		////////////////////////////////////////////////////////////
+		static void bind(const TextureArray& array, GLint location = 0);
+	};
+
+} // namespace jackal
+
+#endif//__JACKAL_TEXTURE_ARRAY_HPP__
+
+////////////////////////////////////////////////////////////
+/// @author Benjamin Carter
+///
+/// @class jackal::TextureArray
+/// @ingroup rendering
+///
+/// The jackal::TextureArray is a GL_TEXTURE_2D_ARRAY whose layers
+/// are handed out to textures of the same size, format and sampling.
+/// Every material whose textures share an array binds the same texture
+/// object, the layer is passed to the shader as a uniform instead.
+///
+/// Arrays are created and filled by the TexturePacker, due to the
+/// internal use of the class, it is not exposed to the lua scripting
+/// interface.
+///
+/// @code
+/// using namespace jackal;
+///
+/// int layer = -1;
+/// TextureArray* pArray = TexturePacker::getInstance().pack(Vector2i(512, 512), eTextureFormat::BC1, 10, eWrapMode::REPEAT, eFilter::LINEAR, layer);
+///
+/// TextureArray::bind(*pArray, 0);
+/// @endcode
+///
+////////////////////////////////////////////////////////////
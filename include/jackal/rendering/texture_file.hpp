@@ -0,0 +1,275 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __JACKAL_TEXTURE_FILE_HPP__
+#define __JACKAL_TEXTURE_FILE_HPP__
+
+//====================
+// C++ includes
+//====================
+#include <cstddef>                       // Sizing the data of each level.
+#include <cstdint>                       // Fixed width file headers.
+#include <string>                        // Opening and writing files by name.
+#include <utility>                       // Pairing the size and data of each written level.
+#include <vector>                        // Storing the levels of the texture.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/utils/mapped_file.hpp>  // The levels are read straight from the mapped file.
+#include <jackal/math/vector2.hpp>       // Storing the size of each level.
+
+//====================
+// Additional includes
+//====================
+#include <GL/glew.h>                     // Mapping each format to its OpenGL format.
+
+namespace jackal
+{
+	//====================
+	// Enumerations
+	//====================
+	enum class eTextureFormat : std::uint32_t
+	{
+		RGBA8, ///< Uncompressed, 4 bytes per texel.
+		BC1,   ///< Opaque colour, 0.5 bytes per texel.
+		BC3,   ///< Colour with smooth alpha, 1 byte per texel.
+		BC5,   ///< Two channels, such as normal maps, 1 byte per texel.
+		BC7,   ///< High quality colour and alpha, 1 byte per texel.
+		COUNT  ///< The number of formats.
+	};
+
+	class TextureFile final : NonCopyable
+	{
+	public:
+		//====================
+		// Static variables
+		//====================
+		static const std::uint32_t MAGIC      = 0x5845544Au; ///< Identifies a cooked texture file, "JTEX".
+		static const std::uint32_t VERSION    = 1;           ///< The version of the cooked texture file layout.
+		static const unsigned int  MAX_LEVELS = 16;          ///< The maximum number of mip levels within a file.
+
+		//====================
+		// Structures
+		//====================
+		struct Level_t
+		{
+			Vector2i             size;  ///< The width and height of the level, in texels.
+			const unsigned char* pData; ///< The encoded blocks of the level.
+			std::size_t          bytes; ///< The size of the encoded blocks, in bytes.
+		};
+
+	private:
+		//====================
+		// Structures
+		//====================
+		struct Header_t
+		{
+			std::uint32_t magic;   ///< Always MAGIC.
+			std::uint32_t version; ///< The layout version the file was written with.
+			std::uint32_t format;  ///< The eTextureFormat of every level.
+			std::uint32_t width;   ///< The width of the largest level.
+			std::uint32_t height;  ///< The height of the largest level.
+			std::uint32_t levels;  ///< The number of mip levels that follow the header.
+		};
+
+		struct LevelHeader_t
+		{
+			std::uint32_t width;  ///< The width of the level.
+			std::uint32_t height; ///< The height of the level.
+			std::uint64_t offset; ///< The offset of the level from the start of the file.
+			std::uint64_t size;   ///< The size of the level, in bytes.
+		};
+
+		//====================
+		// Member variables
+		//====================
+		MappedFile           m_file;   ///< The mapped contents of the file.
+		eTextureFormat       m_format; ///< The format of every level.
+		std::vector<Level_t> m_levels; ///< The mip levels, starting with the largest.
+
+	public:
+		//====================
+		// Ctor and dtor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Default constructor for the TextureFile object.
+		////////////////////////////////////////////////////////////
+		explicit TextureFile();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Default destructor for the TextureFile object.
+		////////////////////////////////////////////////////////////
+		~TextureFile() = default;
+
+		//====================
+		// Getters and setters
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the format of the levels.
+		///
+		/// @returns The format every level is encoded in.
+		///
+		////////////////////////////////////////////////////////////
+		eTextureFormat getFormat() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the size of the largest level.
+		///
+		/// @returns The width and height of the texture, in texels.
+		///
+		////////////////////////////////////////////////////////////
+		Vector2i getSize() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the mip levels of the texture.
+		///
+		/// The data of each level points into the mapped file, it is
+		/// only valid while the file is open.
+		///
+		/// @returns The levels, starting with the largest.
+		///
+		////////////////////////////////////////////////////////////
+		const std::vector<Level_t>& getLevels() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the combined size of every level.
+		///
+		/// @returns The number of bytes uploaded to the GPU.
+		///
+		////////////////////////////////////////////////////////////
+		std::size_t getDataSize() const;
+
+		//====================
+		// Methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Maps and validates a cooked texture file.
+		///
+		/// The header and level table are validated against the size
+		/// of the file, no texel data is read. This method can make use
+		/// of the virtual file system.
+		///
+		/// @param filename  The file name of the .jtex file.
+		///
+		/// @returns         True if the file is a valid cooked texture.
+		///
+		////////////////////////////////////////////////////////////
+		bool open(const std::string& filename);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Unmaps the file and clears the levels.
+		////////////////////////////////////////////////////////////
+		void close();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Writes a cooked texture file.
+		///
+		/// The data of each level is aligned to 16 bytes within the file.
+		///
+		/// @param filename  The path of the file to write.
+		/// @param format    The format the levels are encoded in.
+		/// @param levels    The size and encoded data of each level, starting with the largest.
+		///
+		/// @returns         True if the file was written.
+		///
+		////////////////////////////////////////////////////////////
+		static bool write(const std::string& filename, eTextureFormat format,
+			const std::vector<std::pair<Vector2i, std::vector<unsigned char>>>& levels);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Calculates the encoded size of a level.
+		///
+		/// Block compressed formats encode 4x4 texels at a time, so the
+		/// size is rounded up to whole blocks.
+		///
+		/// @param format  The format of the level.
+		/// @param size    The width and height of the level, in texels.
+		///
+		/// @returns       The size of the encoded level, in bytes.
+		///
+		////////////////////////////////////////////////////////////
+		static std::size_t getLevelSize(eTextureFormat format, const Vector2i& size);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the internal OpenGL format of a format.
+		///
+		/// @param format  The format to convert.
+		///
+		/// @returns       The internal format passed to glCompressedTexImage2D.
+		///
+		////////////////////////////////////////////////////////////
+		static GLenum getInternalFormat(eTextureFormat format);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves whether the driver can sample a format.
+		///
+		/// This must be invoked on the thread that owns the context.
+		///
+		/// @param format  The format to query.
+		///
+		/// @returns       True if textures of the format can be uploaded.
+		///
+		////////////////////////////////////////////////////////////
+		static bool isSupported(eTextureFormat format);
+	};
+
+} // namespace jackal
+
+#endif//__JACKAL_TEXTURE_FILE_HPP__
+
+////////////////////////////////////////////////////////////
+/// @author Benjamin Carter
+///
+/// @class jackal::TextureFile
+/// @ingroup rendering
+///
+/// The jackal::TextureFile reads the .jtex files written by the
+/// jackal_texcook tool. A .jtex file holds a texture that has already
+/// been block compressed and mipmapped offline, so loading it is a
+/// matter of mapping the file and handing each level to
+/// glCompressedTexImage2D, no decoding or mipmap generation is done
+/// at runtime. BC1 uses an eighth of the memory of RGBA8, BC3, BC5
+/// and BC7 a quarter.
+///
+/// Textures load .jtex files automatically when their image has the
+/// .jtex extension. Due to the low level aspects of the class, it is
+/// not exposed to the lua scripting interface.
+///
+/// @code
+/// using namespace jackal;
+///
+/// TextureFile file;
+/// if (file.open("~assets/textures/crate.jtex"))
+/// {
+///		GLenum format = TextureFile::getInternalFormat(file.getFormat());
+///		for (std::size_t i = 0; i < file.getLevels().size(); ++i)
+///		{
+///			const auto& level = file.getLevels()[i];
+///			glCompressedTexImage2D(GL_TEXTURE_2D, i, format, level.size.x, level.size.y, 0, level.bytes, level.pData);
+///		}
+/// }
+/// @endcode
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,200 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __JACKAL_TEXTURE_PACKER_HPP__
+#define __JACKAL_TEXTURE_PACKER_HPP__
+
+//====================
+// C++ includes
+//====================
+#include <memory>                             // Owning each array texture.
+#include <mutex>                              // Layers are released from the game thread.
+#include <vector>                             // Storing the array textures.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/utils/singleton.hpp>         // TexturePacker is a singleton object.
+#include <jackal/rendering/texture_array.hpp> // The array textures the textures are packed into.
+
+namespace jackal
+{
+	//====================
+	// Forward declarations
+	//====================
+	class ConfigFile;
+
+	class TexturePacker final : public Singleton<TexturePacker>
+	{
+	private:
+		//====================
+		// Friend classes
+		//====================
+		friend class Singleton<TexturePacker>;
+
+		//====================
+		// Member variables
+		//====================
+		std::vector<std::unique_ptr<TextureArray>> m_arrays;      ///< The array textures that have been created.
+		TextureArray                               m_placeholder; ///< The array bound in place of textures that haven't been uploaded.
+		bool                                       m_enabled;     ///< Whether textures are packed into arrays.
+		unsigned int                               m_layers;      ///< The most layers allocated within each array.
+		unsigned int                               m_bytes;       ///< The most bytes allocated by each array.
+		std::mutex                                 m_mutex;       ///< Locks the array textures.
+
+	private:
+		//====================
+		// Ctor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Default constructor for the TexturePacker object.
+		///
+		/// Textures aren't packed until the packer is created.
+		///
+		////////////////////////////////////////////////////////////
+		explicit TexturePacker();
+
+	public:
+		//====================
+		// Dtor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Default destructor for the TexturePacker object.
+		////////////////////////////////////////////////////////////
+		~TexturePacker() = default;
+
+		//====================
+		// Getters and setters
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves whether textures are packed into arrays.
+		///
+		/// @returns True if packing is enabled within the config file.
+		///
+		////////////////////////////////////////////////////////////
+		bool isEnabled() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the array bound in place of textures that haven't been uploaded.
+		///
+		/// The placeholder is a single white layer, so materials keep
+		/// their colour while the image is loading.
+		///
+		/// @returns The placeholder array texture.
+		///
+		////////////////////////////////////////////////////////////
+		const TextureArray& getPlaceholder() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the number of array textures created.
+		///
+		/// @returns The number of array textures.
+		///
+		////////////////////////////////////////////////////////////
+		std::size_t getArrayCount();
+
+		//====================
+		// Methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Creates the placeholder array texture.
+		///
+		/// The settings are read from the TexturePacker section.
+		///
+		/// @param config  The config file to read the settings from.
+		///
+		////////////////////////////////////////////////////////////
+		void create(const ConfigFile& config);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Destroys every array texture.
+		////////////////////////////////////////////////////////////
+		void destroy();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Allocates a layer for a texture.
+		///
+		/// This must be invoked on the render thread. The layer is taken
+		/// from an array with the same size, format and sampling as the
+		/// texture, a new array is created when every matching array is
+		/// full.
+		///
+		/// @param size    The width and height of the texture.
+		/// @param format  The format of the texture.
+		/// @param levels  The number of mip levels of the texture.
+		/// @param mode    The wrap mode of the texture.
+		/// @param filter  The filter of the texture.
+		/// @param layer   Receives the allocated layer.
+		///
+		/// @returns       The array the layer belongs to, or null if no array could be created.
+		///
+		////////////////////////////////////////////////////////////
+		TextureArray* pack(const Vector2i& size, eTextureFormat format, int levels, eWrapMode mode, eFilter filter, int& layer);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Returns the layer of a texture to its array.
+		///
+		/// Releasing a layer of an array that has been destroyed is
+		/// ignored, so textures may outlive the packer.
+		///
+		/// @param pArray  The array the layer belongs to.
+		/// @param layer   The layer to return.
+		///
+		////////////////////////////////////////////////////////////
+		void release(TextureArray* pArray, int layer);
+	};
+
+} // namespace jackal
+
+#endif//__JACKAL_TEXTURE_PACKER_HPP__
+
+////////////////////////////////////////////////////////////
+/// @author Benjamin Carter
+///
+/// @class jackal::TexturePacker
+/// @ingroup rendering
+///
+/// The jackal::TexturePacker groups textures into array textures as
+/// they are uploaded. Textures with the same size, format, mip levels
+/// and sampling are given a layer of the same GL_TEXTURE_2D_ARRAY, so
+/// materials whose textures were packed together bind the same
+/// texture objects and only differ by the layers passed to the shader.
+/// Consecutive draws of those materials skip the texture binds, and
+/// can be batched or instanced.
+///
+/// Textures opt out with "pack": false within their description,
+/// shaders sample packed textures when compiled with the DIFFUSE_ARRAY
+/// and SPECULAR_ARRAY keywords. Due to the internal use of the class,
+/// it is not exposed to the lua scripting interface.
+///
+/// @code
+/// using namespace jackal;
+///
+/// TexturePacker::getInstance().create(config);
+///
+/// // The diffuse and specular textures are packed once uploaded.
+/// auto material = Material::find("~assets/materials/box-material.json");
+/// @endcode
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,264 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __JACKAL_TEXTURE_STREAMER_HPP__
+#define __JACKAL_TEXTURE_STREAMER_HPP__
+
+//====================
+// C++ includes
+//====================
+#include <cstdint>                           // Counting the resident bytes and frames.
+#include <memory>                            // Sharing the cooked texture files with the uploads.
+#include <mutex>                             // Levels are marked resident from the render thread.
+#include <unordered_map>                     // Storing the residency of each streamed texture.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/utils/singleton.hpp>        // TextureStreamer is a singleton object.
+#include <jackal/rendering/texture_file.hpp> // Streaming the levels of cooked textures.
+
+namespace jackal
+{
+	//====================
+	// Forward declarations
+	//====================
+	class ConfigFile;
+	class Texture;
+
+	class TextureStreamer final : public Singleton<TextureStreamer>
+	{
+	private:
+		//====================
+		// Friend classes
+		//====================
+		friend class Singleton<TextureStreamer>;
+
+		//====================
+		// Structures
+		//====================
+		struct Streamed_t
+		{
+			Texture*                           pTexture; ///< The texture the levels are streamed into.
+			std::shared_ptr<const TextureFile> pFile;    ///< The mapped levels of the cooked image.
+			int                                resident; ///< The largest level that is resident.
+			int                                floor;    ///< The largest level that is always resident.
+			int                                wanted;   ///< The largest level requested since the last update.
+			bool                               pending;  ///< Whether an upload of the texture is queued.
+			std::uint64_t                      bytes;    ///< The bytes of the levels resident or queued.
+			std::uint64_t                      used;     ///< The frame the texture was last requested.
+		};
+
+		//====================
+		// Member variables
+		//====================
+		std::unordered_map<const Texture*, Streamed_t> m_textures;     ///< The residency of each streamed texture.
+		std::uint64_t                                  m_budget;       ///< The bytes of streamed levels that may be resident.
+		std::uint64_t                                  m_resident;     ///< The bytes of streamed levels resident or queued.
+		unsigned int                                   m_residentSize; ///< Levels no larger than this are always resident.
+		std::uint64_t                                  m_frame;        ///< The number of updates, used to order textures by use.
+		std::mutex                                     m_mutex;        ///< Locks the residency of the textures.
+
+	private:
+		//====================
+		// Ctor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Default constructor for the TextureStreamer object.
+		///
+		/// Textures aren't streamed until the streamer is created with
+		/// a budget.
+		///
+		////////////////////////////////////////////////////////////
+		explicit TextureStreamer();
+
+		//====================
+		// Private methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the bytes of the levels from a level onwards.
+		///
+		/// @param file   The cooked image to measure.
+		/// @param first  The first level to measure.
+		///
+		/// @returns      The bytes of the first level and every smaller level.
+		///
+		////////////////////////////////////////////////////////////
+		static std::uint64_t getTailSize(const TextureFile& file, int first);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Evicts the largest level of the least recently used texture.
+		///
+		/// Only textures used before the texture that is being promoted,
+		/// or holding more levels than were requested, are evicted.
+		///
+		/// @param promoted  The texture that needs the memory.
+		///
+		/// @returns         True if a level was evicted.
+		///
+		////////////////////////////////////////////////////////////
+		bool evict(const Streamed_t& promoted);
+
+	public:
+		//====================
+		// Dtor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Default destructor for the TextureStreamer object.
+		////////////////////////////////////////////////////////////
+		~TextureStreamer() = default;
+
+		//====================
+		// Getters and setters
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves whether cooked textures are streamed.
+		///
+		/// @returns True if a texture budget is set within the config file.
+		///
+		////////////////////////////////////////////////////////////
+		bool isEnabled() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the bytes of streamed levels resident or queued.
+		///
+		/// @returns The bytes held against the budget.
+		///
+		////////////////////////////////////////////////////////////
+		std::uint64_t getResidentBytes();
+
+		//====================
+		// Methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Loads the budget from the config file.
+		///
+		/// The settings are read from the ContextSettings section, a
+		/// budget of zero disables streaming.
+		///
+		/// @param config  The config file to read the settings from.
+		///
+		////////////////////////////////////////////////////////////
+		void create(const ConfigFile& config);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Stops tracking every streamed texture.
+		////////////////////////////////////////////////////////////
+		void destroy();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Begins streaming a cooked image into a texture.
+		///
+		/// Only the levels no larger than the resident size are queued
+		/// for upload, the larger levels are streamed in once requested.
+		/// This is invoked from the worker threads that map images.
+		///
+		/// @param texture  The texture the image is streamed into.
+		/// @param pFile    The opened .jtex file of the image.
+		///
+		////////////////////////////////////////////////////////////
+		void add(Texture& texture, std::shared_ptr<const TextureFile> pFile);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Stops streaming a texture.
+		///
+		/// This is invoked when a texture is reloaded or destroyed, its
+		/// levels are no longer held against the budget.
+		///
+		/// @param texture  The texture to stop streaming.
+		///
+		////////////////////////////////////////////////////////////
+		void remove(const Texture& texture);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Requests the resolution a texture is sampled at.
+		///
+		/// The size is the number of pixels the texture covers on screen,
+		/// the smallest level that still covers them is streamed in.
+		///
+		/// @param texture  The texture that is visible.
+		/// @param pixels   The number of pixels across the texture covers.
+		///
+		////////////////////////////////////////////////////////////
+		void request(const Texture& texture, float pixels);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Marks a level of a texture as resident.
+		///
+		/// This is invoked by the TextureUploader on the render thread.
+		///
+		/// @param texture  The texture that was uploaded.
+		/// @param level    The largest level that was uploaded.
+		///
+		////////////////////////////////////////////////////////////
+		void onUploaded(const Texture& texture, int level);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Streams the levels requested since the last update.
+		///
+		/// This should be invoked once per frame, after the visible
+		/// objects have requested their textures. Each texture is
+		/// promoted by at most one level a frame, when the budget is
+		/// exceeded the least recently used textures are demoted.
+		///
+		////////////////////////////////////////////////////////////
+		void update();
+	};
+
+} // namespace jackal
+
+#endif//__JACKAL_TEXTURE_STREAMER_HPP__
+
+////////////////////////////////////////////////////////////
+/// @author Benjamin Carter
+///
+/// @class jackal::TextureStreamer
+/// @ingroup rendering
+///
+/// The jackal::TextureStreamer keeps the mip levels of cooked textures
+/// resident only while they are needed. A texture loads its smallest
+/// levels up front, each frame the visible objects request the size
+/// they cover on screen and the larger levels are uploaded one at a
+/// time. The resident levels are held under the budget, when a level
+/// doesn't fit the largest level of the least recently used texture
+/// is freed.
+///
+/// Due to the internal use of the class, it is not exposed to the
+/// lua scripting interface.
+///
+/// @code
+/// using namespace jackal;
+///
+/// TextureStreamer::getInstance().create(config);
+///
+/// // Once per frame, after culling.
+/// if (culler.isVisible(index))
+/// {
+///		material->request(culler.getScreenSize(index, camera.getViewProjection(), screenSize));
+/// }
+///
+/// TextureStreamer::getInstance().update();
+/// @endcode
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,274 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __JACKAL_TEXTURE_UPLOADER_HPP__
+#define __JACKAL_TEXTURE_UPLOADER_HPP__
+
+//====================
+// C++ includes
+//====================
+#include <deque>                              // Storing the decoded images waiting to be uploaded.
+#include <memory>                             // Sharing the cooked texture files with the uploads.
+#include <mutex>                              // Images are queued from the worker threads.
+#include <vector>                             // Storing the pixels of each decoded image.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/utils/singleton.hpp>         // TextureUploader is a singleton object.
+#include <jackal/math/vector2.hpp>            // Storing the size of each decoded image.
+#include <jackal/rendering/stream_buffer.hpp> // Staging the pixels within a pixel buffer object.
+#include <jackal/rendering/texture_file.hpp>  // Uploading the levels of cooked textures.
+
+//====================
+// Additional includes
+//====================
+#include <GL/glew.h>                          // Uploading the images to their textures.
+
+namespace jackal
+{
+	//====================
+	// Forward declarations
+	//====================
+	class ConfigFile;
+	class Texture;
+
+	class TextureUploader final : public Singleton<TextureUploader>
+	{
+	private:
+		//====================
+		// Friend classes
+		//====================
+		friend class Singleton<TextureUploader>;
+
+		//====================
+		// Structures
+		//====================
+		struct Upload_t
+		{
+			Texture*                           pTexture; ///< The texture the image is uploaded to.
+			Vector2i                           size;     ///< The width and height of the image.
+			std::vector<unsigned char>         pixels;   ///< The tightly packed RGBA pixels of a decoded image.
+			std::shared_ptr<const TextureFile> pFile;    ///< The mapped levels of a cooked image, null for decoded images.
+			int                                first;    ///< The first level of the cooked image to upload.
+			int                                last;     ///< One past the last level of the cooked image to upload.
+		};
+
+		//====================
+		// Member variables
+		//====================
+		std::deque<Upload_t> m_uploads;     ///< The decoded images waiting to be uploaded.
+		StreamBuffer         m_buffer;      ///< The pixel buffer object the images are staged within.
+		GLuint               m_placeholder; ///< The texture bound in place of textures that haven't been uploaded.
+		unsigned int         m_budget;      ///< The number of bytes uploaded each frame, zero is unlimited.
+		std::mutex           m_mutex;       ///< Locks the queue of images.
+
+	private:
+		//====================
+		// Ctor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Default constructor for the TextureUploader object.
+		///
+		/// Images are uploaded from client memory without a budget until
+		/// the uploader is created.
+		///
+		////////////////////////////////////////////////////////////
+		explicit TextureUploader();
+
+		//====================
+		// Private methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Uploads the queued images until the budget is spent.
+		///
+		/// This must be invoked on the render thread. At least one image
+		/// is uploaded each frame, so an image larger than the budget is
+		/// never stuck within the queue.
+		///
+		////////////////////////////////////////////////////////////
+		void drain();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Uploads a single image to its texture.
+		///
+		/// Staged pixels are copied into the pixel buffer object, so the
+		/// driver transfers them asynchronously. Images that don't fit
+		/// within the remainder of the frame are uploaded directly from
+		/// client memory.
+		///
+		/// @param upload  The decoded image to upload.
+		/// @param staged  Whether to stage the pixels within the pixel buffer object.
+		///
+		////////////////////////////////////////////////////////////
+		void upload(const Upload_t& upload, bool staged);
+
+	public:
+		//====================
+		// Dtor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Default destructor for the TextureUploader object.
+		////////////////////////////////////////////////////////////
+		~TextureUploader() = default;
+
+		//====================
+		// Getters and setters
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the texture bound in place of textures that haven't been uploaded.
+		///
+		/// The placeholder is a single white pixel, so materials keep
+		/// their colour while the image is loading.
+		///
+		/// @returns The ID of the placeholder texture.
+		///
+		////////////////////////////////////////////////////////////
+		GLuint getPlaceholder() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the number of images waiting to be uploaded.
+		///
+		/// @returns The number of decoded images within the queue.
+		///
+		////////////////////////////////////////////////////////////
+		std::size_t getPending();
+
+		//====================
+		// Methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Creates the placeholder texture and pixel buffer object.
+		///
+		/// The settings are read from the TextureUpload section, the pixel
+		/// buffer object is sized to the per-frame budget.
+		///
+		/// @param config  The config file to read the settings from.
+		///
+		////////////////////////////////////////////////////////////
+		void create(const ConfigFile& config);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Destroys the placeholder texture and pixel buffer object.
+		///
+		/// Any images still waiting to be uploaded are discarded.
+		///
+		////////////////////////////////////////////////////////////
+		void destroy();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Queues a decoded image to be uploaded to a texture.
+		///
+		/// This is invoked from the worker threads that decode images.
+		///
+		/// @param texture  The texture the image is uploaded to.
+		/// @param size     The width and height of the image.
+		/// @param pixels   The tightly packed RGBA pixels of the image.
+		///
+		////////////////////////////////////////////////////////////
+		void queue(Texture& texture, const Vector2i& size, std::vector<unsigned char> pixels);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Queues a cooked image to be uploaded to a texture.
+		///
+		/// The levels are uploaded straight from the mapped file, the
+		/// file is closed once the upload has completed.
+		///
+		/// @param texture  The texture the image is uploaded to.
+		/// @param pFile    The opened .jtex file of the image.
+		///
+		////////////////////////////////////////////////////////////
+		void queue(Texture& texture, std::shared_ptr<const TextureFile> pFile);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Queues a range of levels of a cooked image to be uploaded.
+		///
+		/// The levels before the range are left out of the texture, the
+		/// base level is moved to the first level uploaded. This is used
+		/// to stream in the larger levels of a texture on demand.
+		///
+		/// @param texture  The texture the image is uploaded to.
+		/// @param pFile    The opened .jtex file of the image.
+		/// @param first    The first level to upload.
+		/// @param last     One past the last level to upload.
+		///
+		////////////////////////////////////////////////////////////
+		void queue(Texture& texture, std::shared_ptr<const TextureFile> pFile, int first, int last);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Discards the queued images of a texture.
+		///
+		/// This is invoked when a texture is reloaded or destroyed before
+		/// its image has been uploaded.
+		///
+		/// @param texture  The texture whose images to discard.
+		///
+		////////////////////////////////////////////////////////////
+		void cancel(const Texture& texture);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Uploads the queued images for the current frame.
+		///
+		/// This should be invoked once per frame, the uploads are
+		/// executed on the render thread.
+		///
+		////////////////////////////////////////////////////////////
+		void update();
+	};
+
+} // namespace jackal
+
+#endif//__JACKAL_TEXTURE_UPLOADER_HPP__
+
+////////////////////////////////////////////////////////////
+/// @author Benjamin Carter
+///
+/// @class jackal::TextureUploader
+/// @ingroup rendering
+///
+/// The jackal::TextureUploader moves decoded images onto the GPU.
+/// Textures decode their images on the ThreadPool and queue the
+/// pixels here, each frame the render thread stages as many images
+/// as the byte budget allows within a pixel buffer object and uploads
+/// them with glTexImage2D. Cooked .jtex images skip decoding, their
+/// compressed levels are uploaded with glCompressedTexImage2D. Loading a level therefore never blocks on
+/// decoding or uploading, textures bind the placeholder until their
+/// image has been uploaded.
+///
+/// Due to the internal use of the class, it is not exposed to the
+/// lua scripting interface.
+///
+/// @code
+/// using namespace jackal;
+///
+/// TextureUploader::getInstance().create(config);
+///
+/// // Returns straight away, the image is decoded on a worker thread.
+/// auto texture = Texture::find("~assets/textures/crate.json");
+///
+/// // Once per frame.
+/// TextureUploader::getInstance().update();
+/// @endcode
+///
+////////////////////////////////////////////////////////////
@@ -40,6 +40,7 @@
 #include <jackal/math/matrix4.hpp>             // Passing Matrix4 objects as uniforms.
 #include <jackal/math/colour.hpp>              // Passing Colour objects as uniforms.
 #include <jackal/utils/ext/json.hpp>          // Setting uniforms by the value of Json values.
+#include <jackal/rendering/render_statistics.hpp> // Counting the uniforms set.
 
 //====================
 // Additional includes
@@ -65,11 +66,23 @@ namespace jackal
 		static const std::string MATERIAL_SPECULAR_TEXTURE;///< The material specular texture uniform name.
 		static const std::string MATERIAL_DIFFUSE_COLOUR;  ///< The material colour uniform name.
 		static const std::string MATERIAL_SHININESS;       ///< The material shininess uniform name.
+		static const std::string MATERIAL_DIFFUSE_LAYER;   ///< The material diffuse array layer uniform name.
+		static const std::string MATERIAL_SPECULAR_LAYER;  ///< The material specular array layer uniform name.
 		// DirectionalLight uniforms
 		static const std::string DIRECTIONAL_LIGHT_COLOUR;      ///< The directional light colour uniform name.
 		static const std::string DIRECTIONAL_LIGHT_SPECULARITY; ///< The directional light specularity uniform name.
 		static const std::string DIRECTIONAL_LIGHT_INTENSITY;   ///< The directional light intensity uniform name.
 		static const std::string DIRECTIONAL_LIGHT_DIRECTION;   ///< The directional light direction uniform name.
+		// Camera uniforms
+		static const std::string VIEW;                          ///< The view matrix uniform name.
+		static const std::string VIEW_POSITION;                 ///< The camera position uniform name.
+		// ClusteredLighting uniforms
+		static const std::string CLUSTER_LIGHTS;                ///< The packed light data buffer texture uniform name.
+		static const std::string CLUSTER_GRID;                  ///< The cluster offset and count buffer texture uniform name.
+		static const std::string CLUSTER_INDICES;               ///< The cluster light index buffer texture uniform name.
+		static const std::string CLUSTER_SCREEN_SIZE;           ///< The size of the screen the clusters divide uniform name.
+		static const std::string CLUSTER_NEAR;                  ///< The depth of the first cluster slice uniform name.
+		static const std::string CLUSTER_SLICE_SCALE;           ///< The depth to cluster slice scale uniform name.
 	};
 
 	class Uniform final
@@ -335,6 +348,7 @@ namespace jackal
 	template <typename T>
 	void Uniform::setParameter(const std::string& uniform, T value)
 	{
+		RenderStatistics::getInstance().add(eRenderCounter::UNIFORM_CALLS);
 		this->set(this->getLocation(uniform), std::forward<T>(value));
 	}
 
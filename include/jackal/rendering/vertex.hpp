@@ -30,6 +30,8 @@
 //====================
 #include <jackal/math/vector3.hpp> // The position of the vertex.
 #include <jackal/math/vector2.hpp> // The uv co-ordinates of the vertex.
+#include <jackal/math/vector4.hpp> // The tangent of the vertex.
+#include <jackal/math/colour.hpp>  // The colour of the vertex.
 
 namespace jackal
 {
@@ -41,6 +43,8 @@ namespace jackal
 		Vector3f position;  ///< The position of the vertex in 3D space. 
 		Vector3f normal;    ///< The vertex normal.
 		Vector2f uv;        ///< The uv co-ordinate of the vertex.
+		Vector4f tangent;   ///< The vertex tangent, w is the handedness of the bitangent.
+		Colour   colour;    ///< The colour of the vertex.
 
 		//====================
 		// Ctor and dtor
@@ -48,12 +52,13 @@ namespace jackal
 		////////////////////////////////////////////////////////////
 		/// @brief Default constructor for the Vertex_t object.
 		///
-		/// The default constructor will set the position, normals and
-		/// uv's to blank vectors, with elements equalling 0.
+		/// The default constructor will set the position, normals,
+		/// uv's and tangent to blank vectors, with elements equalling 0.
+		/// The colour is white.
 		///
 		////////////////////////////////////////////////////////////
 		explicit Vertex_t()
-			: position(), normal(), uv()
+			: position(), normal(), uv(), tangent(), colour()
 		{
 		}
 
@@ -69,7 +74,7 @@ namespace jackal
 		///
 		////////////////////////////////////////////////////////////
 		explicit Vertex_t(const Vector3f& position, const Vector2f& uv)
-			: position(position), normal(), uv(uv)
+			: position(position), normal(), uv(uv), tangent(), colour()
 		{
 		}
 
@@ -85,7 +90,7 @@ namespace jackal
 		///
 		////////////////////////////////////////////////////////////
 		explicit Vertex_t(const Vector3f& position, const Vector3f& normal, const Vector2f& uv)
-			: position(position), normal(normal), uv(uv)
+			: position(position), normal(normal), uv(uv), tangent(), colour()
 		{
 		}
 	};
@@ -101,8 +106,10 @@ namespace jackal
 /// @ingroup rendering
 ///
 /// The jackal::Vertex_t is a basic struct that is basis of every
-/// mesh within the application. It defines the meshes position, normals
-/// and UV co-ordinates. Due to its simplicity and internal use, an example
+/// mesh within the application. It defines the meshes position, normals,
+/// UV co-ordinates, tangent and colour. The vertices are encoded into a
+/// VertexLayout when they are uploaded, so only the attributes the layout
+/// stores reach the GPU. Due to its simplicity and internal use, an example
 /// is not provided and it is not exposed to the lua scripting
 /// interface.
 ///
@@ -0,0 +1,310 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __JACKAL_VERTEX_LAYOUT_HPP__
+#define __JACKAL_VERTEX_LAYOUT_HPP__
+
+//====================
+// C++ includes
+//====================
+#include <array>   // Storing the format of each attribute.
+#include <cstdint> // Packing the layout into a cooked file.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/rendering/vertex.hpp>  // Encoding vertices into the layout.
+#include <jackal/math/bounding_box.hpp> // The box positions are quantised within.
+#include <jackal/math/vector3.hpp>      // The scale and offset of quantised positions.
+
+//====================
+// Additional includes
+//====================
+#include <GL/glew.h> // Specifying the vertex attribute pointers.
+
+namespace jackal
+{
+	//====================
+	// Enumerations
+	//====================
+	enum class eVertexAttribute
+	{
+		POSITION, ///< Location 0, the position of the vertex.
+		NORMAL,   ///< Location 1, the vertex normal.
+		UV,       ///< Location 2, the uv co-ordinate of the vertex.
+		TANGENT,  ///< Location 3, the tangent of the vertex, w holds the handedness of the bitangent.
+		COLOUR,   ///< Location 4, the colour of the vertex.
+		COUNT
+	};
+
+	enum class eVertexFormat
+	{
+		NONE,            ///< The attribute is not stored.
+		FLOAT2,          ///< Two 32-bit floats. (8 bytes)
+		FLOAT3,          ///< Three 32-bit floats. (12 bytes)
+		FLOAT4,          ///< Four 32-bit floats. (16 bytes)
+		HALF2,           ///< Two 16-bit floats. (4 bytes)
+		HALF4,           ///< Four 16-bit floats. (8 bytes)
+		SNORM16_2,       ///< Two normalised 16-bit integers, normals are octahedral encoded. (4 bytes)
+		SNORM16_4,       ///< Four normalised 16-bit integers, positions are quantised within a box. (8 bytes)
+		SNORM10_10_10_2, ///< Three normalised 10-bit integers and a 2-bit integer. (4 bytes)
+		UNORM8_4         ///< Four normalised 8-bit integers. (4 bytes)
+	};
+
+	class VertexLayout final
+	{
+	public:
+		//====================
+		// Static variables
+		//====================
+		static const int    ATTRIBUTE_COUNT = static_cast<int>(eVertexAttribute::COUNT); ///< The number of attributes a layout can store.
+		static const GLuint DECODE_LOCATION = 5;                                         ///< The first attribute location of the decode constants.
+
+		//====================
+		// Structures
+		//====================
+		struct Decode_t
+		{
+			Vector3f scale;      ///< Multiplies the stored position, location 5.
+			Vector3f offset;     ///< Added to the scaled position, location 6.
+			float    octahedral; ///< 1 if the normals are octahedral encoded, location 7.
+		};
+
+	private:
+		//====================
+		// Member variables
+		//====================
+		std::array<eVertexFormat, ATTRIBUTE_COUNT> m_formats; ///< The format of each attribute, NONE if it isn't stored.
+		std::array<GLuint, ATTRIBUTE_COUNT>        m_offsets; ///< The byte offset of each attribute within a vertex.
+		GLsizei                                    m_stride;  ///< The size of a single vertex in bytes.
+
+	public:
+		//====================
+		// Ctor and dtor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Default constructor for the VertexLayout object.
+		///
+		/// The default layout doesn't store any attributes, they must
+		/// be added with set.
+		///
+		////////////////////////////////////////////////////////////
+		explicit VertexLayout();
+
+		//====================
+		// Operators
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Checks whether two layouts store the same attributes in the same formats.
+		///
+		/// @param layout  The layout to compare against.
+		///
+		/// @returns       True if vertices of one layout can be read with the other.
+		///
+		////////////////////////////////////////////////////////////
+		bool operator==(const VertexLayout& layout) const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Checks whether two layouts differ.
+		///
+		/// @param layout  The layout to compare against.
+		///
+		/// @returns       True if the layouts are not equal.
+		///
+		////////////////////////////////////////////////////////////
+		bool operator!=(const VertexLayout& layout) const;
+
+		//====================
+		// Getters and setters
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Sets the format an attribute is stored with.
+		///
+		/// The attributes are always stored in the order of the
+		/// eVertexAttribute enumeration, so the offsets are recalculated.
+		/// Only the formats that make sense for an attribute are accepted,
+		/// eVertexFormat::NONE removes the attribute.
+		///
+		/// @param attribute  The attribute to store.
+		/// @param format     The format to store the attribute with.
+		///
+		/// @returns          False if the format cannot store the attribute.
+		///
+		////////////////////////////////////////////////////////////
+		bool set(eVertexAttribute attribute, eVertexFormat format);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the format an attribute is stored with.
+		///
+		/// @param attribute  The attribute to retrieve the format of.
+		///
+		/// @returns          The format, eVertexFormat::NONE if the attribute isn't stored.
+		///
+		////////////////////////////////////////////////////////////
+		eVertexFormat getFormat(eVertexAttribute attribute) const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the size of a single vertex.
+		///
+		/// @returns The distance in bytes between consecutive vertices.
+		///
+		////////////////////////////////////////////////////////////
+		GLsizei getStride() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the constants that decode the stored vertices.
+		///
+		/// Quantised positions are stored relative to the box they were
+		/// encoded within, so the same box must be passed here.
+		///
+		/// @param frame  The box the positions were quantised within.
+		///
+		/// @returns      The scale, offset and normal encoding of the layout.
+		///
+		////////////////////////////////////////////////////////////
+		Decode_t getDecode(const BoundingBox& frame) const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Checks whether the positions are quantised within a box.
+		///
+		/// @returns True if the positions are stored as eVertexFormat::SNORM16_4.
+		///
+		////////////////////////////////////////////////////////////
+		bool isQuantised() const;
+
+		//====================
+		// Methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Specifies the attribute pointers of the layout.
+		///
+		/// The attributes are read from the currently bound vertex
+		/// buffer, the attributes the layout doesn't store are disabled
+		/// so the shader reads their constant value instead.
+		///
+		////////////////////////////////////////////////////////////
+		void apply() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Encodes vertices into the layout.
+		///
+		/// @param pVertices  The vertices to encode.
+		/// @param count      The number of vertices to encode.
+		/// @param frame      The box to quantise the positions within.
+		/// @param pOutput    Storage for count * getStride() bytes.
+		///
+		////////////////////////////////////////////////////////////
+		void encode(const Vertex_t* pVertices, int count, const BoundingBox& frame, void* pOutput) const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Packs the layout into a single integer.
+		///
+		/// Each attribute takes four bits, in the order of the
+		/// eVertexAttribute enumeration.
+		///
+		/// @returns The packed formats of the layout.
+		///
+		////////////////////////////////////////////////////////////
+		std::uint32_t pack() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Unpacks a layout that was packed with pack.
+		///
+		/// @param packed  The packed formats.
+		/// @param layout  The unpacked layout.
+		///
+		/// @returns       False if the packed value doesn't describe a valid layout.
+		///
+		////////////////////////////////////////////////////////////
+		static bool unpack(std::uint32_t packed, VertexLayout& layout);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Sets the decode constants of the next draws.
+		///
+		/// The constants are generic vertex attributes, so they are not
+		/// part of any vertex array and apply to every draw until they
+		/// are set again.
+		///
+		/// @param decode  The constants retrieved from getDecode.
+		///
+		////////////////////////////////////////////////////////////
+		static void applyDecode(const Decode_t& decode);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the full precision layout.
+		///
+		/// The layout matches Vertex_t without its tangent and colour,
+		/// float positions, normals and uv's. (32 bytes)
+		///
+		/// @returns The standard layout.
+		///
+		////////////////////////////////////////////////////////////
+		static const VertexLayout& standard();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the compressed layout.
+		///
+		/// Positions are quantised to 16-bits within the bounds of the
+		/// mesh, normals are octahedral encoded and uv's are stored as
+		/// half floats. (16 bytes)
+		///
+		/// @returns The compressed layout.
+		///
+		////////////////////////////////////////////////////////////
+		static const VertexLayout& compressed();
+	};
+
+} // namespace jackal
+
+#endif//__JACKAL_VERTEX_LAYOUT_HPP__
+
+////////////////////////////////////////////////////////////
+/// @author Benjamin Carter
+///
+/// @class jackal::VertexLayout
+/// @ingroup rendering
+///
+/// The jackal::VertexLayout describes how the attributes of a vertex
+/// are stored on the GPU. Meshes are still built from Vertex_t, the
+/// layout encodes them when they are uploaded, so a mesh can trade
+/// precision for a smaller vertex buffer without changing how it is
+/// built. The geometry heap keeps separate pages for each layout.
+///
+/// Positions that are quantised and normals that are octahedral encoded
+/// are decoded by the vertex shader, using the generic attributes at
+/// locations 5 to 7 that applyDecode sets. Layouts that store floats
+/// decode with an identity scale, so every shader can decode every
+/// layout. Due to the low level aspects of the class, it is not
+/// exposed to the lua scripting interface.
+///
+/// @code
+/// using namespace jackal;
+///
+/// VertexLayout layout = VertexLayout::compressed();
+/// layout.set(eVertexAttribute::TANGENT, eVertexFormat::SNORM10_10_10_2);
+///
+/// Mesh mesh(vertices, indices, layout);
+/// @endcode
+///
+////////////////////////////////////////////////////////////
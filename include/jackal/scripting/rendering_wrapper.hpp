@@ -0,0 +1,110 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __JACKAL_RENDERING_WRAPPER_HPP__
+#define __JACKAL_RENDERING_WRAPPER_HPP__
+
+//====================
+// Additional includes
+//====================
+#include <jackal/utils/ext/sol.hpp> // Exposing classes and enums to lua.
+
+namespace jackal
+{
+	class RenderingWrapper final
+	{
+	private:
+		//====================
+		// Private methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Binds the eRenderCounter enum to the lua scripting interface.
+		///
+		/// So that the budget of each counter can be set within scripts,
+		/// the counters are exposed to lua.
+		///
+		/// @param state   The global lua state.
+		///
+		////////////////////////////////////////////////////////////
+		void bindRenderCounter(sol::state& state);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Binds the RenderStatistics class to the lua scripting interface.
+		///
+		/// The counters of the last frame can be read within scripts, so
+		/// that levels can monitor and react to the work they submit. It
+		/// cannot be constructed within a lua script, only the single
+		/// instance can be retrieved.
+		///
+		/// @param state   The global lua state.
+		///
+		////////////////////////////////////////////////////////////
+		void bindRenderStatistics(sol::state& state);
+
+	public:
+		//====================
+		// Ctor and dtor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Default constructor for the RenderingWrapper object.
+		////////////////////////////////////////////////////////////
+		explicit RenderingWrapper() = default;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Default destructor for the RenderingWrapper object.
+		////////////////////////////////////////////////////////////
+		~RenderingWrapper() = default;
+
+		//====================
+		// Methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Binds all of the classes exposed to the lua interface.
+		///
+		/// When this method is invoked, it will bind all of the rendering
+		/// classes that this class has exposed to the scripting interface.
+		///
+		/// @param state The global sol state object.
+		///
+		////////////////////////////////////////////////////////////
+		void bind(sol::state& state);
+	};
+
+} // namespace jackal
+
+#endif//__JACKAL_RENDERING_WRAPPER_HPP__
+
+////////////////////////////////////////////////////////////
+/// @author Benjamin Carter
+///
+/// @class jackal::RenderingWrapper
+/// @ingroup scripting
+///
+/// The jackal::RenderingWrapper is a simple class that is used to
+/// wrap the classes contained within the jackal_rendering library
+/// and expose them as lua objects for additional behavior within
+/// lua. Only specific classes and properties are exposed to the
+/// scripting interface.
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,230 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __JACKAL_ASYNC_HANDLE_HPP__
+#define __JACKAL_ASYNC_HANDLE_HPP__
+
+//====================
+// C++ includes
+//====================
+#include <atomic>                           // The state is written by the render thread and read by any thread.
+#include <memory>                           // Sharing the state between the handles of the same load.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/utils/resource_handle.hpp> // Retrieving the resource once it has loaded.
+
+namespace jackal
+{
+	//====================
+	// Enumerations
+	//====================
+	enum class eResourceState
+	{
+		PENDING, ///< The resource is still being loaded.
+		READY,   ///< The resource has loaded and can be used.
+		FAILED   ///< The resource failed to load.
+	};
+
+	//====================
+	// Structures
+	//====================
+	struct AsyncState_t final
+	{
+		std::atomic<eResourceState> state;    ///< The state of the load, set once the resource is stored.
+		ResourceHandle<Resource>    resource; ///< The loaded resource, null until the load is ready.
+
+		////////////////////////////////////////////////////////////
+		/// @brief Default constructor for the AsyncState_t object.
+		////////////////////////////////////////////////////////////
+		explicit AsyncState_t()
+			: state(eResourceState::PENDING), resource()
+		{
+		}
+	};
+
+	template <typename T>
+	class AsyncHandle final
+	{
+		static_assert(std::is_base_of<Resource, T>::value, "The template must be of base-type Resource.");
+
+	private:
+		//====================
+		// Member variables
+		//====================
+		std::shared_ptr<const AsyncState_t> m_pState; ///< The state of the load the handle refers to.
+
+	public:
+		//====================
+		// Ctor and dtor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Default constructor for the AsyncHandle.
+		///
+		/// The default AsyncHandle doesn't refer to any load, so its
+		/// state is always failed.
+		///
+		////////////////////////////////////////////////////////////
+		explicit AsyncHandle();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Constructor for the AsyncHandle object.
+		///
+		/// The handle is constructed by the ResourceManager when a load
+		/// is requested, every handle to the same load shares its state.
+		///
+		/// @param pState  The state of the load.
+		///
+		////////////////////////////////////////////////////////////
+		explicit AsyncHandle(std::shared_ptr<const AsyncState_t> pState);
+
+		//====================
+		// Getters and setters
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the state of the load.
+		///
+		/// @returns The state of the load, eResourceState::FAILED if the handle is empty.
+		///
+		////////////////////////////////////////////////////////////
+		eResourceState getState() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Checks whether the resource is still being loaded.
+		///
+		/// @returns True if the state of the load is eResourceState::PENDING.
+		///
+		////////////////////////////////////////////////////////////
+		bool isPending() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Checks whether the resource has loaded.
+		///
+		/// @returns True if the state of the load is eResourceState::READY.
+		///
+		////////////////////////////////////////////////////////////
+		bool isReady() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the loaded resource.
+		///
+		/// The resource is the same resource that ResourceManager::get
+		/// retrieves, so it can be stored and used like any other.
+		///
+		/// @returns A handle to the resource, null unless the load is ready.
+		///
+		////////////////////////////////////////////////////////////
+		ResourceHandle<T> get() const;
+	};
+
+	//====================
+	// Ctor and dtor
+	//====================
+	////////////////////////////////////////////////////////////
+	template <typename T>
+	AsyncHandle<T>::AsyncHandle()
+		: m_pState(nullptr)
+	{
+	}
+
+	////////////////////////////////////////////////////////////
+	template <typename T>
+	AsyncHandle<T>::AsyncHandle(std::shared_ptr<const AsyncState_t> pState)
+		: m_pState(std::move(pState))
+	{
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	////////////////////////////////////////////////////////////
+	template <typename T>
+	eResourceState AsyncHandle<T>::getState() const
+	{
+		return m_pState ? m_pState->state.load() : eResourceState::FAILED;
+	}
+
+	////////////////////////////////////////////////////////////
+	template <typename T>
+	bool AsyncHandle<T>::isPending() const
+	{
+		return this->getState() == eResourceState::PENDING;
+	}
+
+	////////////////////////////////////////////////////////////
+	template <typename T>
+	bool AsyncHandle<T>::isReady() const
+	{
+		return this->getState() == eResourceState::READY;
+	}
+
+	////////////////////////////////////////////////////////////
+	template <typename T>
+	ResourceHandle<T> AsyncHandle<T>::get() const
+	{
+		// The resource is stored before the state is set, so it is complete once the load is ready.
+		if (!this->isReady())
+		{
+			return ResourceHandle<T>();
+		}
+
+		return ResourceHandle<T>(static_cast<T*>(m_pState->resource.get()));
+	}
+
+} // namespace jackal
+
+#endif//__JACKAL_ASYNC_HANDLE_HPP__
+
+////////////////////////////////////////////////////////////
+/// @author Benjamin Carter
+///
+/// @class AsyncHandle
+/// @ingroup utils
+///
+/// The jackal::AsyncHandle template object refers to a resource
+/// that is being loaded in the background by the ResourceManager.
+/// The handle can be polled every frame, once the load is ready the
+/// resource is retrieved as a ResourceHandle. Every handle to a load
+/// keeps the loaded resource alive, even when the load finishes after
+/// every other handle to the resource has been released.
+///
+/// Due to the internal use of the class, it is not exposed to the
+/// lua scripting interface.
+///
+/// C++ Code example.
+/// @code
+/// using namespace jackal;
+///
+/// // Request the material, the textures and shader it uses are loaded alongside it.
+/// AsyncHandle<Material> request = ResourceManager::getInstance().getAsync<Material>("material.json");
+///
+/// // Later, once the state is no longer pending.
+/// if (request.isReady())
+/// {
+///		ResourceHandle<Material> material = request.get();
+/// }
+/// @endcode
+///
+////////////////////////////////////////////////////////////
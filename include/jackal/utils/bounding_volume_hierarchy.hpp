@@ -0,0 +1,378 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __JACKAL_BOUNDING_VOLUME_HIERARCHY_HPP__
+#define __JACKAL_BOUNDING_VOLUME_HIERARCHY_HPP__
+
+//====================
+// C++ includes
+//====================
+#include <vector>                          // Storing the nodes and query results.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/math/bounding_box.hpp>    // The bounds of each node.
+#include <jackal/math/bounding_sphere.hpp> // Querying the objects within a sphere.
+#include <jackal/math/frustum.hpp>         // Querying the objects within a frustum.
+#include <jackal/math/ray.hpp>             // Querying the objects hit by a ray.
+
+namespace jackal
+{
+	class BoundingVolumeHierarchy final
+	{
+	public:
+		//====================
+		// Static variables
+		//====================
+		static const int NULL_NODE = -1;            ///< Refers to no node.
+		static const int BINS = 12;                 ///< The number of bins evaluated by the SAH builder.
+		static const int PARALLEL_THRESHOLD = 1024; ///< The number of objects above which subtrees are built in parallel.
+
+	private:
+		//====================
+		// Structures
+		//====================
+		struct Node_t
+		{
+			BoundingBox box;    ///< The bounds of the node, enlarged by the margin for dynamic leaves.
+			void*       pData;  ///< The object of a leaf, supplied by the user.
+			int         parent; ///< The parent of the node, or the next free node.
+			int         left;   ///< The left child, NULL_NODE for a leaf.
+			int         right;  ///< The right child, NULL_NODE for a leaf.
+			int         height; ///< Zero for a leaf, negative when the node is free.
+
+			explicit Node_t();
+			bool isLeaf() const;
+		};
+
+		//====================
+		// Member variables
+		//====================
+		std::vector<Node_t> m_nodes;  ///< Every node of the tree, including free nodes.
+		int                 m_root;   ///< The root of the tree.
+		int                 m_free;   ///< The first node of the free list.
+		int                 m_count;  ///< The number of objects within the tree.
+		float               m_margin; ///< The distance dynamic leaves are enlarged by.
+
+	private:
+		//====================
+		// Private methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Takes a node from the free list, growing the pool if needed.
+		///
+		/// @returns The index of the node.
+		///
+		////////////////////////////////////////////////////////////
+		int allocateNode();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Returns a node to the free list.
+		///
+		/// @param node  The index of the node.
+		///
+		////////////////////////////////////////////////////////////
+		void freeNode(int node);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Inserts a leaf beside the sibling that least increases the surface area.
+		///
+		/// @param leaf  The index of the leaf.
+		///
+		////////////////////////////////////////////////////////////
+		void insertLeaf(int leaf);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Removes a leaf, its parent is replaced by its sibling.
+		///
+		/// @param leaf  The index of the leaf.
+		///
+		////////////////////////////////////////////////////////////
+		void removeLeaf(int leaf);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Recalculates the bounds and heights from a node up to the root.
+		///
+		/// @param node  The first node to recalculate.
+		///
+		////////////////////////////////////////////////////////////
+		void refitAncestors(int node);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Rotates a node if its children are unbalanced.
+		///
+		/// @param node  The node to balance.
+		///
+		/// @returns     The node that has replaced it within the tree.
+		///
+		////////////////////////////////////////////////////////////
+		int balance(int node);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Recalculates the bounds of a subtree from its leaves.
+		///
+		/// @param node  The root of the subtree.
+		///
+		////////////////////////////////////////////////////////////
+		void refitNode(int node);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Builds a subtree over a range of objects.
+		///
+		/// A subtree of n objects always occupies 2n - 1 consecutive
+		/// nodes, so both children can be built at the same time without
+		/// sharing an allocator.
+		///
+		/// @param node     The index of the root of the subtree.
+		/// @param parent   The parent of the subtree.
+		/// @param pFirst   The first object of the range.
+		/// @param pLast    One past the last object of the range.
+		/// @param boxes    The bounds of every object.
+		/// @param data     The user data of every object.
+		/// @param proxies  Set to the proxy of every object.
+		///
+		////////////////////////////////////////////////////////////
+		void buildNode(int node, int parent, int* pFirst, int* pLast, const std::vector<BoundingBox>& boxes,
+			const std::vector<void*>& data, std::vector<int>& proxies);
+
+	public:
+		//====================
+		// Ctor and dtor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Constructor for the BoundingVolumeHierarchy object.
+		///
+		/// @param margin  The distance dynamic leaves are enlarged by, so
+		///                small movements do not change the tree.
+		///
+		////////////////////////////////////////////////////////////
+		explicit BoundingVolumeHierarchy(float margin = 0.1f);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Default destructor for the BoundingVolumeHierarchy object.
+		////////////////////////////////////////////////////////////
+		~BoundingVolumeHierarchy() = default;
+
+		//====================
+		// Getters and setters
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the user data of an object.
+		///
+		/// @param proxy  The proxy returned when the object was inserted.
+		///
+		/// @returns      The user data of the object.
+		///
+		////////////////////////////////////////////////////////////
+		void* getData(int proxy) const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the bounds stored for an object.
+		///
+		/// @param proxy  The proxy returned when the object was inserted.
+		///
+		/// @returns      The bounds of the object, including the margin.
+		///
+		////////////////////////////////////////////////////////////
+		const BoundingBox& getBox(int proxy) const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the number of objects within the tree.
+		///
+		/// @returns The number of leaves.
+		///
+		////////////////////////////////////////////////////////////
+		int getCount() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the height of the tree.
+		///
+		/// @returns The number of levels below the root, zero if empty.
+		///
+		////////////////////////////////////////////////////////////
+		int getHeight() const;
+
+		//====================
+		// Methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Inserts an object into the tree.
+		///
+		/// @param box    The world space bounds of the object.
+		/// @param pData  The user data returned by queries, typically the object.
+		///
+		/// @returns      The proxy of the object.
+		///
+		////////////////////////////////////////////////////////////
+		int insert(const BoundingBox& box, void* pData);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Removes an object from the tree.
+		///
+		/// @param proxy  The proxy returned when the object was inserted.
+		///
+		////////////////////////////////////////////////////////////
+		void remove(int proxy);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Moves an object within the tree.
+		///
+		/// The object is only re-inserted when it leaves its enlarged
+		/// bounds, which is rare for objects that move a little each
+		/// frame.
+		///
+		/// @param proxy  The proxy returned when the object was inserted.
+		/// @param box    The new world space bounds of the object.
+		///
+		/// @returns      True if the object was re-inserted.
+		///
+		////////////////////////////////////////////////////////////
+		bool move(int proxy, const BoundingBox& box);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Sets the bounds of an object without changing the tree.
+		///
+		/// When many objects move every frame it is cheaper to update
+		/// every leaf and refit the tree once than to move each object.
+		/// Queries are incorrect until refit is invoked.
+		///
+		/// @param proxy  The proxy returned when the object was inserted.
+		/// @param box    The new world space bounds of the object.
+		///
+		////////////////////////////////////////////////////////////
+		void update(int proxy, const BoundingBox& box);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Recalculates the bounds of every node from its leaves.
+		////////////////////////////////////////////////////////////
+		void refit();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Replaces the tree with one built over a set of static objects.
+		///
+		/// The tree is built from the top down, each node is split
+		/// with a binned surface area heuristic and large subtrees are
+		/// built across the workers of the ThreadPool. Objects can still
+		/// be inserted and removed afterwards.
+		///
+		/// @param boxes    The world space bounds of each object.
+		/// @param data     The user data of each object.
+		/// @param proxies  Set to the proxy of each object.
+		///
+		////////////////////////////////////////////////////////////
+		void build(const std::vector<BoundingBox>& boxes, const std::vector<void*>& data, std::vector<int>& proxies);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Removes every object from the tree.
+		////////////////////////////////////////////////////////////
+		void clear();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Finds every object whose bounds overlap a box.
+		///
+		/// @param box      The box to query.
+		/// @param results  The proxies of the objects are appended to the vector.
+		///
+		////////////////////////////////////////////////////////////
+		void query(const BoundingBox& box, std::vector<int>& results) const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Finds every object whose bounds overlap a sphere.
+		///
+		/// @param sphere   The sphere to query.
+		/// @param results  The proxies of the objects are appended to the vector.
+		///
+		////////////////////////////////////////////////////////////
+		void query(const BoundingSphere& sphere, std::vector<int>& results) const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Finds every object whose bounds may be within a frustum.
+		///
+		/// @param frustum  The frustum to query.
+		/// @param results  The proxies of the objects are appended to the vector.
+		///
+		////////////////////////////////////////////////////////////
+		void query(const Frustum& frustum, std::vector<int>& results) const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Finds every object whose bounds are hit by a ray.
+		///
+		/// @param ray          The ray to query.
+		/// @param maxDistance  The length of the ray.
+		/// @param results      The proxies of the objects are appended to the vector.
+		///
+		////////////////////////////////////////////////////////////
+		void query(const Ray& ray, float maxDistance, std::vector<int>& results) const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Finds the nearest object whose bounds are hit by a ray.
+		///
+		/// @param ray          The ray to cast.
+		/// @param maxDistance  The length of the ray.
+		/// @param distance     Set to the distance of the hit.
+		///
+		/// @returns            The proxy of the object, or NULL_NODE.
+		///
+		////////////////////////////////////////////////////////////
+		int raycast(const Ray& ray, float maxDistance, float& distance) const;
+	};
+
+} // namespace jackal
+
+#endif//__JACKAL_BOUNDING_VOLUME_HIERARCHY_HPP__
+
+////////////////////////////////////////////////////////////
+/// @author Benjamin Carter
+///
+/// @class jackal::BoundingVolumeHierarchy
+/// @ingroup utils
+///
+/// The jackal::BoundingVolumeHierarchy is a binary tree of
+/// axis aligned boxes, so spatial queries only visit the objects
+/// that are near the query rather than every object in the scene.
+/// It is shared by culling, picking, audio and gameplay queries.
+///
+/// Dynamic objects are inserted and removed incrementally, the
+/// tree is kept balanced with rotations. Static geometry can be
+/// built at once with a surface area heuristic, which produces a
+/// better tree. Due to the internal use of the class, it is not
+/// exposed to the lua scripting interface.
+///
+/// @code
+/// using namespace jackal;
+///
+/// BoundingVolumeHierarchy bvh;
+/// int proxy = bvh.insert(mesh.getBoundingBox().transform(transform.getTransformation()), &gameObject);
+///
+/// std::vector<int> visible;
+/// bvh.query(Frustum(camera.getViewProjection()), visible);
+///
+/// for (int visibleProxy : visible)
+/// {
+///		auto* pObject = static_cast<GameObject*>(bvh.getData(visibleProxy));
+/// }
+/// @endcode
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,197 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __JACKAL_FILE_WATCHER_HPP__
+#define __JACKAL_FILE_WATCHER_HPP__
+
+//====================
+// C++ includes
+//====================
+#include <atomic>        // Stopping the watching thread.
+#include <chrono>        // Debouncing the changes of each file.
+#include <mutex>         // Locking the watched files and the detected changes.
+#include <string>        // Storing the path of each watched file.
+#include <thread>        // The changes are detected on a seperate thread.
+#include <unordered_map> // Mapping watched directories and pending changes.
+#include <unordered_set> // Storing the watched files.
+#include <vector>        // Returning the changed files.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/utils/non_copyable.hpp> // FileWatcher owns a thread and cannot be copied.
+
+namespace jackal
+{
+	class FileWatcher final : NonCopyable
+	{
+	private:
+		//====================
+		// Type definitions
+		//====================
+		using Clock = std::chrono::steady_clock;
+
+		//====================
+		// Member variables
+		//====================
+		std::unordered_set<std::string>                      m_files;       ///< The absolute paths of the watched files.
+		std::unordered_map<int, std::string>                 m_directories; ///< The directory of each watch descriptor.
+		std::unordered_map<std::string, Clock::time_point>   m_pending;     ///< The files that changed, and when they last changed.
+		std::vector<std::string>                             m_changes;     ///< The debounced changes waiting to be collected.
+		std::chrono::milliseconds                            m_debounce;    ///< How long a file must be left alone before it is reported.
+		std::mutex                                           m_mutex;       ///< Locking the watched files and the changes.
+		std::thread                                          m_thread;      ///< The thread waiting for changes.
+		std::atomic<bool>                                    m_running;     ///< Whether the thread is waiting for changes.
+		int                                                  m_descriptor;  ///< The inotify instance, -1 when not created.
+		int                                                  m_wake[2];     ///< The pipe used to wake the thread when destroyed.
+
+	private:
+		//====================
+		// Private methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Waits for changes to the watched files.
+		///
+		/// On Linux the thread sleeps within poll until inotify reports
+		/// a change, so no time is spent when nothing changes. Changes are
+		/// debounced, as editors often write a file several times when
+		/// saving. Other platforms fall back to checking the write time
+		/// of each file once per second.
+		///
+		////////////////////////////////////////////////////////////
+		void listen();
+
+	public:
+		//====================
+		// Ctor and dtor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Default constructor for the FileWatcher.
+		///
+		/// The FileWatcher does not detect any changes until it is
+		/// created.
+		///
+		////////////////////////////////////////////////////////////
+		explicit FileWatcher();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Destructor for the FileWatcher.
+		///
+		/// The destructor implicitly calls the destroy method, which
+		/// stops and joins the watching thread.
+		///
+		////////////////////////////////////////////////////////////
+		~FileWatcher();
+
+		//====================
+		// Getters and setters
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the files that have changed since the last call.
+		///
+		/// A file is only reported once it has not been written to for
+		/// the debounce period, each file is reported once per change.
+		///
+		/// @returns The absolute paths of the changed files.
+		///
+		////////////////////////////////////////////////////////////
+		std::vector<std::string> getChanges();
+
+		//====================
+		// Methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Creates the watching thread.
+		///
+		/// @param debounce  The milliseconds a file must be left alone before it is reported.
+		///
+		/// @returns         True if the thread was started.
+		///
+		////////////////////////////////////////////////////////////
+		bool create(unsigned int debounce = 100);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Stops and joins the watching thread.
+		////////////////////////////////////////////////////////////
+		void destroy();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Starts watching a file for changes.
+		///
+		/// The directory of the file is watched rather than the file
+		/// itself, so editors that save by replacing the file are still
+		/// detected. Watching the same file twice has no effect.
+		///
+		/// @param filename  The absolute path of the file, see resolve.
+		///
+		/// @returns         True if the file is being watched.
+		///
+		////////////////////////////////////////////////////////////
+		bool watch(const std::string& filename);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Converts a virtual or relative path into the path reported on changes.
+		///
+		/// @param filename  The virtual or relative path of the file.
+		///
+		/// @returns         The normalised absolute path, or an empty string if the file doesn't exist.
+		///
+		////////////////////////////////////////////////////////////
+		static std::string resolve(const std::string& filename);
+	};
+
+} // namespace jackal
+
+#endif//__JACKAL_FILE_WATCHER_HPP__
+
+////////////////////////////////////////////////////////////
+/// @author Benjamin Carter
+///
+/// @class jackal::FileWatcher
+/// @ingroup utils
+///
+/// The jackal::FileWatcher detects changes to a set of files on a
+/// seperate thread. On Linux it is driven by inotify, so a change is
+/// detected as soon as the file is written and the thread costs nothing
+/// while files are left alone. It is used by the ResourceManager to
+/// hot-reload resources in debug builds.
+///
+/// Due to the internal use of the class, it is not exposed to the
+/// lua scripting interface.
+///
+/// @code
+/// using namespace jackal;
+///
+/// FileWatcher watcher;
+/// watcher.create();
+/// watcher.watch(FileWatcher::resolve("~data/shaders/basic-lighting.fragment.glsl"));
+///
+/// // Once per frame.
+/// for (const auto& file : watcher.getChanges())
+/// {
+///		// Reload the resources using the file.
+/// }
+/// @endcode
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,168 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __JACKAL_FRAME_TIMER_HPP__
+#define __JACKAL_FRAME_TIMER_HPP__
+
+//====================
+// C++ includes
+//====================
+#include <chrono>  // Measuring the duration of each frame.
+#include <cstddef> // Counting the recorded frames.
+#include <string>  // Writing the frame times to a file.
+#include <vector>  // Storing the recorded frame times.
+
+namespace jackal
+{
+	//====================
+	// Structures
+	//====================
+	struct FrameStatistics_t
+	{
+		std::size_t frames;  ///< The number of frames the statistics were calculated from.
+		double      minimum; ///< The shortest frame, in milliseconds.
+		double      average; ///< The mean frame time, in milliseconds.
+		double      median;  ///< The 50th percentile frame time, in milliseconds.
+		double      p95;     ///< The 95th percentile frame time, in milliseconds.
+		double      p99;     ///< The 99th percentile frame time, in milliseconds.
+		double      maximum; ///< The longest frame, in milliseconds.
+
+		////////////////////////////////////////////////////////////
+		/// @brief Default constructor for the FrameStatistics_t object.
+		////////////////////////////////////////////////////////////
+		explicit FrameStatistics_t();
+	};
+
+	class FrameTimer
+	{
+	private:
+		//====================
+		// Member variables
+		//====================
+		std::vector<double>                   m_times;   ///< The duration of every recorded frame, in milliseconds.
+		std::chrono::steady_clock::time_point m_last;    ///< The time the previous frame ended.
+		bool                                  m_started; ///< Whether the first frame boundary has been reached.
+
+	public:
+		//====================
+		// Ctor and dtor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Default constructor for the FrameTimer object.
+		////////////////////////////////////////////////////////////
+		explicit FrameTimer();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Default destructor for the FrameTimer object.
+		////////////////////////////////////////////////////////////
+		~FrameTimer() = default;
+
+		//====================
+		// Getters and setters
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the number of recorded frames.
+		///
+		/// @returns The number of frames that have been timed.
+		///
+		////////////////////////////////////////////////////////////
+		std::size_t getCount() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Calculates the statistics of the recorded frames.
+		///
+		/// The percentiles are calculated using the nearest rank of
+		/// the sorted frame times. If no frames have been recorded, every
+		/// statistic is zero.
+		///
+		/// @returns The statistics of the recorded frames.
+		///
+		////////////////////////////////////////////////////////////
+		FrameStatistics_t getStatistics() const;
+
+		//====================
+		// Methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Clears every recorded frame.
+		///
+		/// @param reserve  The number of frames to reserve memory for.
+		///
+		////////////////////////////////////////////////////////////
+		void reset(std::size_t reserve = 0);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Marks the boundary between two frames.
+		///
+		/// The first invocation starts the timer, every subsequent
+		/// invocation records the time elapsed since the previous one.
+		///
+		////////////////////////////////////////////////////////////
+		void tick();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Writes every recorded frame time to a csv file.
+		///
+		/// @param filename  The location of the csv file to write.
+		///
+		/// @returns         True if the file was written successfully.
+		///
+		////////////////////////////////////////////////////////////
+		bool writeCSV(const std::string& filename) const;
+	};
+
+} // namespace jackal
+
+#endif//__JACKAL_FRAME_TIMER_HPP__
+
+////////////////////////////////////////////////////////////
+/// @author Benjamin Carter
+///
+/// @class jackal::FrameTimer
+/// @ingroup utils
+///
+/// The jackal::FrameTimer records the duration of each frame so
+/// that the performance of the engine can be measured. It is used by
+/// the Window when a number of benchmark frames has been set, at which
+/// point the statistics are written to the log and every frame time to
+/// a csv file. The FrameTimer is not exposed to the lua scripting
+/// interface.
+///
+/// @code
+/// using namespace jackal;
+///
+/// FrameTimer timer;
+/// timer.reset(1000);
+///
+/// while (timer.getCount() < 1000)
+/// {
+///		// Render the frame.
+///		timer.tick();
+/// }
+///
+/// FrameStatistics_t statistics = timer.getStatistics();
+/// timer.writeCSV("logs/benchmark.csv");
+/// @endcode
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,157 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __JACKAL_MAPPED_FILE_HPP__
+#define __JACKAL_MAPPED_FILE_HPP__
+
+//====================
+// C++ includes
+//====================
+#include <cstddef>                       // Sizing the mapped memory.
+#include <string>                        // Opening the file by name.
+#include <vector>                        // Storing the contents when mapping is unsupported.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/utils/non_copyable.hpp> // MappedFile owns the mapped memory and cannot be copied.
+
+namespace jackal
+{
+	class MappedFile final : NonCopyable
+	{
+	private:
+		//====================
+		// Member variables
+		//====================
+		const unsigned char*       m_pData;    ///< The first byte of the file.
+		std::size_t                m_size;     ///< The size of the file, in bytes.
+		bool                       m_mapped;   ///< Whether the memory was mapped rather than read.
+		std::vector<unsigned char> m_contents; ///< The contents of the file when mapping is unsupported.
+
+	public:
+		//====================
+		// Ctor and dtor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Default constructor for the MappedFile object.
+		///
+		/// No file is mapped until the open method is invoked.
+		///
+		////////////////////////////////////////////////////////////
+		explicit MappedFile();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Destructor for the MappedFile object.
+		///
+		/// The destructor implicitly calls the close method, which unmaps
+		/// the memory of the file.
+		///
+		////////////////////////////////////////////////////////////
+		~MappedFile();
+
+		//====================
+		// Getters and setters
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the contents of the file.
+		///
+		/// The memory is read only and remains valid until the file is
+		/// closed.
+		///
+		/// @returns The first byte of the file, or null if no file is open.
+		///
+		////////////////////////////////////////////////////////////
+		const unsigned char* getData() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the size of the file.
+		///
+		/// @returns The size of the file, in bytes.
+		///
+		////////////////////////////////////////////////////////////
+		std::size_t getSize() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves whether a file is open.
+		///
+		/// @returns True if the contents of a file are available.
+		///
+		////////////////////////////////////////////////////////////
+		bool isOpen() const;
+
+		//====================
+		// Methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Maps the contents of a file into memory.
+		///
+		/// On Linux the file is mapped with mmap, so pages are only read
+		/// from disk when they are first touched and no copy is made.
+		/// Other platforms read the whole file into memory. This method
+		/// can make use of the virtual file system.
+		///
+		/// @param filename  The file name of the file to map.
+		///
+		/// @returns         True if the file was mapped.
+		///
+		////////////////////////////////////////////////////////////
+		bool open(const std::string& filename);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Unmaps the contents of the file.
+		////////////////////////////////////////////////////////////
+		void close();
+	};
+
+} // namespace jackal
+
+#endif//__JACKAL_MAPPED_FILE_HPP__
+
+////////////////////////////////////////////////////////////
+/// @author Benjamin Carter
+///
+/// @class jackal::MappedFile
+/// @ingroup utils
+///
+/// The jackal::MappedFile provides read only access to the contents
+/// of a file without copying it. It is used to load cooked assets,
+/// whose data is already in the layout the GPU expects and can be
+/// uploaded straight from the mapped memory.
+///
+/// Due to the low level aspects of the class, it is not exposed to
+/// the lua scripting interface.
+///
+/// @code
+/// using namespace jackal;
+///
+/// MappedFile file;
+/// if (file.open("~assets/textures/crate.jtex"))
+/// {
+///		const unsigned char* pData = file.getData();
+///		// Read file.getSize() bytes from pData.
+/// }
+/// @endcode
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,187 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __JACKAL_RANGE_ALLOCATOR_HPP__
+#define __JACKAL_RANGE_ALLOCATOR_HPP__
+
+//====================
+// C++ includes
+//====================
+#include <vector> // Storing the free blocks of the allocator.
+
+namespace jackal
+{
+	class RangeAllocator
+	{
+	private:
+		//====================
+		// Member variables
+		//====================
+		struct Block_t
+		{
+			int offset; ///< The first element of the free block.
+			int count;  ///< The number of elements within the free block.
+		};
+
+		int                  m_capacity; ///< The total number of elements managed by the allocator.
+		int                  m_used;     ///< The number of elements currently handed out.
+		std::vector<Block_t> m_free;     ///< Free blocks, sorted by their offset.
+
+	public:
+		//====================
+		// Ctor and dtor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Default constructor for the RangeAllocator object.
+		///
+		/// The default constructor creates an allocator with no capacity,
+		/// every allocation will fail until the allocator is reset with
+		/// a valid capacity.
+		///
+		////////////////////////////////////////////////////////////
+		explicit RangeAllocator();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Constructor for the RangeAllocator object.
+		///
+		/// Creates an allocator that manages the range [0, capacity), the
+		/// entire range is initially free.
+		///
+		/// @param capacity  The number of elements managed by the allocator.
+		///
+		////////////////////////////////////////////////////////////
+		explicit RangeAllocator(int capacity);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Default destructor for the RangeAllocator object.
+		////////////////////////////////////////////////////////////
+		~RangeAllocator() = default;
+
+		//====================
+		// Getters and setters
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the total number of elements managed by the allocator.
+		///
+		/// @returns The capacity of the allocator.
+		///
+		////////////////////////////////////////////////////////////
+		int getCapacity() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the number of elements currently allocated.
+		///
+		/// @returns The number of elements handed out by the allocator.
+		///
+		////////////////////////////////////////////////////////////
+		int getUsed() const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the size of the largest free block.
+		///
+		/// As the free space can become fragmented, the largest block
+		/// is the largest single allocation that can currently succeed.
+		///
+		/// @returns The number of elements in the largest free block.
+		///
+		////////////////////////////////////////////////////////////
+		int getLargestBlock() const;
+
+		//====================
+		// Methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Resets the allocator to a single free block.
+		///
+		/// All previous allocations are forgotten, the caller is responsible
+		/// for ensuring that no ranges are still in use.
+		///
+		/// @param capacity  The new number of elements managed by the allocator.
+		///
+		////////////////////////////////////////////////////////////
+		void reset(int capacity);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Allocates a contiguous range from the allocator.
+		///
+		/// The first free block large enough to hold the requested count
+		/// is split, with the remainder staying in the free list. The
+		/// offset of the range is aligned to the specified alignment.
+		///
+		/// @param count      The number of elements to allocate.
+		/// @param offset     The offset of the allocated range.
+		/// @param alignment  The alignment of the offset, in elements.
+		///
+		/// @returns True if the range was allocated successfully.
+		///
+		////////////////////////////////////////////////////////////
+		bool allocate(int count, int& offset, int alignment = 1);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Returns a range back to the allocator.
+		///
+		/// The range is merged with any neighbouring free blocks, so
+		/// that the free list does not fragment when ranges are freed
+		/// in a different order to their allocation.
+		///
+		/// @param offset  The offset of the range to free.
+		/// @param count   The number of elements within the range.
+		///
+		////////////////////////////////////////////////////////////
+		void free(int offset, int count);
+	};
+
+} // namespace jackal
+
+#endif//__JACKAL_RANGE_ALLOCATOR_HPP__
+
+////////////////////////////////////////////////////////////
+/// @author Benjamin Carter
+///
+/// @class jackal::RangeAllocator
+/// @ingroup utils
+///
+/// The jackal::RangeAllocator is a simple first-fit free list
+/// allocator that hands out offsets into a fixed size range. It
+/// does not own any memory itself, it is used to sub-allocate
+/// large blocks of memory that are owned elsewhere, such as the
+/// pages of the geometry heap.
+///
+/// Due to the internal use of the class, it is not exposed to
+/// the lua scripting interface.
+///
+/// @code
+/// using namespace jackal;
+///
+/// RangeAllocator allocator(1024);
+///
+/// int offset = 0;
+/// if (allocator.allocate(128, offset))
+/// {
+///		// Use the elements [offset, offset + 128).
+///		allocator.free(offset, 128);
+/// }
+/// @endcode
+///
+////////////////////////////////////////////////////////////
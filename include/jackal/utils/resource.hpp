@@ -124,6 +124,34 @@ namespace jackal
 		///
 		////////////////////////////////////////////////////////////
 		virtual bool load(const std::string& filename) = 0;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Prepares a resource to be loaded in the background.
+		///
+		/// Resources loaded with ResourceManager::getAsync are prepared
+		/// on a worker thread before they are loaded on the render thread,
+		/// so reading and parsing files is moved off the render thread.
+		/// The method must not touch the OpenGL context. Resources that
+		/// override it keep the prepared data for the following load, the
+		/// default implementation leaves all of the work to load.
+		///
+		/// @param filename    The filename of the resource to prepare.
+		///
+		/// @returns           True if the resource can be loaded.
+		///
+		////////////////////////////////////////////////////////////
+		virtual bool prepare(const std::string& filename);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Checks whether a prepared resource waits upon other resources.
+		///
+		/// A resource that requested the resources it depends upon while
+		/// it was prepared isn't loaded until they have finished loading.
+		///
+		/// @returns           True if any of the requested resources are still loading.
+		///
+		////////////////////////////////////////////////////////////
+		virtual bool hasPendingDependencies() const;
 	};
 
 } // namespace jackal
@@ -141,7 +169,8 @@ namespace jackal
 /// behavior and functionality from external json files. Resources
 /// include objects such as shaders, textures and materials. 
 /// The load method is commonly invoked by the ResourceManager object
-/// to load objects that have not yet been initialized.
+/// to load objects that have not yet been initialized. Resources that
+/// are loaded in the background are prepared on a worker thread first.
 ///
 /// Due to its internal use, the class is not exposed to the
 /// lua scripting interface and a code example is not provided.
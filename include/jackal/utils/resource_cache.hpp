@@ -92,6 +92,33 @@ namespace jackal
 		////////////////////////////////////////////////////////////
 		T* get(const std::string& name);
 
+		////////////////////////////////////////////////////////////
+		/// @brief Finds a resource within the ResourceCache.
+		///
+		/// Unlike get, the resource is never loaded if it isn't found.
+		///
+		/// @param name   The key name of the resource to find.
+		///
+		/// @returns      The Resource associated with the key, nullptr if there isn't one.
+		///
+		////////////////////////////////////////////////////////////
+		T* find(const std::string& name) const;
+
+		////////////////////////////////////////////////////////////
+		/// @brief Adds a resource that was loaded outside of the ResourceCache.
+		///
+		/// The cache takes ownership of the resource. If a resource with
+		/// the same key was added whilst it was loading, the resource is
+		/// de-allocated and the existing resource is kept instead.
+		///
+		/// @param name       The key name of the resource.
+		/// @param pResource  The loaded resource to add.
+		///
+		/// @returns          The Resource now associated with the key.
+		///
+		////////////////////////////////////////////////////////////
+		T* insert(const std::string& name, T* pResource);
+
 		////////////////////////////////////////////////////////////
 		/// @brief Retrieves the resources of the cache.
 		///
@@ -73,6 +73,27 @@ T* ResourceCache<T>::get(const std::string& name)
 	return pResource;
 }
 
+////////////////////////////////////////////////////////////
+template <typename T>
+T* ResourceCache<T>::find(const std::string& name) const
+{
+	auto itr = m_resources.find(name);
+	return itr != std::end(m_resources) ? itr->second : nullptr;
+}
+
+////////////////////////////////////////////////////////////
+template <typename T>
+T* ResourceCache<T>::insert(const std::string& name, T* pResource)
+{
+	auto result = m_resources.insert(std::make_pair(name, pResource));
+	if (!result.second)
+	{
+		delete pResource;
+	}
+
+	return result.first->second;
+}
+
 ////////////////////////////////////////////////////////////
 template <typename T>
 std::unordered_map<std::string, T*> ResourceCache<T>::getResources() const
@@ -28,11 +28,14 @@
 //====================
 // C++ includes
 //====================
-#include <array>                            // Storing the time stamps for each Shader object.
-#if _DEBUG
-#include <mutex>                            // Locking when the Shader are being re-loaded.
-#include <thread>                           // File reading and time-stamping is passed to a seperate thread.
-#endif
+#include <functional>                       // Reloading the resources that depend upon a file.
+#include <future>                           // Waiting on the resources being prepared.
+#include <memory>                           // Sharing the state of each load with its handles.
+#include <mutex>                            // Locking the registered dependencies.
+#include <string>                           // Mapping files to their dependent resources.
+#include <unordered_map>                    // Storing the dependents of each file.
+#include <unordered_set>                    // Storing the resources that are already watched.
+#include <vector>                           // Storing several dependents for each file.
 
 //====================
 // Jackal includes
@@ -40,9 +43,11 @@
 #include <jackal/utils/singleton.hpp>       // ResourceManager is a singleton object.
 #include <jackal/utils/resource_cache.hpp>  // Different caches for the all the resources. 
 #include <jackal/utils/resource_handle.hpp> // A RAII is a handle to the resource object.
+#include <jackal/utils/async_handle.hpp>    // A handle to a resource that is loading in the background.
 #include <jackal/rendering/material.hpp>    // Storing materials, shaders and textures within the manager.
 #include <jackal/rendering/model.hpp>       // Storing models.
 #include <jackal/scripting/script.hpp>      // Storing scripts.
+#include <jackal/utils/file_watcher.hpp>    // Detecting changes to the files of each resource.
 
 namespace jackal
 {
@@ -50,6 +55,12 @@ namespace jackal
 	{
 		friend class Singleton<ResourceManager>;
 
+	public:
+		//====================
+		// Static variables
+		//====================
+		static const int LOADS_PER_FRAME = 4; ///< The most background loads that are finished on the render thread each frame.
+
 	private:
 		//====================
 		// Member variables
@@ -60,15 +71,29 @@ namespace jackal
 		ResourceCache<Model>                       m_models;         ///< The resource cache for all the models.
 		ResourceCache<Script>                      m_scripts;        ///< The resource cache for all the scripts.
 
-#if _DEBUG
-		using TimeArray = std::array<int64_t, static_cast<int>(eShaderType::MAX)>;
+		using ReloadList   = std::vector<std::function<void()>>;
+		using DependentMap = std::unordered_map<std::string, ReloadList>;
+
+		DependentMap                               m_dependents;     ///< The reload callbacks of each watched file.
+		std::unordered_set<std::string>            m_watched;        ///< The resources whose files are already watched.
+		std::mutex                                 m_mutex;          ///< Locking the dependents, resources are retrieved from several threads.
+		FileWatcher                                m_watcher;        ///< Detects changes to the watched files in debug builds.
+
+		struct AsyncLoad_t
+		{
+			std::shared_ptr<AsyncState_t>       pState;    ///< The state shared with the handles of the load.
+			std::string                         name;      ///< The file name prefixed with the type of the resource.
+			std::string                         filename;  ///< The file the resource is loaded from.
+			Resource*                           pResource; ///< The resource being loaded, created on the render thread.
+			std::future<void>                   prepared;  ///< Ready once the resource has been prepared on a worker thread.
+			std::function<Resource*()>          find;      ///< Finds the resource within its cache.
+			std::function<Resource*()>          create;    ///< Creates the resource to load.
+			std::function<Resource*(Resource*)> store;     ///< Adds the loaded resource to its cache, returning the cached resource.
+		};
+
+		std::vector<AsyncLoad_t>                   m_loads;          ///< The resources being loaded in the background.
+		std::mutex                                 m_loadMutex;      ///< Locking the loads, they are requested from any thread.
 
-		std::unordered_map<std::string, TimeArray> m_timeStamps;     ///< The time stamps for all of the different shaders.
-		std::vector<Shader*>                       m_changedShaders; ///< A list of all the changed shaders.
-		bool                                       m_listening;      ///< Whether the seperate thread is listening for changes.
-		std::mutex                                 m_mutex;          ///< Mutex locking for shader reloading.
-		std::thread                                m_listener;       ///< Seperate thread for file change listening.
-#endif
 	private:
 		//====================
 		// Private ctor
@@ -77,28 +102,88 @@ namespace jackal
 		/// @brief Default destructor for the ResourceManager.
 		///
 		/// The default constructor sets all of the member variables to
-		/// default values and registers the thread listener thread with the
-		/// fileChangeListener() method.
+		/// default values. In debug builds, the file watcher is created so
+		/// that resources are reloaded when their files change.
 		///
 		////////////////////////////////////////////////////////////
 		explicit ResourceManager();
 
-#if _DEBUG
 		//====================
 		// Private methods
 		//====================
 		////////////////////////////////////////////////////////////
-		/// @brief Detects changes to the different registered shaders.
+		/// @brief Watches the files of a resource the first time it is retrieved.
+		///
+		/// @param name    The name of the resource within its cache.
+		/// @param files   The files the resource is loaded from.
+		/// @param reload  Reloads the resource when any of the files change.
+		///
+		////////////////////////////////////////////////////////////
+		void watchResource(const std::string& name, const std::vector<std::string>& files, const std::function<void()>& reload);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Watches the files of a material.
 		///
-		/// This method is registered to a seperate thread and utilises
-		/// experimental C++17 behavior. It will check the time-stamp of
-		/// each registered glsl object within the application for changes made.
-		/// If any of the files have been changed, the shader will be re-compiled
-		/// with the new source data.
+		/// @param pResource  The material to reload when its file changes.
+		/// @param filename   The file the material was loaded from.
 		///
 		////////////////////////////////////////////////////////////
-		void fileChangeListener();
-#endif
+		void watchResource(Material* pResource, const std::string& filename);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Watches the files of a shader.
+		///
+		/// @param pResource  The shader to re-compile when any of its files change.
+		/// @param filename   The file the shader was loaded from.
+		///
+		////////////////////////////////////////////////////////////
+		void watchResource(Shader* pResource, const std::string& filename);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Watches the files of a texture.
+		///
+		/// @param pResource  The texture to reload when its file or image changes.
+		/// @param filename   The file the texture was loaded from.
+		///
+		////////////////////////////////////////////////////////////
+		void watchResource(Texture* pResource, const std::string& filename);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Queues a resource to be loaded in the background.
+		///
+		/// Requesting a resource that is already queued returns another
+		/// handle to the same load.
+		///
+		/// @param cache     The cache the resource is stored within.
+		/// @param type      The type of the resource, keeping the names of the loads unique.
+		/// @param filename  The file to load the resource from.
+		/// @param loaded    Invoked on the render thread with the cached resource, may be empty.
+		///
+		/// @returns         A handle to the load.
+		///
+		////////////////////////////////////////////////////////////
+		template <typename T>
+		AsyncHandle<T> queueLoad(ResourceCache<T>& cache, const std::string& type, const std::string& filename,
+			const std::function<void(T*)>& loaded);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Advances the loads, invoked on the render thread.
+		///
+		/// The resources of new loads are created and prepared on the
+		/// thread pool. Prepared resources whose dependencies have loaded
+		/// are loaded and added to their cache, up to LOADS_PER_FRAME
+		/// resources are loaded each frame.
+		///
+		////////////////////////////////////////////////////////////
+		void processLoads();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Loads a prepared resource, invoked on the render thread.
+		///
+		/// @param load  The load to finish.
+		///
+		////////////////////////////////////////////////////////////
+		void finishLoad(AsyncLoad_t& load);
 
 	public:
 		//====================
@@ -127,28 +212,71 @@ namespace jackal
 		template <typename T>
 		ResourceHandle<T> get(const std::string& filename);
 
-#if _DEBUG
+		////////////////////////////////////////////////////////////
+		/// @brief Loads an object into the relevant resource cache in the background.
+		///
+		/// The method never blocks, so it can be invoked from any thread
+		/// to prefetch the resources of a level. Each resource is created
+		/// on the render thread, prepared on the thread pool and then
+		/// loaded on the render thread once update has been invoked. The
+		/// handle is pending until the resource has been added to its cache,
+		/// retrieving the same resource with get afterwards is free.
+		///
+		/// @param filename    The filename of the resource to load.
+		///
+		/// @returns           A handle to the load, pending until the resource is ready or failed.
+		///
+		////////////////////////////////////////////////////////////
+		template <typename T>
+		AsyncHandle<T> getAsync(const std::string& filename);
+
 		//====================
 		// Methods
 		//====================
 		////////////////////////////////////////////////////////////
-		/// @brief Reloads the needed shaders for additional use.
+		/// @brief Reloads the resources whose files have changed.
 		///
-		/// This method is invoked every frame, the shaders are only updated
-		/// if the external glsl shaders are altered. This allows for shaders
-		/// to be altered whilst the application is still functioning.
+		/// This method is invoked every frame. The files are watched on
+		/// a seperate thread, so the method only has work to do when a
+		/// file has been written to. Every resource loaded from a changed
+		/// file is reloaded in place, shaders are re-compiled. Release
+		/// builds never watch any files.
 		///
 		////////////////////////////////////////////////////////////
 		void reload();
-#endif
+
+		////////////////////////////////////////////////////////////
+		/// @brief Advances the resources being loaded in the background.
+		///
+		/// This method is invoked every frame. The work is queued on the
+		/// render thread, which creates the newly requested resources and
+		/// loads the resources that have been prepared.
+		///
+		////////////////////////////////////////////////////////////
+		void update();
+
+		////////////////////////////////////////////////////////////
+		/// @brief Invokes a callback when a file changes.
+		///
+		/// This is used for files that are not resources, such as config
+		/// files. The callback is invoked by reload on the calling thread.
+		///
+		/// @param filename  The virtual or relative path of the file.
+		/// @param callback  The callback to invoke when the file changes.
+		///
+		/// @returns         True if the file is being watched.
+		///
+		////////////////////////////////////////////////////////////
+		bool watch(const std::string& filename, const std::function<void()>& callback);
 
 		////////////////////////////////////////////////////////////
 		/// @brief Destroys the ResourceManager and release the retained resources
 		///
 		/// This method is typically only invoked when the application is
 		/// about to close, it clears all of the retained resources and
-		/// joins the shader watching thread if currently within debug
-		/// mode.
+		/// joins the file watching thread if currently within debug
+		/// mode. Resources that are still loading in the background are
+		/// discarded and their loads fail.
 		///
 		////////////////////////////////////////////////////////////
 		void destroy();
@@ -232,6 +360,65 @@ namespace jackal
 	template <>
 	ResourceHandle<Script> ResourceManager::get(const std::string& filename);
 
+	////////////////////////////////////////////////////////////
+	/// @brief Loads a Material object in the background.
+	///
+	/// The json file is parsed on the thread pool, which also requests
+	/// the textures and shader of the material in the background. The
+	/// material is loaded once they are no longer pending.
+	///
+	/// @param filename    The filename of the material to load.
+	///
+	/// @returns           A handle to the load of the material.
+	///
+	////////////////////////////////////////////////////////////
+	template <>
+	AsyncHandle<Material> ResourceManager::getAsync(const std::string& filename);
+
+	////////////////////////////////////////////////////////////
+	/// @brief Loads a Shader object in the background.
+	///
+	/// The json and glsl files are read on the thread pool, the program
+	/// is submitted on the render thread. Its link status is collected
+	/// as usual, the shader may be ready before the program has linked.
+	///
+	/// @param filename    The filename of the shader to load.
+	///
+	/// @returns           A handle to the load of the shader.
+	///
+	////////////////////////////////////////////////////////////
+	template <>
+	AsyncHandle<Shader> ResourceManager::getAsync(const std::string& filename);
+
+	////////////////////////////////////////////////////////////
+	/// @brief Loads a Texture object in the background.
+	///
+	/// The json file is parsed on the thread pool. The image is decoded
+	/// and uploaded as usual, the texture may be ready before its image
+	/// has been uploaded.
+	///
+	/// @param filename    The filename of the texture to load.
+	///
+	/// @returns           A handle to the load of the texture.
+	///
+	////////////////////////////////////////////////////////////
+	template <>
+	AsyncHandle<Texture> ResourceManager::getAsync(const std::string& filename);
+
+	////////////////////////////////////////////////////////////
+	/// @brief Loads a Model object in the background.
+	///
+	/// The model is imported or the cooked file is read on the thread
+	/// pool, the meshes are uploaded on the render thread.
+	///
+	/// @param filename    The filename of the model to load.
+	///
+	/// @returns           A handle to the load of the model.
+	///
+	////////////////////////////////////////////////////////////
+	template <>
+	AsyncHandle<Model> ResourceManager::getAsync(const std::string& filename);
+
 } // namespace jackal
 
 #endif//__JACKAL_RESOURCE_MANAGER_HPP__
@@ -248,9 +435,15 @@ namespace jackal
 /// textures and materials. The ResourceManager contains a number
 /// of cache classes for all the mentioned resources.
 ///
-/// The ResoureManager is also used to track the time stamps of shaders, 
-/// this is utilised to constantly hot-swap and reload shaders when the
-/// file is changed. This allows for shaders to be edited during runtime.
+/// In debug builds, the ResourceManager also watches the files of every
+/// resource it loads. Shaders, textures, materials and scripts are
+/// reloaded when their files change, so they can be edited while the
+/// application is running.
+///
+/// Materials, shaders, textures and models can also be loaded in the
+/// background with getAsync, so a level can be prefetched without the
+/// frame stalling on file reads and parsing. Scripts are always loaded
+/// with get, as the lua state belongs to the game thread.
 ///
 /// @code 
 /// using namespace jackal;
@@ -263,6 +456,10 @@ namespace jackal
 /// // Render meshes.
 /// Shader::unbind();
 ///
+/// // Prefetch a model, update is invoked every frame until it is ready.
+/// AsyncHandle<Model> model = ResourceManager::getInstance().getAsync<Model>("assets/models/crate.jmesh");
+/// ResourceManager::getInstance().update();
+///
 /// @endcode
 ///
 ////////////////////////////////////////////////////////////
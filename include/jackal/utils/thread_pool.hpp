@@ -0,0 +1,169 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __JACKAL_THREAD_POOL_HPP__
+#define __JACKAL_THREAD_POOL_HPP__
+
+//====================
+// C++ includes
+//====================
+#include <condition_variable>         // Waking the workers when a task is queued.
+#include <cstddef>                    // Sizing the ranges of a parallel loop.
+#include <functional>                 // Storing the body of a parallel loop.
+#include <future>                     // Waiting on submitted tasks.
+#include <mutex>                      // Locking the task queue.
+#include <queue>                      // Storing the tasks waiting to be executed.
+#include <thread>                     // The worker threads.
+#include <vector>                     // Storing the worker threads.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/utils/singleton.hpp> // ThreadPool is a singleton object.
+
+namespace jackal
+{
+	class ThreadPool final : public Singleton<ThreadPool>
+	{
+	private:
+		//====================
+		// Friend classes
+		//====================
+		friend class Singleton<ThreadPool>;
+
+		//====================
+		// Member variables
+		//====================
+		std::vector<std::thread>               m_workers;   ///< The threads that execute the tasks.
+		std::queue<std::packaged_task<void()>> m_tasks;     ///< Tasks waiting to be executed.
+		bool                                   m_stopping;  ///< Whether the workers have been asked to stop.
+		std::mutex                             m_mutex;     ///< Locks the task queue.
+		std::condition_variable                m_condition; ///< Signals that a task has been queued.
+
+	private:
+		//====================
+		// Ctor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Default constructor for the ThreadPool object.
+		///
+		/// A worker is started for every hardware thread except one,
+		/// which is left for the thread that submits the work.
+		///
+		////////////////////////////////////////////////////////////
+		explicit ThreadPool();
+
+		//====================
+		// Private methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief The loop executed by each worker thread.
+		////////////////////////////////////////////////////////////
+		void run();
+
+	public:
+		//====================
+		// Dtor
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Destructor for the ThreadPool object.
+		///
+		/// Every queued task is executed before the workers are joined.
+		///
+		////////////////////////////////////////////////////////////
+		~ThreadPool();
+
+		//====================
+		// Getters and setters
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Retrieves the number of worker threads.
+		///
+		/// @returns The number of workers, not including the caller.
+		///
+		////////////////////////////////////////////////////////////
+		std::size_t getWorkerCount() const;
+
+		//====================
+		// Methods
+		//====================
+		////////////////////////////////////////////////////////////
+		/// @brief Queues a task to be executed on a worker thread.
+		///
+		/// @param task  The task to execute.
+		///
+		/// @returns     A future that is ready once the task has executed.
+		///
+		////////////////////////////////////////////////////////////
+		std::future<void> submit(std::function<void()> task);
+
+		////////////////////////////////////////////////////////////
+		/// @brief Executes a loop across the worker threads.
+		///
+		/// The range is split into chunks of at least grain elements,
+		/// the workers and the calling thread claim chunks until every
+		/// chunk has been executed. The method blocks until the whole
+		/// range has been processed. As the caller executes chunks as
+		/// well, it is safe to invoke from within a worker.
+		///
+		/// @param count     The number of elements in the range.
+		/// @param grain     The minimum number of elements in a chunk.
+		/// @param function  The body of the loop, invoked with the beginning and end of each chunk.
+		///
+		////////////////////////////////////////////////////////////
+		void parallelFor(std::size_t count, std::size_t grain, const std::function<void(std::size_t, std::size_t)>& function);
+	};
+
+} // namespace jackal
+
+#endif//__JACKAL_THREAD_POOL_HPP__
+
+////////////////////////////////////////////////////////////
+/// @author Benjamin Carter
+///
+/// @class jackal::ThreadPool
+/// @ingroup utils
+///
+/// The jackal::ThreadPool owns a fixed set of worker threads
+/// that execute short tasks, such as culling or building data for
+/// the renderer. Tasks should never touch the OpenGL context, that
+/// is owned by the render thread.
+///
+/// Due to the internal use of the class, it is not exposed to the
+/// lua scripting interface.
+///
+/// @code
+/// using namespace jackal;
+///
+/// std::vector<float> values(100000);
+///
+/// ThreadPool::getInstance().parallelFor(values.size(), 1024, [&values](std::size_t begin, std::size_t end) {
+///		for (std::size_t i = begin; i < end; ++i)
+///		{
+///			values[i] = std::sqrt(static_cast<float>(i));
+///		}
+/// });
+/// @endcode
+///
+////////////////////////////////////////////////////////////
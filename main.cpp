@@ -25,17 +25,29 @@
 //====================
 // Jackal includes
 //====================
-#include <jackal/core/virtual_file_system.hpp>    // Register the common virtual paths.
-#include <jackal/core/config_file.hpp>            // Load the main configuration file. 
-#include <jackal/utils/properties.hpp>            // Load the locale for the current application.
-#include <jackal/core/window.hpp>                 // Creating test window instance.
-#include <jackal/core/camera.hpp>                 // Creating the global camera.
-#include <jackal/utils/resource_manager.hpp>      // Retrieve a shader object. 
-#include <jackal/rendering/material.hpp>          // Binding and utilising a material.   
+#include <jackal/core/virtual_file_system.hpp> // Register the common virtual paths.
+#include <jackal/core/config_file.hpp>         // Load the main configuration file. 
+#include <jackal/utils/properties.hpp>         // Load the locale for the current application.
+#include <jackal/core/window.hpp>              // Creating test window instance.
+#include <jackal/core/camera.hpp>              // Creating the global camera.
+#include <jackal/utils/resource_manager.hpp>   // Retrieve a shader object. 
+#include <jackal/rendering/material.hpp>       // Binding and utilising a material.   
 #include <jackal/scripting/scripting_manager.hpp>
 #include <jackal/scripting/scriptable.hpp>
 
 #include <jackal/rendering/model.hpp>
+#include <jackal/rendering/geometry_heap.hpp>
+#include <jackal/rendering/render_thread.hpp>
+#include <jackal/rendering/gpu_profiler.hpp>
+#include <jackal/rendering/render_statistics.hpp>
+#include <jackal/rendering/frustum_culler.hpp>
+#include <jackal/rendering/clustered_lighting.hpp>
+#include <jackal/rendering/directional_light.hpp>
+#include <jackal/rendering/point_light.hpp>
+#include <jackal/rendering/program_cache.hpp>
+#include <jackal/rendering/texture_uploader.hpp>
+#include <jackal/rendering/texture_packer.hpp>
+#include <jackal/rendering/texture_streamer.hpp>
 
 using namespace jackal;
 
@@ -64,6 +76,26 @@ int main(int argc, char** argv)
 	Window window;
 	window.create(config);
 
+	if (config.get<bool>("Window.threaded_rendering"))
+	{
+		RenderThread::getInstance().start(window);
+	}
+
+	RenderStatistics::getInstance().loadBudgets(config);
+	ProgramCache::getInstance().create(config);
+	TexturePacker::getInstance().create(config);
+	TextureStreamer::getInstance().create(config);
+	TextureUploader::getInstance().create(config);
+
+	// The render budgets can be tuned while the application is running.
+	ResourceManager::getInstance().watch("~config/main.jcfg", []() {
+		ConfigFile reloaded;
+		if (reloaded.open("~config/main.jcfg"))
+		{
+			RenderStatistics::getInstance().loadBudgets(reloaded);
+		}
+	});
+
 	Camera camera;
 	camera.create(config);
 
@@ -100,10 +132,15 @@ int main(int argc, char** argv)
 		mesh.addIndex(3 + offset);
 	}
 
+	mesh.generateLods();
 	mesh.create();
 
-	auto model = Model::find("data/models/box.obj");
-	auto material = Material::find("~assets/materials/basic-lighting-material.json");
+	// The model and material are prefetched in the background, the mesh is rendered once the material is ready.
+	AsyncHandle<Model> modelRequest = ResourceManager::getInstance().getAsync<Model>("data/models/box.obj");
+	AsyncHandle<Material> materialRequest = ResourceManager::getInstance().getAsync<Material>("~assets/materials/basic-lighting-material.json");
+
+	ResourceHandle<Model> model;
+	ResourceHandle<Material> material;
 	
 	ScriptingManager::getInstance().bind();
 
@@ -116,25 +153,97 @@ int main(int argc, char** argv)
 
 	Camera::getMain().getTransform().setPosition(0.0f, 0.0f, -2.0f);
 
+	DirectionalLight* pSun = DirectionalLight::create(Colour::white(), 1.5f, Vector3f::forward());
+	pSun->setSpecularity(Colour(1.0f, 0.0f, 0.0f, 1.0f));
+
+	PointLight* pLamp = PointLight::create(Colour(1.0f, 0.5f, 0.2f, 1.0f), 2.0f, Vector3f(1.0f, 1.0f, -1.0f), 3.0f);
+
+	auto& lighting = ClusteredLighting::getInstance();
+	lighting.setDirectionalLight(pSun);
+	lighting.add(pLamp);
+
+	FrustumCuller culler;
+	std::size_t meshIndex = culler.add(mesh.getBoundingBox().transform(t1.getTransformation()));
+
 	while (window.isRunning())
 	{
 		window.clear();
 
-		Material::bind(*material.get());
+		{
+			ProfileScope_t scope("Scene");
+
+			if (!model.get() && modelRequest.isReady())
+			{
+				model = modelRequest.get();
+			}
+
+			if (!material.get() && materialRequest.isReady())
+			{
+				material = materialRequest.get();
+			}
 
-		material->process(t1);
-		mesh.render();
+			culler.set(meshIndex, mesh.getBoundingBox().transform(t1.getTransformation()));
+			culler.cull(Frustum(camera.getViewProjection()));
+
+			if (culler.isVisible(meshIndex))
+			{
+				Vector2i windowSize = window.getSize();
+				float screenSize = culler.getScreenSize(meshIndex, camera.getViewProjection(), Vector2f(windowSize.x, windowSize.y));
+
+				// The level of detail is selected before the mesh is rendered, so the selected level is the one drawn.
+				mesh.updateLod(screenSize);
+
+				if (material.get())
+				{
+					material->requestResolution(screenSize);
+				}
+			}
+
+			lighting.update(camera);
+			TextureStreamer::getInstance().update();
+			TextureUploader::getInstance().update();
+			ResourceManager::getInstance().update();
+
+			if (material.get())
+			{
+				Material::bind(*material.get());
+
+				if (culler.isVisible(meshIndex))
+				{
+					material->process(t1);
+					mesh.render();
+				}
+
+				Material::unbind();
+			}
+		}
 
-		Material::unbind();
 		window.swap();
+		GpuProfiler::getInstance().endFrame();
+		RenderStatistics::getInstance().endFrame();
 
 		window.pollEvents();
 
 		ResourceManager::getInstance().reload();
 	}
 
+	GpuProfiler::getInstance().report();
+	GpuProfiler::getInstance().writeCSV("logs/profile.csv");
+	GpuProfiler::getInstance().destroy();
+	lighting.destroy();
+	TextureUploader::getInstance().destroy();
+	TexturePacker::getInstance().destroy();
+	TextureStreamer::getInstance().destroy();
+
+	delete pLamp;
+	delete pSun;
+
+	RenderThread::getInstance().stop();
+
 	ResourceManager::getInstance().destroy();
+	GeometryHeap::getInstance().destroy();
 	SDL_Quit();
 
-	return 0;
+	// Automated performance runs fail when any frame exceeded its render budget.
+	return RenderStatistics::getInstance().getExceededFrames() > 0 ? 1 : 0;
 }
\ No newline at end of file
@@ -0,0 +1,239 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/core/headless_context.hpp> // HeadlessContext class declaration.
+#include <jackal/utils/log.hpp>             // Logging warnings and errors.
+
+//====================
+// Additional includes
+//====================
+#ifdef JACKAL_EGL
+#include <EGL/egl.h>                        // Creating a context without a window system.
+#include <EGL/eglext.h>                     // Selecting the surfaceless platform.
+#endif
+
+namespace jackal
+{
+	//====================
+	// Local variables
+	//====================
+	static DebugLog log("logs/engine_log.txt");
+
+	//====================
+	// Ctor and dtor
+	//====================
+	////////////////////////////////////////////////////////////
+	HeadlessContext::HeadlessContext()
+		: NonCopyable(), m_pDisplay(nullptr), m_pContext(nullptr), m_framebuffer(0), m_colour(0), m_depth(0), m_size()
+	{
+	}
+
+	////////////////////////////////////////////////////////////
+	HeadlessContext::~HeadlessContext()
+	{
+		this->destroy();
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	////////////////////////////////////////////////////////////
+	bool HeadlessContext::isCreated() const
+	{
+		return m_pContext != nullptr;
+	}
+
+	////////////////////////////////////////////////////////////
+	bool HeadlessContext::setActive(bool active /*= true*/) const
+	{
+#ifdef JACKAL_EGL
+		if (!m_pContext)
+		{
+			return false;
+		}
+
+		EGLContext context = active ? static_cast<EGLContext>(m_pContext) : EGL_NO_CONTEXT;
+		if (!eglMakeCurrent(static_cast<EGLDisplay>(m_pDisplay), EGL_NO_SURFACE, EGL_NO_SURFACE, context))
+		{
+			log.error(log.function(__FUNCTION__, active), "Failed to change the EGL context:", eglGetError());
+			return false;
+		}
+
+		return true;
+#else
+		static_cast<void>(active);
+		return false;
+#endif
+	}
+
+	//====================
+	// Methods
+	//====================
+	////////////////////////////////////////////////////////////
+	bool HeadlessContext::create(const ContextSettings_t& settings)
+	{
+#ifdef JACKAL_EGL
+		this->destroy();
+
+		// The surfaceless platform does not require a window system or a GPU, e.g. Mesa llvmpipe.
+		EGLDisplay display = EGL_NO_DISPLAY;
+		auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+
+		if (getPlatformDisplay)
+		{
+			display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+		}
+
+		if (display == EGL_NO_DISPLAY)
+		{
+			display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+		}
+
+		EGLint major = 0, minor = 0;
+		if (display == EGL_NO_DISPLAY || !eglInitialize(display, &major, &minor))
+		{
+			log.error(log.function(__FUNCTION__), "Failed to initialise the EGL display:", eglGetError());
+			return false;
+		}
+
+		if (!eglBindAPI(EGL_OPENGL_API))
+		{
+			log.error(log.function(__FUNCTION__), "EGL does not support desktop OpenGL:", eglGetError());
+			eglTerminate(display);
+			return false;
+		}
+
+		const EGLint configAttributes[] = {
+			EGL_SURFACE_TYPE,    EGL_PBUFFER_BIT,
+			EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+			EGL_NONE
+		};
+
+		// Rendering goes through a framebuffer object, so any config is acceptable, or none at all.
+		EGLConfig config = nullptr;
+		EGLint count = 0;
+		if (!eglChooseConfig(display, configAttributes, &config, 1, &count) || count == 0)
+		{
+			config = nullptr;
+		}
+
+		const EGLint contextAttributes[] = {
+			EGL_CONTEXT_MAJOR_VERSION_KHR,       static_cast<EGLint>(settings.majorVersion),
+			EGL_CONTEXT_MINOR_VERSION_KHR,       static_cast<EGLint>(settings.minorVersion),
+			EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR,
+			EGL_NONE
+		};
+
+		EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttributes);
+		if (context == EGL_NO_CONTEXT)
+		{
+			log.error(log.function(__FUNCTION__), "Failed to create the EGL context:", eglGetError());
+			eglTerminate(display);
+			return false;
+		}
+
+		m_pDisplay = display;
+		m_pContext = context;
+
+		if (!this->setActive(true))
+		{
+			log.error(log.function(__FUNCTION__), "Surfaceless contexts are not supported by the EGL driver.");
+			this->destroy();
+			return false;
+		}
+
+		log.debug(log.function(__FUNCTION__), "Created EGL", major, ".", minor, "context:", eglQueryString(display, EGL_VENDOR));
+		return true;
+#else
+		static_cast<void>(settings);
+		log.error(log.function(__FUNCTION__), "Headless rendering requires the engine to be built with EGL.");
+		return false;
+#endif
+	}
+
+	////////////////////////////////////////////////////////////
+	bool HeadlessContext::createFramebuffer(const Vector2i& size, const ContextSettings_t& settings)
+	{
+		m_size = size;
+
+		glGenFramebuffers(1, &m_framebuffer);
+		glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+
+		glGenRenderbuffers(1, &m_colour);
+		glBindRenderbuffer(GL_RENDERBUFFER, m_colour);
+		glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, m_size.x, m_size.y);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_colour);
+
+		GLenum format = settings.stencilBits > 0 ? GL_DEPTH24_STENCIL8 : GL_DEPTH_COMPONENT24;
+		GLenum attachment = settings.stencilBits > 0 ? GL_DEPTH_STENCIL_ATTACHMENT : GL_DEPTH_ATTACHMENT;
+
+		glGenRenderbuffers(1, &m_depth);
+		glBindRenderbuffer(GL_RENDERBUFFER, m_depth);
+		glRenderbufferStorage(GL_RENDERBUFFER, format, m_size.x, m_size.y);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, attachment, GL_RENDERBUFFER, m_depth);
+
+		glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+		if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+		{
+			log.error(log.function(__FUNCTION__, size), "Offscreen framebuffer is incomplete.");
+			return false;
+		}
+
+		// The framebuffer is left bound, standing in for the default framebuffer.
+		glViewport(0, 0, m_size.x, m_size.y);
+		return true;
+	}
+
+	////////////////////////////////////////////////////////////
+	void HeadlessContext::destroy()
+	{
+		if (m_framebuffer)
+		{
+			glDeleteRenderbuffers(1, &m_depth);
+			glDeleteRenderbuffers(1, &m_colour);
+			glDeleteFramebuffers(1, &m_framebuffer);
+
+			m_framebuffer = m_colour = m_depth = 0;
+		}
+
+#ifdef JACKAL_EGL
+		if (m_pContext)
+		{
+			EGLDisplay display = static_cast<EGLDisplay>(m_pDisplay);
+
+			eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+			eglDestroyContext(display, static_cast<EGLContext>(m_pContext));
+			eglTerminate(display);
+		}
+#endif
+
+		m_pDisplay = nullptr;
+		m_pContext = nullptr;
+	}
+
+} // namespace jackal
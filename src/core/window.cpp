@@ -22,19 +22,26 @@
 //
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+//====================
+// C++ includes
+//==================== 
+#include <iostream>                           // Printing the benchmark statistics.
+#include <sstream>                            // Formatting the benchmark statistics.
+
 //====================
 // Jackal includes
 //==================== 
-#include <jackal/core/window.hpp>      // Window class declaration. 
-#include <jackal/utils/log.hpp>        // Logging warnings and errors.
-#include <jackal/utils/constants.hpp>  // Constant log location.
-#include <jackal/core/config_file.hpp> // ConfigFile variable retrieval.
+#include <jackal/core/window.hpp>             // Window class declaration. 
+#include <jackal/utils/log.hpp>               // Logging warnings and errors.
+#include <jackal/utils/constants.hpp>         // Constant log location.
+#include <jackal/core/config_file.hpp>        // ConfigFile variable retrieval.
+#include <jackal/rendering/render_thread.hpp> // Executing the window commands on the render thread.
 
 //====================
 // Additional includes
 //==================== 
-#include <GL/glew.h>                   // Initialising GLEW context.
-#include <SDL2/SDL_image.h>            // Initializing SDL image.
+#include <GL/glew.h>                          // Initialising GLEW context.
+#include <SDL2/SDL_image.h>                   // Initializing SDL image.
 
 namespace jackal
 {
@@ -54,7 +61,7 @@ namespace jackal
 	////////////////////////////////////////////////////////////
 	Window::Window()
 		: m_pWindow(nullptr), m_context(), m_title(), m_position(), m_size(),
-			m_settings(), m_running(false)
+			m_settings(), m_running(false), m_headless(false), m_offscreen(), m_benchmark(0), m_output(), m_timer()
 	{
 	}
 
@@ -73,6 +80,89 @@ namespace jackal
         }
 	}
 
+	//====================
+	// Private methods
+	//==================== 
+	////////////////////////////////////////////////////////////
+	bool Window::createHeadless(const ContextSettings_t& settings)
+	{
+		if (SDL_Init(SDL_INIT_TIMER))
+		{
+			log.error(log.function(__FUNCTION__), "SDL failed to initialize:", SDL_GetError());
+			return false;
+		}
+
+		if (IMG_Init(IMG_INIT_PNG | IMG_INIT_JPG) == 0)
+		{
+			log.error(log.function(__FUNCTION__), "SDL image failed to initialize:", IMG_GetError());
+			return false;
+		}
+
+		if (!m_offscreen.create(settings))
+		{
+			log.error(log.function(__FUNCTION__), "Failed to create the headless context.");
+			return false;
+		}
+
+		glewExperimental = GL_TRUE;
+		GLenum error = glewInit();
+
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+		// GLEW loads the core entry points before it looks for a GLX display, which EGL does not need.
+		if (error == GLEW_ERROR_NO_GLX_DISPLAY)
+		{
+			error = GLEW_OK;
+		}
+#endif
+
+		if (error != GLEW_OK)
+		{
+			log.error(log.function(__FUNCTION__), "GLEW failed to initialize:", glewGetErrorString(error));
+			return false;
+		}
+
+		if (!m_offscreen.createFramebuffer(m_size, settings))
+		{
+			return false;
+		}
+
+		glEnable(GL_BLEND);
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		glEnable(GL_DEPTH_TEST);
+
+		m_running = true;
+		if (!m_pMain)
+		{
+			m_pMain = this;
+		}
+
+		log.debug(log.function(__FUNCTION__), "Created headless:", glGetString(GL_RENDERER));
+		return true;
+	}
+
+	////////////////////////////////////////////////////////////
+	void Window::reportBenchmark() const
+	{
+		FrameStatistics_t statistics = m_timer.getStatistics();
+
+		std::stringstream ss;
+		ss << "frames: " << statistics.frames
+		   << " min: " << statistics.minimum << "ms"
+		   << " avg: " << statistics.average << "ms"
+		   << " median: " << statistics.median << "ms"
+		   << " p95: " << statistics.p95 << "ms"
+		   << " p99: " << statistics.p99 << "ms"
+		   << " max: " << statistics.maximum << "ms";
+
+		log.debug(log.function(__FUNCTION__), "Benchmark", ss.str());
+		std::cout << "Benchmark " << ss.str() << std::endl;
+
+		if (!m_output.empty())
+		{
+			m_timer.writeCSV(m_output);
+		}
+	}
+
 	//====================
 	// Getters and setters
 	//==================== 
@@ -133,6 +223,37 @@ namespace jackal
 		return m_running;
 	}
 
+	////////////////////////////////////////////////////////////
+	bool Window::isHeadless() const
+	{
+		return m_headless;
+	}
+
+	////////////////////////////////////////////////////////////
+	void Window::setBenchmark(unsigned int frames, const std::string& output, bool headless /*= false*/)
+	{
+		m_benchmark = frames;
+		m_output = output;
+		m_headless = headless;
+	}
+
+	////////////////////////////////////////////////////////////
+	bool Window::setActive(bool active /*= true*/) const
+	{
+		if (m_headless)
+		{
+			return m_offscreen.setActive(active);
+		}
+
+		if (SDL_GL_MakeCurrent(m_pWindow, active ? m_context : nullptr) != 0)
+		{
+			log.error(log.function(__FUNCTION__, active), "Failed to change the OpenGL context:", SDL_GetError());
+			return false;
+		}
+
+		return true;
+	}
+
 	//====================
 	// Methods
 	//==================== 
@@ -143,6 +264,11 @@ namespace jackal
 		m_position = position;
 		m_size = size;
 
+		if (m_headless)
+		{
+			return this->createHeadless(settings);
+		}
+
 		if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER | SDL_INIT_AUDIO))
 		{
 			log.error(log.function(__FUNCTION__, title, position, size), "SDL failed to initialize:", SDL_GetError());
@@ -213,6 +339,10 @@ namespace jackal
 		settings.majorVersion = config.get<unsigned int>("ContextSettings.major_version");
 		settings.minorVersion = config.get<unsigned int>("ContextSettings.minor_version");
 
+		this->setBenchmark(config.get<unsigned int>("Window.benchmark_frames"),
+		                   config.get<std::string>("Window.benchmark_output"),
+		                   config.get<bool>("Window.headless"));
+
 		return this->create(config.get<std::string>("Window.title"),
 		                    config.get<Vector2i>("Window.position"),
 		                    config.get<Vector2i>("Window.size"),
@@ -222,6 +352,26 @@ namespace jackal
     ////////////////////////////////////////////////////////////
     void Window::pollEvents()
     {
+        if (m_benchmark > 0)
+        {
+            if (m_timer.getCount() == 0)
+            {
+                m_timer.reset(m_benchmark);
+            }
+
+            m_timer.tick();
+            if (m_timer.getCount() >= m_benchmark)
+            {
+                this->reportBenchmark();
+                this->close();
+            }
+        }
+
+        if (m_headless)
+        {
+            return;
+        }
+
         SDL_Event e;
 
         while (SDL_PollEvent(&e))
@@ -244,14 +394,30 @@ namespace jackal
     ////////////////////////////////////////////////////////////
     void Window::clear() const
     {
-        glClearColor(0.5, 0.5, 0.5, 1.0);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        RenderThread::getInstance().enqueue([]() {
+            glClearColor(0.5, 0.5, 0.5, 1.0);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        });
     }
 
     ////////////////////////////////////////////////////////////
     void Window::swap() const
     {
-        SDL_GL_SwapWindow(m_pWindow);
+        SDL_Window* pWindow = m_pWindow;
+        bool headless = m_headless;
+        RenderThread::getInstance().enqueue([pWindow, headless]() {
+            // Offscreen frames are not presented, finishing them keeps the frame times honest.
+            if (headless)
+            {
+                glFinish();
+            }
+            else
+            {
+                SDL_GL_SwapWindow(pWindow);
+            }
+        });
+
+        RenderThread::getInstance().submit();
     }
 
 } // namespace jackal
\ No newline at end of file
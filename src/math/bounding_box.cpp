@@ -0,0 +1,148 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//====================
+// C++ includes
+//====================
+#include <cmath>                        // Taking the absolute value of the matrix.
+#include <limits>                       // The initial corners of an empty box.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/math/bounding_box.hpp> // BoundingBox class declaration.
+
+namespace jackal
+{
+	//====================
+	// Ctor and dtor
+	//====================
+	////////////////////////////////////////////////////////////
+	BoundingBox::BoundingBox()
+		: minimum(std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max()),
+		  maximum(-std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max())
+	{
+	}
+
+	////////////////////////////////////////////////////////////
+	BoundingBox::BoundingBox(const Vector3f& minimum, const Vector3f& maximum)
+		: minimum(minimum), maximum(maximum)
+	{
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	////////////////////////////////////////////////////////////
+	Vector3f BoundingBox::getCentre() const
+	{
+		return (minimum + maximum) * 0.5f;
+	}
+
+	////////////////////////////////////////////////////////////
+	Vector3f BoundingBox::getExtents() const
+	{
+		return (maximum - minimum) * 0.5f;
+	}
+
+	////////////////////////////////////////////////////////////
+	float BoundingBox::getSurfaceArea() const
+	{
+		if (!this->isValid())
+		{
+			return 0.0f;
+		}
+
+		Vector3f size = maximum - minimum;
+		return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+	}
+
+	////////////////////////////////////////////////////////////
+	bool BoundingBox::isValid() const
+	{
+		return minimum.x <= maximum.x && minimum.y <= maximum.y && minimum.z <= maximum.z;
+	}
+
+	//====================
+	// Methods
+	//====================
+	////////////////////////////////////////////////////////////
+	void BoundingBox::expand(const Vector3f& point)
+	{
+		minimum = Vector3f::minimum(minimum, point);
+		maximum = Vector3f::maximum(maximum, point);
+	}
+
+	////////////////////////////////////////////////////////////
+	void BoundingBox::merge(const BoundingBox& box)
+	{
+		if (box.isValid())
+		{
+			minimum = Vector3f::minimum(minimum, box.minimum);
+			maximum = Vector3f::maximum(maximum, box.maximum);
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	bool BoundingBox::intersects(const BoundingBox& box) const
+	{
+		return minimum.x <= box.maximum.x && maximum.x >= box.minimum.x &&
+		       minimum.y <= box.maximum.y && maximum.y >= box.minimum.y &&
+		       minimum.z <= box.maximum.z && maximum.z >= box.minimum.z;
+	}
+
+	////////////////////////////////////////////////////////////
+	bool BoundingBox::contains(const BoundingBox& box) const
+	{
+		return minimum.x <= box.minimum.x && maximum.x >= box.maximum.x &&
+		       minimum.y <= box.minimum.y && maximum.y >= box.maximum.y &&
+		       minimum.z <= box.minimum.z && maximum.z >= box.maximum.z;
+	}
+
+	////////////////////////////////////////////////////////////
+	BoundingBox BoundingBox::transform(const Matrix4& matrix) const
+	{
+		if (!this->isValid())
+		{
+			return BoundingBox();
+		}
+
+		Vector3f centre = this->getCentre();
+		Vector3f extents = this->getExtents();
+
+		// The matrix is stored by column, m[column][row].
+		Vector3f newCentre(
+			matrix.m[0][0] * centre.x + matrix.m[1][0] * centre.y + matrix.m[2][0] * centre.z + matrix.m[3][0],
+			matrix.m[0][1] * centre.x + matrix.m[1][1] * centre.y + matrix.m[2][1] * centre.z + matrix.m[3][1],
+			matrix.m[0][2] * centre.x + matrix.m[1][2] * centre.y + matrix.m[2][2] * centre.z + matrix.m[3][2]);
+
+		Vector3f newExtents(
+			std::abs(matrix.m[0][0]) * extents.x + std::abs(matrix.m[1][0]) * extents.y + std::abs(matrix.m[2][0]) * extents.z,
+			std::abs(matrix.m[0][1]) * extents.x + std::abs(matrix.m[1][1]) * extents.y + std::abs(matrix.m[2][1]) * extents.z,
+			std::abs(matrix.m[0][2]) * extents.x + std::abs(matrix.m[1][2]) * extents.y + std::abs(matrix.m[2][2]) * extents.z);
+
+		return BoundingBox(newCentre - newExtents, newCentre + newExtents);
+	}
+
+} // namespace jackal
@@ -0,0 +1,74 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//====================
+// C++ includes
+//====================
+#include <cmath>                           // Calculating the radius.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/math/bounding_sphere.hpp> // BoundingSphere class declaration.
+
+namespace jackal
+{
+	//====================
+	// Ctor and dtor
+	//====================
+	////////////////////////////////////////////////////////////
+	BoundingSphere::BoundingSphere()
+		: centre(), radius(-1.0f)
+	{
+	}
+
+	////////////////////////////////////////////////////////////
+	BoundingSphere::BoundingSphere(const Vector3f& centre, float radius)
+		: centre(centre), radius(radius)
+	{
+	}
+
+	////////////////////////////////////////////////////////////
+	BoundingSphere::BoundingSphere(const BoundingBox& box)
+		: centre(), radius(-1.0f)
+	{
+		if (box.isValid())
+		{
+			Vector3f extents = box.getExtents();
+
+			centre = box.getCentre();
+			radius = std::sqrt(Vector3f::dot(extents, extents));
+		}
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	////////////////////////////////////////////////////////////
+	bool BoundingSphere::isValid() const
+	{
+		return radius >= 0.0f;
+	}
+
+} // namespace jackal
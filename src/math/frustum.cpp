@@ -0,0 +1,142 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//====================
+// C++ includes
+//====================
+#include <cmath>                   // Normalising the planes.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/math/frustum.hpp> // Frustum class declaration.
+
+namespace jackal
+{
+	//====================
+	// Static variables
+	//====================
+	const int Frustum::PLANES;
+
+	//====================
+	// Ctor and dtor
+	//====================
+	////////////////////////////////////////////////////////////
+	Frustum::Frustum()
+		: m_planes()
+	{
+		m_planes.fill(Vector4f::zero());
+	}
+
+	////////////////////////////////////////////////////////////
+	Frustum::Frustum(const Matrix4& viewProjection)
+		: m_planes()
+	{
+		this->extract(viewProjection);
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	////////////////////////////////////////////////////////////
+	const Vector4f& Frustum::getPlane(eFrustumPlane plane) const
+	{
+		return m_planes[static_cast<int>(plane)];
+	}
+
+	//====================
+	// Methods
+	//====================
+	////////////////////////////////////////////////////////////
+	void Frustum::extract(const Matrix4& viewProjection)
+	{
+		Vector4f x = viewProjection.getRow(0);
+		Vector4f y = viewProjection.getRow(1);
+		Vector4f z = viewProjection.getRow(2);
+		Vector4f w = viewProjection.getRow(3);
+
+		m_planes[static_cast<int>(eFrustumPlane::LEFT)] = w + x;
+		m_planes[static_cast<int>(eFrustumPlane::RIGHT)] = w - x;
+		m_planes[static_cast<int>(eFrustumPlane::BOTTOM)] = w + y;
+		m_planes[static_cast<int>(eFrustumPlane::TOP)] = w - y;
+		m_planes[static_cast<int>(eFrustumPlane::FRONT)] = w + z;
+		m_planes[static_cast<int>(eFrustumPlane::BACK)] = w - z;
+
+		for (auto& plane : m_planes)
+		{
+			float length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+			if (length > 0.0f)
+			{
+				plane /= length;
+			}
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	bool Frustum::contains(const Vector3f& point) const
+	{
+		for (const auto& plane : m_planes)
+		{
+			if (plane.x * point.x + plane.y * point.y + plane.z * point.z + plane.w < 0.0f)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	////////////////////////////////////////////////////////////
+	bool Frustum::intersects(const BoundingBox& box) const
+	{
+		for (const auto& plane : m_planes)
+		{
+			float x = plane.x > 0.0f ? box.maximum.x : box.minimum.x;
+			float y = plane.y > 0.0f ? box.maximum.y : box.minimum.y;
+			float z = plane.z > 0.0f ? box.maximum.z : box.minimum.z;
+
+			if (plane.x * x + plane.y * y + plane.z * z + plane.w < 0.0f)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	////////////////////////////////////////////////////////////
+	bool Frustum::intersects(const BoundingSphere& sphere) const
+	{
+		for (const auto& plane : m_planes)
+		{
+			if (plane.x * sphere.centre.x + plane.y * sphere.centre.y + plane.z * sphere.centre.z + plane.w < -sphere.radius)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+} // namespace jackal
@@ -0,0 +1,146 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//====================
+// C++ includes
+//====================
+#include <algorithm> // Clipping the ray against each slab.
+#include <cmath>     // Normalising the direction.
+#include <limits>    // Handling directions parallel to an axis.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/math/ray.hpp> // Ray class declaration.
+
+namespace jackal
+{
+	//====================
+	// Ctor and dtor
+	//====================
+	////////////////////////////////////////////////////////////
+	Ray::Ray()
+		: origin(), direction(Vector3f::forward())
+	{
+	}
+
+	////////////////////////////////////////////////////////////
+	Ray::Ray(const Vector3f& origin, const Vector3f& direction)
+		: origin(origin), direction(direction)
+	{
+		float length = std::sqrt(Vector3f::dot(direction, direction));
+		if (length > 0.0f)
+		{
+			this->direction /= length;
+		}
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	////////////////////////////////////////////////////////////
+	Vector3f Ray::getPoint(float distance) const
+	{
+		return origin + direction * distance;
+	}
+
+	//====================
+	// Methods
+	//====================
+	////////////////////////////////////////////////////////////
+	bool Ray::intersects(const BoundingBox& box, float& distance) const
+	{
+		if (!box.isValid())
+		{
+			return false;
+		}
+
+		const float origins[3] = { origin.x, origin.y, origin.z };
+		const float directions[3] = { direction.x, direction.y, direction.z };
+		const float minimums[3] = { box.minimum.x, box.minimum.y, box.minimum.z };
+		const float maximums[3] = { box.maximum.x, box.maximum.y, box.maximum.z };
+
+		float nearest = 0.0f;
+		float furthest = std::numeric_limits<float>::max();
+
+		// The ray is clipped against the pair of planes on each axis.
+		for (int i = 0; i < 3; ++i)
+		{
+			if (std::abs(directions[i]) < 1.0e-8f)
+			{
+				if (origins[i] < minimums[i] || origins[i] > maximums[i])
+				{
+					return false;
+				}
+
+				continue;
+			}
+
+			float inverse = 1.0f / directions[i];
+			float first = (minimums[i] - origins[i]) * inverse;
+			float second = (maximums[i] - origins[i]) * inverse;
+
+			nearest = std::max(nearest, std::min(first, second));
+			furthest = std::min(furthest, std::max(first, second));
+
+			if (nearest > furthest)
+			{
+				return false;
+			}
+		}
+
+		distance = nearest;
+		return true;
+	}
+
+	////////////////////////////////////////////////////////////
+	bool Ray::intersects(const BoundingSphere& sphere, float& distance) const
+	{
+		if (!sphere.isValid())
+		{
+			return false;
+		}
+
+		Vector3f offset = origin - sphere.centre;
+
+		float b = Vector3f::dot(offset, direction);
+		float c = Vector3f::dot(offset, offset) - sphere.radius * sphere.radius;
+
+		// The origin is outside of the sphere and facing away from it.
+		if (c > 0.0f && b > 0.0f)
+		{
+			return false;
+		}
+
+		float discriminant = b * b - c;
+		if (discriminant < 0.0f)
+		{
+			return false;
+		}
+
+		distance = std::max(-b - std::sqrt(discriminant), 0.0f);
+		return true;
+	}
+
+} // namespace jackal
@@ -22,38 +22,33 @@
 //
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
-//====================
-// C++ includes
-//====================
-#include <cstddef>						 // Calculating memory offset of vertices.
-
 //====================
 // Jackal includes
 //====================
-#include <jackal/rendering/buffer.hpp>   // Buffer class declaration.
-#include <jackal/rendering/vertex.hpp>   // Vertex_t size use.
+#include <jackal/rendering/buffer.hpp>            // Buffer class declaration.
+#include <jackal/rendering/draw_command.hpp>      // DrawCommand_t size use.
+#include <jackal/rendering/render_statistics.hpp> // Counting the bytes uploaded.
 
 namespace jackal
 {
-	//====================
-	// Local variables
-	//====================
-	const GLvoid* POS_OFFSET = reinterpret_cast<const GLvoid*>(offsetof(Vertex_t, position));
-	const GLvoid* NOR_OFFSET = reinterpret_cast<const GLvoid*>(offsetof(Vertex_t, normal));
-	const GLvoid* UV_OFFSET = reinterpret_cast<const GLvoid*>(offsetof(Vertex_t, uv));
-
 	//====================
 	// Ctor and dtor
 	//====================
 	////////////////////////////////////////////////////////////
 	Buffer::Buffer()
-		: m_ID(0), m_type(eBufferType::VERTEX)
+		: m_ID(0), m_type(eBufferType::VERTEX), m_layout(VertexLayout::standard())
 	{
 	}
 
 	////////////////////////////////////////////////////////////
 	Buffer::Buffer(eBufferType type)
-		: m_ID(0), m_type(type)
+		: m_ID(0), m_type(type), m_layout(VertexLayout::standard())
+	{
+	}
+
+	////////////////////////////////////////////////////////////
+	Buffer::Buffer(const VertexLayout& layout)
+		: m_ID(0), m_type(eBufferType::VERTEX), m_layout(layout)
 	{
 	}
 
@@ -93,6 +88,12 @@ namespace jackal
 		return m_type;
 	}
 
+	////////////////////////////////////////////////////////////
+	const VertexLayout& Buffer::getLayout() const
+	{
+		return m_layout;
+	}
+
 	////////////////////////////////////////////////////////////
 	bool Buffer::isCreated() const
 	{
@@ -108,16 +109,9 @@ namespace jackal
 		switch (m_type)
 		{
 		case eBufferType::VERTEX:
-			glGenBuffers(1, &m_ID);
-			glEnableVertexAttribArray(0);
-			glEnableVertexAttribArray(1);
-			glEnableVertexAttribArray(2);
-			glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex_t), POS_OFFSET);
-			glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex_t), NOR_OFFSET);
-			glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex_t), UV_OFFSET);
-			break;
-
 		case eBufferType::INDEX:
+		case eBufferType::SHORT_INDEX:
+		case eBufferType::INDIRECT:
 			glGenBuffers(1, &m_ID);
 			break;
 
@@ -132,12 +126,9 @@ namespace jackal
 	{
 		if (m_ID)
 		{
-			if (m_type == eBufferType::VERTEX || m_type == eBufferType::INDEX)
+			// The attribute state belongs to the vertex array, so deleting a buffer needn't disable any attributes.
+			if (m_type != eBufferType::ARRAY)
 			{
-				glDisableVertexAttribArray(0);
-				glDisableVertexAttribArray(1);
-				glDisableVertexAttribArray(2);
-
 				glDeleteBuffers(1, &m_ID);
 				m_ID = 0;
 			}
@@ -152,15 +143,62 @@ namespace jackal
 	////////////////////////////////////////////////////////////
 	void Buffer::allocate(const void* pData, int count)
 	{
+		GLsizeiptr size = 0;
+
 		// vertex arrays don't need info allocated.
 		switch (m_type)
 		{
 		case eBufferType::VERTEX:
-			glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex_t) * count, pData, GL_STATIC_DRAW);
+			size = m_layout.getStride() * count;
+			glBufferData(GL_ARRAY_BUFFER, size, pData, GL_STATIC_DRAW);
 			break;
 
 		case eBufferType::INDEX:
-			glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLuint) * count, pData, GL_STATIC_DRAW);
+			size = sizeof(GLuint) * count;
+			glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, pData, GL_STATIC_DRAW);
+			break;
+
+		case eBufferType::SHORT_INDEX:
+			size = sizeof(GLushort) * count;
+			glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, pData, GL_STATIC_DRAW);
+			break;
+
+		case eBufferType::INDIRECT:
+			size = sizeof(DrawCommand_t) * count;
+			glBufferData(GL_DRAW_INDIRECT_BUFFER, size, pData, GL_STATIC_DRAW);
+			break;
+		}
+
+		// Reserving storage without any data uploads nothing.
+		if (pData)
+		{
+			RenderStatistics::getInstance().add(eRenderCounter::BUFFER_BYTES, size);
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void Buffer::update(const void* pData, int offset, int count)
+	{
+		switch (m_type)
+		{
+		case eBufferType::VERTEX:
+			glBufferSubData(GL_ARRAY_BUFFER, m_layout.getStride() * offset, m_layout.getStride() * count, pData);
+			RenderStatistics::getInstance().add(eRenderCounter::BUFFER_BYTES, m_layout.getStride() * count);
+			break;
+
+		case eBufferType::INDEX:
+			glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLuint) * offset, sizeof(GLuint) * count, pData);
+			RenderStatistics::getInstance().add(eRenderCounter::BUFFER_BYTES, sizeof(GLuint) * count);
+			break;
+
+		case eBufferType::SHORT_INDEX:
+			glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLushort) * offset, sizeof(GLushort) * count, pData);
+			RenderStatistics::getInstance().add(eRenderCounter::BUFFER_BYTES, sizeof(GLushort) * count);
+			break;
+
+		case eBufferType::INDIRECT:
+			glBufferSubData(GL_DRAW_INDIRECT_BUFFER, sizeof(DrawCommand_t) * offset, sizeof(DrawCommand_t) * count, pData);
+			RenderStatistics::getInstance().add(eRenderCounter::BUFFER_BYTES, sizeof(DrawCommand_t) * count);
 			break;
 		}
 	}
@@ -172,16 +210,18 @@ namespace jackal
 		{
 		case eBufferType::VERTEX:
 			glBindBuffer(GL_ARRAY_BUFFER, buffer.getID());
-			glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex_t), POS_OFFSET);
-			glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex_t), NOR_OFFSET);
-			glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex_t), UV_OFFSET);
-
+			buffer.getLayout().apply();
 			break;
 
 		case eBufferType::INDEX:
+		case eBufferType::SHORT_INDEX:
 			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer.getID());
 			break;
 
+		case eBufferType::INDIRECT:
+			glBindBuffer(GL_DRAW_INDIRECT_BUFFER, buffer.getID());
+			break;
+
 		case eBufferType::ARRAY:
 			glBindVertexArray(buffer.getID());
 			break;
@@ -198,9 +238,14 @@ namespace jackal
 			break;
 
 		case eBufferType::INDEX:
+		case eBufferType::SHORT_INDEX:
 			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 			break;
 
+		case eBufferType::INDIRECT:
+			glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+			break;
+
 		case eBufferType::ARRAY:
 			glBindVertexArray(0);
 			break;
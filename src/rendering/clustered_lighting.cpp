@@ -0,0 +1,407 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//====================
+// C++ includes
+//====================
+#include <algorithm> // Removing lights and bounding the clusters.
+#include <cmath>     // Distributing the depth slices exponentially.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/rendering/clustered_lighting.hpp> // ClusteredLighting class declaration.
+#include <jackal/rendering/directional_light.hpp>  // The light shading every pixel.
+#include <jackal/rendering/point_light.hpp>        // Packing the point lights.
+#include <jackal/rendering/spot_light.hpp>         // Packing the spot lights.
+#include <jackal/rendering/material.hpp>           // The texture units used by the material.
+#include <jackal/rendering/render_thread.hpp>      // Uploading the buffers on the render thread.
+#include <jackal/rendering/render_statistics.hpp>  // Counting the bytes uploaded.
+#include <jackal/core/camera.hpp>                  // The camera the clusters are built from.
+#include <jackal/utils/thread_pool.hpp>            // Building each depth slice in parallel.
+#include <jackal/utils/log.hpp>                    // Logging invalid cameras.
+
+namespace jackal
+{
+	//====================
+	// Local variables
+	//====================
+	static DebugLog log("logs/engine_log.txt");
+	static const float DEGREES_TO_RADIANS = 3.14159265f / 180.0f; // Converting the angles of the spot lights.
+
+	static_assert(ClusteredLighting::TEXTURE_UNIT >= MAX_TEXTURES, "The cluster textures overlap the material textures.");
+
+	//====================
+	// Static variables
+	//====================
+	const int ClusteredLighting::TILES_X;
+	const int ClusteredLighting::TILES_Y;
+	const int ClusteredLighting::SLICES;
+	const int ClusteredLighting::CLUSTERS;
+	const int ClusteredLighting::LIGHT_TEXELS;
+	const int ClusteredLighting::TEXTURE_UNIT;
+
+	//====================
+	// Ctor and dtor
+	//====================
+	////////////////////////////////////////////////////////////
+	ClusteredLighting::ClusteredLighting()
+		: Singleton<ClusteredLighting>(), m_pDirectional(nullptr), m_pointLights(), m_spotLights(), m_bounds(), m_lights(),
+		  m_slices(), m_grid(), m_indices(), m_view(), m_screenSize(), m_near(0.0f), m_far(0.0f), m_sliceScale(0.0f),
+		  m_buffers(), m_textures()
+	{
+		m_buffers.fill(0);
+		m_textures.fill(0);
+	}
+
+	//====================
+	// Private methods
+	//====================
+	////////////////////////////////////////////////////////////
+	void ClusteredLighting::gatherLights()
+	{
+		m_bounds.clear();
+		m_lights.clear();
+
+		Vector4f row0 = m_view.getRow(0);
+		Vector4f row1 = m_view.getRow(1);
+		Vector4f row2 = m_view.getRow(2);
+
+		auto toView = [&row0, &row1, &row2](const Vector3f& point) {
+			return Vector3f(row0.x * point.x + row0.y * point.y + row0.z * point.z + row0.w,
+			                row1.x * point.x + row1.y * point.y + row1.z * point.z + row1.w,
+			                row2.x * point.x + row2.y * point.y + row2.z * point.z + row2.w);
+		};
+
+		auto pack = [this](const ILight& light, const Vector3f& position, float range, const Vector3f& direction, float cosInner, float cosOuter) {
+			const Colour& colour = light.getColour();
+			const Colour& specularity = light.getSpecularity();
+
+			m_lights.insert(m_lights.end(), {
+				position.x,    position.y,    position.z,    range,
+				colour.r,      colour.g,      colour.b,      light.getIntensity(),
+				specularity.r, specularity.g, specularity.b, cosInner,
+				direction.x,   direction.y,   direction.z,   cosOuter
+			});
+		};
+
+		for (const PointLight* pLight : m_pointLights)
+		{
+			BoundingSphere bounds(toView(pLight->getPosition()), pLight->getRange());
+			if (bounds.centre.z + bounds.radius < m_near || bounds.centre.z - bounds.radius > m_far)
+			{
+				continue;
+			}
+
+			// A zero direction and negative cone makes the shader treat the light as omnidirectional.
+			m_bounds.push_back(bounds);
+			pack(*pLight, pLight->getPosition(), pLight->getRange(), Vector3f::zero(), -1.0f, -2.0f);
+		}
+
+		for (const SpotLight* pLight : m_spotLights)
+		{
+			BoundingSphere bounds = pLight->getBoundingSphere();
+			bounds.centre = toView(bounds.centre);
+
+			if (bounds.centre.z + bounds.radius < m_near || bounds.centre.z - bounds.radius > m_far)
+			{
+				continue;
+			}
+
+			m_bounds.push_back(bounds);
+			pack(*pLight, pLight->getPosition(), pLight->getRange(), pLight->getDirection(),
+				std::cos(pLight->getInnerAngle() * DEGREES_TO_RADIANS), std::cos(pLight->getOuterAngle() * DEGREES_TO_RADIANS));
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void ClusteredLighting::assignSlice(int slice, float scaleX, float scaleY)
+	{
+		std::vector<std::uint32_t>& indices = m_slices[slice];
+		indices.clear();
+
+		float ratio = m_far / m_near;
+		float zNear = m_near * std::pow(ratio, static_cast<float>(slice) / SLICES);
+		float zFar = m_near * std::pow(ratio, static_cast<float>(slice + 1) / SLICES);
+
+		// Only the lights overlapping the depth of the slice are tested against its tiles.
+		std::vector<std::uint32_t> candidates;
+		for (std::size_t i = 0; i < m_bounds.size(); ++i)
+		{
+			const BoundingSphere& bounds = m_bounds[i];
+			if (bounds.centre.z - bounds.radius <= zFar && bounds.centre.z + bounds.radius >= zNear)
+			{
+				candidates.push_back(static_cast<std::uint32_t>(i));
+			}
+		}
+
+		for (int y = 0; y < TILES_Y; ++y)
+		{
+			float bottom = -1.0f + 2.0f * y / TILES_Y;
+			float top = -1.0f + 2.0f * (y + 1) / TILES_Y;
+
+			float minY = std::min(bottom * zNear, bottom * zFar) / scaleY;
+			float maxY = std::max(top * zNear, top * zFar) / scaleY;
+
+			for (int x = 0; x < TILES_X; ++x)
+			{
+				float left = -1.0f + 2.0f * x / TILES_X;
+				float right = -1.0f + 2.0f * (x + 1) / TILES_X;
+
+				float minX = std::min(left * zNear, left * zFar) / scaleX;
+				float maxX = std::max(right * zNear, right * zFar) / scaleX;
+
+				int cluster = (slice * TILES_Y + y) * TILES_X + x;
+				m_grid[cluster * 2] = static_cast<std::uint32_t>(indices.size());
+
+				for (std::uint32_t index : candidates)
+				{
+					const BoundingSphere& bounds = m_bounds[index];
+
+					float dx = std::max(minX - bounds.centre.x, 0.0f) + std::max(bounds.centre.x - maxX, 0.0f);
+					float dy = std::max(minY - bounds.centre.y, 0.0f) + std::max(bounds.centre.y - maxY, 0.0f);
+					float dz = std::max(zNear - bounds.centre.z, 0.0f) + std::max(bounds.centre.z - zFar, 0.0f);
+
+					if (dx * dx + dy * dy + dz * dz <= bounds.radius * bounds.radius)
+					{
+						indices.push_back(index);
+					}
+				}
+
+				m_grid[cluster * 2 + 1] = static_cast<std::uint32_t>(indices.size()) - m_grid[cluster * 2];
+			}
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void ClusteredLighting::upload()
+	{
+		std::vector<float> lights(m_lights);
+		std::vector<std::uint32_t> grid(m_grid);
+		std::vector<std::uint32_t> indices(m_indices);
+
+		// Buffer textures cannot be empty, so unused buffers hold a single zeroed element.
+		if (lights.empty())
+		{
+			lights.resize(LIGHT_TEXELS * 4, 0.0f);
+		}
+
+		if (indices.empty())
+		{
+			indices.push_back(0);
+		}
+
+		RenderStatistics::getInstance().add(eRenderCounter::BUFFER_BYTES,
+			sizeof(float) * lights.size() + sizeof(std::uint32_t) * (grid.size() + indices.size()));
+		RenderStatistics::getInstance().add(eRenderCounter::TEXTURE_BINDS, BUFFERS);
+
+		RenderThread::getInstance().enqueue([this, lights = std::move(lights), grid = std::move(grid), indices = std::move(indices)]() {
+			const GLenum formats[BUFFERS] = { GL_RGBA32F, GL_RG32UI, GL_R32UI };
+			const GLvoid* data[BUFFERS] = { lights.data(), grid.data(), indices.data() };
+			const GLsizeiptr sizes[BUFFERS] = {
+				static_cast<GLsizeiptr>(sizeof(float) * lights.size()),
+				static_cast<GLsizeiptr>(sizeof(std::uint32_t) * grid.size()),
+				static_cast<GLsizeiptr>(sizeof(std::uint32_t) * indices.size())
+			};
+
+			bool created = m_buffers[0] != 0;
+			if (!created)
+			{
+				glGenBuffers(BUFFERS, m_buffers.data());
+				glGenTextures(BUFFERS, m_textures.data());
+			}
+
+			for (int i = 0; i < BUFFERS; ++i)
+			{
+				// Respecifying the storage orphans the data still being read by the previous frame.
+				glBindBuffer(GL_TEXTURE_BUFFER, m_buffers[i]);
+				glBufferData(GL_TEXTURE_BUFFER, sizes[i], data[i], GL_STREAM_DRAW);
+
+				glActiveTexture(GL_TEXTURE0 + TEXTURE_UNIT + i);
+				glBindTexture(GL_TEXTURE_BUFFER, m_textures[i]);
+
+				if (!created)
+				{
+					glTexBuffer(GL_TEXTURE_BUFFER, formats[i], m_buffers[i]);
+				}
+			}
+
+			glBindBuffer(GL_TEXTURE_BUFFER, 0);
+			glActiveTexture(GL_TEXTURE0);
+		});
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	////////////////////////////////////////////////////////////
+	void ClusteredLighting::setDirectionalLight(const DirectionalLight* pLight)
+	{
+		m_pDirectional = pLight;
+	}
+
+	////////////////////////////////////////////////////////////
+	const DirectionalLight* ClusteredLighting::getDirectionalLight() const
+	{
+		return m_pDirectional;
+	}
+
+	////////////////////////////////////////////////////////////
+	std::size_t ClusteredLighting::getVisibleCount() const
+	{
+		return m_bounds.size();
+	}
+
+	////////////////////////////////////////////////////////////
+	const Matrix4& ClusteredLighting::getView() const
+	{
+		return m_view;
+	}
+
+	////////////////////////////////////////////////////////////
+	const Vector2f& ClusteredLighting::getScreenSize() const
+	{
+		return m_screenSize;
+	}
+
+	////////////////////////////////////////////////////////////
+	float ClusteredLighting::getNear() const
+	{
+		return m_near;
+	}
+
+	////////////////////////////////////////////////////////////
+	float ClusteredLighting::getSliceScale() const
+	{
+		return m_sliceScale;
+	}
+
+	//====================
+	// Methods
+	//====================
+	////////////////////////////////////////////////////////////
+	void ClusteredLighting::add(const PointLight* pLight)
+	{
+		if (pLight)
+		{
+			m_pointLights.push_back(pLight);
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void ClusteredLighting::add(const SpotLight* pLight)
+	{
+		if (pLight)
+		{
+			m_spotLights.push_back(pLight);
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void ClusteredLighting::remove(const PointLight* pLight)
+	{
+		m_pointLights.erase(std::remove(m_pointLights.begin(), m_pointLights.end(), pLight), m_pointLights.end());
+	}
+
+	////////////////////////////////////////////////////////////
+	void ClusteredLighting::remove(const SpotLight* pLight)
+	{
+		m_spotLights.erase(std::remove(m_spotLights.begin(), m_spotLights.end(), pLight), m_spotLights.end());
+	}
+
+	////////////////////////////////////////////////////////////
+	void ClusteredLighting::clear()
+	{
+		m_pDirectional = nullptr;
+		m_pointLights.clear();
+		m_spotLights.clear();
+	}
+
+	////////////////////////////////////////////////////////////
+	void ClusteredLighting::update(const Camera& camera)
+	{
+		if (camera.getNearPlane() <= 0.0f || camera.getFarPlane() <= camera.getNearPlane())
+		{
+			log.warning(log.function(__FUNCTION__), "The camera planes cannot be divided into depth slices.");
+			return;
+		}
+
+		Matrix4 projection = camera.getProjection();
+
+		m_view = camera.getView();
+		m_screenSize = camera.getSize();
+		m_near = camera.getNearPlane();
+		m_far = camera.getFarPlane();
+		m_sliceScale = SLICES / std::log(m_far / m_near);
+
+		this->gatherLights();
+
+		m_grid.assign(CLUSTERS * 2, 0);
+		m_indices.clear();
+
+		if (!m_bounds.empty())
+		{
+			float scaleX = projection.getRow(0).x;
+			float scaleY = projection.getRow(1).y;
+
+			ThreadPool::getInstance().parallelFor(SLICES, 1, [this, scaleX, scaleY](std::size_t begin, std::size_t end) {
+				for (std::size_t slice = begin; slice < end; ++slice)
+				{
+					this->assignSlice(static_cast<int>(slice), scaleX, scaleY);
+				}
+			});
+
+			// The slices were built independently, their offsets are made global as they are joined.
+			for (int slice = 0; slice < SLICES; ++slice)
+			{
+				std::uint32_t base = static_cast<std::uint32_t>(m_indices.size());
+				for (int cluster = slice * TILES_X * TILES_Y; cluster < (slice + 1) * TILES_X * TILES_Y; ++cluster)
+				{
+					m_grid[cluster * 2] += base;
+				}
+
+				m_indices.insert(m_indices.end(), m_slices[slice].begin(), m_slices[slice].end());
+			}
+		}
+
+		this->upload();
+	}
+
+	////////////////////////////////////////////////////////////
+	void ClusteredLighting::destroy()
+	{
+		RenderThread::getInstance().invoke([this]() {
+			if (m_buffers[0])
+			{
+				glDeleteTextures(BUFFERS, m_textures.data());
+				glDeleteBuffers(BUFFERS, m_buffers.data());
+			}
+		});
+
+		m_buffers.fill(0);
+		m_textures.fill(0);
+		this->clear();
+	}
+
+} // namespace jackal
@@ -0,0 +1,253 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//====================
+// C++ includes
+//====================
+#include <algorithm> // Bounding the projected corners of a box.
+#include <limits>    // Initialising the projected bounds.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/rendering/frustum_culler.hpp> // FrustumCuller class declaration.
+#include <jackal/utils/thread_pool.hpp>        // Culling large sets of boxes in parallel.
+
+//====================
+// Additional includes
+//====================
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+	#define JACKAL_SSE 1
+	#include <xmmintrin.h>                     // Testing four boxes at once.
+#endif
+
+namespace jackal
+{
+	//====================
+	// Static variables
+	//====================
+	const int FrustumCuller::WIDTH;
+	const int FrustumCuller::GRAIN;
+
+	//====================
+	// Ctor and dtor
+	//====================
+	////////////////////////////////////////////////////////////
+	FrustumCuller::FrustumCuller()
+		: m_minX(), m_minY(), m_minZ(), m_maxX(), m_maxY(), m_maxZ(), m_visible(), m_indices(), m_count(0)
+	{
+	}
+
+	//====================
+	// Private methods
+	//====================
+	////////////////////////////////////////////////////////////
+	void FrustumCuller::cullRange(const Frustum& frustum, std::size_t begin, std::size_t end)
+	{
+		// The corner furthest along each normal is the only corner that needs testing.
+		const float* pX[Frustum::PLANES];
+		const float* pY[Frustum::PLANES];
+		const float* pZ[Frustum::PLANES];
+
+		for (int i = 0; i < Frustum::PLANES; ++i)
+		{
+			const Vector4f& plane = frustum.getPlane(static_cast<eFrustumPlane>(i));
+
+			pX[i] = plane.x > 0.0f ? m_maxX.data() : m_minX.data();
+			pY[i] = plane.y > 0.0f ? m_maxY.data() : m_minY.data();
+			pZ[i] = plane.z > 0.0f ? m_maxZ.data() : m_minZ.data();
+		}
+
+		for (std::size_t i = begin; i < end; i += WIDTH)
+		{
+#if JACKAL_SSE
+			int mask = 0xF;
+
+			for (int j = 0; j < Frustum::PLANES && mask; ++j)
+			{
+				const Vector4f& plane = frustum.getPlane(static_cast<eFrustumPlane>(j));
+
+				__m128 distance = _mm_add_ps(
+					_mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.x), _mm_loadu_ps(pX[j] + i)),
+					           _mm_mul_ps(_mm_set1_ps(plane.y), _mm_loadu_ps(pY[j] + i))),
+					_mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.z), _mm_loadu_ps(pZ[j] + i)), _mm_set1_ps(plane.w)));
+
+				mask &= _mm_movemask_ps(_mm_cmpge_ps(distance, _mm_setzero_ps()));
+			}
+
+			for (int k = 0; k < WIDTH; ++k)
+			{
+				m_visible[i + k] = (mask >> k) & 1;
+			}
+#else
+			for (std::size_t k = i; k < i + WIDTH; ++k)
+			{
+				bool visible = true;
+
+				for (int j = 0; j < Frustum::PLANES && visible; ++j)
+				{
+					const Vector4f& plane = frustum.getPlane(static_cast<eFrustumPlane>(j));
+					visible = plane.x * pX[j][k] + plane.y * pY[j][k] + plane.z * pZ[j][k] + plane.w >= 0.0f;
+				}
+
+				m_visible[k] = visible;
+			}
+#endif
+		}
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	////////////////////////////////////////////////////////////
+	void FrustumCuller::set(std::size_t index, const BoundingBox& box)
+	{
+		m_minX[index] = box.minimum.x;
+		m_minY[index] = box.minimum.y;
+		m_minZ[index] = box.minimum.z;
+		m_maxX[index] = box.maximum.x;
+		m_maxY[index] = box.maximum.y;
+		m_maxZ[index] = box.maximum.z;
+	}
+
+	////////////////////////////////////////////////////////////
+	std::size_t FrustumCuller::getCount() const
+	{
+		return m_count;
+	}
+
+	////////////////////////////////////////////////////////////
+	bool FrustumCuller::isVisible(std::size_t index) const
+	{
+		return m_visible[index] != 0;
+	}
+
+	////////////////////////////////////////////////////////////
+	float FrustumCuller::getScreenSize(std::size_t index, const Matrix4& viewProjection, const Vector2f& screenSize) const
+	{
+		Vector4f x = viewProjection.getRow(0);
+		Vector4f y = viewProjection.getRow(1);
+		Vector4f w = viewProjection.getRow(3);
+
+		float minX = std::numeric_limits<float>::max();
+		float minY = std::numeric_limits<float>::max();
+		float maxX = std::numeric_limits<float>::lowest();
+		float maxY = std::numeric_limits<float>::lowest();
+
+		for (int corner = 0; corner < 8; ++corner)
+		{
+			float px = corner & 1 ? m_maxX[index] : m_minX[index];
+			float py = corner & 2 ? m_maxY[index] : m_minY[index];
+			float pz = corner & 4 ? m_maxZ[index] : m_minZ[index];
+
+			float clipW = w.x * px + w.y * py + w.z * pz + w.w;
+			if (clipW <= std::numeric_limits<float>::epsilon())
+			{
+				return std::max(screenSize.x, screenSize.y);
+			}
+
+			float ndcX = (x.x * px + x.y * py + x.z * pz + x.w) / clipW;
+			float ndcY = (y.x * px + y.y * py + y.z * pz + y.w) / clipW;
+
+			minX = std::min(minX, ndcX);
+			minY = std::min(minY, ndcY);
+			maxX = std::max(maxX, ndcX);
+			maxY = std::max(maxY, ndcY);
+		}
+
+		// Normalised device co-ordinates span two units across the screen.
+		return std::max((maxX - minX) * 0.5f * screenSize.x, (maxY - minY) * 0.5f * screenSize.y);
+	}
+
+	////////////////////////////////////////////////////////////
+	const std::vector<std::uint32_t>& FrustumCuller::getVisible() const
+	{
+		return m_indices;
+	}
+
+	//====================
+	// Methods
+	//====================
+	////////////////////////////////////////////////////////////
+	std::size_t FrustumCuller::add(const BoundingBox& box)
+	{
+		std::size_t index = m_count++;
+
+		// The arrays are padded to a multiple of WIDTH so every block of boxes is complete.
+		if (index >= m_minX.size())
+		{
+			std::size_t size = m_minX.size() + WIDTH;
+			BoundingBox empty;
+
+			m_minX.resize(size, empty.minimum.x);
+			m_minY.resize(size, empty.minimum.y);
+			m_minZ.resize(size, empty.minimum.z);
+			m_maxX.resize(size, empty.maximum.x);
+			m_maxY.resize(size, empty.maximum.y);
+			m_maxZ.resize(size, empty.maximum.z);
+			m_visible.resize(size, 0);
+		}
+
+		this->set(index, box);
+		m_visible[index] = 1;
+
+		return index;
+	}
+
+	////////////////////////////////////////////////////////////
+	void FrustumCuller::clear()
+	{
+		m_minX.clear();
+		m_minY.clear();
+		m_minZ.clear();
+		m_maxX.clear();
+		m_maxY.clear();
+		m_maxZ.clear();
+		m_visible.clear();
+		m_indices.clear();
+		m_count = 0;
+	}
+
+	////////////////////////////////////////////////////////////
+	std::size_t FrustumCuller::cull(const Frustum& frustum)
+	{
+		std::size_t blocks = m_minX.size() / WIDTH;
+
+		ThreadPool::getInstance().parallelFor(blocks, GRAIN / WIDTH, [this, &frustum](std::size_t begin, std::size_t end) {
+			this->cullRange(frustum, begin * WIDTH, end * WIDTH);
+		});
+
+		m_indices.clear();
+		for (std::size_t i = 0; i < m_count; ++i)
+		{
+			if (m_visible[i])
+			{
+				m_indices.push_back(static_cast<std::uint32_t>(i));
+			}
+		}
+
+		return m_indices.size();
+	}
+
+} // namespace jackal
@@ -0,0 +1,264 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//====================
+// C++ includes
+//====================
+#include <algorithm>                          // Sizing pages for large geometry.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/rendering/geometry_heap.hpp> // GeometryHeap class declaration.
+#include <jackal/utils/log.hpp>               // Logging warnings and errors.
+
+namespace jackal
+{
+	//====================
+	// Local variables
+	//====================
+	static DebugLog log("logs/engine_log.txt");
+
+	//====================
+	// Static variables
+	//====================
+	const int GeometryHeap::VERTICES_PER_PAGE;
+	const int GeometryHeap::INDICES_PER_PAGE;
+	const int GeometryHeap::MAX_SHORT_VERTICES;
+
+	//====================
+	// Ctor and dtor
+	//====================
+	////////////////////////////////////////////////////////////
+	GeometryRange_t::GeometryRange_t()
+		: page(-1), baseVertex(0), vertexCount(0), firstIndex(0), indexCount(0), indexType(GL_UNSIGNED_INT)
+	{
+	}
+
+	////////////////////////////////////////////////////////////
+	GeometryHeap::Page_t::Page_t(const VertexLayout& layout, bool shortIndices)
+		: vao(eBufferType::ARRAY), vbo(layout), ibo(shortIndices ? eBufferType::SHORT_INDEX : eBufferType::INDEX), vertices(), indices(),
+		  shortIndices(shortIndices)
+	{
+	}
+
+	////////////////////////////////////////////////////////////
+	GeometryHeap::GeometryHeap()
+		: Singleton<GeometryHeap>(), m_pages(), m_boundPage(-1)
+	{
+	}
+
+	//====================
+	// Private methods
+	//====================
+	////////////////////////////////////////////////////////////
+	int GeometryHeap::createPage(const VertexLayout& layout, int vertexCapacity, int indexCapacity, bool shortIndices)
+	{
+		auto pPage = std::make_unique<Page_t>(layout, shortIndices);
+
+		pPage->vao.create();
+		Buffer::bind(pPage->vao);
+
+		pPage->vbo.create();
+		Buffer::bind(pPage->vbo);
+		pPage->vbo.allocate(nullptr, vertexCapacity);
+
+		pPage->ibo.create();
+		Buffer::bind(pPage->ibo);
+		pPage->ibo.allocate(nullptr, indexCapacity);
+
+		pPage->vertices.reset(vertexCapacity);
+		pPage->indices.reset(indexCapacity);
+
+		m_pages.push_back(std::move(pPage));
+		m_boundPage = m_pages.size() - 1;
+
+		log.debug(log.function(__FUNCTION__, layout.getStride(), vertexCapacity, indexCapacity, shortIndices), "Created geometry page", m_boundPage);
+		return m_boundPage;
+	}
+
+	////////////////////////////////////////////////////////////
+	bool GeometryHeap::allocateRange(const VertexLayout& layout, const void* pVertices, int vertexCount, const void* pIndices, int indexCount, bool shortIndices,
+		GeometryRange_t& range)
+	{
+		if (vertexCount <= 0 || indexCount <= 0)
+		{
+			log.warning(log.function(__FUNCTION__, vertexCount, indexCount), "Cannot allocate empty geometry.");
+			return false;
+		}
+
+		int vertexOffset = 0;
+		int indexOffset = 0;
+		int page = -1;
+
+		for (std::size_t i = 0; i < m_pages.size() && page < 0; i++)
+		{
+			Page_t& candidate = *m_pages[i];
+			if (candidate.shortIndices != shortIndices || candidate.vbo.getLayout() != layout || !candidate.vertices.allocate(vertexCount, vertexOffset))
+			{
+				continue;
+			}
+
+			if (!candidate.indices.allocate(indexCount, indexOffset))
+			{
+				candidate.vertices.free(vertexOffset, vertexCount);
+				continue;
+			}
+
+			page = i;
+		}
+
+		if (page < 0)
+		{
+			page = this->createPage(layout, std::max(vertexCount, VERTICES_PER_PAGE), std::max(indexCount, INDICES_PER_PAGE), shortIndices);
+			m_pages[page]->vertices.allocate(vertexCount, vertexOffset);
+			m_pages[page]->indices.allocate(indexCount, indexOffset);
+		}
+
+		// Binding the vertex buffer re-specifies the attribute pointers, so the
+		// vertex array of the page itself must be bound before uploading.
+		Page_t& target = *m_pages[page];
+		Buffer::bind(target.vao);
+		m_boundPage = page;
+
+		Buffer::bind(target.vbo);
+		target.vbo.update(pVertices, vertexOffset, vertexCount);
+
+		Buffer::bind(target.ibo);
+		target.ibo.update(pIndices, indexOffset, indexCount);
+
+		range.page = page;
+		range.baseVertex = vertexOffset;
+		range.vertexCount = vertexCount;
+		range.firstIndex = indexOffset;
+		range.indexCount = indexCount;
+		range.indexType = shortIndices ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+
+		return true;
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	////////////////////////////////////////////////////////////
+	bool GeometryRange_t::isValid() const
+	{
+		return page >= 0;
+	}
+
+	////////////////////////////////////////////////////////////
+	int GeometryHeap::getPageCount() const
+	{
+		return m_pages.size();
+	}
+
+	//====================
+	// Methods
+	//====================
+	////////////////////////////////////////////////////////////
+	bool GeometryHeap::allocate(const VertexLayout& layout, const void* pVertices, int vertexCount, const GLuint* pIndices, int indexCount,
+		GeometryRange_t& range)
+	{
+		if (vertexCount > MAX_SHORT_VERTICES || indexCount <= 0)
+		{
+			return this->allocateRange(layout, pVertices, vertexCount, pIndices, indexCount, false, range);
+		}
+
+		// Every index is relative to the first vertex of the range, so they all fit within 16 bits and halve the index fetch.
+		std::vector<GLushort> narrowed(pIndices, pIndices + indexCount);
+		return this->allocateRange(layout, pVertices, vertexCount, narrowed.data(), indexCount, true, range);
+	}
+
+	////////////////////////////////////////////////////////////
+	bool GeometryHeap::allocate(const VertexLayout& layout, const void* pVertices, int vertexCount, const GLushort* pIndices, int indexCount,
+		GeometryRange_t& range)
+	{
+		if (vertexCount > MAX_SHORT_VERTICES)
+		{
+			log.warning(log.function(__FUNCTION__, vertexCount, indexCount), "Too many vertices for 16-bit indices.");
+			return false;
+		}
+
+		return this->allocateRange(layout, pVertices, vertexCount, pIndices, indexCount, true, range);
+	}
+
+	////////////////////////////////////////////////////////////
+	void GeometryHeap::free(GeometryRange_t& range)
+	{
+		if (range.isValid() && range.page < static_cast<int>(m_pages.size()))
+		{
+			Page_t& page = *m_pages[range.page];
+			page.vertices.free(range.baseVertex, range.vertexCount);
+			page.indices.free(range.firstIndex, range.indexCount);
+		}
+
+		range = GeometryRange_t();
+	}
+
+	////////////////////////////////////////////////////////////
+	void GeometryHeap::bind(const GeometryRange_t& range)
+	{
+		this->bind(range.page);
+	}
+
+	////////////////////////////////////////////////////////////
+	void GeometryHeap::bind(int page)
+	{
+		if (page >= 0 && page != m_boundPage && page < static_cast<int>(m_pages.size()))
+		{
+			Buffer::bind(m_pages[page]->vao);
+			m_boundPage = page;
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void GeometryHeap::unbind()
+	{
+		glBindVertexArray(0);
+		m_boundPage = -1;
+	}
+
+	////////////////////////////////////////////////////////////
+	void GeometryHeap::draw(const GeometryRange_t& range)
+	{
+		if (!range.isValid())
+		{
+			return;
+		}
+
+		this->bind(range);
+
+		std::size_t indexSize = range.indexType == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint);
+		const GLvoid* pOffset = reinterpret_cast<const GLvoid*>(indexSize * range.firstIndex);
+		glDrawElementsBaseVertex(GL_TRIANGLES, range.indexCount, range.indexType, pOffset, range.baseVertex);
+	}
+
+	////////////////////////////////////////////////////////////
+	void GeometryHeap::destroy()
+	{
+		this->unbind();
+		m_pages.clear();
+	}
+
+} // namespace jackal
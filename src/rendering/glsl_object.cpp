@@ -43,7 +43,7 @@ namespace jackal
 	//====================
 	////////////////////////////////////////////////////////////
 	GLSLObject::GLSLObject()
-		: m_ID(0), m_type(0), m_filename(), m_source(), m_compiled(false)
+		: m_ID(0), m_type(0), m_filename(), m_source(), m_defines(), m_compiled(false)
 	{
 	}
 
@@ -68,6 +68,30 @@ namespace jackal
 		return m_filename;
 	}
 
+	////////////////////////////////////////////////////////////
+	GLenum GLSLObject::getType() const
+	{
+		return m_type;
+	}
+
+	////////////////////////////////////////////////////////////
+	const std::string& GLSLObject::getSource() const
+	{
+		return m_source;
+	}
+
+	////////////////////////////////////////////////////////////
+	void GLSLObject::setDefines(const std::string& defines)
+	{
+		m_defines = defines;
+	}
+
+	////////////////////////////////////////////////////////////
+	const std::string& GLSLObject::getDefines() const
+	{
+		return m_defines;
+	}
+
 	////////////////////////////////////////////////////////////
 	bool GLSLObject::isCompiled() const
 	{
@@ -88,9 +112,26 @@ namespace jackal
 		}
 
 		m_filename = reader.getAbsolutePath();
+		// A program loaded from the cache never compiles its objects, so the previous source is still held.
+		m_source.clear();
+
+		bool injected = m_defines.empty();
 		for (auto line : reader.getLines())
 		{
 			m_source.append(line + '\n');
+
+			// The version directive must be the first statement, so the defines follow it.
+			std::size_t start = line.find_first_not_of(" \t");
+			if (!injected && start != std::string::npos && line.compare(start, 8, "#version") == 0)
+			{
+				m_source.append(m_defines);
+				injected = true;
+			}
+		}
+
+		if (!injected)
+		{
+			m_source.insert(0, m_defines);
 		}
 
 		log.debug(log.function(__FUNCTION__, filename), "Parsed successfully.");
@@ -178,39 +219,58 @@ namespace jackal
 	}
 
 	////////////////////////////////////////////////////////////
-	void GLSLObject::compile()
+	void GLSLObject::submit()
 	{
 		// Create an ID with the defined type.
-		GLuint ID = glCreateShader(m_type);
+		m_ID = glCreateShader(m_type);
 		// Get the source and pass it as the source for the shader.
 		const GLchar* pSource = m_source.c_str();
-		glShaderSource(ID, 1, (const GLchar**)&pSource, nullptr);
-		// Compile the shader.
-		glCompileShader(ID);
+		glShaderSource(m_ID, 1, (const GLchar**)&pSource, nullptr);
+		// Compile the shader, the status is not queried so the driver is free to compile in the background.
+		glCompileShader(m_ID);
+	}
+
+	////////////////////////////////////////////////////////////
+	bool GLSLObject::finish()
+	{
+		if (!m_ID)
+		{
+			return false;
+		}
+
 		// Get the result of the compilation.
 		GLint status;
-		glGetShaderiv(ID, GL_COMPILE_STATUS, &status);
+		glGetShaderiv(m_ID, GL_COMPILE_STATUS, &status);
 		// Shader compilation failed.
 		if (status != GL_TRUE)
 		{
 			GLint logSize = 0;
-			glGetShaderiv(ID, GL_INFO_LOG_LENGTH, &logSize);
+			glGetShaderiv(m_ID, GL_INFO_LOG_LENGTH, &logSize);
 			// Get and log the error.
-			std::vector<GLchar> errorLog(logSize);
-			glGetShaderInfoLog(ID, logSize, &logSize, &errorLog[0]);
+			std::vector<GLchar> errorLog(logSize + 1);
+			glGetShaderInfoLog(m_ID, logSize, &logSize, &errorLog[0]);
+
+			glDeleteShader(m_ID);
+			m_ID = 0;
 
-			glDeleteShader(ID);
 			log.error(log.function(__FUNCTION__), "Failed to compile:", &errorLog[0]);
 		}
 		else
 		{	
-			m_ID = ID;
 			m_compiled = true;
 			
 			log.debug(log.function(__FUNCTION__), "Compiled successfully.");
 		}
 
 		m_source.clear();
+		return m_compiled;
+	}
+
+	////////////////////////////////////////////////////////////
+	void GLSLObject::compile()
+	{
+		this->submit();
+		this->finish();
 	}
 
 } // namespace jackal 
\ No newline at end of file
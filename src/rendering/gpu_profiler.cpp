@@ -0,0 +1,349 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//====================
+// C++ includes
+//====================
+#include <algorithm>                          // Selecting the percentile of the samples.
+#include <fstream>                            // Writing the csv file.
+#include <numeric>                            // Summing the samples.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/rendering/gpu_profiler.hpp>  // GpuProfiler class declaration.
+#include <jackal/rendering/render_thread.hpp> // Recording the queries on the render thread.
+#include <jackal/utils/log.hpp>               // Logging warnings and statistics.
+
+namespace jackal
+{
+	//====================
+	// Local variables
+	//====================
+	static DebugLog log("logs/engine_log.txt");
+
+	//====================
+	// Static variables
+	//====================
+	const int GpuProfiler::LATENCY;
+	const int GpuProfiler::SAMPLES;
+
+	//====================
+	// Ctor and dtor
+	//====================
+	////////////////////////////////////////////////////////////
+	ProfileStatistics_t::ProfileStatistics_t()
+		: name(), cpuAverage(0.0), cpuP95(0.0), gpuAverage(0.0), gpuP95(0.0)
+	{
+	}
+
+	////////////////////////////////////////////////////////////
+	GpuProfiler::Samples_t::Samples_t()
+		: values(), count(0), next(0)
+	{
+	}
+
+	////////////////////////////////////////////////////////////
+	GpuProfiler::Scope_t::Scope_t(const std::string& scopeName)
+		: name(scopeName), cpu(), gpu(), queries(), issued(), lastFrame(0), warned(false)
+	{
+		queries.fill(0);
+		issued.fill(false);
+	}
+
+	////////////////////////////////////////////////////////////
+	GpuProfiler::GpuProfiler()
+		: Singleton<GpuProfiler>(), m_scopes(), m_lookup(), m_stack(), m_gpuActive(false), m_enabled(true), m_frame(1), m_mutex()
+	{
+	}
+
+	////////////////////////////////////////////////////////////
+	ProfileScope_t::ProfileScope_t(const std::string& name)
+		: NonCopyable()
+	{
+		GpuProfiler::getInstance().beginScope(name);
+	}
+
+	////////////////////////////////////////////////////////////
+	ProfileScope_t::~ProfileScope_t()
+	{
+		GpuProfiler::getInstance().endScope();
+	}
+
+	//====================
+	// Private methods
+	//====================
+	////////////////////////////////////////////////////////////
+	void GpuProfiler::Samples_t::push(double value)
+	{
+		values[next] = value;
+		next = (next + 1) % SAMPLES;
+		count = std::min(count + 1, SAMPLES);
+	}
+
+	////////////////////////////////////////////////////////////
+	double GpuProfiler::Samples_t::getAverage() const
+	{
+		if (count == 0)
+		{
+			return 0.0;
+		}
+
+		return std::accumulate(values.begin(), values.begin() + count, 0.0) / count;
+	}
+
+	////////////////////////////////////////////////////////////
+	double GpuProfiler::Samples_t::getPercentile(double percentile) const
+	{
+		if (count == 0)
+		{
+			return 0.0;
+		}
+
+		std::array<double, SAMPLES> sorted(values);
+		auto nth = sorted.begin() + static_cast<int>(percentile * (count - 1) + 0.5);
+
+		std::nth_element(sorted.begin(), nth, sorted.begin() + count);
+		return *nth;
+	}
+
+	////////////////////////////////////////////////////////////
+	void GpuProfiler::collect(Scope_t& scope, int slot)
+	{
+		if (!scope.issued[slot])
+		{
+			return;
+		}
+
+		GLint available = 0;
+		glGetQueryObjectiv(scope.queries[slot], GL_QUERY_RESULT_AVAILABLE, &available);
+
+		if (available)
+		{
+			GLuint64 elapsed = 0;
+			glGetQueryObjectui64v(scope.queries[slot], GL_QUERY_RESULT, &elapsed);
+
+			std::lock_guard<std::mutex> guard(m_mutex);
+			scope.gpu.push(elapsed / 1.0e6);
+		}
+
+		scope.issued[slot] = false;
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	////////////////////////////////////////////////////////////
+	void GpuProfiler::setEnabled(bool enabled)
+	{
+		m_enabled = enabled;
+	}
+
+	////////////////////////////////////////////////////////////
+	bool GpuProfiler::isEnabled() const
+	{
+		return m_enabled;
+	}
+
+	////////////////////////////////////////////////////////////
+	std::vector<ProfileStatistics_t> GpuProfiler::getStatistics() const
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+
+		std::vector<ProfileStatistics_t> statistics;
+		statistics.reserve(m_scopes.size());
+
+		for (const auto& pScope : m_scopes)
+		{
+			ProfileStatistics_t scope;
+			scope.name = pScope->name;
+			scope.cpuAverage = pScope->cpu.getAverage();
+			scope.cpuP95 = pScope->cpu.getPercentile(0.95);
+			scope.gpuAverage = pScope->gpu.getAverage();
+			scope.gpuP95 = pScope->gpu.getPercentile(0.95);
+
+			statistics.push_back(scope);
+		}
+
+		return statistics;
+	}
+
+	//====================
+	// Methods
+	//====================
+	////////////////////////////////////////////////////////////
+	void GpuProfiler::beginScope(const std::string& name)
+	{
+		if (!m_enabled)
+		{
+			return;
+		}
+
+		auto itr = m_lookup.find(name);
+		if (itr == m_lookup.end())
+		{
+			std::lock_guard<std::mutex> guard(m_mutex);
+
+			itr = m_lookup.emplace(name, static_cast<int>(m_scopes.size())).first;
+			m_scopes.push_back(std::make_unique<Scope_t>(name));
+		}
+
+		Active_t active;
+		active.scope = itr->second;
+		active.gpu = false;
+
+		Scope_t* pScope = m_scopes[active.scope].get();
+
+		if (m_gpuActive)
+		{
+			if (!pScope->warned)
+			{
+				log.warning(log.function(__FUNCTION__, name), "Timer queries cannot be nested, only CPU time is measured.");
+				pScope->warned = true;
+			}
+		}
+		else if ((GLEW_VERSION_3_3 || GLEW_ARB_timer_query) && pScope->lastFrame != m_frame)
+		{
+			int slot = static_cast<int>(m_frame % LATENCY);
+
+			RenderThread::getInstance().enqueue([this, pScope, slot]() {
+				if (!pScope->queries[0])
+				{
+					glGenQueries(LATENCY, pScope->queries.data());
+				}
+
+				// The query was issued LATENCY frames ago, so its result is almost always ready.
+				this->collect(*pScope, slot);
+
+				glBeginQuery(GL_TIME_ELAPSED, pScope->queries[slot]);
+				pScope->issued[slot] = true;
+			});
+
+			pScope->lastFrame = m_frame;
+			active.gpu = true;
+			m_gpuActive = true;
+		}
+
+		active.start = std::chrono::steady_clock::now();
+		m_stack.push_back(active);
+	}
+
+	////////////////////////////////////////////////////////////
+	void GpuProfiler::endScope()
+	{
+		if (!m_enabled)
+		{
+			return;
+		}
+
+		if (m_stack.empty())
+		{
+			log.warning(log.function(__FUNCTION__), "No scope has begun.");
+			return;
+		}
+
+		Active_t active = m_stack.back();
+		m_stack.pop_back();
+
+		double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - active.start).count();
+
+		{
+			std::lock_guard<std::mutex> guard(m_mutex);
+			m_scopes[active.scope]->cpu.push(elapsed);
+		}
+
+		if (active.gpu)
+		{
+			RenderThread::getInstance().enqueue([]() {
+				glEndQuery(GL_TIME_ELAPSED);
+			});
+
+			m_gpuActive = false;
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void GpuProfiler::endFrame()
+	{
+		if (!m_stack.empty())
+		{
+			log.warning(log.function(__FUNCTION__), m_stack.size(), "scopes have not ended.");
+		}
+
+		m_frame++;
+	}
+
+	////////////////////////////////////////////////////////////
+	void GpuProfiler::report() const
+	{
+		for (const auto& scope : this->getStatistics())
+		{
+			log.debug(log.function(__FUNCTION__), scope.name,
+				"cpu avg:", scope.cpuAverage, "ms p95:", scope.cpuP95, "ms",
+				"gpu avg:", scope.gpuAverage, "ms p95:", scope.gpuP95, "ms");
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	bool GpuProfiler::writeCSV(const std::string& filename) const
+	{
+		std::ofstream file(filename, std::ios::out | std::ios::trunc);
+		if (!file.is_open())
+		{
+			log.warning(log.function(__FUNCTION__, filename), "Failed to open the csv file.");
+			return false;
+		}
+
+		file << "scope,cpu_average_ms,cpu_p95_ms,gpu_average_ms,gpu_p95_ms\n";
+		for (const auto& scope : this->getStatistics())
+		{
+			file << scope.name << "," << scope.cpuAverage << "," << scope.cpuP95 << ","
+			     << scope.gpuAverage << "," << scope.gpuP95 << "\n";
+		}
+
+		return true;
+	}
+
+	////////////////////////////////////////////////////////////
+	void GpuProfiler::destroy()
+	{
+		// Blocks until the render thread no longer references the scopes.
+		RenderThread::getInstance().invoke([this]() {
+			for (const auto& pScope : m_scopes)
+			{
+				if (pScope->queries[0])
+				{
+					glDeleteQueries(LATENCY, pScope->queries.data());
+				}
+			}
+		});
+
+		std::lock_guard<std::mutex> guard(m_mutex);
+		m_scopes.clear();
+		m_lookup.clear();
+		m_stack.clear();
+		m_gpuActive = false;
+	}
+
+} // namespace jackal
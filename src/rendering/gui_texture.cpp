@@ -1,11 +1,34 @@
 #include <jackal/rendering/gui_texture.hpp>
+#include <jackal/rendering/render_statistics.hpp>
+#include <jackal/rendering/render_thread.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 
 using namespace Awesomium;
 
 namespace jackal
 {
+	static const std::size_t MAX_DIRTY_RECTS = 8; // Past this many regions, they are uploaded as their bounds.
+
+	static bool overlaps(const Rect& a, const Rect& b)
+	{
+		return a.x <= b.x + b.width && b.x <= a.x + a.width && a.y <= b.y + b.height && b.y <= a.y + a.height;
+	}
+
+	static Rect merge(const Rect& a, const Rect& b)
+	{
+		int left = std::min(a.x, b.x);
+		int top = std::min(a.y, b.y);
+		int right = std::max(a.x + a.width, b.x + b.width);
+		int bottom = std::max(a.y + a.height, b.y + b.height);
+
+		return Rect(left, top, right - left, bottom - top);
+	}
+
 	GUITexture::GUITexture(const Vector2i& size)
-		: Texture(), Surface(), m_pBuffer(nullptr)
+		: Texture(), Surface(), m_pBuffer(nullptr), m_dirty(), m_allocated(false)
 	{
 		this->setSize(size);
 
@@ -18,34 +41,157 @@ namespace jackal
 		delete[] m_pBuffer;
 	}
 
+	void GUITexture::invalidate(const Rect& rect)
+	{
+		// Clipped to the buffer, Awesomium may report regions hanging off the edge of the view.
+		int left = std::max(rect.x, 0);
+		int top = std::max(rect.y, 0);
+		int right = std::min(rect.x + rect.width, this->getSize().x);
+		int bottom = std::min(rect.y + rect.height, this->getSize().y);
+
+		if (right <= left || bottom <= top)
+		{
+			return;
+		}
+
+		Rect dirty(left, top, right - left, bottom - top);
+
+		// Merging may make the region overlap regions it didn't before, so the search restarts.
+		for (std::size_t i = 0; i < m_dirty.size();)
+		{
+			if (overlaps(m_dirty[i], dirty))
+			{
+				dirty = merge(m_dirty[i], dirty);
+				m_dirty.erase(m_dirty.begin() + i);
+				i = 0;
+			}
+			else
+			{
+				++i;
+			}
+		}
+
+		m_dirty.push_back(dirty);
+
+		if (m_dirty.size() > MAX_DIRTY_RECTS)
+		{
+			Rect bounds = m_dirty.front();
+			for (const Rect& other : m_dirty)
+			{
+				bounds = merge(bounds, other);
+			}
+
+			m_dirty.assign(1, bounds);
+		}
+	}
+
 	void GUITexture::Paint(unsigned char* src_buffer, int src_row_span, const Awesomium::Rect& src_rect, const Awesomium::Rect& dest_rect)
 	{
 		int rowspan = this->getSize().x * 4;
 		for (int row = 0; row < dest_rect.height; row++)
 		{
-			memcpy(m_pBuffer + (row + dest_rect.y) * rowspan + (dest_rect.x *4), 
+			memcpy(m_pBuffer + (row + dest_rect.y) * rowspan + (dest_rect.x *4),
 				   src_buffer + (row + src_rect.y) * src_row_span + (src_rect.x * 4),
 				   dest_rect.width * 4);
 		}
+
+		this->invalidate(dest_rect);
 	}
 
 	void GUITexture::Scroll(int dx, int dy, const Awesomium::Rect& clip_rect)
 	{
+		int left = std::max(clip_rect.x, 0);
+		int top = std::max(clip_rect.y, 0);
+		int right = std::min(clip_rect.x + clip_rect.width, this->getSize().x);
+		int bottom = std::min(clip_rect.y + clip_rect.height, this->getSize().y);
+
+		int width = right - left - std::abs(dx);
+		int height = bottom - top - std::abs(dy);
+
+		// Everything was scrolled out of view, Awesomium repaints the whole region.
+		if (width <= 0 || height <= 0)
+		{
+			return;
+		}
+
+		int rowspan = this->getSize().x * 4;
+		int srcX = dx < 0 ? left - dx : left;
+		int destX = dx > 0 ? left + dx : left;
+
+		// Rows are moved away from the direction of the scroll, so no row is overwritten before it is read.
+		for (int i = 0; i < height; ++i)
+		{
+			int row = dy > 0 ? height - 1 - i : i;
+			int srcY = (dy < 0 ? top - dy : top) + row;
+			int destY = (dy > 0 ? top + dy : top) + row;
+
+			memmove(m_pBuffer + destY * rowspan + destX * 4, m_pBuffer + srcY * rowspan + srcX * 4, width * 4);
+		}
+
+		this->invalidate(Rect(left, top, right - left, bottom - top));
 	}
 
 	void GUITexture::bind(const GUITexture& texture)
 	{
-		glBindTexture(GL_TEXTURE_2D, texture.getID());
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, texture.getSize().x, texture.getSize().y, 0, GL_BGRA_EXT, GL_UNSIGNED_BYTE, texture.m_pBuffer);
+		GLuint id = texture.getID();
+		Vector2i size = texture.getSize();
+
+		// The storage and sampling are specified once, afterwards only the painted regions are uploaded.
+		if (!texture.m_allocated)
+		{
+			// Awesomium keeps painting into the buffer whilst the frame executes, so the pixels are copied.
+			std::vector<unsigned char> pixels(texture.m_pBuffer, texture.m_pBuffer + size.x * size.y * 4);
+			RenderStatistics::getInstance().add(eRenderCounter::BUFFER_BYTES, pixels.size());
+
+			texture.m_allocated = true;
+			texture.m_dirty.clear();
+
+			RenderThread::getInstance().enqueue([id, size, pixels = std::move(pixels)]() {
+				glBindTexture(GL_TEXTURE_2D, id);
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+				glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, size.x, size.y, 0, GL_BGRA_EXT, GL_UNSIGNED_BYTE, pixels.data());
+			});
+
+			return;
+		}
+
+		// Each region is copied out row by row, so the rows of every region are tightly packed.
+		std::vector<Rect> regions(texture.m_dirty.begin(), texture.m_dirty.end());
+		std::vector<unsigned char> pixels;
+
+		for (const Rect& rect : regions)
+		{
+			for (int row = 0; row < rect.height; ++row)
+			{
+				const unsigned char* pRow = texture.m_pBuffer + ((rect.y + row) * size.x + rect.x) * 4;
+				pixels.insert(pixels.end(), pRow, pRow + rect.width * 4);
+			}
+		}
+
+		RenderStatistics::getInstance().add(eRenderCounter::BUFFER_BYTES, pixels.size());
+		texture.m_dirty.clear();
+
+		RenderThread::getInstance().enqueue([id, regions = std::move(regions), pixels = std::move(pixels)]() {
+			glBindTexture(GL_TEXTURE_2D, id);
+			glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+			std::size_t offset = 0;
+			for (const Rect& rect : regions)
+			{
+				glTexSubImage2D(GL_TEXTURE_2D, 0, rect.x, rect.y, rect.width, rect.height, GL_BGRA_EXT, GL_UNSIGNED_BYTE, pixels.data() + offset);
+				offset += rect.width * rect.height * 4;
+			}
+		});
 	}
 
 	void GUITexture::unbind()
 	{
-		glBindTexture(GL_TEXTURE_2D, 0);
+		RenderThread::getInstance().enqueue([]() {
+			glBindTexture(GL_TEXTURE_2D, 0);
+		});
 	}
 
-} // namespace jackal
\ No newline at end of file
+} // namespace jackal
@@ -22,29 +22,180 @@
 //
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+//====================
+// C++ includes
+//====================
+#include <algorithm> // Finding the furthest vertex and the largest extent.
+#include <cmath>     // Calculating the radius of the bounding sphere.
+#include <utility>   // Moving the vertices and indices between objects.
+
 //====================
 // Jackal includes
 //====================
-#include <jackal/rendering/irenderable.hpp> // IRenderable class declaration.
+#include <jackal/rendering/irenderable.hpp>       // IRenderable class declaration.
+#include <jackal/rendering/render_thread.hpp>     // Executing the geometry commands on the render thread.
+#include <jackal/rendering/render_statistics.hpp> // Counting the draw calls and triangles.
+#include <jackal/rendering/mesh_simplifier.hpp>   // Generating the levels of detail.
 
 namespace jackal
 {
+	//====================
+	// Local variables
+	//====================
+	static const float LOD_PIXEL_ERROR = 1.0f;  // The most a level of detail may project to on screen, in pixels.
+	static const float LOD_HYSTERESIS  = 0.25f; // How much tighter the threshold is when switching to a coarser level.
+
 	//====================
 	// Ctor and dtor
 	//====================
 	////////////////////////////////////////////////////////////
 	IRenderable::IRenderable()
-		: m_vao(eBufferType::ARRAY), m_vbo(eBufferType::VERTEX), m_ibo(eBufferType::INDEX), m_vertices(), m_indices()
+		: m_range(), m_vertices(), m_indices(), m_box(), m_sphere(), m_layout(VertexLayout::standard()), m_frame(),
+		  m_decode(m_layout.getDecode(m_frame)), m_lodIndices(), m_lods(), m_lod(0)
 	{
 	}
 
 	////////////////////////////////////////////////////////////
-	IRenderable::IRenderable(const std::vector<Vertex_t>& vertices, const std::vector<GLuint>& indices)
-		: m_vao(eBufferType::ARRAY), m_vbo(eBufferType::VERTEX), m_ibo(eBufferType::INDEX), m_vertices(vertices), m_indices(indices)
+	IRenderable::IRenderable(const std::vector<Vertex_t>& vertices, const std::vector<GLuint>& indices,
+		const VertexLayout& layout/*= VertexLayout::standard()*/, const BoundingBox& frame/*= BoundingBox()*/)
+		: m_range(), m_vertices(vertices), m_indices(indices), m_box(), m_sphere(), m_layout(layout), m_frame(frame),
+		  m_decode(m_layout.getDecode(m_frame)), m_lodIndices(), m_lods(), m_lod(0)
 	{
 		this->create();
 	}
 
+	////////////////////////////////////////////////////////////
+	IRenderable::IRenderable(IRenderable&& renderable)
+		: m_range(renderable.m_range), m_vertices(std::move(renderable.m_vertices)), m_indices(std::move(renderable.m_indices)),
+		  m_box(renderable.m_box), m_sphere(renderable.m_sphere), m_layout(renderable.m_layout), m_frame(renderable.m_frame),
+		  m_decode(renderable.m_decode), m_lodIndices(std::move(renderable.m_lodIndices)), m_lods(std::move(renderable.m_lods)),
+		  m_lod(renderable.m_lod)
+	{
+		renderable.m_range = GeometryRange_t();
+	}
+
+	////////////////////////////////////////////////////////////
+	IRenderable::~IRenderable()
+	{
+		this->destroy();
+	}
+
+	//====================
+	// Operators
+	//====================
+	////////////////////////////////////////////////////////////
+	IRenderable& IRenderable::operator=(IRenderable&& renderable)
+	{
+		if (this != &renderable)
+		{
+			this->destroy();
+
+			m_range = renderable.m_range;
+			m_vertices = std::move(renderable.m_vertices);
+			m_indices = std::move(renderable.m_indices);
+			m_box = renderable.m_box;
+			m_sphere = renderable.m_sphere;
+			m_layout = renderable.m_layout;
+			m_frame = renderable.m_frame;
+			m_decode = renderable.m_decode;
+			m_lodIndices = std::move(renderable.m_lodIndices);
+			m_lods = std::move(renderable.m_lods);
+			m_lod = renderable.m_lod;
+
+			renderable.m_range = GeometryRange_t();
+		}
+
+		return *this;
+	}
+
+	//====================
+	// Protected methods
+	//====================
+	////////////////////////////////////////////////////////////
+	void IRenderable::setBounds(const BoundingBox& box, const BoundingSphere& sphere)
+	{
+		m_box = box;
+		m_sphere = sphere;
+	}
+
+	////////////////////////////////////////////////////////////
+	void IRenderable::setLods(const std::vector<MeshLod_t>& lods)
+	{
+		m_lods = lods;
+		this->setLod(m_lod);
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	////////////////////////////////////////////////////////////
+	const GeometryRange_t& IRenderable::getRange() const
+	{
+		return m_range;
+	}
+
+	////////////////////////////////////////////////////////////
+	const std::vector<Vertex_t>& IRenderable::getVertices() const
+	{
+		return m_vertices;
+	}
+
+	////////////////////////////////////////////////////////////
+	const std::vector<GLuint>& IRenderable::getIndices() const
+	{
+		return m_indices;
+	}
+
+	////////////////////////////////////////////////////////////
+	const BoundingBox& IRenderable::getBoundingBox() const
+	{
+		return m_box;
+	}
+
+	////////////////////////////////////////////////////////////
+	const BoundingSphere& IRenderable::getBoundingSphere() const
+	{
+		return m_sphere;
+	}
+
+	////////////////////////////////////////////////////////////
+	void IRenderable::setLayout(const VertexLayout& layout, const BoundingBox& frame/*= BoundingBox()*/)
+	{
+		m_layout = layout;
+		m_frame = frame;
+		m_decode = m_layout.getDecode(m_frame.isValid() ? m_frame : m_box);
+	}
+
+	////////////////////////////////////////////////////////////
+	const VertexLayout& IRenderable::getLayout() const
+	{
+		return m_layout;
+	}
+
+	////////////////////////////////////////////////////////////
+	const VertexLayout::Decode_t& IRenderable::getDecode() const
+	{
+		return m_decode;
+	}
+
+	////////////////////////////////////////////////////////////
+	const std::vector<MeshLod_t>& IRenderable::getLods() const
+	{
+		return m_lods;
+	}
+
+	////////////////////////////////////////////////////////////
+	void IRenderable::setLod(int lod)
+	{
+		m_lod = std::max(0, std::min(lod, static_cast<int>(m_lods.size()) - 1));
+	}
+
+	////////////////////////////////////////////////////////////
+	int IRenderable::getLod() const
+	{
+		return m_lod;
+	}
+
 	//====================
 	// Methods
 	//====================
@@ -72,31 +223,177 @@ namespace jackal
 		m_indices.insert(std::end(m_indices), std::begin(indices), std::end(indices));
 	}
 
+	////////////////////////////////////////////////////////////
+	void IRenderable::generateLods()
+	{
+		MeshSimplifier::generateLods(m_vertices, m_indices, m_lodIndices, m_lods);
+		this->setLod(m_lod);
+	}
+
+	////////////////////////////////////////////////////////////
+	int IRenderable::selectLod(float screenSize, int current) const
+	{
+		Vector3f extents = m_box.getExtents();
+		float size = 2.0f * std::max({ extents.x, extents.y, extents.z });
+
+		if (m_lods.size() <= 1 || !m_box.isValid() || size <= 0.0f)
+		{
+			return 0;
+		}
+
+		// The errors are in local space, the box spans the screen size, so the error scales by the same amount.
+		float pixelsPerUnit = screenSize / size;
+
+		for (int i = static_cast<int>(m_lods.size()) - 1; i > 0; --i)
+		{
+			float threshold = i > current ? LOD_PIXEL_ERROR * (1.0f - LOD_HYSTERESIS) : LOD_PIXEL_ERROR;
+			if (m_lods[i].error * pixelsPerUnit <= threshold)
+			{
+				return i;
+			}
+		}
+
+		return 0;
+	}
+
+	////////////////////////////////////////////////////////////
+	void IRenderable::updateLod(float screenSize)
+	{
+		this->setLod(this->selectLod(screenSize, m_lod));
+	}
+
 	////////////////////////////////////////////////////////////
 	void IRenderable::create()
 	{
-		m_vao.create();
-		Buffer::bind(m_vao);
+		this->destroy();
+
+		m_box = BoundingBox();
+		for (const auto& vertex : m_vertices)
+		{
+			m_box.expand(vertex.position);
+		}
+
+		// The sphere is centred on the box, but only as large as the furthest vertex.
+		Vector3f centre = m_box.getCentre();
+		float radiusSqr = 0.0f;
+
+		for (const auto& vertex : m_vertices)
+		{
+			radiusSqr = std::max(radiusSqr, Vector3f::distanceSqr(centre, vertex.position));
+		}
+
+		m_sphere = m_box.isValid() ? BoundingSphere(centre, std::sqrt(radiusSqr)) : BoundingSphere();
+
+		const BoundingBox& frame = m_frame.isValid() ? m_frame : m_box;
+		m_decode = m_layout.getDecode(frame);
+
+		std::vector<unsigned char> encoded(m_vertices.size() * m_layout.getStride());
+		m_layout.encode(m_vertices.data(), m_vertices.size(), frame, encoded.data());
+
+		// Levels generated before indices were added no longer describe the indices.
+		if (m_lods.empty() || m_lods[0].indexCount != static_cast<GLsizei>(m_indices.size()))
+		{
+			m_lodIndices.clear();
+			m_lods.assign(1, MeshLod_t(0, static_cast<GLsizei>(m_indices.size()), 0.0f));
+		}
+
+		this->setLod(m_lod);
+
+		std::vector<GLuint> indices;
+		const std::vector<GLuint>* pIndices = &m_indices;
+
+		if (!m_lodIndices.empty())
+		{
+			indices.reserve(m_indices.size() + m_lodIndices.size());
+			indices.insert(indices.end(), m_indices.begin(), m_indices.end());
+			indices.insert(indices.end(), m_lodIndices.begin(), m_lodIndices.end());
+			pIndices = &indices;
+		}
+
+		// The upload must complete before the range can be used by the caller.
+		RenderThread::getInstance().invoke([this, &encoded, pIndices]() {
+			GeometryHeap::getInstance().allocate(m_layout, encoded.data(), m_vertices.size(), pIndices->data(), pIndices->size(), m_range);
+		});
+	}
+
+	////////////////////////////////////////////////////////////
+	void IRenderable::create(const void* pVertices, int vertexCount, const GLuint* pIndices, int indexCount,
+		const BoundingBox& box, const BoundingSphere& sphere, const std::vector<MeshLod_t>& lods/*= std::vector<MeshLod_t>()*/)
+	{
+		this->destroy();
 
-		m_vbo.create();
-		Buffer::bind(m_vbo);
+		m_vertices.clear();
+		m_indices.clear();
+		m_lodIndices.clear();
+		m_lods = lods.empty() ? std::vector<MeshLod_t>(1, MeshLod_t(0, indexCount, 0.0f)) : lods;
+		m_box = box;
+		m_sphere = sphere;
+		m_decode = m_layout.getDecode(m_frame.isValid() ? m_frame : m_box);
+		this->setLod(m_lod);
 
-		m_vbo.allocate(m_vertices.data(), m_vertices.size());
+		// The pointers are only guaranteed to be valid for the duration of the call, so the upload is waited on.
+		RenderThread::getInstance().invoke([this, pVertices, vertexCount, pIndices, indexCount]() {
+			GeometryHeap::getInstance().allocate(m_layout, pVertices, vertexCount, pIndices, indexCount, m_range);
+		});
+	}
 
-		m_ibo.create();
-		Buffer::bind(m_ibo);
+	////////////////////////////////////////////////////////////
+	void IRenderable::create(const void* pVertices, int vertexCount, const GLushort* pIndices, int indexCount,
+		const BoundingBox& box, const BoundingSphere& sphere, const std::vector<MeshLod_t>& lods/*= std::vector<MeshLod_t>()*/)
+	{
+		this->destroy();
 
-		m_ibo.allocate(m_indices.data(), m_indices.size());
+		m_vertices.clear();
+		m_indices.clear();
+		m_lodIndices.clear();
+		m_lods = lods.empty() ? std::vector<MeshLod_t>(1, MeshLod_t(0, indexCount, 0.0f)) : lods;
+		m_box = box;
+		m_sphere = sphere;
+		m_decode = m_layout.getDecode(m_frame.isValid() ? m_frame : m_box);
+		this->setLod(m_lod);
 
-		Buffer::unbind(m_vao);
+		RenderThread::getInstance().invoke([this, pVertices, vertexCount, pIndices, indexCount]() {
+			GeometryHeap::getInstance().allocate(m_layout, pVertices, vertexCount, pIndices, indexCount, m_range);
+		});
+	}
+
+	////////////////////////////////////////////////////////////
+	void IRenderable::destroy()
+	{
+		if (!m_range.isValid())
+		{
+			return;
+		}
+
+		// Freed in frame order, so the range is not reused whilst a submitted frame still draws it.
+		GeometryRange_t range = m_range;
+		RenderThread::getInstance().enqueue([range]() mutable {
+			GeometryHeap::getInstance().free(range);
+		});
+
+		m_range = GeometryRange_t();
 	}
 
 	////////////////////////////////////////////////////////////
 	void IRenderable::render() 
 	{
-		Buffer::bind(m_vao);
-		glDrawElements(GL_TRIANGLES, m_indices.size(), GL_UNSIGNED_INT, nullptr);
-		Buffer::unbind(m_vao);
+		// Only the indices of the rendered level of detail are drawn, the range itself is kept intact to be freed.
+		GeometryRange_t range = m_range;
+		if (m_lod < static_cast<int>(m_lods.size()))
+		{
+			range.firstIndex += m_lods[m_lod].firstIndex;
+			range.indexCount = m_lods[m_lod].indexCount;
+		}
+
+		RenderStatistics::getInstance().add(eRenderCounter::DRAW_CALLS);
+		RenderStatistics::getInstance().add(eRenderCounter::TRIANGLES, range.indexCount / 3);
+
+		VertexLayout::Decode_t decode = m_decode;
+
+		RenderThread::getInstance().enqueue([range, decode]() {
+			VertexLayout::applyDecode(decode);
+			GeometryHeap::getInstance().draw(range);
+		});
 	}
 	
 } // namespace jackal
\ No newline at end of file
@@ -25,10 +25,12 @@
 //====================
 // Jackal methods
 //====================
-#include <jackal/rendering/material.hpp>          // Material class declaration.
-#include <jackal/utils/log.hpp>                   // Logging warnings and errors.
-#include <jackal/utils/json_file_reader.hpp>      // Loading json file from directory.
-#include <jackal/utils/resource_manager.hpp>      // Loading textures and shaders from the resource manager.
+#include <jackal/rendering/material.hpp>         // Material class declaration.
+#include <jackal/utils/log.hpp>                  // Logging warnings and errors.
+#include <jackal/utils/json_file_reader.hpp>     // Loading json file from directory.
+#include <jackal/utils/resource_manager.hpp>     // Loading textures and shaders from the resource manager.
+#include <jackal/rendering/texture_array.hpp>    // Identifying materials by the arrays their textures were packed into.
+#include <jackal/rendering/texture_streamer.hpp> // Requesting the levels of streamed textures.
 
 namespace jackal
 {
@@ -37,12 +39,17 @@ namespace jackal
 	//====================
 	static DebugLog log("logs/engine_log.txt");
 
+	static const std::string FALLBACK_SHADER = "~assets/shaders/basic-unlit-shader.json"; // Rendered until the shader of a material has compiled.
+
+	static const std::array<std::string, MAX_TEXTURES> ARRAY_KEYWORDS = { "DIFFUSE_ARRAY", "SPECULAR_ARRAY" }; // Samples each texture from an array.
+
 	//====================
 	// Ctor and dtor
 	//====================
 	////////////////////////////////////////////////////////////
 	Material::Material()
-		: m_ID(0), m_shader(nullptr), m_textures(), m_colour(), m_lighting(true), m_shininess(0.0f)
+		: m_shader(nullptr), m_variant(nullptr), m_fallback(nullptr), m_fallbackVariant(nullptr), m_textures(), m_colour(), m_lighting(true), m_shininess(0.0f),
+		  m_document(), m_pendingShader(), m_pendingTextures(), m_prepared(false), m_pActive(nullptr)
 	{
 	}
 
@@ -52,7 +59,31 @@ namespace jackal
 	////////////////////////////////////////////////////////////
 	int64_t Material::getID() const
 	{
-		return m_ID;
+		// Packed textures are identified by their array, so materials that share arrays share an ID and sort together.
+		int64_t id = static_cast<int64_t>(m_variant.get() ? m_variant->getID() : 0) << 24;
+		for (std::size_t i = 0; i < m_textures.size(); ++i)
+		{
+			const Texture* pTex = m_textures.at(i).get();
+			if (pTex)
+			{
+				const TextureArray* pArray = pTex->isPacked() && pTex->isReady() ? pTex->getArray() : nullptr;
+				id |= static_cast<int64_t>(pArray ? pArray->getID() : pTex->getID()) << (16 - i * 8);
+			}
+		}
+
+		return id;
+	}
+
+	////////////////////////////////////////////////////////////
+	float Material::getLayer(eTextureType type) const
+	{
+		const Texture* pTex = m_textures.at(type).get();
+		if (pTex && pTex->isPacked() && pTex->isReady())
+		{
+			return static_cast<float>(pTex->getLayer());
+		}
+
+		return 0.0f;
 	}
 
 	////////////////////////////////////////////////////////////
@@ -85,18 +116,85 @@ namespace jackal
 		return m_lighting;
 	}
 
+	//====================
+	// Private methods
+	//====================
+	////////////////////////////////////////////////////////////
+	Shader* Material::getActiveShader() const
+	{
+		Shader* pShader = m_variant.get();
+		Shader* pFallback = m_fallbackVariant.get();
+
+		if (pShader && !pShader->isReady() && pFallback && pFallback->isReady())
+		{
+			return pFallback;
+		}
+
+		return pShader;
+	}
+
+	////////////////////////////////////////////////////////////
+	bool Material::read(const std::string& filename)
+	{
+		JSONFileReader reader;
+		if (!reader.read(filename))
+		{
+			log.error(log.function(__FUNCTION__, filename), "Failed to parse json file.");
+			return false;
+		}
+
+		m_document = reader.getRoot();
+		m_prepared = true;
+
+		return true;
+	}
+
 	//====================
 	// Methods
 	//====================
+	////////////////////////////////////////////////////////////
+	bool Material::prepare(const std::string& filename)//override
+	{
+		if (!this->read(filename))
+		{
+			return false;
+		}
+
+		// The material is loaded once these are no longer pending, so it finds them within the caches.
+		ResourceManager& manager = ResourceManager::getInstance();
+		nlohmann::json textures = m_document["textures"];
+
+		m_pendingTextures.at(eTextureType::DIFFUSE) = manager.getAsync<Texture>(textures["diffuse"].get<std::string>());
+		m_pendingTextures.at(eTextureType::SPECULAR) = manager.getAsync<Texture>(textures["specular"].get<std::string>());
+		m_pendingShader = manager.getAsync<Shader>(m_document["shader"].get<std::string>());
+
+		return true;
+	}
+
+	////////////////////////////////////////////////////////////
+	bool Material::hasPendingDependencies() const//override
+	{
+		for (const auto& texture : m_pendingTextures)
+		{
+			if (texture.isPending())
+			{
+				return true;
+			}
+		}
+
+		return m_pendingShader.isPending();
+	}
+
 	////////////////////////////////////////////////////////////
 	bool Material::load(const std::string& filename)//override
 	{
 		using namespace nlohmann;
 
-		JSONFileReader reader;
-		if (reader.read(filename))
+		if (m_prepared || this->read(filename))
 		{
-			json root = reader.getRoot();
+			// The prepared file is only used once, a reload reads the file again.
+			json root = std::move(m_document);
+			m_prepared = false;
 
 			this->setName(root.value("name", filename));
 
@@ -110,15 +208,53 @@ namespace jackal
 	
 			m_shader = Shader::find(root["shader"].get<std::string>());
 
-			m_ID |= m_shader->getID() << 24;
-			m_ID |= m_textures.at(eTextureType::DIFFUSE)->getID() << 16;
-			m_ID |= m_textures.at(eTextureType::SPECULAR)->getID() << 8;
+			// Lighting is compiled into the variant rather than branched upon, keywords the shader doesn't declare are ignored.
+			std::vector<std::string> keywords = root.value("keywords", std::vector<std::string>());
+			if (m_lighting)
+			{
+				keywords.push_back("LIGHTING");
+			}
+
+			// Packed textures are sampled from their array, the layer is set along with the other uniforms.
+			for (std::size_t i = 0; i < m_textures.size(); ++i)
+			{
+				if (m_textures.at(i).get() && m_textures.at(i)->isPacked())
+				{
+					keywords.push_back(ARRAY_KEYWORDS.at(i));
+				}
+			}
+
+			m_pActive = nullptr;
+			m_variant = m_shader->getVariant(m_shader->getKeywordMask(keywords));
+			if (!m_variant.get())
+			{
+				log.warning(log.function(__FUNCTION__, filename), "Failed to load the shader variant, using the shader without keywords.");
+				m_variant = m_shader;
+			}
+
+			// The shader compiles in the background, the fallback is waited upon so there is always something to render.
+			if (!m_variant->isReady())
+			{
+				m_fallback = Shader::find(root.value("fallback-shader", FALLBACK_SHADER));
+
+				// The fallback must sample the textures the same way, so it is compiled with the same keywords.
+				m_fallbackVariant = m_fallback->getVariant(m_fallback->getKeywordMask(keywords));
+				if (!m_fallbackVariant.get())
+				{
+					m_fallbackVariant = m_fallback;
+				}
+
+				m_fallbackVariant->wait();
+			}
+
+			// The requested resources are cached now, the loads no longer need to be referenced.
+			m_pendingTextures.fill(AsyncHandle<Texture>());
+			m_pendingShader = AsyncHandle<Shader>();
 
 			return true;
 		}
 		else
 		{
-			log.error(log.function(__FUNCTION__, filename), "Failed to parse json file.");
 			return false;
 		}
 
@@ -134,13 +270,34 @@ namespace jackal
 	////////////////////////////////////////////////////////////
 	void Material::process(const Transform& transform)
 	{
-		m_shader->process(transform, *this);
+		// The shader chosen by bind is used, the variant may become ready on the render thread in between.
+		Shader* pShader = m_pActive ? m_pActive : this->getActiveShader();
+		pShader->process(transform, *this);
+	}
+
+	////////////////////////////////////////////////////////////
+	void Material::requestResolution(float pixels) const
+	{
+		for (const auto& texture : m_textures)
+		{
+			if (texture.get() && texture->isStreamed())
+			{
+				TextureStreamer::getInstance().request(*texture.get(), pixels);
+			}
+		}
 	}
 
 	////////////////////////////////////////////////////////////
 	void Material::bind(const Material& material)
 	{
-		Shader::bind(*material.m_shader.get());
+		Shader* pShader = material.m_variant.get();
+		if (!pShader->isReady())
+		{
+			pShader->poll();
+		}
+
+		material.m_pActive = material.getActiveShader();
+		Shader::bind(*material.m_pActive);
 		for (std::size_t i = 0; i < material.m_textures.size(); i++)
 		{
 			Texture* pTex = material.m_textures.at(i).get();
@@ -39,11 +39,32 @@ namespace jackal
 	}
 
 	////////////////////////////////////////////////////////////
-	Mesh::Mesh(const std::vector<Vertex_t>& vertices, const std::vector<GLuint>& indices)
-		: IRenderable(vertices, indices)
+	Mesh::Mesh(const std::vector<Vertex_t>& vertices, const std::vector<GLuint>& indices,
+		const VertexLayout& layout/*= VertexLayout::standard()*/, const BoundingBox& frame/*= BoundingBox()*/)
+		: IRenderable(vertices, indices, layout, frame)
 	{
 	}
 
+	////////////////////////////////////////////////////////////
+	Mesh::Mesh(const void* pVertices, int vertexCount, const VertexLayout& layout, const BoundingBox& frame,
+		const GLuint* pIndices, int indexCount, const BoundingBox& box, const BoundingSphere& sphere,
+		const std::vector<MeshLod_t>& lods/*= std::vector<MeshLod_t>()*/)
+		: IRenderable()
+	{
+		this->setLayout(layout, frame);
+		this->create(pVertices, vertexCount, pIndices, indexCount, box, sphere, lods);
+	}
+
+	////////////////////////////////////////////////////////////
+	Mesh::Mesh(const void* pVertices, int vertexCount, const VertexLayout& layout, const BoundingBox& frame,
+		const GLushort* pIndices, int indexCount, const BoundingBox& box, const BoundingSphere& sphere,
+		const std::vector<MeshLod_t>& lods/*= std::vector<MeshLod_t>()*/)
+		: IRenderable()
+	{
+		this->setLayout(layout, frame);
+		this->create(pVertices, vertexCount, pIndices, indexCount, box, sphere, lods);
+	}
+
 	//====================
 	// Methods
 	//====================
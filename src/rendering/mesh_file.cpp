@@ -0,0 +1,414 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//====================
+// C++ includes
+//====================
+#include <algorithm>  // Finding the furthest vertex of each sub-mesh.
+#include <cmath>      // Calculating the radius of each bounding sphere.
+#include <cstring>    // Reading the headers from the mapped file.
+#include <filesystem> // Replacing the written file.
+#include <fstream>    // Writing cooked mesh files.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/rendering/mesh_file.hpp>     // MeshFile class declaration.
+#include <jackal/rendering/geometry_heap.hpp> // Sub-meshes the heap stores with 16-bit indices are cooked with them.
+#include <jackal/utils/log.hpp>               // Logging invalid files.
+
+namespace jackal
+{
+	//====================
+	// Local variables
+	//====================
+	static DebugLog log("logs/engine_log.txt");
+
+	static const std::uint64_t DATA_ALIGNMENT = 16; // The alignment of the vertex and index blobs within the file.
+
+	////////////////////////////////////////////////////////////
+	static std::uint64_t align(std::uint64_t offset)
+	{
+		return (offset + DATA_ALIGNMENT - 1) / DATA_ALIGNMENT * DATA_ALIGNMENT;
+	}
+
+	////////////////////////////////////////////////////////////
+	static bool isValid(std::uint32_t lodCount, const std::uint32_t* pFirstIndices, const std::uint32_t* pIndexCounts, std::uint32_t indexCount)
+	{
+		if (lodCount == 0 || lodCount > static_cast<std::uint32_t>(MeshSimplifier::MAX_LODS))
+		{
+			return false;
+		}
+
+		for (std::uint32_t i = 0; i < lodCount; ++i)
+		{
+			if (pFirstIndices[i] > indexCount || pIndexCounts[i] > indexCount - pFirstIndices[i] || pIndexCounts[i] % 3 != 0)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	//====================
+	// Static variables
+	//====================
+	const std::uint32_t MeshFile::MAGIC;
+	const std::uint32_t MeshFile::VERSION;
+
+	//====================
+	// Ctor
+	//====================
+	////////////////////////////////////////////////////////////
+	MeshFile::MeshFile()
+		: NonCopyable(), m_file(), m_pVertices(nullptr), m_vertexCount(0), m_pIndices(nullptr), m_indexCount(0), m_pShortIndices(nullptr),
+		  m_shortIndexCount(0), m_layout(), m_meshes(), m_box()
+	{
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	////////////////////////////////////////////////////////////
+	const unsigned char* MeshFile::getVertices() const
+	{
+		return m_pVertices;
+	}
+
+	////////////////////////////////////////////////////////////
+	std::size_t MeshFile::getVertexCount() const
+	{
+		return m_vertexCount;
+	}
+
+	////////////////////////////////////////////////////////////
+	const VertexLayout& MeshFile::getLayout() const
+	{
+		return m_layout;
+	}
+
+	////////////////////////////////////////////////////////////
+	const GLuint* MeshFile::getIndices() const
+	{
+		return m_pIndices;
+	}
+
+	////////////////////////////////////////////////////////////
+	std::size_t MeshFile::getIndexCount() const
+	{
+		return m_indexCount;
+	}
+
+	////////////////////////////////////////////////////////////
+	const GLushort* MeshFile::getShortIndices() const
+	{
+		return m_pShortIndices;
+	}
+
+	////////////////////////////////////////////////////////////
+	std::size_t MeshFile::getShortIndexCount() const
+	{
+		return m_shortIndexCount;
+	}
+
+	////////////////////////////////////////////////////////////
+	const std::vector<MeshFile::SubMesh_t>& MeshFile::getSubMeshes() const
+	{
+		return m_meshes;
+	}
+
+	////////////////////////////////////////////////////////////
+	const BoundingBox& MeshFile::getBoundingBox() const
+	{
+		return m_box;
+	}
+
+	//====================
+	// Methods
+	//====================
+	////////////////////////////////////////////////////////////
+	bool MeshFile::open(const std::string& filename)
+	{
+		this->close();
+
+		if (!m_file.open(filename))
+		{
+			return false;
+		}
+
+		Header_t header;
+		bool valid = m_file.getSize() >= sizeof(header);
+
+		if (valid)
+		{
+			std::memcpy(&header, m_file.getData(), sizeof(header));
+
+			std::uint64_t size = m_file.getSize();
+			valid = header.magic == MAGIC && header.version == VERSION && VertexLayout::unpack(header.vertexLayout, m_layout) &&
+				m_layout.getStride() > 0 && header.vertexStride == static_cast<std::uint32_t>(m_layout.getStride()) &&
+				sizeof(header) + static_cast<std::uint64_t>(header.meshes) * sizeof(SubMeshHeader_t) <= size &&
+				header.vertexOffset % DATA_ALIGNMENT == 0 && header.indexOffset % DATA_ALIGNMENT == 0 && header.shortIndexOffset % DATA_ALIGNMENT == 0 &&
+				header.vertexOffset <= size && header.vertexCount <= (size - header.vertexOffset) / header.vertexStride &&
+				header.indexOffset <= size && header.indexCount <= (size - header.indexOffset) / sizeof(GLuint) &&
+				header.shortIndexOffset <= size && header.shortIndexCount <= (size - header.shortIndexOffset) / sizeof(GLushort);
+		}
+
+		if (!valid)
+		{
+			log.warning(log.function(__FUNCTION__, filename), "Not a valid cooked mesh file.");
+			this->close();
+
+			return false;
+		}
+
+		// The blobs are aligned within the file and the file is mapped on a page boundary, so they can be used in place.
+		m_pVertices = reinterpret_cast<const unsigned char*>(m_file.getData() + header.vertexOffset);
+		m_vertexCount = static_cast<std::size_t>(header.vertexCount);
+		m_pIndices = reinterpret_cast<const GLuint*>(m_file.getData() + header.indexOffset);
+		m_indexCount = static_cast<std::size_t>(header.indexCount);
+		m_pShortIndices = reinterpret_cast<const GLushort*>(m_file.getData() + header.shortIndexOffset);
+		m_shortIndexCount = static_cast<std::size_t>(header.shortIndexCount);
+		m_box = BoundingBox(Vector3f(header.minimum[0], header.minimum[1], header.minimum[2]),
+			Vector3f(header.maximum[0], header.maximum[1], header.maximum[2]));
+
+		for (std::uint32_t i = 0; i < header.meshes; ++i)
+		{
+			SubMeshHeader_t mesh;
+			std::memcpy(&mesh, m_file.getData() + sizeof(header) + i * sizeof(mesh), sizeof(mesh));
+
+			// Each range is checked against the blobs, so a truncated file is never uploaded.
+			std::size_t indexCount = mesh.shortIndices ? m_shortIndexCount : m_indexCount;
+			if (mesh.firstVertex > m_vertexCount || mesh.vertexCount > m_vertexCount - mesh.firstVertex ||
+				mesh.firstIndex > indexCount || mesh.indexCount > indexCount - mesh.firstIndex ||
+				(mesh.shortIndices && mesh.vertexCount > static_cast<std::uint32_t>(GeometryHeap::MAX_SHORT_VERTICES)) ||
+				!isValid(mesh.lodCount, mesh.lodFirstIndex, mesh.lodIndexCount, mesh.indexCount))
+			{
+				log.warning(log.function(__FUNCTION__, filename), "Sub-mesh", i, "of the cooked mesh is invalid.");
+				this->close();
+
+				return false;
+			}
+
+			SubMesh_t subMesh;
+			subMesh.firstVertex = mesh.firstVertex;
+			subMesh.vertexCount = mesh.vertexCount;
+			subMesh.firstIndex = mesh.firstIndex;
+			subMesh.indexCount = mesh.indexCount;
+			subMesh.shortIndices = mesh.shortIndices != 0;
+			subMesh.box = BoundingBox(Vector3f(mesh.minimum[0], mesh.minimum[1], mesh.minimum[2]), Vector3f(mesh.maximum[0], mesh.maximum[1], mesh.maximum[2]));
+			subMesh.sphere = BoundingSphere(Vector3f(mesh.centre[0], mesh.centre[1], mesh.centre[2]), mesh.radius);
+
+			for (std::uint32_t j = 0; j < mesh.lodCount; ++j)
+			{
+				subMesh.lods.emplace_back(mesh.lodFirstIndex[j], static_cast<GLsizei>(mesh.lodIndexCount[j]), mesh.lodError[j]);
+			}
+
+			m_meshes.push_back(subMesh);
+		}
+
+		return true;
+	}
+
+	////////////////////////////////////////////////////////////
+	void MeshFile::close()
+	{
+		m_pVertices = nullptr;
+		m_vertexCount = 0;
+		m_pIndices = nullptr;
+		m_indexCount = 0;
+		m_pShortIndices = nullptr;
+		m_shortIndexCount = 0;
+		m_layout = VertexLayout();
+		m_meshes.clear();
+		m_box = BoundingBox();
+		m_file.close();
+	}
+
+	////////////////////////////////////////////////////////////
+	bool MeshFile::write(const std::string& filename, const std::vector<Vertex_t>& vertices,
+		const std::vector<GLuint>& indices, std::vector<SubMesh_t> meshes, const VertexLayout& layout/*= VertexLayout::standard()*/)
+	{
+		if (layout.getStride() == 0)
+		{
+			log.warning(log.function(__FUNCTION__, filename), "The vertex layout doesn't store any attributes.");
+			return false;
+		}
+
+		BoundingBox bounds;
+		std::vector<SubMeshHeader_t> table(meshes.size());
+		std::vector<GLuint> wideIndices;
+		std::vector<GLushort> shortIndices;
+
+		for (std::size_t i = 0; i < meshes.size(); ++i)
+		{
+			SubMesh_t& mesh = meshes[i];
+			if (mesh.firstVertex > vertices.size() || mesh.vertexCount > vertices.size() - mesh.firstVertex ||
+				mesh.firstIndex > indices.size() || mesh.indexCount > indices.size() - mesh.firstIndex)
+			{
+				log.warning(log.function(__FUNCTION__, filename), "Sub-mesh", i, "lies outside of the vertices or indices.");
+				return false;
+			}
+
+			if (mesh.lods.empty())
+			{
+				mesh.lods.emplace_back(0, static_cast<GLsizei>(mesh.indexCount), 0.0f);
+			}
+
+			SubMeshHeader_t& entry = table[i];
+			entry.lodCount = static_cast<std::uint32_t>(std::min(mesh.lods.size(), static_cast<std::size_t>(MeshSimplifier::MAX_LODS)));
+
+			for (std::uint32_t j = 0; j < MeshSimplifier::MAX_LODS; ++j)
+			{
+				bool used = j < entry.lodCount;
+				entry.lodFirstIndex[j] = used ? mesh.lods[j].firstIndex : 0;
+				entry.lodIndexCount[j] = used ? static_cast<std::uint32_t>(mesh.lods[j].indexCount) : 0;
+				entry.lodError[j] = used ? mesh.lods[j].error : 0.0f;
+			}
+
+			if (mesh.lods.size() > static_cast<std::size_t>(MeshSimplifier::MAX_LODS) ||
+				!isValid(entry.lodCount, entry.lodFirstIndex, entry.lodIndexCount, mesh.indexCount))
+			{
+				log.warning(log.function(__FUNCTION__, filename), "The levels of detail of sub-mesh", i, "are invalid.");
+				return false;
+			}
+
+			// The bounds are calculated the same way IRenderable calculates them, the sphere is centred on the box.
+			mesh.box = BoundingBox();
+			for (std::uint32_t j = 0; j < mesh.vertexCount; ++j)
+			{
+				mesh.box.expand(vertices[mesh.firstVertex + j].position);
+			}
+
+			Vector3f centre = mesh.box.getCentre();
+			float radiusSqr = 0.0f;
+
+			for (std::uint32_t j = 0; j < mesh.vertexCount; ++j)
+			{
+				radiusSqr = std::max(radiusSqr, Vector3f::distanceSqr(centre, vertices[mesh.firstVertex + j].position));
+			}
+
+			mesh.sphere = mesh.box.isValid() ? BoundingSphere(centre, std::sqrt(radiusSqr)) : BoundingSphere();
+			bounds.merge(mesh.box);
+
+			// The indices are relative to the first vertex of the sub-mesh, so small sub-meshes are stored at half the size.
+			const GLuint* pIndices = indices.data() + mesh.firstIndex;
+			mesh.shortIndices = mesh.vertexCount <= static_cast<std::uint32_t>(GeometryHeap::MAX_SHORT_VERTICES);
+
+			if (mesh.shortIndices)
+			{
+				mesh.firstIndex = static_cast<std::uint32_t>(shortIndices.size());
+				shortIndices.insert(shortIndices.end(), pIndices, pIndices + mesh.indexCount);
+			}
+			else
+			{
+				mesh.firstIndex = static_cast<std::uint32_t>(wideIndices.size());
+				wideIndices.insert(wideIndices.end(), pIndices, pIndices + mesh.indexCount);
+			}
+
+			entry.firstVertex = mesh.firstVertex;
+			entry.vertexCount = mesh.vertexCount;
+			entry.firstIndex = mesh.firstIndex;
+			entry.indexCount = mesh.indexCount;
+			entry.shortIndices = mesh.shortIndices ? 1u : 0u;
+			entry.minimum[0] = mesh.box.minimum.x;
+			entry.minimum[1] = mesh.box.minimum.y;
+			entry.minimum[2] = mesh.box.minimum.z;
+			entry.maximum[0] = mesh.box.maximum.x;
+			entry.maximum[1] = mesh.box.maximum.y;
+			entry.maximum[2] = mesh.box.maximum.z;
+			entry.centre[0] = mesh.sphere.centre.x;
+			entry.centre[1] = mesh.sphere.centre.y;
+			entry.centre[2] = mesh.sphere.centre.z;
+			entry.radius = mesh.sphere.radius;
+		}
+
+		// Every sub-mesh is quantised within the same box, so a model draws all of them with one set of decode constants.
+		std::vector<unsigned char> encoded(vertices.size() * layout.getStride());
+		layout.encode(vertices.data(), vertices.size(), bounds, encoded.data());
+
+		Header_t header;
+		header.magic = MAGIC;
+		header.version = VERSION;
+		header.vertexLayout = layout.pack();
+		header.vertexStride = static_cast<std::uint32_t>(layout.getStride());
+		header.meshes = static_cast<std::uint32_t>(meshes.size());
+		header.reserved = 0;
+		header.vertexOffset = align(sizeof(header) + meshes.size() * sizeof(SubMeshHeader_t));
+		header.vertexCount = vertices.size();
+		header.indexOffset = align(header.vertexOffset + encoded.size());
+		header.indexCount = wideIndices.size();
+		header.shortIndexOffset = align(header.indexOffset + wideIndices.size() * sizeof(GLuint));
+		header.shortIndexCount = shortIndices.size();
+		header.minimum[0] = bounds.minimum.x;
+		header.minimum[1] = bounds.minimum.y;
+		header.minimum[2] = bounds.minimum.z;
+		header.maximum[0] = bounds.maximum.x;
+		header.maximum[1] = bounds.maximum.y;
+		header.maximum[2] = bounds.maximum.z;
+
+		std::string temporary = filename + ".tmp";
+		{
+			std::ofstream file(temporary, std::ios::out | std::ios::binary | std::ios::trunc);
+			if (!file.is_open())
+			{
+				log.warning(log.function(__FUNCTION__, filename), "Failed to open the cooked mesh for writing.");
+				return false;
+			}
+
+			static const char PADDING[DATA_ALIGNMENT] = {};
+
+			file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			file.write(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(SubMeshHeader_t));
+
+			file.write(PADDING, static_cast<std::streamsize>(header.vertexOffset - static_cast<std::uint64_t>(file.tellp())));
+			file.write(reinterpret_cast<const char*>(encoded.data()), encoded.size());
+
+			file.write(PADDING, static_cast<std::streamsize>(header.indexOffset - static_cast<std::uint64_t>(file.tellp())));
+			file.write(reinterpret_cast<const char*>(wideIndices.data()), wideIndices.size() * sizeof(GLuint));
+
+			file.write(PADDING, static_cast<std::streamsize>(header.shortIndexOffset - static_cast<std::uint64_t>(file.tellp())));
+			file.write(reinterpret_cast<const char*>(shortIndices.data()), shortIndices.size() * sizeof(GLushort));
+
+			if (!file)
+			{
+				log.warning(log.function(__FUNCTION__, filename), "Failed to write the cooked mesh.");
+				return false;
+			}
+		}
+
+		std::error_code error;
+		std::filesystem::rename(temporary, filename, error);
+		if (error)
+		{
+			log.warning(log.function(__FUNCTION__, filename), "Failed to replace the cooked mesh:", error.message());
+			std::filesystem::remove(temporary, error);
+
+			return false;
+		}
+
+		return true;
+	}
+
+} // namespace jackal
@@ -0,0 +1,401 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//====================
+// C++ includes
+//====================
+#include <algorithm> // Sorting the clusters of triangles.
+#include <cmath>     // Normalising the facing of each cluster.
+#include <cstdint>   // Prioritising the candidate vertices.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/rendering/mesh_optimiser.hpp> // MeshOptimiser class declaration.
+
+namespace jackal
+{
+	//====================
+	// Local variables
+	//====================
+	static const GLuint INVALID_INDEX = ~0u; // Marks a vertex that hasn't been remapped yet.
+
+	////////////////////////////////////////////////////////////
+	static bool isValid(const std::vector<GLuint>& indices, std::size_t vertexCount)
+	{
+		if (indices.size() % 3 != 0)
+		{
+			return false;
+		}
+
+		return std::all_of(indices.begin(), indices.end(), [vertexCount](GLuint index) {
+			return index < vertexCount;
+		});
+	}
+
+	////////////////////////////////////////////////////////////
+	static unsigned int simulate(const GLuint* pIndices, std::size_t count, std::vector<unsigned int>& stamps, unsigned int& time)
+	{
+		// A vertex is within the FIFO cache while fewer than CACHE_SIZE vertices have been transformed after it.
+		unsigned int misses = 0;
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			unsigned int& stamp = stamps[pIndices[i]];
+			if (time - stamp > MeshOptimiser::CACHE_SIZE)
+			{
+				stamp = time++;
+				misses++;
+			}
+		}
+
+		return misses;
+	}
+
+	//====================
+	// Static variables
+	//====================
+	const unsigned int MeshOptimiser::CACHE_SIZE;
+
+	//====================
+	// Methods
+	//====================
+	////////////////////////////////////////////////////////////
+	void MeshOptimiser::optimiseVertexCache(std::vector<GLuint>& indices, std::size_t vertexCount)
+	{
+		if (indices.empty() || !isValid(indices, vertexCount))
+		{
+			return;
+		}
+
+		std::size_t triangles = indices.size() / 3;
+
+		// The triangles that use each vertex, and how many of them are yet to be emitted.
+		std::vector<unsigned int> live(vertexCount, 0);
+		for (GLuint index : indices)
+		{
+			live[index]++;
+		}
+
+		std::vector<std::size_t> offsets(vertexCount + 1, 0);
+		for (std::size_t i = 0; i < vertexCount; ++i)
+		{
+			offsets[i + 1] = offsets[i] + live[i];
+		}
+
+		std::vector<std::size_t> fill(offsets.begin(), offsets.end() - 1);
+		std::vector<std::size_t> adjacency(indices.size());
+
+		for (std::size_t i = 0; i < indices.size(); ++i)
+		{
+			adjacency[fill[indices[i]]++] = i / 3;
+		}
+
+		std::vector<unsigned int> stamps(vertexCount, 0);
+		unsigned int time = CACHE_SIZE + 1;
+
+		std::vector<bool> emitted(triangles, false);
+		std::vector<GLuint> deadEnds;
+		std::vector<GLuint> candidates;
+		std::vector<GLuint> output;
+		output.reserve(indices.size());
+
+		std::size_t cursor = 0;
+		std::int64_t fanning = indices.front();
+
+		while (fanning >= 0)
+		{
+			candidates.clear();
+
+			// Every remaining triangle around the fanning vertex is emitted.
+			for (std::size_t i = offsets[fanning]; i < offsets[fanning + 1]; ++i)
+			{
+				std::size_t triangle = adjacency[i];
+				if (emitted[triangle])
+				{
+					continue;
+				}
+
+				for (std::size_t j = 0; j < 3; ++j)
+				{
+					GLuint vertex = indices[triangle * 3 + j];
+
+					output.push_back(vertex);
+					deadEnds.push_back(vertex);
+					candidates.push_back(vertex);
+					live[vertex]--;
+
+					if (time - stamps[vertex] > CACHE_SIZE)
+					{
+						stamps[vertex] = time++;
+					}
+				}
+
+				emitted[triangle] = true;
+			}
+
+			// The oldest candidate that would still be cached after its own fan is emitted is preferred.
+			fanning = -1;
+			std::int64_t best = -1;
+
+			for (GLuint vertex : candidates)
+			{
+				if (live[vertex] == 0)
+				{
+					continue;
+				}
+
+				std::int64_t priority = 0;
+				if (time - stamps[vertex] + 2 * live[vertex] <= CACHE_SIZE)
+				{
+					priority = time - stamps[vertex];
+				}
+
+				if (priority > best)
+				{
+					best = priority;
+					fanning = vertex;
+				}
+			}
+
+			// Otherwise the most recently used vertex with triangles left, or the next one in order.
+			while (fanning < 0 && !deadEnds.empty())
+			{
+				GLuint vertex = deadEnds.back();
+				deadEnds.pop_back();
+
+				if (live[vertex] > 0)
+				{
+					fanning = vertex;
+				}
+			}
+
+			while (fanning < 0 && cursor < vertexCount)
+			{
+				if (live[cursor] > 0)
+				{
+					fanning = static_cast<std::int64_t>(cursor);
+				}
+
+				cursor++;
+			}
+		}
+
+		indices.swap(output);
+	}
+
+	////////////////////////////////////////////////////////////
+	void MeshOptimiser::optimiseOverdraw(std::vector<GLuint>& indices, const std::vector<Vertex_t>& vertices, float threshold /*= 1.05f*/)
+	{
+		if (indices.empty() || !isValid(indices, vertices.size()))
+		{
+			return;
+		}
+
+		std::size_t triangles = indices.size() / 3;
+
+		std::vector<unsigned int> stamps(vertices.size(), 0);
+		unsigned int time = CACHE_SIZE + 1;
+
+		// A triangle whose every vertex misses the cache starts a cluster, reordering there costs nothing.
+		std::vector<std::size_t> hard;
+		for (std::size_t i = 0; i < triangles; ++i)
+		{
+			unsigned int misses = simulate(&indices[i * 3], 3, stamps, time);
+			if (i == 0 || misses == 3)
+			{
+				hard.push_back(i);
+			}
+		}
+
+		hard.push_back(triangles);
+
+		// Each cluster is split further wherever the cache miss ratio since the last split is within the threshold
+		// of the ratio of the whole cluster, so reordering the smaller clusters stays within the threshold.
+		std::vector<std::size_t> clusters;
+		for (std::size_t i = 0; i + 1 < hard.size(); ++i)
+		{
+			std::size_t begin = hard[i];
+			std::size_t end = hard[i + 1];
+
+			// Advancing the time flushes the simulated cache.
+			time += CACHE_SIZE + 1;
+			float target = simulate(&indices[begin * 3], (end - begin) * 3, stamps, time) / static_cast<float>(end - begin) * threshold;
+
+			time += CACHE_SIZE + 1;
+			clusters.push_back(begin);
+
+			std::size_t start = begin;
+			unsigned int misses = 0;
+
+			for (std::size_t j = begin; j + 1 < end; ++j)
+			{
+				misses += simulate(&indices[j * 3], 3, stamps, time);
+				if (misses <= target * (j - start + 1))
+				{
+					time += CACHE_SIZE + 1;
+					clusters.push_back(j + 1);
+
+					start = j + 1;
+					misses = 0;
+				}
+			}
+		}
+
+		clusters.push_back(triangles);
+
+		struct Cluster_t
+		{
+			std::size_t begin;  ///< The first triangle of the cluster.
+			std::size_t end;    ///< One past the last triangle of the cluster.
+			Vector3f    centre; ///< The area weighted centre of the triangles.
+			Vector3f    normal; ///< The area weighted normal of the triangles.
+			float       facing; ///< How far the cluster faces away from the centre of the mesh.
+		};
+
+		std::vector<Cluster_t> sorted;
+		Vector3f centre;
+		float area = 0.0f;
+
+		for (std::size_t i = 0; i + 1 < clusters.size(); ++i)
+		{
+			Cluster_t cluster = { clusters[i], clusters[i + 1], Vector3f(), Vector3f(), 0.0f };
+			float clusterArea = 0.0f;
+
+			for (std::size_t j = cluster.begin; j < cluster.end; ++j)
+			{
+				const Vector3f& a = vertices[indices[j * 3]].position;
+				const Vector3f& b = vertices[indices[j * 3 + 1]].position;
+				const Vector3f& c = vertices[indices[j * 3 + 2]].position;
+
+				// The length of the cross product is twice the area of the triangle.
+				Vector3f normal = Vector3f::cross(b - a, c - a);
+				float weight = std::sqrt(Vector3f::dot(normal, normal));
+
+				cluster.normal += normal;
+				cluster.centre += (a + b + c) * (weight / 3.0f);
+				clusterArea += weight;
+			}
+
+			centre += cluster.centre;
+			area += clusterArea;
+
+			if (clusterArea > 0.0f)
+			{
+				cluster.centre /= clusterArea;
+			}
+
+			sorted.push_back(cluster);
+		}
+
+		if (area > 0.0f)
+		{
+			centre /= area;
+		}
+
+		for (auto& cluster : sorted)
+		{
+			float length = std::sqrt(Vector3f::dot(cluster.normal, cluster.normal));
+			cluster.facing = length > 0.0f ? Vector3f::dot(cluster.centre - centre, cluster.normal) / length : 0.0f;
+		}
+
+		// The clusters facing outwards are most likely to be in front of the rest, whichever side the mesh is viewed from.
+		std::stable_sort(sorted.begin(), sorted.end(), [](const Cluster_t& lhs, const Cluster_t& rhs) {
+			return lhs.facing > rhs.facing;
+		});
+
+		std::vector<GLuint> output;
+		output.reserve(indices.size());
+
+		for (const auto& cluster : sorted)
+		{
+			output.insert(output.end(), indices.begin() + cluster.begin * 3, indices.begin() + cluster.end * 3);
+		}
+
+		indices.swap(output);
+	}
+
+	////////////////////////////////////////////////////////////
+	void MeshOptimiser::optimiseVertexFetch(std::vector<Vertex_t>& vertices, std::vector<GLuint>& indices)
+	{
+		if (!isValid(indices, vertices.size()))
+		{
+			return;
+		}
+
+		std::vector<GLuint> remap(vertices.size(), INVALID_INDEX);
+		std::vector<Vertex_t> ordered;
+		ordered.reserve(vertices.size());
+
+		for (GLuint& index : indices)
+		{
+			if (remap[index] == INVALID_INDEX)
+			{
+				remap[index] = static_cast<GLuint>(ordered.size());
+				ordered.push_back(vertices[index]);
+			}
+
+			index = remap[index];
+		}
+
+		vertices.swap(ordered);
+	}
+
+	////////////////////////////////////////////////////////////
+	void MeshOptimiser::optimise(std::vector<Vertex_t>& vertices, std::vector<GLuint>& indices)
+	{
+		optimiseVertexCache(indices, vertices.size());
+		optimiseOverdraw(indices, vertices);
+		optimiseVertexFetch(vertices, indices);
+	}
+
+	////////////////////////////////////////////////////////////
+	MeshOptimiser::Statistics_t MeshOptimiser::analyse(const std::vector<GLuint>& indices, std::size_t vertexCount)
+	{
+		if (indices.empty() || !isValid(indices, vertexCount))
+		{
+			return { 0.0f, 0.0f };
+		}
+
+		std::vector<unsigned int> stamps(vertexCount, 0);
+		unsigned int time = CACHE_SIZE + 1;
+
+		unsigned int misses = simulate(indices.data(), indices.size(), stamps, time);
+
+		// Only the vertices the triangles refer to could ever be transformed.
+		std::vector<bool> used(vertexCount, false);
+		std::size_t count = 0;
+
+		for (GLuint index : indices)
+		{
+			if (!used[index])
+			{
+				used[index] = true;
+				count++;
+			}
+		}
+
+		return { misses / static_cast<float>(indices.size() / 3), misses / static_cast<float>(count) };
+	}
+
+} // namespace jackal
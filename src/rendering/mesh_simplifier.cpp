@@ -0,0 +1,408 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//====================
+// C++ includes
+//====================
+#include <algorithm>     // Sorting the collapses by cost.
+#include <cmath>         // Converting the quadric error into a distance.
+#include <cstdint>       // Packing the edges into a single key.
+#include <numeric>       // Ordering the vertices by position.
+#include <unordered_set> // Finding the edges on the border of the mesh.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/rendering/mesh_simplifier.hpp> // MeshSimplifier class declaration.
+#include <jackal/rendering/mesh_optimiser.hpp>  // Optimising each level for the vertex cache.
+
+namespace jackal
+{
+	//====================
+	// Local variables
+	//====================
+	static const float MIN_REDUCTION = 0.85f; // A level must have at most this fraction of the triangles of the previous level.
+
+	struct Quadric_t
+	{
+		double a00, a01, a02, a03; ///< The first row of the symmetric matrix.
+		double a11, a12, a13;      ///< The second row, from the diagonal.
+		double a22, a23;           ///< The third row, from the diagonal.
+		double a33;                ///< The last element of the diagonal.
+	};
+
+	struct Collapse_t
+	{
+		GLuint from; ///< The vertex that is removed.
+		GLuint to;   ///< The vertex the triangles of the removed vertex are moved onto.
+		double cost; ///< The quadric error of the collapse.
+	};
+
+	////////////////////////////////////////////////////////////
+	static void addPlane(Quadric_t& quadric, const Vector3f& normal, float distance)
+	{
+		double a = normal.x;
+		double b = normal.y;
+		double c = normal.z;
+		double d = distance;
+
+		quadric.a00 += a * a; quadric.a01 += a * b; quadric.a02 += a * c; quadric.a03 += a * d;
+		quadric.a11 += b * b; quadric.a12 += b * c; quadric.a13 += b * d;
+		quadric.a22 += c * c; quadric.a23 += c * d;
+		quadric.a33 += d * d;
+	}
+
+	////////////////////////////////////////////////////////////
+	static void addQuadric(Quadric_t& quadric, const Quadric_t& other)
+	{
+		quadric.a00 += other.a00; quadric.a01 += other.a01; quadric.a02 += other.a02; quadric.a03 += other.a03;
+		quadric.a11 += other.a11; quadric.a12 += other.a12; quadric.a13 += other.a13;
+		quadric.a22 += other.a22; quadric.a23 += other.a23;
+		quadric.a33 += other.a33;
+	}
+
+	////////////////////////////////////////////////////////////
+	static double evaluate(const Quadric_t& quadric, const Vector3f& point)
+	{
+		double x = point.x;
+		double y = point.y;
+		double z = point.z;
+
+		// The sum of the squared distances from the point to every plane of the quadric.
+		double error = quadric.a00 * x * x + 2.0 * quadric.a01 * x * y + 2.0 * quadric.a02 * x * z + 2.0 * quadric.a03 * x +
+			quadric.a11 * y * y + 2.0 * quadric.a12 * y * z + 2.0 * quadric.a13 * y +
+			quadric.a22 * z * z + 2.0 * quadric.a23 * z + quadric.a33;
+
+		return std::max(0.0, error);
+	}
+
+	////////////////////////////////////////////////////////////
+	static std::uint64_t getEdgeKey(GLuint from, GLuint to)
+	{
+		return (static_cast<std::uint64_t>(from) << 32) | to;
+	}
+
+	////////////////////////////////////////////////////////////
+	static bool isFlipped(const std::vector<Vertex_t>& vertices, const std::vector<GLuint>& indices, const std::vector<GLuint>& offsets,
+		const std::vector<GLuint>& adjacency, GLuint from, GLuint to)
+	{
+		for (GLuint i = offsets[from]; i < offsets[from + 1]; ++i)
+		{
+			const GLuint* pTriangle = &indices[adjacency[i] * 3];
+			if (pTriangle[0] == to || pTriangle[1] == to || pTriangle[2] == to)
+			{
+				continue;
+			}
+
+			const Vector3f& a = vertices[pTriangle[0]].position;
+			const Vector3f& b = vertices[pTriangle[1]].position;
+			const Vector3f& c = vertices[pTriangle[2]].position;
+
+			const Vector3f& moved = vertices[to].position;
+			const Vector3f& a2 = pTriangle[0] == from ? moved : a;
+			const Vector3f& b2 = pTriangle[1] == from ? moved : b;
+			const Vector3f& c2 = pTriangle[2] == from ? moved : c;
+
+			// A triangle that turns over, or collapses to a line, would show its back or a crack.
+			Vector3f before = Vector3f::cross(b - a, c - a);
+			Vector3f after = Vector3f::cross(b2 - a2, c2 - a2);
+
+			if (Vector3f::dot(before, after) <= 0.0f)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	//====================
+	// Static variables
+	//====================
+	const int MeshSimplifier::MAX_LODS;
+	const int MeshSimplifier::MIN_TRIANGLES;
+
+	//====================
+	// Methods
+	//====================
+	////////////////////////////////////////////////////////////
+	std::vector<GLuint> MeshSimplifier::simplify(const std::vector<Vertex_t>& vertices, const std::vector<GLuint>& indices,
+		std::size_t targetCount, float& error)
+	{
+		error = 0.0f;
+		std::vector<GLuint> result = indices;
+
+		std::size_t vertexCount = vertices.size();
+		if (indices.size() % 3 != 0 || std::any_of(indices.begin(), indices.end(), [vertexCount](GLuint index) { return index >= vertexCount; }))
+		{
+			return result;
+		}
+
+		// Vertices that share a position are the wedges of a single point on the surface, the first wedge represents the point.
+		std::vector<GLuint> order(vertexCount);
+		std::iota(order.begin(), order.end(), 0);
+		std::sort(order.begin(), order.end(), [&vertices](GLuint lhs, GLuint rhs) {
+			const Vector3f& a = vertices[lhs].position;
+			const Vector3f& b = vertices[rhs].position;
+
+			return a.x != b.x ? a.x < b.x : a.y != b.y ? a.y < b.y : a.z < b.z;
+		});
+
+		std::vector<GLuint> points(vertexCount);
+		for (std::size_t i = 0; i < vertexCount; ++i)
+		{
+			bool shared = i > 0 && vertices[order[i]].position == vertices[order[i - 1]].position;
+			points[order[i]] = shared ? points[order[i - 1]] : order[i];
+		}
+
+		// A point with several wedges in use lies on a seam of the uv's or normals, moving it would tear the seam.
+		std::vector<unsigned int> wedges(vertexCount, 0);
+		std::vector<unsigned char> used(vertexCount, 0);
+		std::vector<unsigned char> locked(vertexCount, 0);
+
+		for (GLuint index : indices)
+		{
+			if (!used[index])
+			{
+				used[index] = 1;
+				wedges[points[index]]++;
+			}
+		}
+
+		for (std::size_t i = 0; i < vertexCount; ++i)
+		{
+			locked[i] = wedges[i] > 1;
+		}
+
+		// An edge without a twin running the other way is on the border of the mesh, moving it would open a hole.
+		std::unordered_set<std::uint64_t> edges;
+		for (std::size_t i = 0; i < indices.size(); i += 3)
+		{
+			for (int j = 0; j < 3; ++j)
+			{
+				edges.insert(getEdgeKey(points[indices[i + j]], points[indices[i + (j + 1) % 3]]));
+			}
+		}
+
+		std::vector<Quadric_t> quadrics(vertexCount, Quadric_t());
+		for (std::size_t i = 0; i < indices.size(); i += 3)
+		{
+			for (int j = 0; j < 3; ++j)
+			{
+				GLuint from = points[indices[i + j]];
+				GLuint to = points[indices[i + (j + 1) % 3]];
+
+				if (edges.find(getEdgeKey(to, from)) == edges.end())
+				{
+					locked[from] = 1;
+					locked[to] = 1;
+				}
+			}
+
+			const Vector3f& a = vertices[indices[i]].position;
+			const Vector3f& b = vertices[indices[i + 1]].position;
+			const Vector3f& c = vertices[indices[i + 2]].position;
+
+			Vector3f normal = Vector3f::cross(b - a, c - a);
+			float length = normal.magnitude();
+
+			if (length <= 0.0f)
+			{
+				continue;
+			}
+
+			normal /= length;
+			float distance = -Vector3f::dot(normal, a);
+
+			for (int j = 0; j < 3; ++j)
+			{
+				addPlane(quadrics[points[indices[i + j]]], normal, distance);
+			}
+		}
+
+		std::vector<GLuint> offsets(vertexCount + 1);
+		std::vector<GLuint> adjacency;
+		std::vector<GLuint> collapses(vertexCount);
+		std::vector<unsigned char> touched(vertexCount);
+		std::vector<Collapse_t> candidates;
+		double maximumCost = 0.0;
+
+		// Each pass collapses the cheapest edges that don't share a triangle, so the costs stay valid for the whole pass.
+		while (result.size() > targetCount)
+		{
+			std::fill(offsets.begin(), offsets.end(), 0);
+			for (GLuint index : result)
+			{
+				offsets[index + 1]++;
+			}
+
+			for (std::size_t i = 0; i < vertexCount; ++i)
+			{
+				offsets[i + 1] += offsets[i];
+			}
+
+			std::vector<GLuint> cursors(offsets.begin(), offsets.end() - 1);
+			adjacency.resize(result.size());
+
+			for (std::size_t i = 0; i < result.size(); ++i)
+			{
+				adjacency[cursors[result[i]]++] = static_cast<GLuint>(i / 3);
+			}
+
+			candidates.clear();
+			for (std::size_t i = 0; i < result.size(); i += 3)
+			{
+				for (int j = 0; j < 3; ++j)
+				{
+					GLuint a = result[i + j];
+					GLuint b = result[i + (j + 1) % 3];
+
+					for (int k = 0; k < 2; ++k)
+					{
+						GLuint from = k == 0 ? a : b;
+						GLuint to = k == 0 ? b : a;
+
+						if (locked[points[from]])
+						{
+							continue;
+						}
+
+						Quadric_t quadric = quadrics[points[from]];
+						addQuadric(quadric, quadrics[points[to]]);
+
+						candidates.push_back({ from, to, evaluate(quadric, vertices[to].position) });
+					}
+				}
+			}
+
+			std::sort(candidates.begin(), candidates.end(), [](const Collapse_t& lhs, const Collapse_t& rhs) {
+				return lhs.cost < rhs.cost;
+			});
+
+			std::iota(collapses.begin(), collapses.end(), 0);
+			std::fill(touched.begin(), touched.end(), 0);
+
+			std::size_t removed = 0;
+			std::size_t required = result.size() - targetCount;
+
+			for (const auto& candidate : candidates)
+			{
+				if (removed >= required)
+				{
+					break;
+				}
+
+				if (touched[candidate.from] || touched[candidate.to] ||
+					isFlipped(vertices, result, offsets, adjacency, candidate.from, candidate.to))
+				{
+					continue;
+				}
+
+				collapses[candidate.from] = candidate.to;
+
+				for (GLuint i = offsets[candidate.from]; i < offsets[candidate.from + 1]; ++i)
+				{
+					const GLuint* pTriangle = &result[adjacency[i] * 3];
+					if (pTriangle[0] == candidate.to || pTriangle[1] == candidate.to || pTriangle[2] == candidate.to)
+					{
+						removed += 3;
+					}
+
+					touched[pTriangle[0]] = 1;
+					touched[pTriangle[1]] = 1;
+					touched[pTriangle[2]] = 1;
+				}
+
+				addQuadric(quadrics[points[candidate.to]], quadrics[points[candidate.from]]);
+				maximumCost = std::max(maximumCost, candidate.cost);
+			}
+
+			if (removed == 0)
+			{
+				break;
+			}
+
+			// The triangles that shared the collapsed edges now refer to a vertex twice and are dropped.
+			std::size_t count = 0;
+			for (std::size_t i = 0; i < result.size(); i += 3)
+			{
+				GLuint a = collapses[result[i]];
+				GLuint b = collapses[result[i + 1]];
+				GLuint c = collapses[result[i + 2]];
+
+				if (a != b && b != c && a != c)
+				{
+					result[count++] = a;
+					result[count++] = b;
+					result[count++] = c;
+				}
+			}
+
+			result.resize(count);
+		}
+
+		error = static_cast<float>(std::sqrt(maximumCost));
+		return result;
+	}
+
+	////////////////////////////////////////////////////////////
+	void MeshSimplifier::generateLods(const std::vector<Vertex_t>& vertices, const std::vector<GLuint>& indices,
+		std::vector<GLuint>& lodIndices, std::vector<MeshLod_t>& lods)
+	{
+		lodIndices.clear();
+		lods.clear();
+		lods.emplace_back(0, static_cast<GLsizei>(indices.size()), 0.0f);
+
+		if (indices.size() / 3 < static_cast<std::size_t>(MIN_TRIANGLES))
+		{
+			return;
+		}
+
+		// Each level is simplified from the previous one, so the errors of the levels add up.
+		const std::vector<GLuint>* pPrevious = &indices;
+		std::vector<GLuint> previous;
+		float error = 0.0f;
+
+		for (int i = 1; i < MAX_LODS; ++i)
+		{
+			float levelError = 0.0f;
+			std::vector<GLuint> simplified = simplify(vertices, *pPrevious, pPrevious->size() / 6 * 3, levelError);
+
+			if (simplified.empty() || simplified.size() > static_cast<std::size_t>(pPrevious->size() * MIN_REDUCTION))
+			{
+				break;
+			}
+
+			MeshOptimiser::optimiseVertexCache(simplified, vertices.size());
+			error += levelError;
+
+			lods.emplace_back(static_cast<GLuint>(indices.size() + lodIndices.size()), static_cast<GLsizei>(simplified.size()), error);
+			lodIndices.insert(lodIndices.end(), simplified.begin(), simplified.end());
+
+			previous = std::move(simplified);
+			pPrevious = &previous;
+		}
+	}
+
+} // namespace jackal
@@ -22,20 +22,31 @@
 //
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+//====================
+// C++ includes
+//====================
+#include <algorithm>  // Sorting the meshes by page and clamping the levels of detail.
+#include <filesystem> // Checking the extension of the model.
+
 //====================
 // Jackal includes
 //====================
-#include <jackal/rendering/model.hpp>           // Model class declaration.
-#include <jackal/utils/log.hpp>                 // Logs warnings and errors.
-#include <jackal/core/virtual_file_system.hpp>  // Loading files using the virtual file system.
-#include <jackal/utils/resource_manager.hpp>    // Retrieving a Model resource from the manager.
+#include <jackal/rendering/model.hpp>             // Model class declaration.
+#include <jackal/utils/log.hpp>                   // Logs warnings and errors.
+#include <jackal/core/virtual_file_system.hpp>    // Loading files using the virtual file system.
+#include <jackal/utils/resource_manager.hpp>      // Retrieving a Model resource from the manager.
+#include <jackal/rendering/geometry_heap.hpp>     // Binding the pages the meshes are stored in.
+#include <jackal/rendering/render_thread.hpp>     // Executing the draw commands on the render thread.
+#include <jackal/rendering/render_statistics.hpp> // Counting the draw calls and triangles.
+#include <jackal/rendering/mesh_optimiser.hpp>    // Reordering the imported triangles and vertices.
+#include <jackal/rendering/vertex_layout.hpp>     // Uploading imported models with the compressed layout.
 
 //====================
 // Additional includes
 //====================
-#include <assimp/Importer.hpp>                  // Importing the model from an external source.
-#include <assimp/scene.h>                       // Loading the model into a scene object.
-#include <assimp/postprocess.h>                 // Post-processing. Flipping uv's.
+#include <assimp/Importer.hpp>  // Importing the model from an external source.
+#include <assimp/scene.h>       // Loading the model into a scene object.
+#include <assimp/postprocess.h> // Post-processing. Flipping uv's.
 
 namespace jackal
 {
@@ -49,7 +60,8 @@ namespace jackal
 	//====================
 	////////////////////////////////////////////////////////////
 	Model::Model()
-		: IRenderable(), Resource(), m_meshes()
+		: IRenderable(), Resource(), m_meshes(), m_commands(), m_batches(), m_lodBatches(), m_indirect(eBufferType::INDIRECT),
+		  m_counts(), m_offsets(), m_baseVertices(), m_pFile(), m_prepared(false)
 	{
 	}
 
@@ -96,6 +108,21 @@ namespace jackal
 				vertex.normal.z = pMesh->mNormals[i].z;
 			}
 
+			if (pMesh->mTangents && pMesh->mBitangents)
+			{
+				Vector3f tangent(pMesh->mTangents[i].x, pMesh->mTangents[i].y, pMesh->mTangents[i].z);
+				Vector3f bitangent(pMesh->mBitangents[i].x, pMesh->mBitangents[i].y, pMesh->mBitangents[i].z);
+
+				// Only the handedness of the bitangent is kept, the shader rebuilds it from the normal and tangent.
+				float handedness = Vector3f::dot(Vector3f::cross(vertex.normal, tangent), bitangent) < 0.0f ? -1.0f : 1.0f;
+				vertex.tangent = Vector4f(tangent.x, tangent.y, tangent.z, handedness);
+			}
+
+			if (pMesh->mColors[0])
+			{
+				vertex.colour = Colour(pMesh->mColors[0][i].r, pMesh->mColors[0][i].g, pMesh->mColors[0][i].b, pMesh->mColors[0][i].a);
+			}
+
 			vertices.push_back(vertex);
 		}
 
@@ -107,16 +134,144 @@ namespace jackal
 				indices.push_back(face.mIndices[j]);
 			}
 		}
-		
-		m_meshes.emplace_back(vertices, indices);
+
+		// Assimp keeps the order of the source file, which is rarely the order the GPU draws fastest.
+		MeshOptimiser::optimise(vertices, indices);
+
+		// The mesh is created once every mesh of the model is converted, as they are quantised within the bounds of the model.
+		Mesh mesh;
+		mesh.addVertices(vertices);
+		mesh.addIndices(indices);
+		mesh.generateLods();
+
+		m_meshes.push_back(std::move(mesh));
+	}
+
+	////////////////////////////////////////////////////////////
+	void Model::loadCooked(const MeshFile& file)
+	{
+		// The positions of every sub-mesh are quantised within the bounds of the file.
+		const VertexLayout& layout = file.getLayout();
+		const BoundingBox& frame = file.getBoundingBox();
+
+		for (const auto& mesh : file.getSubMeshes())
+		{
+			const unsigned char* pVertices = file.getVertices() + static_cast<std::size_t>(mesh.firstVertex) * layout.getStride();
+			if (mesh.shortIndices)
+			{
+				m_meshes.emplace_back(pVertices, static_cast<int>(mesh.vertexCount), layout, frame,
+					file.getShortIndices() + mesh.firstIndex, static_cast<int>(mesh.indexCount), mesh.box, mesh.sphere, mesh.lods);
+			}
+			else
+			{
+				m_meshes.emplace_back(pVertices, static_cast<int>(mesh.vertexCount), layout, frame,
+					file.getIndices() + mesh.firstIndex, static_cast<int>(mesh.indexCount), mesh.box, mesh.sphere, mesh.lods);
+			}
+		}
+
+		this->setBounds(frame, BoundingSphere(frame));
+		this->setLayout(layout, frame);
+		this->createBatches();
+	}
+
+	////////////////////////////////////////////////////////////
+	void Model::createBatches()
+	{
+		m_commands.clear();
+		m_batches.clear();
+		m_lodBatches.clear();
+		m_counts.clear();
+		m_offsets.clear();
+		m_baseVertices.clear();
+
+		std::vector<const Mesh*> meshes;
+		std::size_t lodCount = 1;
+
+		for (const auto& mesh : m_meshes)
+		{
+			if (mesh.getRange().isValid())
+			{
+				meshes.push_back(&mesh);
+				lodCount = std::max(lodCount, mesh.getLods().size());
+			}
+		}
+
+		std::stable_sort(std::begin(meshes), std::end(meshes), [](const Mesh* pLhs, const Mesh* pRhs) {
+			return pLhs->getRange().page < pRhs->getRange().page;
+		});
+
+		// Every level of detail of the model has its own batches, meshes with fewer levels draw their coarsest level.
+		std::vector<MeshLod_t> lods(lodCount);
+		for (std::size_t i = 0; i < lodCount; ++i)
+		{
+			m_lodBatches.push_back(static_cast<int>(m_batches.size()));
+
+			for (const auto* pMesh : meshes)
+			{
+				const GeometryRange_t& range = pMesh->getRange();
+				if (m_batches.size() == static_cast<std::size_t>(m_lodBatches.back()) || m_batches.back().page != range.page)
+				{
+					m_batches.push_back({ range.page, static_cast<int>(m_commands.size()), 0, range.indexType });
+				}
+
+				const auto& meshLods = pMesh->getLods();
+				const MeshLod_t& lod = meshLods[std::min(i, meshLods.size() - 1)];
+
+				m_batches.back().count++;
+				m_commands.emplace_back(lod.indexCount, range.firstIndex + lod.firstIndex, range.baseVertex);
+
+				lods[i].indexCount += lod.indexCount;
+				lods[i].error = std::max(lods[i].error, lod.error);
+			}
+		}
+
+		m_lodBatches.push_back(static_cast<int>(m_batches.size()));
+		this->setLods(lods);
+
+		if (GLEW_VERSION_4_3 || GLEW_ARB_multi_draw_indirect)
+		{
+			m_indirect.create();
+			Buffer::bind(m_indirect);
+			m_indirect.allocate(m_commands.data(), m_commands.size());
+			Buffer::unbind(m_indirect);
+		}
+		else
+		{
+			for (const auto& batch : m_batches)
+			{
+				std::size_t indexSize = batch.indexType == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint);
+				for (int i = batch.first; i < batch.first + batch.count; ++i)
+				{
+					m_counts.push_back(m_commands[i].count);
+					m_offsets.push_back(reinterpret_cast<const GLvoid*>(indexSize * m_commands[i].firstIndex));
+					m_baseVertices.push_back(m_commands[i].baseVertex);
+				}
+			}
+		}
 	}
 
 	//====================
 	// Methods
 	//====================
 	////////////////////////////////////////////////////////////
-	bool Model::load(const std::string& filename) // override
+	bool Model::prepare(const std::string& filename) // override
 	{
+		// Cooked models only need to be opened, their meshes are allocated straight from the mapping.
+		if (std::filesystem::path(filename).extension() == ".jmesh")
+		{
+			auto pFile = std::make_unique<MeshFile>();
+			if (!pFile->open(filename))
+			{
+				log.warning(log.function(__FUNCTION__, filename), "Failed to load the cooked model.");
+				return false;
+			}
+
+			m_pFile = std::move(pFile);
+			m_prepared = true;
+
+			return true;
+		}
+
 		std::string path;
 		if (!VirtualFileSystem::getInstance().resolve(filename, path))
 		{
@@ -134,6 +289,55 @@ namespace jackal
 		}
 
 		this->loadNode(pScene->mRootNode, pScene);
+
+		// The model is bounded by every mesh it is made of, and every mesh is quantised within
+		// the same box so they can all be drawn with a single set of decode constants.
+		BoundingBox box;
+		for (const auto& mesh : m_meshes)
+		{
+			for (const auto& vertex : mesh.getVertices())
+			{
+				box.expand(vertex.position);
+			}
+		}
+
+		for (auto& mesh : m_meshes)
+		{
+			mesh.setLayout(VertexLayout::compressed(), box);
+		}
+
+		this->setBounds(box, BoundingSphere(box));
+		this->setLayout(VertexLayout::compressed(), box);
+		m_prepared = true;
+
+		return true;
+	}
+
+	////////////////////////////////////////////////////////////
+	bool Model::load(const std::string& filename) // override
+	{
+		if (!m_prepared && !this->prepare(filename))
+		{
+			return false;
+		}
+
+		m_prepared = false;
+
+		if (m_pFile)
+		{
+			this->loadCooked(*m_pFile);
+			m_pFile.reset();
+
+			log.debug(log.function(__FUNCTION__, filename), "Loaded successfully.");
+			return true;
+		}
+
+		for (auto& mesh : m_meshes)
+		{
+			mesh.create();
+		}
+
+		this->createBatches();
 		log.debug(log.function(__FUNCTION__, filename), "Imported successfully.");
 
 		return true;
@@ -148,10 +352,80 @@ namespace jackal
 	////////////////////////////////////////////////////////////
 	void Model::render()
 	{
-		for (auto& mesh : m_meshes)
+		if (m_lodBatches.size() < 2)
 		{
-			mesh.render();
+			return;
 		}
+
+		int lod = std::min(this->getLod(), static_cast<int>(m_lodBatches.size()) - 2);
+		int firstBatch = m_lodBatches[lod];
+		int lastBatch = m_lodBatches[lod + 1];
+
+		std::uint64_t triangles = 0;
+		for (int i = firstBatch; i < lastBatch; ++i)
+		{
+			for (int j = m_batches[i].first; j < m_batches[i].first + m_batches[i].count; ++j)
+			{
+				triangles += m_commands[j].count / 3;
+			}
+		}
+
+		// Each batch is submitted with a single multi-draw call.
+		RenderStatistics::getInstance().add(eRenderCounter::DRAW_CALLS, lastBatch - firstBatch);
+		RenderStatistics::getInstance().add(eRenderCounter::TRIANGLES, triangles);
+
+		// The batches are copied, so the model can change, or be released, before the frame executes.
+		std::vector<Batch_t> batches(m_batches.begin() + firstBatch, m_batches.begin() + lastBatch);
+		std::vector<GLsizei> counts;
+		std::vector<const GLvoid*> offsets;
+		std::vector<GLint> baseVertices;
+
+		GLuint indirect = m_indirect.isCreated() ? m_indirect.getID() : 0;
+		if (!indirect)
+		{
+			for (auto& batch : batches)
+			{
+				int first = batch.first;
+				batch.first = static_cast<int>(counts.size());
+
+				counts.insert(counts.end(), m_counts.begin() + first, m_counts.begin() + first + batch.count);
+				offsets.insert(offsets.end(), m_offsets.begin() + first, m_offsets.begin() + first + batch.count);
+				baseVertices.insert(baseVertices.end(), m_baseVertices.begin() + first, m_baseVertices.begin() + first + batch.count);
+			}
+		}
+
+		VertexLayout::Decode_t decode = this->getDecode();
+		RenderThread::getInstance().enqueue([decode, indirect, batches = std::move(batches), counts = std::move(counts),
+			offsets = std::move(offsets), baseVertices = std::move(baseVertices)]() {
+			auto& heap = GeometryHeap::getInstance();
+			VertexLayout::applyDecode(decode);
+
+			if (indirect)
+			{
+				glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirect);
+			}
+
+			for (const Batch_t& batch : batches)
+			{
+				heap.bind(batch.page);
+
+				if (indirect)
+				{
+					const GLvoid* pOffset = reinterpret_cast<const GLvoid*>(sizeof(DrawCommand_t) * batch.first);
+					glMultiDrawElementsIndirect(GL_TRIANGLES, batch.indexType, pOffset, batch.count, 0);
+				}
+				else
+				{
+					glMultiDrawElementsBaseVertex(GL_TRIANGLES, &counts[batch.first], batch.indexType, 
+						&offsets[batch.first], batch.count, &baseVertices[batch.first]);
+				}
+			}
+
+			if (indirect)
+			{
+				glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+			}
+		});
 	}
 
 } // namespace jackal
\ No newline at end of file
@@ -0,0 +1,398 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//====================
+// C++ includes
+//====================
+#include <algorithm>                             // Clamping the bounds of triangles and boxes.
+#include <cmath>                                 // Rounding the bounds to whole pixels.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/rendering/occlusion_culler.hpp> // OcclusionCuller class declaration.
+#include <jackal/rendering/irenderable.hpp>      // Reading the vertices and indices of the occluders.
+#include <jackal/utils/thread_pool.hpp>          // Rasterising the tiles in parallel.
+
+//====================
+// Additional includes
+//====================
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+	#define JACKAL_SSE 1
+	#include <xmmintrin.h>                       // Rasterising four pixels at once.
+#endif
+
+namespace jackal
+{
+	//====================
+	// Local variables
+	//====================
+	////////////////////////////////////////////////////////////
+	/// @brief Projects a point into the screen space of the depth buffer.
+	///
+	/// @param matrix  The matrix to project the point by.
+	/// @param point   The point to project.
+	/// @param width   The width of the depth buffer.
+	/// @param height  The height of the depth buffer.
+	/// @param pOut    Set to the x, y and depth of the projected point.
+	///
+	/// @returns       False if the point is in front of the near plane.
+	///
+	////////////////////////////////////////////////////////////
+	static bool project(const Matrix4& matrix, const Vector3f& point, float width, float height, float* pOut)
+	{
+		// The matrix is stored by column, m[column][row].
+		float x = matrix.m[0][0] * point.x + matrix.m[1][0] * point.y + matrix.m[2][0] * point.z + matrix.m[3][0];
+		float y = matrix.m[0][1] * point.x + matrix.m[1][1] * point.y + matrix.m[2][1] * point.z + matrix.m[3][1];
+		float z = matrix.m[0][2] * point.x + matrix.m[1][2] * point.y + matrix.m[2][2] * point.z + matrix.m[3][2];
+		float w = matrix.m[0][3] * point.x + matrix.m[1][3] * point.y + matrix.m[2][3] * point.z + matrix.m[3][3];
+
+		if (w <= 0.0f || z < -w)
+		{
+			return false;
+		}
+
+		pOut[0] = (x / w * 0.5f + 0.5f) * width;
+		pOut[1] = (0.5f - y / w * 0.5f) * height;
+		pOut[2] = z / w;
+
+		return true;
+	}
+
+	//====================
+	// Static variables
+	//====================
+	const int OcclusionCuller::TILE_WIDTH;
+	const int OcclusionCuller::TILE_HEIGHT;
+
+	//====================
+	// Ctor and dtor
+	//====================
+	////////////////////////////////////////////////////////////
+	OcclusionCuller::OcclusionCuller(int width /*= 320*/, int height /*= 192*/)
+		: m_width(0), m_height(0), m_tilesX(0), m_tilesY(0), m_depth(), m_triangles(), m_bins(), m_viewProjection()
+	{
+		m_tilesX = std::max((width + TILE_WIDTH - 1) / TILE_WIDTH, 1);
+		m_tilesY = std::max((height + TILE_HEIGHT - 1) / TILE_HEIGHT, 1);
+		m_width = m_tilesX * TILE_WIDTH;
+		m_height = m_tilesY * TILE_HEIGHT;
+
+		m_depth.resize(m_width * m_height, 1.0f);
+		m_bins.resize(m_tilesX * m_tilesY);
+	}
+
+	//====================
+	// Private methods
+	//====================
+	////////////////////////////////////////////////////////////
+	void OcclusionCuller::rasteriseTile(int tile)
+	{
+		int tileX = (tile % m_tilesX) * TILE_WIDTH;
+		int tileY = (tile / m_tilesX) * TILE_HEIGHT;
+
+		for (int index : m_bins[tile])
+		{
+			Triangle_t triangle = m_triangles[index];
+
+			float area = (triangle.x[1] - triangle.x[0]) * (triangle.y[2] - triangle.y[0]) -
+			             (triangle.x[2] - triangle.x[0]) * (triangle.y[1] - triangle.y[0]);
+
+			// Occluders are double sided, the winding is flipped so every edge function is positive inside.
+			if (area < 0.0f)
+			{
+				std::swap(triangle.x[1], triangle.x[2]);
+				std::swap(triangle.y[1], triangle.y[2]);
+				std::swap(triangle.z[1], triangle.z[2]);
+				area = -area;
+			}
+
+			// The edge opposite each vertex, as a function A * x + B * y + C.
+			float a[3], b[3], c[3];
+			for (int i = 0; i < 3; ++i)
+			{
+				int from = (i + 1) % 3;
+				int to = (i + 2) % 3;
+
+				a[i] = triangle.y[from] - triangle.y[to];
+				b[i] = triangle.x[to] - triangle.x[from];
+				c[i] = -(a[i] * triangle.x[from] + b[i] * triangle.y[from]);
+			}
+
+			// The depth is interpolated with the same edge functions, normalised by the area.
+			float za = (a[0] * triangle.z[0] + a[1] * triangle.z[1] + a[2] * triangle.z[2]) / area;
+			float zb = (b[0] * triangle.z[0] + b[1] * triangle.z[1] + b[2] * triangle.z[2]) / area;
+			float zc = (c[0] * triangle.z[0] + c[1] * triangle.z[1] + c[2] * triangle.z[2]) / area;
+
+			int minX = std::max(static_cast<int>(std::floor(std::min({ triangle.x[0], triangle.x[1], triangle.x[2] }))), tileX);
+			int maxX = std::min(static_cast<int>(std::ceil(std::max({ triangle.x[0], triangle.x[1], triangle.x[2] }))), tileX + TILE_WIDTH - 1);
+			int minY = std::max(static_cast<int>(std::floor(std::min({ triangle.y[0], triangle.y[1], triangle.y[2] }))), tileY);
+			int maxY = std::min(static_cast<int>(std::ceil(std::max({ triangle.y[0], triangle.y[1], triangle.y[2] }))), tileY + TILE_HEIGHT - 1);
+
+			// Rows are processed four pixels at a time, the tiles are aligned to four pixels.
+			minX &= ~3;
+
+			for (int y = minY; y <= maxY; ++y)
+			{
+				float py = y + 0.5f;
+				float* pRow = &m_depth[y * m_width];
+
+#if JACKAL_SSE
+				__m128 offsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+				__m128 zero = _mm_setzero_ps();
+
+				for (int x = minX; x <= maxX; x += 4)
+				{
+					__m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), offsets);
+
+					__m128 e0 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(a[0]), px), _mm_set1_ps(b[0] * py + c[0]));
+					__m128 e1 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(a[1]), px), _mm_set1_ps(b[1] * py + c[1]));
+					__m128 e2 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(a[2]), px), _mm_set1_ps(b[2] * py + c[2]));
+					__m128 z = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(za), px), _mm_set1_ps(zb * py + zc));
+
+					__m128 depth = _mm_loadu_ps(pRow + x);
+					__m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_cmpge_ps(e1, zero)),
+					                           _mm_and_ps(_mm_cmpge_ps(e2, zero), _mm_cmplt_ps(z, depth)));
+
+					_mm_storeu_ps(pRow + x, _mm_or_ps(_mm_and_ps(inside, z), _mm_andnot_ps(inside, depth)));
+				}
+#else
+				for (int x = minX; x <= maxX; ++x)
+				{
+					float px = x + 0.5f;
+
+					if (a[0] * px + b[0] * py + c[0] >= 0.0f &&
+					    a[1] * px + b[1] * py + c[1] >= 0.0f &&
+					    a[2] * px + b[2] * py + c[2] >= 0.0f)
+					{
+						pRow[x] = std::min(pRow[x], za * px + zb * py + zc);
+					}
+				}
+#endif
+			}
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	const float* OcclusionCuller::getPixel(int x, int y) const
+	{
+		return &m_depth[y * m_width + x];
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	////////////////////////////////////////////////////////////
+	int OcclusionCuller::getWidth() const
+	{
+		return m_width;
+	}
+
+	////////////////////////////////////////////////////////////
+	int OcclusionCuller::getHeight() const
+	{
+		return m_height;
+	}
+
+	////////////////////////////////////////////////////////////
+	std::size_t OcclusionCuller::getTriangleCount() const
+	{
+		return m_triangles.size();
+	}
+
+	//====================
+	// Methods
+	//====================
+	////////////////////////////////////////////////////////////
+	void OcclusionCuller::begin(const Matrix4& viewProjection)
+	{
+		m_viewProjection = viewProjection;
+
+		std::fill(m_depth.begin(), m_depth.end(), 1.0f);
+		m_triangles.clear();
+
+		for (auto& bin : m_bins)
+		{
+			bin.clear();
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void OcclusionCuller::addOccluder(const IRenderable& renderable, const Matrix4& model)
+	{
+		const auto& vertices = renderable.getVertices();
+		const auto& indices = renderable.getIndices();
+
+		Matrix4 matrix = model * m_viewProjection;
+
+		std::vector<float> projected(vertices.size() * 3);
+		std::vector<bool> valid(vertices.size());
+
+		for (std::size_t i = 0; i < vertices.size(); ++i)
+		{
+			valid[i] = project(matrix, vertices[i].position, static_cast<float>(m_width), static_cast<float>(m_height), &projected[i * 3]);
+		}
+
+		for (std::size_t i = 0; i + 2 < indices.size(); i += 3)
+		{
+			if (indices[i] >= vertices.size() || indices[i + 1] >= vertices.size() || indices[i + 2] >= vertices.size() ||
+			    !valid[indices[i]] || !valid[indices[i + 1]] || !valid[indices[i + 2]])
+			{
+				continue;
+			}
+
+			Triangle_t triangle;
+			for (int j = 0; j < 3; ++j)
+			{
+				const float* pVertex = &projected[indices[i + j] * 3];
+
+				triangle.x[j] = pVertex[0];
+				triangle.y[j] = pVertex[1];
+				triangle.z[j] = pVertex[2];
+			}
+
+			float minX = std::min({ triangle.x[0], triangle.x[1], triangle.x[2] });
+			float maxX = std::max({ triangle.x[0], triangle.x[1], triangle.x[2] });
+			float minY = std::min({ triangle.y[0], triangle.y[1], triangle.y[2] });
+			float maxY = std::max({ triangle.y[0], triangle.y[1], triangle.y[2] });
+
+			if (maxX < 0.0f || maxY < 0.0f || minX >= m_width || minY >= m_height)
+			{
+				continue;
+			}
+
+			float area = (triangle.x[1] - triangle.x[0]) * (triangle.y[2] - triangle.y[0]) -
+			             (triangle.x[2] - triangle.x[0]) * (triangle.y[1] - triangle.y[0]);
+
+			if (std::abs(area) < 1.0e-6f)
+			{
+				continue;
+			}
+
+			int index = static_cast<int>(m_triangles.size());
+			m_triangles.push_back(triangle);
+
+			int firstX = std::max(static_cast<int>(minX) / TILE_WIDTH, 0);
+			int lastX = std::min(static_cast<int>(maxX) / TILE_WIDTH, m_tilesX - 1);
+			int firstY = std::max(static_cast<int>(minY) / TILE_HEIGHT, 0);
+			int lastY = std::min(static_cast<int>(maxY) / TILE_HEIGHT, m_tilesY - 1);
+
+			for (int y = firstY; y <= lastY; ++y)
+			{
+				for (int x = firstX; x <= lastX; ++x)
+				{
+					m_bins[y * m_tilesX + x].push_back(index);
+				}
+			}
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void OcclusionCuller::rasterise()
+	{
+		ThreadPool::getInstance().parallelFor(m_bins.size(), 1, [this](std::size_t begin, std::size_t end) {
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				this->rasteriseTile(static_cast<int>(i));
+			}
+		});
+	}
+
+	////////////////////////////////////////////////////////////
+	bool OcclusionCuller::isVisible(const BoundingBox& box) const
+	{
+		if (!box.isValid())
+		{
+			return false;
+		}
+
+		float minX = static_cast<float>(m_width), maxX = 0.0f;
+		float minY = static_cast<float>(m_height), maxY = 0.0f;
+		float minZ = 1.0f;
+
+		for (int i = 0; i < 8; ++i)
+		{
+			Vector3f corner(i & 1 ? box.maximum.x : box.minimum.x,
+			                i & 2 ? box.maximum.y : box.minimum.y,
+			                i & 4 ? box.maximum.z : box.minimum.z);
+
+			float projected[3];
+			if (!project(m_viewProjection, corner, static_cast<float>(m_width), static_cast<float>(m_height), projected))
+			{
+				return true;
+			}
+
+			minX = std::min(minX, projected[0]);
+			maxX = std::max(maxX, projected[0]);
+			minY = std::min(minY, projected[1]);
+			maxY = std::max(maxY, projected[1]);
+			minZ = std::min(minZ, projected[2]);
+		}
+
+		int firstX = std::max(static_cast<int>(std::floor(minX)), 0) & ~3;
+		int lastX = std::min(static_cast<int>(std::ceil(maxX)), m_width - 1);
+		int firstY = std::max(static_cast<int>(std::floor(minY)), 0);
+		int lastY = std::min(static_cast<int>(std::ceil(maxY)), m_height - 1);
+
+		for (int y = firstY; y <= lastY; ++y)
+		{
+#if JACKAL_SSE
+			__m128 z = _mm_set1_ps(minZ);
+
+			for (int x = firstX; x <= lastX; x += 4)
+			{
+				if (_mm_movemask_ps(_mm_cmpge_ps(_mm_loadu_ps(this->getPixel(x, y)), z)))
+				{
+					return true;
+				}
+			}
+#else
+			for (int x = firstX; x <= lastX; ++x)
+			{
+				if (*this->getPixel(x, y) >= minZ)
+				{
+					return true;
+				}
+			}
+#endif
+		}
+
+		return false;
+	}
+
+	////////////////////////////////////////////////////////////
+	std::size_t OcclusionCuller::cull(const std::vector<BoundingBox>& boxes, std::vector<std::uint8_t>& visible) const
+	{
+		visible.resize(boxes.size());
+
+		ThreadPool::getInstance().parallelFor(boxes.size(), 256, [this, &boxes, &visible](std::size_t begin, std::size_t end) {
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				visible[i] = this->isVisible(boxes[i]);
+			}
+		});
+
+		return static_cast<std::size_t>(std::count(visible.begin(), visible.end(), 1));
+	}
+
+} // namespace jackal
@@ -0,0 +1,107 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/rendering/point_light.hpp> // PointLight class declaration.
+
+namespace jackal
+{
+	//====================
+	// Ctor and dtor
+	//====================
+	////////////////////////////////////////////////////////////
+	PointLight::PointLight()
+		: ILight("PointLight"), m_position(), m_range(10.0f)
+	{
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	////////////////////////////////////////////////////////////
+	Vector3f PointLight::getPosition() const
+	{
+		return m_position;
+	}
+
+	////////////////////////////////////////////////////////////
+	void PointLight::setPosition(const Vector3f& position)
+	{
+		m_position = position;
+	}
+
+	////////////////////////////////////////////////////////////
+	float PointLight::getRange() const
+	{
+		return m_range;
+	}
+
+	////////////////////////////////////////////////////////////
+	void PointLight::setRange(float range)
+	{
+		m_range = range;
+	}
+
+	//====================
+	// Private methods
+	//====================
+	////////////////////////////////////////////////////////////
+	bool PointLight::init(const Colour& colour, float intensity, const Vector3f& position, float range)
+	{
+		if (!ILight::init(colour, intensity) || range <= 0.0f)
+		{
+			return false;
+		}
+
+		m_position = position;
+		m_range = range;
+
+		return true;
+	}
+
+	//====================
+	// Methods
+	//====================
+	////////////////////////////////////////////////////////////
+	sol::table PointLight::lua_asObject() const // override
+	{
+		return sol::table();
+	}
+
+	////////////////////////////////////////////////////////////
+	PointLight* PointLight::create(const Colour& colour, float intensity, const Vector3f& position, float range)
+	{
+		PointLight* pLight = new PointLight();
+		if (pLight && pLight->init(colour, intensity, position, range))
+		{
+			return pLight;
+		}
+
+		delete pLight;
+		return nullptr;
+	}
+
+} // namespace jackal
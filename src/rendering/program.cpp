@@ -25,9 +25,11 @@
 //====================
 // Jackal includes
 //====================
-#include <jackal/rendering/program.hpp> // Program class declaration.
-#include <jackal/utils/log.hpp>         // Logging warnings and errors.
-#include <jackal/utils/constants.hpp>   // Constant log location.
+#include <jackal/rendering/program.hpp>           // Program class declaration.
+#include <jackal/utils/log.hpp>                   // Logging warnings and errors.
+#include <jackal/utils/constants.hpp>             // Constant log location.
+#include <jackal/rendering/render_statistics.hpp> // Counting the program binds.
+#include <jackal/rendering/program_cache.hpp>     // Loading and storing linked program binaries.
 
 namespace jackal
 {	
@@ -41,7 +43,7 @@ namespace jackal
 	//====================
 	////////////////////////////////////////////////////////////
 	Program::Program()
-		: m_ID(), m_shaders(), m_compiled(false)
+		: m_ID(), m_shaders(), m_defines(), m_key(0), m_compiled(false), m_pending(false), m_cached(false)
 	{
 	}
 
@@ -66,6 +68,41 @@ namespace jackal
 		return m_shaders;
 	}
 
+	////////////////////////////////////////////////////////////
+	void Program::setDefines(const std::string& defines)
+	{
+		m_defines = defines;
+	}
+
+	////////////////////////////////////////////////////////////
+	bool Program::isCompiled() const
+	{
+		return m_compiled;
+	}
+
+	////////////////////////////////////////////////////////////
+	bool Program::isPending() const
+	{
+		return m_pending;
+	}
+
+	////////////////////////////////////////////////////////////
+	bool Program::isParallelCompileSupported()
+	{
+		// Queried once on the thread that owns the context, the driver picks the number of compiler threads.
+		static const bool supported = []() {
+			if (GLEW_KHR_parallel_shader_compile)
+			{
+				glMaxShaderCompilerThreadsKHR(0xFFFFFFFFu);
+				return true;
+			}
+
+			return false;
+		}();
+
+		return supported;
+	}
+
 	//====================
 	// Methods
 	//====================
@@ -84,12 +121,15 @@ namespace jackal
 		}
 
 		m_compiled = false;
+		m_pending = false;
 	}
 
 	////////////////////////////////////////////////////////////
 	void Program::attachShader(const std::string& filename)
 	{
 		GLSLObject object;
+		object.setDefines(m_defines);
+
 		if (object.create(filename))
 		{
 			m_shaders.push_back(object);
@@ -104,6 +144,8 @@ namespace jackal
 	void Program::attachShader(const std::string& filename, eShaderType type)
 	{
 		GLSLObject object;
+		object.setDefines(m_defines);
+
 		// Check the object created and parsed successfully before adding it to the shader list.
 		if (object.create(filename, type))
 		{
@@ -118,50 +160,141 @@ namespace jackal
 	////////////////////////////////////////////////////////////
 	bool Program::compile()
 	{
-		if (!m_compiled)
+		// A submitted Program only has to wait for the driver.
+		if (m_pending)
+		{
+			return this->finish();
+		}
+
+		if (!this->submit())
+		{
+			return false;
+		}
+
+		return m_pending ? this->finish() : m_compiled;
+	}
+
+	////////////////////////////////////////////////////////////
+	bool Program::submit()
+	{
+		if (m_compiled || m_pending)
+		{
+			log.warning(log.function(__FUNCTION__), "Already compiled.");
+			return true;
+		}
+
+		ProgramCache& cache = ProgramCache::getInstance();
+		m_cached = cache.isEnabled();
+		m_key = 0;
+
+		// Compiled objects have released their sources, so they cannot be hashed.
+		for (const auto& shader : m_shaders)
+		{
+			m_cached = m_cached && !shader.isCompiled();
+		}
+
+		if (m_cached)
 		{
-			for (auto& shader : m_shaders)
+			// The sources are hashed before compilation releases them.
+			m_key = cache.hash(m_shaders);
+			if (cache.load(m_ID, m_key))
 			{
-				if (!shader.isCompiled())
-				{
-					shader.compile();
-				}
-				glAttachShader(m_ID, shader.getID());
+				log.debug(log.function(__FUNCTION__), "Loaded from the program cache.");
+				m_compiled = true;
+
+				return true;
 			}
 
-			// Link the shaders and check the link state.
-			glLinkProgram(m_ID);
+			glProgramParameteri(m_ID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+		}
 
-			GLint linked;
-			glGetProgramiv(m_ID, GL_LINK_STATUS, &linked);
+		Program::isParallelCompileSupported();
 
-			if (linked != GL_TRUE)
+		for (auto& shader : m_shaders)
+		{
+			if (!shader.isCompiled())
 			{
-				GLint logLength;
-				glGetProgramiv(m_ID, GL_INFO_LOG_LENGTH, &logLength);
+				shader.submit();
+			}
+			glAttachShader(m_ID, shader.getID());
+		}
+
+		// The link state is not queried until polled, so the driver can link in the background.
+		glLinkProgram(m_ID);
+		m_pending = true;
+
+		return true;
+	}
 
-				std::vector<char> errorLog(logLength);
-				glGetProgramInfoLog(m_ID, logLength, &logLength, &errorLog[0]);
+	////////////////////////////////////////////////////////////
+	bool Program::poll()
+	{
+		if (!m_pending)
+		{
+			return true;
+		}
 
-				log.error(log.function(__FUNCTION__), "Failed:", &errorLog[0]);
-				this->destroy();
+		if (Program::isParallelCompileSupported())
+		{
+			GLint complete = GL_FALSE;
+			glGetProgramiv(m_ID, GL_COMPLETION_STATUS_KHR, &complete);
 
-				m_shaders.clear();
+			if (complete != GL_TRUE)
+			{
 				return false;
 			}
+		}
+
+		this->finish();
+		return true;
+	}
 
-			for (auto& shader : m_shaders)
+	////////////////////////////////////////////////////////////
+	bool Program::finish()
+	{
+		m_pending = false;
+
+		// The objects are checked first so that their own errors are logged, not just the failed link.
+		bool compiled = true;
+		for (auto& shader : m_shaders)
+		{
+			if (!shader.isCompiled())
 			{
-				glDetachShader(m_ID, shader.getID());
+				compiled = shader.finish() && compiled;
 			}
+		}
 
-			log.debug(log.function(__FUNCTION__), "Linked successfully.");
-			m_compiled = true;
+		GLint linked;
+		glGetProgramiv(m_ID, GL_LINK_STATUS, &linked);
 
-			return true;
+		if (!compiled || linked != GL_TRUE)
+		{
+			GLint logLength;
+			glGetProgramiv(m_ID, GL_INFO_LOG_LENGTH, &logLength);
+
+			std::vector<char> errorLog(logLength + 1);
+			glGetProgramInfoLog(m_ID, logLength, &logLength, &errorLog[0]);
+
+			log.error(log.function(__FUNCTION__), "Failed:", &errorLog[0]);
+			this->destroy();
+
+			m_shaders.clear();
+			return false;
+		}
+
+		for (auto& shader : m_shaders)
+		{
+			glDetachShader(m_ID, shader.getID());
 		}
 
-		log.warning(log.function(__FUNCTION__), "Already compiled.");
+		if (m_cached)
+		{
+			ProgramCache::getInstance().save(m_ID, m_key);
+		}
+
+		log.debug(log.function(__FUNCTION__), "Linked successfully.");
+		m_compiled = true;
+
 		return true;
 	}
 
@@ -182,6 +315,7 @@ namespace jackal
 	////////////////////////////////////////////////////////////
 	void Program::bind(const Program& program)
 	{
+		RenderStatistics::getInstance().add(eRenderCounter::PROGRAM_BINDS);
 		glUseProgram(program.getID());
 	}
 
@@ -0,0 +1,327 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//====================
+// C++ includes
+//====================
+#include <filesystem> // Creating the cache directory and replacing entries.
+#include <fstream>    // Reading and writing the program binaries.
+#include <iomanip>    // Formatting the key of each entry.
+#include <sstream>    // Building the filename of each entry.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/rendering/program_cache.hpp> // ProgramCache class declaration.
+#include <jackal/core/config_file.hpp>        // Loading the settings of the cache.
+#include <jackal/utils/log.hpp>               // Logging rejected binaries and failed writes.
+
+namespace jackal
+{
+	//====================
+	// Local variables
+	//====================
+	static DebugLog log("logs/engine_log.txt");
+
+	static const std::uint64_t FNV_OFFSET = 14695981039346656037ull; // The initial value of a 64 bit FNV-1a hash.
+	static const std::uint64_t FNV_PRIME  = 1099511628211ull;        // The multiplier of a 64 bit FNV-1a hash.
+
+	////////////////////////////////////////////////////////////
+	/// @brief Appends bytes to a 64 bit FNV-1a hash.
+	///
+	/// @param hash   The hash of the preceding bytes.
+	/// @param pData  The bytes to append.
+	/// @param size   The number of bytes to append.
+	///
+	/// @returns      The hash including the bytes.
+	///
+	////////////////////////////////////////////////////////////
+	static std::uint64_t hashBytes(std::uint64_t hash, const void* pData, std::size_t size)
+	{
+		const unsigned char* pBytes = static_cast<const unsigned char*>(pData);
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			hash ^= pBytes[i];
+			hash *= FNV_PRIME;
+		}
+
+		return hash;
+	}
+
+	//====================
+	// Static variables
+	//====================
+	const std::uint32_t ProgramCache::MAGIC;
+	const std::uint32_t ProgramCache::VERSION;
+
+	//====================
+	// Ctor and dtor
+	//====================
+	////////////////////////////////////////////////////////////
+	ProgramCache::ProgramCache()
+		: Singleton<ProgramCache>(), m_directory("cache/programs"), m_driver(), m_enabled(true), m_queried(false), m_supported(false),
+		  m_hits(0), m_misses(0)
+	{
+	}
+
+	//====================
+	// Private methods
+	//====================
+	////////////////////////////////////////////////////////////
+	void ProgramCache::queryDriver()
+	{
+		m_queried = true;
+
+		GLint formats = 0;
+		if (GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary)
+		{
+			glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+		}
+
+		m_supported = formats > 0;
+
+		auto getString = [](GLenum name) {
+			const GLubyte* pString = glGetString(name);
+			return pString ? std::string(reinterpret_cast<const char*>(pString)) : std::string();
+		};
+
+		m_driver = getString(GL_VENDOR) + '\n' + getString(GL_RENDERER) + '\n' + getString(GL_VERSION);
+
+		if (!m_supported)
+		{
+			log.debug(log.function(__FUNCTION__), "Program binaries are not supported, shaders are always compiled from source.");
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	std::string ProgramCache::getFilename(std::uint64_t key) const
+	{
+		std::ostringstream stream;
+		stream << m_directory << "/" << std::hex << std::setw(16) << std::setfill('0') << key << ".bin";
+
+		return stream.str();
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	////////////////////////////////////////////////////////////
+	void ProgramCache::setEnabled(bool enabled)
+	{
+		m_enabled = enabled;
+	}
+
+	////////////////////////////////////////////////////////////
+	bool ProgramCache::isEnabled()
+	{
+		if (!m_enabled)
+		{
+			return false;
+		}
+
+		if (!m_queried)
+		{
+			this->queryDriver();
+		}
+
+		return m_supported;
+	}
+
+	////////////////////////////////////////////////////////////
+	void ProgramCache::setDirectory(const std::string& directory)
+	{
+		m_directory = directory;
+	}
+
+	////////////////////////////////////////////////////////////
+	const std::string& ProgramCache::getDirectory() const
+	{
+		return m_directory;
+	}
+
+	////////////////////////////////////////////////////////////
+	unsigned int ProgramCache::getHits() const
+	{
+		return m_hits;
+	}
+
+	////////////////////////////////////////////////////////////
+	unsigned int ProgramCache::getMisses() const
+	{
+		return m_misses;
+	}
+
+	//====================
+	// Methods
+	//====================
+	////////////////////////////////////////////////////////////
+	void ProgramCache::create(const ConfigFile& config)
+	{
+		m_enabled = config.get<bool>("ShaderCache.enabled");
+
+		std::string directory = config.get<std::string>("ShaderCache.directory");
+		if (!directory.empty())
+		{
+			m_directory = directory;
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	std::uint64_t ProgramCache::hash(const std::vector<GLSLObject>& shaders)
+	{
+		if (!m_queried)
+		{
+			this->queryDriver();
+		}
+
+		std::uint64_t hash = FNV_OFFSET;
+		for (const auto& shader : shaders)
+		{
+			GLenum type = shader.getType();
+			const std::string& source = shader.getSource();
+
+			// The length separates each source, so moving text between objects changes the hash.
+			std::uint64_t length = source.size();
+
+			hash = hashBytes(hash, &type, sizeof(type));
+			hash = hashBytes(hash, &length, sizeof(length));
+			hash = hashBytes(hash, source.data(), source.size());
+		}
+
+		return hashBytes(hash, m_driver.data(), m_driver.size());
+	}
+
+	////////////////////////////////////////////////////////////
+	bool ProgramCache::load(GLuint program, std::uint64_t key)
+	{
+		std::string filename = this->getFilename(key);
+
+		std::ifstream file(filename, std::ios::in | std::ios::binary);
+		if (!file.is_open())
+		{
+			m_misses++;
+			return false;
+		}
+
+		Header_t header;
+		std::vector<char> binary;
+
+		bool valid = file.read(reinterpret_cast<char*>(&header), sizeof(header)) && header.magic == MAGIC &&
+			header.version == VERSION && header.key == key && header.length > 0;
+
+		if (valid)
+		{
+			binary.resize(header.length);
+			valid = static_cast<bool>(file.read(binary.data(), binary.size()));
+		}
+
+		file.close();
+
+		GLint linked = GL_FALSE;
+		if (valid)
+		{
+			glProgramBinary(program, header.format, binary.data(), static_cast<GLsizei>(binary.size()));
+			glGetProgramiv(program, GL_LINK_STATUS, &linked);
+		}
+
+		if (linked != GL_TRUE)
+		{
+			// Drivers reject binaries after updates that keep the same version string, the entry is rebuilt.
+			log.debug(log.function(__FUNCTION__, filename), "Program binary was rejected, compiling from source.");
+
+			std::error_code error;
+			std::filesystem::remove(filename, error);
+
+			m_misses++;
+			return false;
+		}
+
+		m_hits++;
+		return true;
+	}
+
+	////////////////////////////////////////////////////////////
+	bool ProgramCache::save(GLuint program, std::uint64_t key)
+	{
+		GLint length = 0;
+		glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+
+		if (length <= 0)
+		{
+			return false;
+		}
+
+		Header_t header;
+		header.magic = MAGIC;
+		header.version = VERSION;
+		header.key = key;
+
+		std::vector<char> binary(length);
+		GLenum format = 0;
+		glGetProgramBinary(program, length, &length, &format, binary.data());
+
+		header.format = format;
+		header.length = static_cast<std::uint32_t>(length);
+
+		std::error_code error;
+		std::filesystem::create_directories(m_directory, error);
+
+		std::string filename = this->getFilename(key);
+		std::string temporary = filename + ".tmp";
+
+		{
+			std::ofstream file(temporary, std::ios::out | std::ios::binary | std::ios::trunc);
+			if (!file.is_open() || !file.write(reinterpret_cast<const char*>(&header), sizeof(header)) || !file.write(binary.data(), length))
+			{
+				log.warning(log.function(__FUNCTION__, filename), "Failed to write the program binary.");
+				return false;
+			}
+		}
+
+		std::filesystem::rename(temporary, filename, error);
+		if (error)
+		{
+			log.warning(log.function(__FUNCTION__, filename), "Failed to replace the program binary:", error.message());
+			std::filesystem::remove(temporary, error);
+
+			return false;
+		}
+
+		return true;
+	}
+
+	////////////////////////////////////////////////////////////
+	void ProgramCache::clear()
+	{
+		std::error_code error;
+		for (const auto& entry : std::filesystem::directory_iterator(m_directory, error))
+		{
+			if (entry.path().extension() == ".bin")
+			{
+				std::filesystem::remove(entry.path(), error);
+			}
+		}
+	}
+
+} // namespace jackal
@@ -0,0 +1,148 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//====================
+// C++ includes
+//====================
+#include <algorithm>                                  // Sizing blocks for large commands.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/rendering/render_command_buffer.hpp> // RenderCommandBuffer class declaration.
+
+namespace jackal
+{
+	//====================
+	// Static variables
+	//====================
+	const std::size_t RenderCommandBuffer::BLOCK_SIZE;
+
+	//====================
+	// Ctor and dtor
+	//====================
+	////////////////////////////////////////////////////////////
+	RenderCommandBuffer::RenderCommandBuffer()
+		: NonCopyable(), m_blocks(), m_current(0), m_count(0)
+	{
+	}
+
+	////////////////////////////////////////////////////////////
+	RenderCommandBuffer::~RenderCommandBuffer()
+	{
+		this->clear();
+	}
+
+	//====================
+	// Private methods
+	//====================
+	////////////////////////////////////////////////////////////
+	void* RenderCommandBuffer::allocate(std::size_t size)
+	{
+		while (m_current < m_blocks.size())
+		{
+			Block_t& block = m_blocks[m_current];
+			if (block.used + size <= block.capacity)
+			{
+				void* pMemory = block.pMemory.get() + block.used;
+				block.used += size;
+
+				return pMemory;
+			}
+
+			m_current++;
+		}
+
+		Block_t block;
+		block.capacity = std::max(size, BLOCK_SIZE);
+		block.pMemory.reset(new unsigned char[block.capacity]);
+		block.used = size;
+
+		m_blocks.push_back(std::move(block));
+		m_current = m_blocks.size() - 1;
+
+		return m_blocks.back().pMemory.get();
+	}
+
+	////////////////////////////////////////////////////////////
+	void RenderCommandBuffer::consume(bool execute)
+	{
+		const std::size_t alignment = alignof(std::max_align_t);
+		const std::size_t headerSize = ((sizeof(Header_t) + alignment - 1) / alignment) * alignment;
+
+		for (auto& block : m_blocks)
+		{
+			std::size_t offset = 0;
+			while (offset < block.used)
+			{
+				Header_t* pHeader = reinterpret_cast<Header_t*>(block.pMemory.get() + offset);
+				void* pCommand = block.pMemory.get() + offset + headerSize;
+
+				if (execute)
+				{
+					pHeader->pExecute(pCommand);
+				}
+
+				pHeader->pDestroy(pCommand);
+				offset += pHeader->size;
+			}
+
+			block.used = 0;
+		}
+
+		m_current = 0;
+		m_count = 0;
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	////////////////////////////////////////////////////////////
+	std::size_t RenderCommandBuffer::getCount() const
+	{
+		return m_count;
+	}
+
+	////////////////////////////////////////////////////////////
+	bool RenderCommandBuffer::isEmpty() const
+	{
+		return m_count == 0;
+	}
+
+	//====================
+	// Methods
+	//====================
+	////////////////////////////////////////////////////////////
+	void RenderCommandBuffer::execute()
+	{
+		this->consume(true);
+	}
+
+	////////////////////////////////////////////////////////////
+	void RenderCommandBuffer::clear()
+	{
+		this->consume(false);
+	}
+
+} // namespace jackal
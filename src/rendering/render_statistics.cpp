@@ -0,0 +1,206 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/rendering/render_statistics.hpp> // RenderStatistics class declaration.
+#include <jackal/rendering/render_thread.hpp>     // Completing the frame once it has executed.
+#include <jackal/core/config_file.hpp>            // Loading the budgets from the config file.
+#include <jackal/utils/log.hpp>                   // Logging frames that exceed a budget.
+
+namespace jackal
+{
+	//====================
+	// Local variables
+	//====================
+	static DebugLog log("logs/engine_log.txt");
+
+	//====================
+	// Static variables
+	//====================
+	const int RenderStatistics::COUNTERS;
+
+	//====================
+	// Ctor and dtor
+	//====================
+	////////////////////////////////////////////////////////////
+	RenderStatistics::RenderStatistics()
+		: Singleton<RenderStatistics>(), m_recorded(), m_executed(), m_previous(), m_budgets(), m_exceeded(0)
+	{
+		for (int i = 0; i < COUNTERS; ++i)
+		{
+			m_recorded[i].store(0);
+			m_executed[i].store(0);
+			m_previous[i].store(0);
+		}
+
+		m_budgets.fill(0);
+	}
+
+	//====================
+	// Private methods
+	//====================
+	////////////////////////////////////////////////////////////
+	void RenderStatistics::completeFrame(const std::array<std::uint64_t, COUNTERS>& recorded)
+	{
+		bool exceeded = false;
+		for (int i = 0; i < COUNTERS; ++i)
+		{
+			std::uint64_t total = recorded[i] + m_executed[i].exchange(0, std::memory_order_relaxed);
+			m_previous[i].store(total, std::memory_order_relaxed);
+
+			if (m_budgets[i] != 0 && total > m_budgets[i])
+			{
+				exceeded = true;
+			}
+		}
+
+		if (exceeded)
+		{
+			// Only the first frame is logged, the count is enough to fail a performance run.
+			if (m_exceeded == 0)
+			{
+				log.warning(log.function(__FUNCTION__), "Frame exceeded its render budget. Draw calls:", this->getDrawCalls(),
+					"triangles:", this->getTriangles(), "buffer bytes:", this->getBufferBytes());
+			}
+
+			m_exceeded++;
+		}
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	////////////////////////////////////////////////////////////
+	std::uint64_t RenderStatistics::get(eRenderCounter counter) const
+	{
+		return m_previous[static_cast<int>(counter)].load(std::memory_order_relaxed);
+	}
+
+	////////////////////////////////////////////////////////////
+	void RenderStatistics::setBudget(eRenderCounter counter, std::uint64_t budget)
+	{
+		m_budgets[static_cast<int>(counter)] = budget;
+	}
+
+	////////////////////////////////////////////////////////////
+	std::uint64_t RenderStatistics::getBudget(eRenderCounter counter) const
+	{
+		return m_budgets[static_cast<int>(counter)];
+	}
+
+	////////////////////////////////////////////////////////////
+	unsigned int RenderStatistics::getExceededFrames() const
+	{
+		return m_exceeded;
+	}
+
+	////////////////////////////////////////////////////////////
+	std::uint64_t RenderStatistics::getDrawCalls() const
+	{
+		return this->get(eRenderCounter::DRAW_CALLS);
+	}
+
+	////////////////////////////////////////////////////////////
+	std::uint64_t RenderStatistics::getTriangles() const
+	{
+		return this->get(eRenderCounter::TRIANGLES);
+	}
+
+	////////////////////////////////////////////////////////////
+	std::uint64_t RenderStatistics::getProgramBinds() const
+	{
+		return this->get(eRenderCounter::PROGRAM_BINDS);
+	}
+
+	////////////////////////////////////////////////////////////
+	std::uint64_t RenderStatistics::getTextureBinds() const
+	{
+		return this->get(eRenderCounter::TEXTURE_BINDS);
+	}
+
+	////////////////////////////////////////////////////////////
+	std::uint64_t RenderStatistics::getBufferBytes() const
+	{
+		return this->get(eRenderCounter::BUFFER_BYTES);
+	}
+
+	////////////////////////////////////////////////////////////
+	std::uint64_t RenderStatistics::getUniformCalls() const
+	{
+		return this->get(eRenderCounter::UNIFORM_CALLS);
+	}
+
+	//====================
+	// Methods
+	//====================
+	////////////////////////////////////////////////////////////
+	void RenderStatistics::add(eRenderCounter counter, std::uint64_t amount /*= 1*/)
+	{
+		auto& counters = RenderThread::getInstance().isRenderThread() ? m_executed : m_recorded;
+		counters[static_cast<int>(counter)].fetch_add(amount, std::memory_order_relaxed);
+	}
+
+	////////////////////////////////////////////////////////////
+	bool RenderStatistics::exceedsBudget() const
+	{
+		for (int i = 0; i < COUNTERS; ++i)
+		{
+			if (m_budgets[i] != 0 && this->get(static_cast<eRenderCounter>(i)) > m_budgets[i])
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	////////////////////////////////////////////////////////////
+	void RenderStatistics::loadBudgets(const ConfigFile& config)
+	{
+		this->setBudget(eRenderCounter::DRAW_CALLS, config.get<unsigned int>("RenderBudget.draw_calls"));
+		this->setBudget(eRenderCounter::TRIANGLES, config.get<unsigned int>("RenderBudget.triangles"));
+		this->setBudget(eRenderCounter::PROGRAM_BINDS, config.get<unsigned int>("RenderBudget.program_binds"));
+		this->setBudget(eRenderCounter::TEXTURE_BINDS, config.get<unsigned int>("RenderBudget.texture_binds"));
+		this->setBudget(eRenderCounter::BUFFER_BYTES, config.get<unsigned int>("RenderBudget.buffer_bytes"));
+		this->setBudget(eRenderCounter::UNIFORM_CALLS, config.get<unsigned int>("RenderBudget.uniform_calls"));
+	}
+
+	////////////////////////////////////////////////////////////
+	void RenderStatistics::endFrame()
+	{
+		std::array<std::uint64_t, COUNTERS> recorded;
+		for (int i = 0; i < COUNTERS; ++i)
+		{
+			recorded[i] = m_recorded[i].exchange(0, std::memory_order_relaxed);
+		}
+
+		// Recorded after the frame was submitted, so it runs once every command of the frame has executed.
+		RenderThread::getInstance().enqueue([this, recorded]() {
+			this->completeFrame(recorded);
+		});
+	}
+
+} // namespace jackal
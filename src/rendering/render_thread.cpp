@@ -0,0 +1,224 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/rendering/render_thread.hpp> // RenderThread class declaration.
+#include <jackal/core/window.hpp>             // Moving the context of the window between threads.
+#include <jackal/utils/log.hpp>               // Logging warnings and errors.
+
+namespace jackal
+{
+	//====================
+	// Local variables
+	//====================
+	static DebugLog log("logs/engine_log.txt");
+
+	//====================
+	// Ctor and dtor
+	//====================
+	////////////////////////////////////////////////////////////
+	RenderThread::RenderThread()
+		: Singleton<RenderThread>(), m_buffers(), m_recording(0), m_pending(false), m_executing(false), m_running(false), m_stopping(false),
+		  m_tasks(), m_pWindow(nullptr), m_thread(), m_threadID(), m_mutex(), m_condition()
+	{
+	}
+
+	////////////////////////////////////////////////////////////
+	RenderThread::~RenderThread()
+	{
+		this->stop();
+	}
+
+	//====================
+	// Private methods
+	//====================
+	////////////////////////////////////////////////////////////
+	void RenderThread::run()
+	{
+		{
+			// Wait for start to finish publishing the thread identifier.
+			std::lock_guard<std::mutex> guard(m_mutex);
+		}
+
+		m_pWindow->setActive(true);
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		while (true)
+		{
+			m_condition.wait(lock, [this]() {
+				return m_pending || !m_tasks.empty() || m_stopping;
+			});
+
+			// Frames are executed before tasks, as tasks were invoked after the frame was submitted.
+			if (m_pending)
+			{
+				RenderCommandBuffer& buffer = m_buffers[1 - m_recording];
+
+				lock.unlock();
+				buffer.execute();
+				lock.lock();
+
+				m_pending = false;
+				m_condition.notify_all();
+			}
+			else if (!m_tasks.empty())
+			{
+				std::vector<std::packaged_task<void()>> tasks = std::move(m_tasks);
+				m_tasks.clear();
+				m_executing = true;
+
+				lock.unlock();
+				for (auto& task : tasks)
+				{
+					task();
+				}
+				lock.lock();
+
+				// The queue is already empty, flush must also wait for the tasks that were taken from it.
+				m_executing = false;
+				m_condition.notify_all();
+			}
+			else if (m_stopping)
+			{
+				break;
+			}
+		}
+
+		lock.unlock();
+		m_pWindow->setActive(false);
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	////////////////////////////////////////////////////////////
+	bool RenderThread::isRunning() const
+	{
+		return m_running;
+	}
+
+	////////////////////////////////////////////////////////////
+	bool RenderThread::isRenderThread() const
+	{
+		return m_running && std::this_thread::get_id() == m_threadID;
+	}
+
+	//====================
+	// Methods
+	//====================
+	////////////////////////////////////////////////////////////
+	bool RenderThread::start(Window& window)
+	{
+		if (m_running)
+		{
+			log.warning(log.function(__FUNCTION__), "Render thread is already running.");
+			return false;
+		}
+
+		if (!window.setActive(false))
+		{
+			log.error(log.function(__FUNCTION__), "Failed to release the OpenGL context.");
+			return false;
+		}
+
+		std::lock_guard<std::mutex> guard(m_mutex);
+
+		m_pWindow = &window;
+		m_recording = 0;
+		m_pending = false;
+		m_executing = false;
+		m_stopping = false;
+
+		m_thread = std::thread(&RenderThread::run, this);
+		m_threadID = m_thread.get_id();
+		m_running = true;
+
+		log.debug(log.function(__FUNCTION__), "Render thread started.");
+		return true;
+	}
+
+	////////////////////////////////////////////////////////////
+	void RenderThread::stop()
+	{
+		if (!m_running)
+		{
+			return;
+		}
+
+		// Execute whatever has been recorded since the last frame.
+		this->submit();
+		this->flush();
+
+		{
+			std::lock_guard<std::mutex> guard(m_mutex);
+			m_stopping = true;
+		}
+
+		m_condition.notify_all();
+		m_thread.join();
+
+		m_running = false;
+		m_pWindow->setActive(true);
+
+		log.debug(log.function(__FUNCTION__), "Render thread stopped.");
+	}
+
+	////////////////////////////////////////////////////////////
+	void RenderThread::submit()
+	{
+		if (!m_running)
+		{
+			return;
+		}
+
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_condition.wait(lock, [this]() {
+				return !m_pending;
+			});
+
+			m_recording = 1 - m_recording;
+			m_pending = true;
+		}
+
+		m_condition.notify_all();
+	}
+
+	////////////////////////////////////////////////////////////
+	void RenderThread::flush()
+	{
+		if (!m_running)
+		{
+			return;
+		}
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_condition.wait(lock, [this]() {
+			return !m_pending && m_tasks.empty() && !m_executing;
+		});
+	}
+
+} // namespace jackal
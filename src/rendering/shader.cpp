@@ -22,24 +22,32 @@
 //
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+//====================
+// C++ includes
+//====================
+#include <algorithm> // Finding the bit of each keyword.
+#include <sstream>   // Building the name of each variant.
+
 //====================
 // Jackal includes
 //====================
-#include <jackal/rendering/shader.hpp>            // Shader class declaration.
-#include <jackal/utils/log.hpp>                   // Logging warnings and errors.
-#include <jackal/utils/constants.hpp>             // Using the constant log location.
-#include <jackal/utils/json_file_reader.hpp>      // Loading and parsing the json file.
-#include <jackal/utils/ext/json.hpp>              // De-serializing a shader file.
-#include <jackal/rendering/material.hpp>          // The material to render the shader with.
-#include <jackal/core/camera.hpp>                 // Rendering from the position of the Camera.
-#include <jackal/utils/resource_manager.hpp>      // Used for retrieving a shader from the resource manager.
-#include <jackal/math/transform.hpp>              // Used to retrieve the position, rotation and scale of an object.
-#include <jackal/rendering/directional_light.hpp> // Test DirectionalLight behavior.
+#include <jackal/rendering/shader.hpp>             // Shader class declaration.
+#include <jackal/utils/log.hpp>                    // Logging warnings and errors.
+#include <jackal/utils/constants.hpp>              // Using the constant log location.
+#include <jackal/utils/json_file_reader.hpp>       // Loading and parsing the json file.
+#include <jackal/utils/ext/json.hpp>               // De-serializing a shader file.
+#include <jackal/rendering/material.hpp>           // The material to render the shader with.
+#include <jackal/core/camera.hpp>                  // Rendering from the position of the Camera.
+#include <jackal/utils/resource_manager.hpp>       // Used for retrieving a shader from the resource manager.
+#include <jackal/math/transform.hpp>               // Used to retrieve the position, rotation and scale of an object.
+#include <jackal/rendering/directional_light.hpp>  // The directional light shading every pixel.
+#include <jackal/rendering/clustered_lighting.hpp> // Sampling the lights assigned to each cluster.
+#include <jackal/rendering/render_thread.hpp>      // Executing the shader commands on the render thread.
 
 //====================
 // Additional includes
 //====================
-#include <SDL2/SDL.h>                             // Used to retrieve the ticks of the application.
+#include <SDL2/SDL.h> // Used to retrieve the ticks of the application.
 
 namespace jackal
 {	
@@ -48,12 +56,20 @@ namespace jackal
 	//====================
 	static DebugLog log("logs/engine_log.txt"); // Logging warnings and errors.
 
+	static const char VARIANT_SEPARATOR = '#'; // Separates the shader file from the keyword mask of a variant.
+
+	//====================
+	// Static variables
+	//====================
+	const unsigned int Shader::MAX_KEYWORDS;
+
 	//====================
 	// Ctor and dtor
 	//====================
 	////////////////////////////////////////////////////////////
 	Shader::Shader()
-		: Resource(), m_program(), m_uniform(m_program)
+		: Resource(), m_program(), m_uniform(m_program), m_constants(), m_keywords(), m_variants(), m_mask(0), m_ready(false),
+		  m_precompile(), m_prepared(false)
 	{
 		m_program.create();
 	}
@@ -73,37 +89,140 @@ namespace jackal
 		return m_program.getShaders();
 	}
 
+	////////////////////////////////////////////////////////////
+	const std::string& Shader::getFilename() const
+	{
+		return m_filename;
+	}
+
+	////////////////////////////////////////////////////////////
+	std::uint32_t Shader::getMask() const
+	{
+		return m_mask;
+	}
+
+	////////////////////////////////////////////////////////////
+	std::uint32_t Shader::getKeywordMask(const std::vector<std::string>& keywords) const
+	{
+		std::uint32_t mask = 0;
+		for (const auto& keyword : keywords)
+		{
+			auto itr = std::find(m_keywords.begin(), m_keywords.end(), keyword);
+			if (itr != m_keywords.end())
+			{
+				mask |= 1u << static_cast<unsigned int>(itr - m_keywords.begin());
+			}
+		}
+
+		return mask;
+	}
+
+	////////////////////////////////////////////////////////////
+	ResourceHandle<Shader> Shader::getVariant(std::uint32_t mask)
+	{
+		if (mask == m_mask)
+		{
+			return ResourceHandle<Shader>(this);
+		}
+
+		auto itr = m_variants.find(mask);
+		if (itr != m_variants.end())
+		{
+			return itr->second;
+		}
+
+		std::ostringstream name;
+		name << m_filename << VARIANT_SEPARATOR << std::hex << mask;
+
+		ResourceHandle<Shader> variant = ResourceManager::getInstance().get<Shader>(name.str());
+		m_variants.insert(std::make_pair(mask, variant));
+
+		return variant;
+	}
+
+	////////////////////////////////////////////////////////////
+	bool Shader::isReady() const
+	{
+		return m_ready;
+	}
+
+	//====================
+	// Private methods
+	//====================
+	////////////////////////////////////////////////////////////
+	void Shader::applyConstants()
+	{
+		// Invoked on the render thread, so the program is bound directly rather than enqueued.
+		if (!m_constants.empty())
+		{
+			Program::bind(m_program);
+
+			for (const auto& uniform : m_constants)
+			{
+				m_uniform.setParameter(uniform);
+			}
+
+			Program::unbind();
+		}
+
+		m_ready = true;
+	}
+
 	//====================
 	// Methods
 	//====================
 	////////////////////////////////////////////////////////////
-	bool Shader::load(const std::string& filename) // override
+	bool Shader::prepare(const std::string& filename) // override
 	{
+		// Variants are loaded from the same json file, the keyword mask follows the separator.
+		std::size_t separator = filename.find(VARIANT_SEPARATOR);
+		m_filename = filename.substr(0, separator);
+
+		if (separator != std::string::npos)
+		{
+			m_mask = static_cast<std::uint32_t>(std::stoul(filename.substr(separator + 1), nullptr, 16));
+		}
+
 		JSONFileReader reader;
-		if (reader.read(filename))
+		if (reader.read(m_filename))
 		{
 			nlohmann::json root = reader.getRoot();
 			nlohmann::json files = root["glsl-files"];
-			
-			for (const auto& file : files)
+
+			for (const auto& keyword : root["keywords"])
 			{
-				this->attachShader(file.get<std::string>());
-			}
+				if (m_keywords.size() == MAX_KEYWORDS)
+				{
+					log.warning(log.function(__FUNCTION__, filename), "Too many keywords, the remaining keywords are ignored.");
+					break;
+				}
 
-			this->compile();
+				m_keywords.push_back(keyword.get<std::string>());
+			}
 
-			nlohmann::json uniforms = root["constant-uniforms"];
-			if (!uniforms.empty())
+			// Each enabled keyword is defined, so the unused features are compiled out of the variant.
+			std::string defines;
+			for (std::size_t i = 0; i < m_keywords.size(); ++i)
 			{
-				Shader::bind(*this);
-
-				for (const auto& uniform : uniforms)
+				if (m_mask & (1u << i))
 				{
-					m_uniform.setParameter(uniform);
+					defines.append("#define " + m_keywords[i] + '\n');
 				}
+			}
 
-				Shader::unbind();
+			m_program.setDefines(defines);
+			
+			for (const auto& file : files)
+			{
+				this->attachShader(file.get<std::string>());
 			}
+
+			// The constant uniforms can only be set once the program has linked.
+			m_constants = root["constant-uniforms"];
+
+			// Variants are retrieved from the resource manager, so they are requested by load.
+			m_precompile = separator == std::string::npos ? root["precompile"] : nlohmann::json();
+			m_prepared = true;
 		}
 		else
 		{
@@ -114,6 +233,39 @@ namespace jackal
 		return true;
 	}
 
+	////////////////////////////////////////////////////////////
+	bool Shader::load(const std::string& filename) // override
+	{
+		if (!m_prepared && !this->prepare(filename))
+		{
+			return false;
+		}
+
+		m_prepared = false;
+
+		// The link status is collected by poll, so loading many shaders doesn't stall on each one.
+		if (!m_program.submit())
+		{
+			log.error(log.function(__FUNCTION__, filename), "Failed to submit.");
+			return false;
+		}
+
+		// Programs loaded from the cache are linked immediately.
+		if (m_program.isCompiled())
+		{
+			this->applyConstants();
+		}
+
+		// The variants listed for precompilation are submitted alongside the shader itself.
+		for (const auto& keywords : m_precompile)
+		{
+			this->getVariant(this->getKeywordMask(keywords.get<std::vector<std::string>>()));
+		}
+
+		m_precompile = nlohmann::json();
+		return true;
+	}
+
 	////////////////////////////////////////////////////////////
 	ResourceHandle<Shader> Shader::find(const std::string& name)
 	{
@@ -138,8 +290,11 @@ namespace jackal
 		if (!m_program.compile())
 		{
 			log.error(log.function(__FUNCTION__), "Failed to compile.");
+			return false;
 		}
 
+		this->applyConstants();
+
 		log.debug(log.function(__FUNCTION__), "Successfully compiled.");
 		return true;
 	}
@@ -147,48 +302,128 @@ namespace jackal
 	////////////////////////////////////////////////////////////
 	bool Shader::recompile()
 	{
-		return m_program.recompile();
+		m_ready = false;
+		if (!m_program.recompile())
+		{
+			return false;
+		}
+
+		this->applyConstants();
+		return true;
 	}
 
 	////////////////////////////////////////////////////////////
-	void Shader::process(const Transform& transform, const Material& material)
+	void Shader::poll()
 	{
-		if (material.isLightingEnabled())
+		if (m_ready)
 		{
-			m_uniform.setParameter(Uniforms::MODEL, transform.getTransformation());
+			return;
+		}
 
-			DirectionalLight light;
-			light.setColour(Colour::white());
-			light.setSpecularity(Colour(1.0f, 0.0f, 0.0f, 1.0f));
-			light.setIntensity(1.5f);
-			light.setDirection(Vector3f::forward());
+		RenderThread::getInstance().enqueue([this]() {
+			// Several materials may poll the same shader within a frame, only the first finishes it.
+			if (m_program.isPending() && m_program.poll() && m_program.isCompiled())
+			{
+				this->applyConstants();
+			}
+		});
+	}
 
-			m_uniform.setParameter(Uniforms::DIRECTIONAL_LIGHT_COLOUR, light.getColour());
-			m_uniform.setParameter(Uniforms::DIRECTIONAL_LIGHT_SPECULARITY, light.getSpecularity());
-			m_uniform.setParameter(Uniforms::DIRECTIONAL_LIGHT_INTENSITY, light.getIntensity());
-			m_uniform.setParameter(Uniforms::DIRECTIONAL_LIGHT_DIRECTION, light.getDirection());
+	////////////////////////////////////////////////////////////
+	bool Shader::wait()
+	{
+		if (!m_ready)
+		{
+			RenderThread::getInstance().invoke([this]() {
+				if (m_program.isPending() && m_program.compile())
+				{
+					this->applyConstants();
+				}
+			});
 		}
 
-		m_uniform.setParameter(Uniforms::MATERIAL_DIFFUSE_TEXTURE, eTextureType::DIFFUSE);
-		m_uniform.setParameter(Uniforms::MATERIAL_SPECULAR_TEXTURE, eTextureType::SPECULAR);
-		m_uniform.setParameter(Uniforms::MATERIAL_DIFFUSE_COLOUR, material.getColour());
-		m_uniform.setParameter(Uniforms::MATERIAL_SHININESS, material.getShininess());
+		return m_ready;
+	}
+
+	////////////////////////////////////////////////////////////
+	void Shader::process(const Transform& transform, const Material& material)
+	{
+		// Every value is resolved on the calling thread, the commands only capture copies.
+		Camera& camera = Camera::getMain();
+
+		bool lighting = material.isLightingEnabled();
+		Matrix4 model = transform.getTransformation();
+		Matrix4 mvp = model * camera.getViewProjection();
+		Colour colour = material.getColour();
+		float shininess = material.getShininess();
+		float diffuseLayer = material.getLayer(eTextureType::DIFFUSE);
+		float specularLayer = material.getLayer(eTextureType::SPECULAR);
+		Vector3f viewPosition = camera.getTransform().getPosition();
 
-		Matrix4 mvp = transform.getTransformation() * Camera::getMain().getViewProjection();
+		const ClusteredLighting& clusters = ClusteredLighting::getInstance();
+		Matrix4 view = clusters.getView();
+		Vector2f screenSize = clusters.getScreenSize();
+		float clusterNear = clusters.getNear();
+		float sliceScale = clusters.getSliceScale();
+
+		// Without a directional light, only the clustered lights shade the object.
+		Colour lightColour = Colour::white();
+		Colour lightSpecularity = Colour::white();
+		float lightIntensity = 0.0f;
+		Vector3f lightDirection = Vector3f::forward();
+
+		if (const DirectionalLight* pLight = clusters.getDirectionalLight())
+		{
+			lightColour = pLight->getColour();
+			lightSpecularity = pLight->getSpecularity();
+			lightIntensity = pLight->getIntensity();
+			lightDirection = pLight->getDirection();
+		}
+
+		RenderThread::getInstance().enqueue([this, lighting, model, mvp, colour, shininess, diffuseLayer, specularLayer, lightColour, lightSpecularity,
+			lightIntensity, lightDirection, viewPosition, view, screenSize, clusterNear, sliceScale]() {
+			if (lighting)
+			{
+				m_uniform.setParameter(Uniforms::MODEL, model);
+				m_uniform.setParameter(Uniforms::VIEW, view);
+				m_uniform.setParameter(Uniforms::VIEW_POSITION, viewPosition);
+				m_uniform.setParameter(Uniforms::DIRECTIONAL_LIGHT_COLOUR, lightColour);
+				m_uniform.setParameter(Uniforms::DIRECTIONAL_LIGHT_SPECULARITY, lightSpecularity);
+				m_uniform.setParameter(Uniforms::DIRECTIONAL_LIGHT_INTENSITY, lightIntensity);
+				m_uniform.setParameter(Uniforms::DIRECTIONAL_LIGHT_DIRECTION, lightDirection);
+				m_uniform.setParameter(Uniforms::CLUSTER_LIGHTS, ClusteredLighting::TEXTURE_UNIT);
+				m_uniform.setParameter(Uniforms::CLUSTER_GRID, ClusteredLighting::TEXTURE_UNIT + 1);
+				m_uniform.setParameter(Uniforms::CLUSTER_INDICES, ClusteredLighting::TEXTURE_UNIT + 2);
+				m_uniform.setParameter(Uniforms::CLUSTER_SCREEN_SIZE, screenSize);
+				m_uniform.setParameter(Uniforms::CLUSTER_NEAR, clusterNear);
+				m_uniform.setParameter(Uniforms::CLUSTER_SLICE_SCALE, sliceScale);
+			}
 
-		m_uniform.setParameter(Uniforms::MODEL_VIEW_PERSPECTIVE, mvp);
+			m_uniform.setParameter(Uniforms::MATERIAL_DIFFUSE_TEXTURE, eTextureType::DIFFUSE);
+			m_uniform.setParameter(Uniforms::MATERIAL_SPECULAR_TEXTURE, eTextureType::SPECULAR);
+			m_uniform.setParameter(Uniforms::MATERIAL_DIFFUSE_COLOUR, colour);
+			m_uniform.setParameter(Uniforms::MATERIAL_SHININESS, shininess);
+			m_uniform.setParameter(Uniforms::MATERIAL_DIFFUSE_LAYER, diffuseLayer);
+			m_uniform.setParameter(Uniforms::MATERIAL_SPECULAR_LAYER, specularLayer);
+			m_uniform.setParameter(Uniforms::MODEL_VIEW_PERSPECTIVE, mvp);
+		});
 	}
 
 	////////////////////////////////////////////////////////////
 	void Shader::bind(const Shader& shader)	
 	{
-		Program::bind(shader.m_program);
+		const Program* pProgram = &shader.m_program;
+		RenderThread::getInstance().enqueue([pProgram]() {
+			Program::bind(*pProgram);
+		});
 	}
 
 	////////////////////////////////////////////////////////////
 	void Shader::unbind()
 	{
-		Program::unbind();
+		RenderThread::getInstance().enqueue([]() {
+			Program::unbind();
+		});
 	}
 
 } // namespace jackal 
\ No newline at end of file
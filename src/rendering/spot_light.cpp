@@ -0,0 +1,170 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//====================
+// C++ includes
+//====================
+#include <algorithm> // Clamping the angles of the cone.
+#include <cmath>     // Calculating the bounds of the cone.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/rendering/spot_light.hpp> // SpotLight class declaration.
+
+namespace jackal
+{
+	//====================
+	// Local variables
+	//====================
+	static const float DEGREES_TO_RADIANS = 3.14159265f / 180.0f; // Converting the angles of the cone.
+
+	//====================
+	// Ctor and dtor
+	//====================
+	////////////////////////////////////////////////////////////
+	SpotLight::SpotLight()
+		: ILight("SpotLight"), m_position(), m_direction(Vector3f::forward()), m_range(10.0f), m_innerAngle(20.0f), m_outerAngle(30.0f)
+	{
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	////////////////////////////////////////////////////////////
+	Vector3f SpotLight::getPosition() const
+	{
+		return m_position;
+	}
+
+	////////////////////////////////////////////////////////////
+	void SpotLight::setPosition(const Vector3f& position)
+	{
+		m_position = position;
+	}
+
+	////////////////////////////////////////////////////////////
+	Vector3f SpotLight::getDirection() const
+	{
+		return m_direction;
+	}
+
+	////////////////////////////////////////////////////////////
+	void SpotLight::setDirection(const Vector3f& direction)
+	{
+		m_direction = direction.normalised();
+	}
+
+	////////////////////////////////////////////////////////////
+	float SpotLight::getRange() const
+	{
+		return m_range;
+	}
+
+	////////////////////////////////////////////////////////////
+	void SpotLight::setRange(float range)
+	{
+		m_range = range;
+	}
+
+	////////////////////////////////////////////////////////////
+	float SpotLight::getInnerAngle() const
+	{
+		return m_innerAngle;
+	}
+
+	////////////////////////////////////////////////////////////
+	float SpotLight::getOuterAngle() const
+	{
+		return m_outerAngle;
+	}
+
+	////////////////////////////////////////////////////////////
+	void SpotLight::setAngles(float innerAngle, float outerAngle)
+	{
+		m_outerAngle = std::max(0.0f, std::min(outerAngle, 89.0f));
+		m_innerAngle = std::max(0.0f, std::min(innerAngle, m_outerAngle));
+	}
+
+	////////////////////////////////////////////////////////////
+	BoundingSphere SpotLight::getBoundingSphere() const
+	{
+		float angle = m_outerAngle * DEGREES_TO_RADIANS;
+		float cosine = std::cos(angle);
+
+		// Wider than 45 degrees, the base of the cone is further from its centre than the apex.
+		if (angle > 45.0f * DEGREES_TO_RADIANS)
+		{
+			return BoundingSphere(m_position + m_direction * (m_range * cosine), m_range * std::sin(angle));
+		}
+
+		float radius = m_range / (2.0f * cosine);
+		return BoundingSphere(m_position + m_direction * radius, radius);
+	}
+
+	//====================
+	// Private methods
+	//====================
+	////////////////////////////////////////////////////////////
+	bool SpotLight::init(const Colour& colour, float intensity, const Vector3f& position, const Vector3f& direction,
+		float range, float innerAngle, float outerAngle)
+	{
+		if (!ILight::init(colour, intensity) || range <= 0.0f)
+		{
+			return false;
+		}
+
+		m_position = position;
+		m_range = range;
+
+		this->setDirection(direction);
+		this->setAngles(innerAngle, outerAngle);
+
+		return true;
+	}
+
+	//====================
+	// Methods
+	//====================
+	////////////////////////////////////////////////////////////
+	sol::table SpotLight::lua_asObject() const // override
+	{
+		return sol::table();
+	}
+
+	////////////////////////////////////////////////////////////
+	SpotLight* SpotLight::create(const Colour& colour, float intensity, const Vector3f& position, const Vector3f& direction,
+		float range, float innerAngle, float outerAngle)
+	{
+		SpotLight* pLight = new SpotLight();
+		if (pLight && pLight->init(colour, intensity, position, direction, range, innerAngle, outerAngle))
+		{
+			return pLight;
+		}
+
+		delete pLight;
+		return nullptr;
+	}
+
+} // namespace jackal
@@ -0,0 +1,303 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//====================
+// C++ includes
+//====================
+#include <cstring> // Copying data into the mapped memory.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/rendering/stream_buffer.hpp>     // StreamBuffer class declaration.
+#include <jackal/utils/log.hpp>                   // Logging warnings and errors.
+#include <jackal/rendering/render_statistics.hpp> // Counting the bytes streamed.
+
+namespace jackal
+{
+	//====================
+	// Local variables
+	//====================
+	static DebugLog log("logs/engine_log.txt");
+
+	static const GLuint64 FENCE_TIMEOUT = 1000000; ///< The time to wait on a fence before flushing, in nanoseconds.
+
+	//====================
+	// Ctor and dtor
+	//====================
+	////////////////////////////////////////////////////////////
+	StreamBuffer::StreamBuffer()
+		: NonCopyable(), m_ID(0), m_target(eStreamTarget::VERTEX), m_size(0), m_region(0), m_head(0), m_flushed(0),
+		  m_persistent(false), m_pMapped(nullptr), m_staging(), m_fences()
+	{
+		m_fences.fill(nullptr);
+	}
+
+	////////////////////////////////////////////////////////////
+	StreamBuffer::~StreamBuffer()
+	{
+		this->destroy();
+	}
+
+	//====================
+	// Private methods
+	//====================
+	////////////////////////////////////////////////////////////
+	void StreamBuffer::wait(int region)
+	{
+		GLsync fence = m_fences[region];
+		if (!fence)
+		{
+			return;
+		}
+
+		GLbitfield flags = 0;
+		while (true)
+		{
+			GLenum result = glClientWaitSync(fence, flags, FENCE_TIMEOUT);
+			if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED || result == GL_WAIT_FAILED)
+			{
+				break;
+			}
+
+			// Ensure the fence is actually submitted, otherwise it may never signal.
+			flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+		}
+
+		glDeleteSync(fence);
+		m_fences[region] = nullptr;
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	////////////////////////////////////////////////////////////
+	GLuint StreamBuffer::getID() const
+	{
+		return m_ID;
+	}
+
+	////////////////////////////////////////////////////////////
+	GLsizeiptr StreamBuffer::getSize() const
+	{
+		return m_size;
+	}
+
+	////////////////////////////////////////////////////////////
+	bool StreamBuffer::isPersistent() const
+	{
+		return m_persistent;
+	}
+
+	//====================
+	// Methods
+	//====================
+	////////////////////////////////////////////////////////////
+	bool StreamBuffer::create(eStreamTarget target, GLsizeiptr size)
+	{
+		this->destroy();
+
+		if (size <= 0)
+		{
+			log.warning(log.function(__FUNCTION__, size), "Cannot create an empty stream buffer.");
+			return false;
+		}
+
+		m_target = target;
+		m_size = size;
+		m_region = 0;
+		m_head = 0;
+		m_flushed = 0;
+		m_persistent = GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage;
+
+		// Storage is managed through the copy target, so that the bindings of
+		// the current vertex array are never disturbed.
+		GLenum glTarget = GL_COPY_WRITE_BUFFER;
+
+		glGenBuffers(1, &m_ID);
+		glBindBuffer(glTarget, m_ID);
+
+		if (m_persistent)
+		{
+			GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+			glBufferStorage(glTarget, m_size * REGIONS, nullptr, flags);
+
+			m_pMapped = static_cast<unsigned char*>(glMapBufferRange(glTarget, 0, m_size * REGIONS, flags));
+			if (!m_pMapped)
+			{
+				log.warning(log.function(__FUNCTION__, size), "Failed to persistently map buffer. Falling back to orphaning.");
+
+				glDeleteBuffers(1, &m_ID);
+				glGenBuffers(1, &m_ID);
+				glBindBuffer(glTarget, m_ID);
+
+				m_persistent = false;
+			}
+		}
+
+		if (!m_persistent)
+		{
+			glBufferData(glTarget, m_size, nullptr, GL_STREAM_DRAW);
+			m_staging.resize(m_size);
+		}
+
+		glBindBuffer(glTarget, 0);
+		return true;
+	}
+
+	////////////////////////////////////////////////////////////
+	void StreamBuffer::destroy()
+	{
+		for (auto& fence : m_fences)
+		{
+			if (fence)
+			{
+				glDeleteSync(fence);
+				fence = nullptr;
+			}
+		}
+
+		if (m_ID)
+		{
+			if (m_pMapped)
+			{
+				GLenum glTarget = GL_COPY_WRITE_BUFFER;
+
+				glBindBuffer(glTarget, m_ID);
+				glUnmapBuffer(glTarget);
+				glBindBuffer(glTarget, 0);
+
+				m_pMapped = nullptr;
+			}
+
+			glDeleteBuffers(1, &m_ID);
+			m_ID = 0;
+		}
+
+		m_staging.clear();
+		m_staging.shrink_to_fit();
+	}
+
+	////////////////////////////////////////////////////////////
+	void StreamBuffer::beginFrame()
+	{
+		m_head = 0;
+		m_flushed = 0;
+
+		if (m_persistent)
+		{
+			this->wait(m_region);
+		}
+		else if (m_ID)
+		{
+			// Orphan the storage, the driver hands back fresh memory instead of stalling.
+			GLenum glTarget = GL_COPY_WRITE_BUFFER;
+
+			glBindBuffer(glTarget, m_ID);
+			glBufferData(glTarget, m_size, nullptr, GL_STREAM_DRAW);
+			glBindBuffer(glTarget, 0);
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void StreamBuffer::endFrame()
+	{
+		if (m_persistent)
+		{
+			m_fences[m_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+			m_region = (m_region + 1) % REGIONS;
+		}
+
+		m_head = 0;
+		m_flushed = 0;
+	}
+
+	////////////////////////////////////////////////////////////
+	void* StreamBuffer::map(GLsizeiptr size, GLintptr& offset, GLsizeiptr alignment /*= 16*/)
+	{
+		GLsizeiptr aligned = ((m_head + alignment - 1) / alignment) * alignment;
+		if (!m_ID || aligned + size > m_size)
+		{
+			log.warning(log.function(__FUNCTION__, size, alignment), "Stream buffer region is full.");
+			return nullptr;
+		}
+
+		m_head = aligned + size;
+		RenderStatistics::getInstance().add(eRenderCounter::BUFFER_BYTES, size);
+
+		if (m_persistent)
+		{
+			offset = m_region * m_size + aligned;
+			return m_pMapped + offset;
+		}
+
+		offset = aligned;
+		return m_staging.data() + aligned;
+	}
+
+	////////////////////////////////////////////////////////////
+	GLintptr StreamBuffer::write(const void* pData, GLsizeiptr size, GLsizeiptr alignment /*= 16*/)
+	{
+		GLintptr offset = -1;
+
+		void* pMemory = this->map(size, offset, alignment);
+		if (!pMemory)
+		{
+			return -1;
+		}
+
+		std::memcpy(pMemory, pData, size);
+		return offset;
+	}
+
+	////////////////////////////////////////////////////////////
+	void StreamBuffer::flush()
+	{
+		if (m_persistent || m_head <= m_flushed)
+		{
+			return;
+		}
+
+		GLenum glTarget = GL_COPY_WRITE_BUFFER;
+
+		glBindBuffer(glTarget, m_ID);
+		glBufferSubData(glTarget, m_flushed, m_head - m_flushed, m_staging.data() + m_flushed);
+		glBindBuffer(glTarget, 0);
+
+		m_flushed = m_head;
+	}
+
+	////////////////////////////////////////////////////////////
+	void StreamBuffer::bind(const StreamBuffer& buffer)
+	{
+		glBindBuffer(static_cast<GLenum>(buffer.m_target), buffer.m_ID);
+	}
+
+	////////////////////////////////////////////////////////////
+	void StreamBuffer::unbind(const StreamBuffer& buffer)
+	{
+		glBindBuffer(static_cast<GLenum>(buffer.m_target), 0);
+	}
+
+} // namespace jackal
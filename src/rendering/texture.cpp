@@ -22,20 +22,35 @@
 //
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+//====================
+// C++ includes
+//====================
+#include <cstring>    // Copying the rows of each decoded image.
+#include <filesystem> // Checking the extension of the image.
+#include <memory>     // Sharing the cooked image with the uploader.
+#include <vector>     // Storing the pixels of each decoded image.
+
 //====================
 // Jackal includes
 //==================== 
-#include <jackal/rendering/texture.hpp>          // Texture class declaration.
-#include <jackal/utils/log.hpp>                  // Logging warnings and errors.
-#include <jackal/utils/constants.hpp>            // Using the constant log location.
-#include <jackal/core/virtual_file_system.hpp>   // Searching paths with the virtual file system.
-#include <jackal/utils/json_file_reader.hpp>     // Parsing the json file and utilising the result.
-#include <jackal/utils/resource_manager.hpp>     // Retrieving a handle to a Texture from the resource manager.
+#include <jackal/rendering/texture.hpp>           // Texture class declaration.
+#include <jackal/utils/log.hpp>                   // Logging warnings and errors.
+#include <jackal/utils/constants.hpp>             // Using the constant log location.
+#include <jackal/core/virtual_file_system.hpp>    // Searching paths with the virtual file system.
+#include <jackal/utils/json_file_reader.hpp>      // Parsing the json file and utilising the result.
+#include <jackal/utils/resource_manager.hpp>      // Retrieving a handle to a Texture from the resource manager.
+#include <jackal/rendering/render_thread.hpp>     // Executing the texture commands on the render thread.
+#include <jackal/rendering/render_statistics.hpp> // Counting the texture binds.
+#include <jackal/rendering/texture_uploader.hpp>  // Uploading the decoded images and binding the placeholder.
+#include <jackal/rendering/texture_file.hpp>      // Mapping cooked images.
+#include <jackal/rendering/texture_packer.hpp>    // Binding and releasing the layers of packed images.
+#include <jackal/rendering/texture_streamer.hpp>  // Streaming the levels of cooked images.
+#include <jackal/utils/thread_pool.hpp>           // Decoding the images on the worker threads.
 
 //====================
 // Additional includes
 //====================
-#include <SDL2/SDL_image.h>                      // Loading an image from a directory.
+#include <SDL2/SDL_image.h> // Loading an image from a directory.
 
 namespace jackal
 {
@@ -49,7 +64,8 @@ namespace jackal
 	//====================
 	////////////////////////////////////////////////////////////
 	Texture::Texture()
-		: Resource(), m_ID(0), m_size(), m_mode(eWrapMode::CLAMP), m_filter(eFilter::LINEAR)
+		: Resource(), m_ID(0), m_size(), m_mode(eWrapMode::CLAMP), m_filter(eFilter::LINEAR), m_image(), m_ready(false), m_decode(), m_packed(false),
+		  m_streamed(false), m_pArray(nullptr), m_layer(0), m_document(), m_prepared(false)
 	{
 		this->create();
 	}
@@ -57,6 +73,19 @@ namespace jackal
 	////////////////////////////////////////////////////////////
 	Texture::~Texture()
 	{
+		if (m_decode.valid())
+		{
+			m_decode.wait();
+		}
+
+		TextureStreamer::getInstance().remove(*this);
+		TextureUploader::getInstance().cancel(*this);
+
+		if (m_pArray)
+		{
+			TexturePacker::getInstance().release(m_pArray, m_layer);
+		}
+
 		if (m_ID)
 		{
 			glDeleteTextures(1, &m_ID);
@@ -72,12 +101,48 @@ namespace jackal
 		return m_ID;
 	}
 
+	////////////////////////////////////////////////////////////
+	const std::string& Texture::getImage() const
+	{
+		return m_image;
+	}
+
 	////////////////////////////////////////////////////////////
 	Vector2i Texture::getSize() const
 	{
 		return m_size;
 	}
 
+	////////////////////////////////////////////////////////////
+	bool Texture::isReady() const
+	{
+		return m_ready;
+	}
+
+	////////////////////////////////////////////////////////////
+	bool Texture::isPacked() const
+	{
+		return m_packed;
+	}
+
+	////////////////////////////////////////////////////////////
+	const TextureArray* Texture::getArray() const
+	{
+		return m_pArray;
+	}
+
+	////////////////////////////////////////////////////////////
+	int Texture::getLayer() const
+	{
+		return m_layer;
+	}
+
+	////////////////////////////////////////////////////////////
+	bool Texture::isStreamed() const
+	{
+		return m_streamed;
+	}
+
 	////////////////////////////////////////////////////////////
 	eWrapMode Texture::getWrapMode() const
 	{
@@ -112,41 +177,100 @@ namespace jackal
 			return false;
 		}
 
-		SDL_Surface* pSurface = IMG_Load(path.c_str());
-		if (!pSurface)
+		// A reload must not race the previous decode, or upload its stale image.
+		if (m_decode.valid())
 		{
-			log.error(log.function(__FUNCTION__, filename), "Failed to load image.");
-			return false;
+			m_decode.wait();
 		}
 
-		m_size.x = pSurface->w;
-		m_size.y = pSurface->h;
+		TextureStreamer::getInstance().remove(*this);
+		TextureUploader::getInstance().cancel(*this);
+
+		m_image = filename;
 		m_mode = mode;
 		m_filter = filter;
+		m_ready = false;
+
+		// Cooked textures are already compressed and mipmapped, mapping them is all that's needed.
+		if (std::filesystem::path(filename).extension() == ".jtex")
+		{
+			m_decode = ThreadPool::getInstance().submit([this, filename]() {
+				auto pFile = std::make_shared<TextureFile>();
+				if (!pFile->open(filename))
+				{
+					log.error(log.function("loadFromFile", filename), "Failed to load cooked image.");
+					return;
+				}
+
+				if (m_streamed)
+				{
+					TextureStreamer::getInstance().add(*this, std::move(pFile));
+					return;
+				}
+
+				TextureUploader::getInstance().queue(*this, std::move(pFile));
+			});
+
+			return true;
+		}
 
-		// basic auto-detection of type.
-		GLenum format = pSurface->format->BytesPerPixel == 3 ? GL_RGB : GL_RGBA;
+		m_decode = ThreadPool::getInstance().submit([this, filename, path]() {
+			SDL_Surface* pSurface = IMG_Load(path.c_str());
+			if (!pSurface)
+			{
+				log.error(log.function("loadFromFile", filename), "Failed to load image.");
+				return;
+			}
 
-		GLenum wrapMode = static_cast<GLenum>(m_mode);
-		GLenum filtering = static_cast<GLenum>(m_filter);
+			// Every image is uploaded as RGBA, so the uploader never needs to inspect the format.
+			SDL_Surface* pConverted = SDL_ConvertSurfaceFormat(pSurface, SDL_PIXELFORMAT_RGBA32, 0);
+			SDL_FreeSurface(pSurface);
 
-		Texture::bind(*this);
+			if (!pConverted)
+			{
+				log.error(log.function("loadFromFile", filename), "Failed to convert image:", SDL_GetError());
+				return;
+			}
 
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filtering);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filtering);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrapMode);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrapMode);
+			Vector2i size(pConverted->w, pConverted->h);
+			std::size_t row = static_cast<std::size_t>(size.x) * 4;
 
-		glTexImage2D(GL_TEXTURE_2D, 0, format, m_size.x, m_size.y, 0, format, GL_UNSIGNED_BYTE, pSurface->pixels);
-		glGenerateMipmap(GL_TEXTURE_2D);
+			std::vector<unsigned char> pixels(row * size.y);
+			const unsigned char* pSource = static_cast<const unsigned char*>(pConverted->pixels);
 
-		Texture::unbind();
+			// Surfaces may pad their rows, the uploader expects tightly packed rows.
+			for (int y = 0; y < size.y; ++y)
+			{
+				std::memcpy(pixels.data() + y * row, pSource + y * pConverted->pitch, row);
+			}
+
+			SDL_FreeSurface(pConverted);
 
-		SDL_FreeSurface(pSurface);
+			TextureUploader::getInstance().queue(*this, size, std::move(pixels));
+		});
 
 		return true;
 	}
 
+	////////////////////////////////////////////////////////////
+	void Texture::onUploaded(const Vector2i& size)
+	{
+		m_size = size;
+		m_ready = true;
+	}
+
+	////////////////////////////////////////////////////////////
+	void Texture::onPacked(TextureArray* pArray, int layer)
+	{
+		if (m_pArray)
+		{
+			TexturePacker::getInstance().release(m_pArray, m_layer);
+		}
+
+		m_pArray = pArray;
+		m_layer = layer;
+	}
+
 	//====================
 	// Methods
 	//====================
@@ -157,13 +281,30 @@ namespace jackal
 	}
 
 	////////////////////////////////////////////////////////////
-	bool Texture::load(const std::string& filename)//override
+	bool Texture::prepare(const std::string& filename)//override
 	{
 		JSONFileReader reader;
-		if (reader.read(filename))
+		if (!reader.read(filename))
 		{
-			nlohmann::json root = reader.getRoot();
+			log.warning(log.function(__FUNCTION__, filename), "Failed to read json file.");
+			return false;
+		}
+
+		m_document = reader.getRoot();
+		m_prepared = true;
+
+		return true;
+	}
+
+	////////////////////////////////////////////////////////////
+	bool Texture::load(const std::string& filename)//override
+	{
+		if (m_prepared || this->prepare(filename))
+		{
+			// The prepared file is only used once, a reload reads the file again.
+			nlohmann::json root = std::move(m_document);
 			nlohmann::json desc = root["description"];
+			m_prepared = false;
 
 			std::string wrapMode = desc["wrap-mode"].get<std::string>();
 			std::string filtering = desc["filter"].get<std::string>();
@@ -198,14 +339,21 @@ namespace jackal
 				log.warning(log.function(__FUNCTION__, filename), "Unknown filtering declared. Defaulting to LINEAR");
 			}
 
-			if (!this->loadFromFile(root["image"].get<std::string>(), mode, filter))
+			// Layers of an array share their levels, so streamed images can't be packed.
+			std::string image = root["image"].get<std::string>();
+			m_streamed = desc.value("stream", true) && TextureStreamer::getInstance().isEnabled() &&
+				std::filesystem::path(image).extension() == ".jtex";
+
+			// Packing is decided before the image loads, as materials compile their shaders to match.
+			m_packed = !m_streamed && desc.value("pack", true) && TexturePacker::getInstance().isEnabled();
+
+			if (!this->loadFromFile(image, mode, filter))
 			{
 				return false;
 			}
 		}
 		else
 		{
-			log.warning(log.function(__FUNCTION__, filename), "Failed to read json file.");
 			return false;
 		}
 
@@ -221,14 +369,29 @@ namespace jackal
 	////////////////////////////////////////////////////////////
 	void Texture::bind(const Texture& texture, GLint location/*= 0*/)
 	{
-		glActiveTexture(GL_TEXTURE0 + location);
-		glBindTexture(GL_TEXTURE_2D, texture.getID());
+		if (texture.isPacked())
+		{
+			const TextureArray* pArray = texture.getArray();
+			TextureArray::bind(texture.isReady() && pArray ? *pArray : TexturePacker::getInstance().getPlaceholder(), location);
+
+			return;
+		}
+
+		RenderStatistics::getInstance().add(eRenderCounter::TEXTURE_BINDS);
+
+		GLuint id = texture.isReady() ? texture.getID() : TextureUploader::getInstance().getPlaceholder();
+		RenderThread::getInstance().enqueue([id, location]() {
+			glActiveTexture(GL_TEXTURE0 + location);
+			glBindTexture(GL_TEXTURE_2D, id);
+		});
 	}
 
 	////////////////////////////////////////////////////////////
 	void Texture::unbind()
 	{
-		glBindTexture(GL_TEXTURE_2D, 0);
+		RenderThread::getInstance().enqueue([]() {
+			glBindTexture(GL_TEXTURE_2D, 0);
+		});
 	}
 
 } // namespace jackal
\ No newline at end of file
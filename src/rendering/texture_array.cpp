@@ -0,0 +1,232 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//====================
+// C++ includes
+//====================
+#include <algorithm> // Sizing each mip level.
+#include <array>     // Storing the array bound to each location.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/rendering/texture_array.hpp>     // TextureArray class declaration.
+#include <jackal/rendering/render_thread.hpp>     // Executing the bind commands on the render thread.
+#include <jackal/rendering/render_statistics.hpp> // Counting the texture binds.
+#include <jackal/utils/log.hpp>                   // Logging unsupported formats.
+
+namespace jackal
+{
+	//====================
+	// Local variables
+	//====================
+	static DebugLog log("logs/engine_log.txt");
+
+	static std::array<GLuint, 32> s_bound = {}; // The array last bound to each location, from the calling thread.
+
+	//====================
+	// Ctor and dtor
+	//====================
+	////////////////////////////////////////////////////////////
+	TextureArray::TextureArray()
+		: NonCopyable(), m_ID(0), m_size(), m_format(eTextureFormat::RGBA8), m_levels(1), m_mode(eWrapMode::CLAMP), m_filter(eFilter::LINEAR),
+		  m_layers(0), m_free()
+	{
+	}
+
+	////////////////////////////////////////////////////////////
+	TextureArray::~TextureArray()
+	{
+		this->destroy();
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	////////////////////////////////////////////////////////////
+	GLuint TextureArray::getID() const
+	{
+		return m_ID;
+	}
+
+	////////////////////////////////////////////////////////////
+	Vector2i TextureArray::getSize() const
+	{
+		return m_size;
+	}
+
+	////////////////////////////////////////////////////////////
+	eTextureFormat TextureArray::getFormat() const
+	{
+		return m_format;
+	}
+
+	////////////////////////////////////////////////////////////
+	int TextureArray::getLevels() const
+	{
+		return m_levels;
+	}
+
+	////////////////////////////////////////////////////////////
+	bool TextureArray::isFull() const
+	{
+		return m_free.empty();
+	}
+
+	////////////////////////////////////////////////////////////
+	bool TextureArray::matches(const Vector2i& size, eTextureFormat format, int levels, eWrapMode mode, eFilter filter) const
+	{
+		return m_size.x == size.x && m_size.y == size.y && m_format == format && m_levels == levels && m_mode == mode && m_filter == filter;
+	}
+
+	//====================
+	// Methods
+	//====================
+	////////////////////////////////////////////////////////////
+	bool TextureArray::create(const Vector2i& size, eTextureFormat format, int levels, eWrapMode mode, eFilter filter, int layers)
+	{
+		this->destroy();
+
+		if (!TextureFile::isSupported(format) || layers <= 0 || levels <= 0)
+		{
+			log.warning(log.function(__FUNCTION__, size, layers), "Cannot create an array texture of an unsupported format.");
+			return false;
+		}
+
+		m_size = size;
+		m_format = format;
+		m_levels = levels;
+		m_mode = mode;
+		m_filter = filter;
+		m_layers = layers;
+
+		GLenum wrapMode = static_cast<GLenum>(mode);
+		GLenum mipFiltering = filter == eFilter::NEAREST ? GL_NEAREST_MIPMAP_NEAREST : GL_LINEAR_MIPMAP_LINEAR;
+		GLenum internalFormat = TextureFile::getInternalFormat(format);
+
+		glGenTextures(1, &m_ID);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, m_ID);
+
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, mipFiltering);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, static_cast<GLenum>(filter));
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, wrapMode);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, wrapMode);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, levels - 1);
+
+		if (GLEW_VERSION_4_2 || GLEW_ARB_texture_storage)
+		{
+			glTexStorage3D(GL_TEXTURE_2D_ARRAY, levels, internalFormat, size.x, size.y, layers);
+		}
+		else
+		{
+			for (int level = 0; level < levels; ++level)
+			{
+				Vector2i mip(std::max(size.x >> level, 1), std::max(size.y >> level, 1));
+
+				if (format == eTextureFormat::RGBA8)
+				{
+					glTexImage3D(GL_TEXTURE_2D_ARRAY, level, internalFormat, mip.x, mip.y, layers, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+				}
+				else
+				{
+					GLsizei bytes = static_cast<GLsizei>(TextureFile::getLevelSize(format, mip) * layers);
+					glCompressedTexImage3D(GL_TEXTURE_2D_ARRAY, level, internalFormat, mip.x, mip.y, layers, 0, bytes, nullptr);
+				}
+			}
+		}
+
+		glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+		// Allocated from the back, so the first texture receives layer zero.
+		m_free.clear();
+		for (int layer = layers - 1; layer >= 0; --layer)
+		{
+			m_free.push_back(layer);
+		}
+
+		return true;
+	}
+
+	////////////////////////////////////////////////////////////
+	void TextureArray::destroy()
+	{
+		if (m_ID)
+		{
+			// The name may be reused by the next array, so it must not be mistaken as already bound.
+			std::replace(s_bound.begin(), s_bound.end(), m_ID, 0u);
+
+			glDeleteTextures(1, &m_ID);
+			m_ID = 0;
+		}
+
+		m_layers = 0;
+		m_free.clear();
+	}
+
+	////////////////////////////////////////////////////////////
+	int TextureArray::allocate()
+	{
+		if (m_free.empty())
+		{
+			return -1;
+		}
+
+		int layer = m_free.back();
+		m_free.pop_back();
+
+		return layer;
+	}
+
+	////////////////////////////////////////////////////////////
+	void TextureArray::release(int layer)
+	{
+		if (layer >= 0 && layer < m_layers)
+		{
+			m_free.push_back(layer);
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void TextureArray::bind(const TextureArray& array, GLint location/*= 0*/)
+	{
+		GLuint id = array.getID();
+		if (location >= 0 && location < static_cast<GLint>(s_bound.size()))
+		{
+			if (s_bound[location] == id)
+			{
+				return;
+			}
+
+			s_bound[location] = id;
+		}
+
+		RenderStatistics::getInstance().add(eRenderCounter::TEXTURE_BINDS);
+
+		RenderThread::getInstance().enqueue([id, location]() {
+			glActiveTexture(GL_TEXTURE0 + location);
+			glBindTexture(GL_TEXTURE_2D_ARRAY, id);
+		});
+	}
+
+} // namespace jackal
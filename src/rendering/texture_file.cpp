@@ -0,0 +1,291 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//====================
+// C++ includes
+//====================
+#include <cstring>                            // Reading the headers from the mapped file.
+#include <filesystem>                         // Replacing the written file.
+#include <fstream>                            // Writing cooked texture files.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/rendering/texture_file.hpp> // TextureFile class declaration.
+#include <jackal/utils/log.hpp>              // Logging invalid files.
+
+namespace jackal
+{
+	//====================
+	// Local variables
+	//====================
+	static DebugLog log("logs/engine_log.txt");
+
+	static const std::uint64_t DATA_ALIGNMENT = 16; // The alignment of the data of each level within the file.
+
+	//====================
+	// Static variables
+	//====================
+	const std::uint32_t TextureFile::MAGIC;
+	const std::uint32_t TextureFile::VERSION;
+	const unsigned int  TextureFile::MAX_LEVELS;
+
+	//====================
+	// Ctor
+	//====================
+	////////////////////////////////////////////////////////////
+	TextureFile::TextureFile()
+		: NonCopyable(), m_file(), m_format(eTextureFormat::RGBA8), m_levels()
+	{
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	////////////////////////////////////////////////////////////
+	eTextureFormat TextureFile::getFormat() const
+	{
+		return m_format;
+	}
+
+	////////////////////////////////////////////////////////////
+	Vector2i TextureFile::getSize() const
+	{
+		return m_levels.empty() ? Vector2i() : m_levels.front().size;
+	}
+
+	////////////////////////////////////////////////////////////
+	const std::vector<TextureFile::Level_t>& TextureFile::getLevels() const
+	{
+		return m_levels;
+	}
+
+	////////////////////////////////////////////////////////////
+	std::size_t TextureFile::getDataSize() const
+	{
+		std::size_t size = 0;
+		for (const auto& level : m_levels)
+		{
+			size += level.bytes;
+		}
+
+		return size;
+	}
+
+	//====================
+	// Methods
+	//====================
+	////////////////////////////////////////////////////////////
+	bool TextureFile::open(const std::string& filename)
+	{
+		this->close();
+
+		if (!m_file.open(filename))
+		{
+			return false;
+		}
+
+		Header_t header;
+		bool valid = m_file.getSize() >= sizeof(header);
+
+		if (valid)
+		{
+			std::memcpy(&header, m_file.getData(), sizeof(header));
+			valid = header.magic == MAGIC && header.version == VERSION && header.format < static_cast<std::uint32_t>(eTextureFormat::COUNT) &&
+				header.levels > 0 && header.levels <= MAX_LEVELS && sizeof(header) + header.levels * sizeof(LevelHeader_t) <= m_file.getSize();
+		}
+
+		if (!valid)
+		{
+			log.warning(log.function(__FUNCTION__, filename), "Not a valid cooked texture file.");
+			this->close();
+
+			return false;
+		}
+
+		m_format = static_cast<eTextureFormat>(header.format);
+
+		for (std::uint32_t i = 0; i < header.levels; ++i)
+		{
+			LevelHeader_t level;
+			std::memcpy(&level, m_file.getData() + sizeof(header) + i * sizeof(level), sizeof(level));
+
+			Vector2i size(static_cast<int>(level.width), static_cast<int>(level.height));
+
+			// Each level is checked against the file, so a truncated file is never uploaded.
+			if (level.offset > m_file.getSize() || level.size > m_file.getSize() - level.offset || level.size != getLevelSize(m_format, size))
+			{
+				log.warning(log.function(__FUNCTION__, filename), "Level", i, "of the cooked texture is invalid.");
+				this->close();
+
+				return false;
+			}
+
+			m_levels.push_back({ size, m_file.getData() + level.offset, static_cast<std::size_t>(level.size) });
+		}
+
+		return true;
+	}
+
+	////////////////////////////////////////////////////////////
+	void TextureFile::close()
+	{
+		m_levels.clear();
+		m_file.close();
+	}
+
+	////////////////////////////////////////////////////////////
+	bool TextureFile::write(const std::string& filename, eTextureFormat format,
+		const std::vector<std::pair<Vector2i, std::vector<unsigned char>>>& levels)
+	{
+		if (levels.empty() || levels.size() > MAX_LEVELS)
+		{
+			log.warning(log.function(__FUNCTION__, filename), "A cooked texture must have between 1 and", MAX_LEVELS, "levels.");
+			return false;
+		}
+
+		Header_t header;
+		header.magic = MAGIC;
+		header.version = VERSION;
+		header.format = static_cast<std::uint32_t>(format);
+		header.width = static_cast<std::uint32_t>(levels.front().first.x);
+		header.height = static_cast<std::uint32_t>(levels.front().first.y);
+		header.levels = static_cast<std::uint32_t>(levels.size());
+
+		std::vector<LevelHeader_t> table(levels.size());
+		std::uint64_t offset = sizeof(header) + table.size() * sizeof(LevelHeader_t);
+
+		for (std::size_t i = 0; i < levels.size(); ++i)
+		{
+			offset = (offset + DATA_ALIGNMENT - 1) / DATA_ALIGNMENT * DATA_ALIGNMENT;
+
+			table[i].width = static_cast<std::uint32_t>(levels[i].first.x);
+			table[i].height = static_cast<std::uint32_t>(levels[i].first.y);
+			table[i].offset = offset;
+			table[i].size = levels[i].second.size();
+
+			offset += table[i].size;
+		}
+
+		std::string temporary = filename + ".tmp";
+		{
+			std::ofstream file(temporary, std::ios::out | std::ios::binary | std::ios::trunc);
+			if (!file.is_open())
+			{
+				log.warning(log.function(__FUNCTION__, filename), "Failed to open the cooked texture for writing.");
+				return false;
+			}
+
+			file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			file.write(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(LevelHeader_t));
+
+			for (std::size_t i = 0; i < levels.size(); ++i)
+			{
+				// Pad up to the aligned offset of the level.
+				static const char PADDING[DATA_ALIGNMENT] = {};
+				file.write(PADDING, static_cast<std::streamsize>(table[i].offset - static_cast<std::uint64_t>(file.tellp())));
+				file.write(reinterpret_cast<const char*>(levels[i].second.data()), levels[i].second.size());
+			}
+
+			if (!file)
+			{
+				log.warning(log.function(__FUNCTION__, filename), "Failed to write the cooked texture.");
+				return false;
+			}
+		}
+
+		std::error_code error;
+		std::filesystem::rename(temporary, filename, error);
+		if (error)
+		{
+			log.warning(log.function(__FUNCTION__, filename), "Failed to replace the cooked texture:", error.message());
+			std::filesystem::remove(temporary, error);
+
+			return false;
+		}
+
+		return true;
+	}
+
+	////////////////////////////////////////////////////////////
+	std::size_t TextureFile::getLevelSize(eTextureFormat format, const Vector2i& size)
+	{
+		std::size_t width = static_cast<std::size_t>(size.x > 0 ? size.x : 0);
+		std::size_t height = static_cast<std::size_t>(size.y > 0 ? size.y : 0);
+
+		switch (format)
+		{
+		case eTextureFormat::RGBA8:
+			return width * height * 4;
+		case eTextureFormat::BC1:
+			return ((width + 3) / 4) * ((height + 3) / 4) * 8;
+		case eTextureFormat::BC3:
+		case eTextureFormat::BC5:
+		case eTextureFormat::BC7:
+			return ((width + 3) / 4) * ((height + 3) / 4) * 16;
+		default:
+			return 0;
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	GLenum TextureFile::getInternalFormat(eTextureFormat format)
+	{
+		switch (format)
+		{
+		case eTextureFormat::RGBA8:
+			return GL_RGBA8;
+		case eTextureFormat::BC1:
+			return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+		case eTextureFormat::BC3:
+			return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+		case eTextureFormat::BC5:
+			return GL_COMPRESSED_RG_RGTC2;
+		case eTextureFormat::BC7:
+			return GL_COMPRESSED_RGBA_BPTC_UNORM;
+		default:
+			return 0;
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	bool TextureFile::isSupported(eTextureFormat format)
+	{
+		switch (format)
+		{
+		case eTextureFormat::RGBA8:
+		case eTextureFormat::BC5:
+			// RGTC has been core since OpenGL 3.0, older contexts are never created.
+			return true;
+		case eTextureFormat::BC1:
+		case eTextureFormat::BC3:
+			return GLEW_EXT_texture_compression_s3tc;
+		case eTextureFormat::BC7:
+			return GLEW_VERSION_4_2 || GLEW_ARB_texture_compression_bptc;
+		default:
+			return false;
+		}
+	}
+
+} // namespace jackal
@@ -0,0 +1,179 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//====================
+// C++ includes
+//====================
+#include <algorithm> // Clamping the number of layers.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/rendering/texture_packer.hpp> // TexturePacker class declaration.
+#include <jackal/rendering/render_thread.hpp>  // Creating the placeholder on the render thread.
+#include <jackal/core/config_file.hpp>         // Loading the settings from the config file.
+#include <jackal/utils/log.hpp>                // Logging failures to create array textures.
+
+namespace jackal
+{
+	//====================
+	// Local variables
+	//====================
+	static DebugLog log("logs/engine_log.txt");
+
+	static const unsigned char PLACEHOLDER_PIXEL[] = { 255, 255, 255, 255 }; // The colour of the placeholder layer.
+
+	//====================
+	// Ctor
+	//====================
+	////////////////////////////////////////////////////////////
+	TexturePacker::TexturePacker()
+		: Singleton<TexturePacker>(), m_arrays(), m_placeholder(), m_enabled(false), m_layers(1), m_bytes(0), m_mutex()
+	{
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	////////////////////////////////////////////////////////////
+	bool TexturePacker::isEnabled() const
+	{
+		return m_enabled;
+	}
+
+	////////////////////////////////////////////////////////////
+	const TextureArray& TexturePacker::getPlaceholder() const
+	{
+		return m_placeholder;
+	}
+
+	////////////////////////////////////////////////////////////
+	std::size_t TexturePacker::getArrayCount()
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		return m_arrays.size();
+	}
+
+	//====================
+	// Methods
+	//====================
+	////////////////////////////////////////////////////////////
+	void TexturePacker::create(const ConfigFile& config)
+	{
+		m_enabled = config.get<bool>("TexturePacker.enabled");
+		m_layers = std::max(config.get<unsigned int>("TexturePacker.layers"), 1u);
+		m_bytes = config.get<unsigned int>("TexturePacker.bytes");
+
+		if (!m_enabled)
+		{
+			return;
+		}
+
+		RenderThread::getInstance().invoke([this]() {
+			GLint maxLayers = 0;
+			glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+
+			m_layers = std::min(m_layers, static_cast<unsigned int>(std::max(maxLayers, 1)));
+
+			if (!m_placeholder.create(Vector2i(1, 1), eTextureFormat::RGBA8, 1, eWrapMode::CLAMP, eFilter::NEAREST, 1))
+			{
+				log.warning(log.function(__FUNCTION__, m_layers), "Failed to create the placeholder array, textures won't be packed.");
+				m_enabled = false;
+
+				return;
+			}
+
+			glBindTexture(GL_TEXTURE_2D_ARRAY, m_placeholder.getID());
+			glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0, 1, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, PLACEHOLDER_PIXEL);
+			glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+		});
+	}
+
+	////////////////////////////////////////////////////////////
+	void TexturePacker::destroy()
+	{
+		RenderThread::getInstance().invoke([this]() {
+			std::lock_guard<std::mutex> guard(m_mutex);
+
+			m_arrays.clear();
+			m_placeholder.destroy();
+		});
+	}
+
+	////////////////////////////////////////////////////////////
+	TextureArray* TexturePacker::pack(const Vector2i& size, eTextureFormat format, int levels, eWrapMode mode, eFilter filter, int& layer)
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+
+		for (auto& pArray : m_arrays)
+		{
+			if (!pArray->isFull() && pArray->matches(size, format, levels, mode, filter))
+			{
+				layer = pArray->allocate();
+				return pArray.get();
+			}
+		}
+
+		// Storage for every layer is allocated up front, so large textures are given fewer layers.
+		std::size_t layerBytes = 0;
+		for (int level = 0; level < levels; ++level)
+		{
+			layerBytes += TextureFile::getLevelSize(format, Vector2i(std::max(size.x >> level, 1), std::max(size.y >> level, 1)));
+		}
+
+		std::size_t layers = m_layers;
+		if (m_bytes > 0)
+		{
+			layers = std::min(layers, std::max<std::size_t>(m_bytes / std::max<std::size_t>(layerBytes, 1), 1));
+		}
+
+		auto pArray = std::make_unique<TextureArray>();
+		if (!pArray->create(size, format, levels, mode, filter, static_cast<int>(layers)))
+		{
+			log.warning(log.function(__FUNCTION__, size, levels), "Failed to create an array texture.");
+			return nullptr;
+		}
+
+		layer = pArray->allocate();
+		m_arrays.push_back(std::move(pArray));
+
+		return m_arrays.back().get();
+	}
+
+	////////////////////////////////////////////////////////////
+	void TexturePacker::release(TextureArray* pArray, int layer)
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+
+		auto iter = std::find_if(m_arrays.begin(), m_arrays.end(), [pArray](const std::unique_ptr<TextureArray>& pOther) {
+			return pOther.get() == pArray;
+		});
+
+		if (iter != m_arrays.end())
+		{
+			(*iter)->release(layer);
+		}
+	}
+
+} // namespace jackal
@@ -0,0 +1,318 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//====================
+// C++ includes
+//====================
+#include <algorithm>                             // Ordering the textures by their last use.
+#include <cmath>                                 // Choosing the level that covers the requested size.
+#include <vector>                                // Collecting the levels to upload.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/rendering/texture_streamer.hpp> // TextureStreamer class declaration.
+#include <jackal/rendering/texture.hpp>          // Retrieving the ID of each streamed texture.
+#include <jackal/rendering/texture_uploader.hpp> // Uploading the streamed levels.
+#include <jackal/rendering/render_thread.hpp>    // Freeing the evicted levels on the render thread.
+#include <jackal/core/config_file.hpp>           // Loading the budget from the config file.
+#include <jackal/utils/log.hpp>                  // Logging textures that don't fit within the budget.
+
+namespace jackal
+{
+	//====================
+	// Local variables
+	//====================
+	static DebugLog log("logs/engine_log.txt");
+
+	//====================
+	// Ctor
+	//====================
+	////////////////////////////////////////////////////////////
+	TextureStreamer::TextureStreamer()
+		: Singleton<TextureStreamer>(), m_textures(), m_budget(0), m_resident(0), m_residentSize(0), m_frame(0), m_mutex()
+	{
+	}
+
+	//====================
+	// Private methods
+	//====================
+	////////////////////////////////////////////////////////////
+	std::uint64_t TextureStreamer::getTailSize(const TextureFile& file, int first)
+	{
+		std::uint64_t bytes = 0;
+
+		const auto& levels = file.getLevels();
+		for (std::size_t i = static_cast<std::size_t>(first); i < levels.size(); ++i)
+		{
+			bytes += levels[i].bytes;
+		}
+
+		return bytes;
+	}
+
+	////////////////////////////////////////////////////////////
+	bool TextureStreamer::evict(const Streamed_t& promoted)
+	{
+		Streamed_t* pVictim = nullptr;
+		for (auto& pair : m_textures)
+		{
+			Streamed_t& entry = pair.second;
+			if (&entry == &promoted || entry.pending || entry.resident >= entry.floor)
+			{
+				continue;
+			}
+
+			// A texture sampled as recently as the promoted one would only be promoted again next frame.
+			if (entry.used >= promoted.used && entry.wanted <= entry.resident)
+			{
+				continue;
+			}
+
+			if (!pVictim || entry.used < pVictim->used)
+			{
+				pVictim = &entry;
+			}
+		}
+
+		if (!pVictim)
+		{
+			return false;
+		}
+
+		int level = pVictim->resident++;
+		std::uint64_t bytes = pVictim->pFile->getLevels()[level].bytes;
+
+		pVictim->bytes -= bytes;
+		m_resident -= bytes;
+
+		GLuint id = pVictim->pTexture->getID();
+		eTextureFormat format = pVictim->pFile->getFormat();
+
+		// The level is specified as empty, which frees its memory while keeping the smaller levels.
+		RenderThread::getInstance().enqueue([id, level, format]() {
+			GLenum internalFormat = TextureFile::getInternalFormat(format);
+
+			glBindTexture(GL_TEXTURE_2D, id);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, level + 1);
+
+			if (format == eTextureFormat::RGBA8)
+			{
+				glTexImage2D(GL_TEXTURE_2D, level, internalFormat, 0, 0, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+			}
+			else
+			{
+				glCompressedTexImage2D(GL_TEXTURE_2D, level, internalFormat, 0, 0, 0, 0, nullptr);
+			}
+
+			glBindTexture(GL_TEXTURE_2D, 0);
+		});
+
+		return true;
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	////////////////////////////////////////////////////////////
+	bool TextureStreamer::isEnabled() const
+	{
+		return m_budget > 0;
+	}
+
+	////////////////////////////////////////////////////////////
+	std::uint64_t TextureStreamer::getResidentBytes()
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		return m_resident;
+	}
+
+	//====================
+	// Methods
+	//====================
+	////////////////////////////////////////////////////////////
+	void TextureStreamer::create(const ConfigFile& config)
+	{
+		m_budget = config.get<unsigned int>("ContextSettings.texture_budget");
+		m_residentSize = std::max(config.get<unsigned int>("ContextSettings.texture_resident_size"), 1u);
+	}
+
+	////////////////////////////////////////////////////////////
+	void TextureStreamer::destroy()
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+
+		m_textures.clear();
+		m_resident = 0;
+	}
+
+	////////////////////////////////////////////////////////////
+	void TextureStreamer::add(Texture& texture, std::shared_ptr<const TextureFile> pFile)
+	{
+		const auto& levels = pFile->getLevels();
+
+		// The first level that fits within the resident size, or the smallest level stored.
+		int floor = static_cast<int>(levels.size()) - 1;
+		for (std::size_t i = 0; i < levels.size(); ++i)
+		{
+			if (static_cast<unsigned int>(std::max(levels[i].size.x, levels[i].size.y)) <= m_residentSize)
+			{
+				floor = static_cast<int>(i);
+				break;
+			}
+		}
+
+		{
+			std::lock_guard<std::mutex> guard(m_mutex);
+
+			// The smallest levels are never evicted, so they are held against the budget even when it is exceeded.
+			std::uint64_t bytes = getTailSize(*pFile, floor);
+			m_resident += bytes;
+			if (m_resident > m_budget)
+			{
+				log.warning(log.function(__FUNCTION__, texture.getImage()), "The resident levels of the streamed textures exceed the budget.");
+			}
+
+			m_textures[&texture] = { &texture, pFile, floor, floor, floor, true, bytes, m_frame };
+		}
+
+		TextureUploader::getInstance().queue(texture, std::move(pFile), floor, static_cast<int>(levels.size()));
+	}
+
+	////////////////////////////////////////////////////////////
+	void TextureStreamer::remove(const Texture& texture)
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+
+		auto itr = m_textures.find(&texture);
+		if (itr != m_textures.end())
+		{
+			m_resident -= itr->second.bytes;
+			m_textures.erase(itr);
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void TextureStreamer::request(const Texture& texture, float pixels)
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+
+		auto itr = m_textures.find(&texture);
+		if (itr == m_textures.end())
+		{
+			return;
+		}
+
+		Streamed_t& entry = itr->second;
+		Vector2i size = entry.pFile->getSize();
+
+		// Each level halves the size, so the level is the number of halvings before the texture is smaller than the pixels covered.
+		float texels = static_cast<float>(std::max(size.x, size.y));
+		int level = pixels > 0.0f ? static_cast<int>(std::floor(std::log2(std::max(texels / pixels, 1.0f)))) : entry.floor;
+
+		entry.wanted = std::min(entry.wanted, std::min(level, entry.floor));
+		entry.used = m_frame;
+	}
+
+	////////////////////////////////////////////////////////////
+	void TextureStreamer::onUploaded(const Texture& texture, int level)
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+
+		auto itr = m_textures.find(&texture);
+		if (itr != m_textures.end())
+		{
+			itr->second.resident = level;
+			itr->second.pending = false;
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void TextureStreamer::update()
+	{
+		struct Promotion_t
+		{
+			Texture*                           pTexture;
+			std::shared_ptr<const TextureFile> pFile;
+			int                                level;
+		};
+
+		std::vector<Promotion_t> promotions;
+
+		{
+			std::lock_guard<std::mutex> guard(m_mutex);
+
+			std::vector<Streamed_t*> wanted;
+			for (auto& pair : m_textures)
+			{
+				if (!pair.second.pending && pair.second.wanted < pair.second.resident)
+				{
+					wanted.push_back(&pair.second);
+				}
+			}
+
+			// The textures wanting the most detail are promoted first, they are the closest to the camera.
+			std::sort(wanted.begin(), wanted.end(), [](const Streamed_t* pA, const Streamed_t* pB) {
+				return pA->wanted < pB->wanted;
+			});
+
+			for (Streamed_t* pEntry : wanted)
+			{
+				int level = pEntry->resident - 1;
+				std::uint64_t bytes = pEntry->pFile->getLevels()[level].bytes;
+
+				bool fits = true;
+				while (m_resident + bytes > m_budget && fits)
+				{
+					fits = this->evict(*pEntry);
+				}
+
+				if (!fits)
+				{
+					break;
+				}
+
+				m_resident += bytes;
+				pEntry->bytes += bytes;
+				pEntry->pending = true;
+
+				promotions.push_back({ pEntry->pTexture, pEntry->pFile, level });
+			}
+
+			// Demand is gathered afresh each frame, textures that aren't requested keep their levels until evicted.
+			for (auto& pair : m_textures)
+			{
+				pair.second.wanted = pair.second.floor;
+			}
+
+			++m_frame;
+		}
+
+		for (auto& promotion : promotions)
+		{
+			TextureUploader::getInstance().queue(*promotion.pTexture, std::move(promotion.pFile), promotion.level, promotion.level + 1);
+		}
+	}
+
+} // namespace jackal
@@ -0,0 +1,363 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//====================
+// C++ includes
+//====================
+#include <algorithm> // Removing the images of cancelled textures.
+#include <cmath>     // Counting the levels of generated mipmaps.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/rendering/texture_uploader.hpp>  // TextureUploader class declaration.
+#include <jackal/rendering/texture.hpp>           // Marking each texture as uploaded.
+#include <jackal/rendering/texture_packer.hpp>    // Packing the images into array textures.
+#include <jackal/rendering/texture_streamer.hpp>  // Marking the streamed levels as resident.
+#include <jackal/rendering/render_thread.hpp>     // Executing the uploads on the render thread.
+#include <jackal/rendering/render_statistics.hpp> // Counting the bytes uploaded from client memory.
+#include <jackal/core/config_file.hpp>            // Loading the budget from the config file.
+#include <jackal/utils/log.hpp>                   // Logging failures to create the pixel buffer object.
+
+namespace jackal
+{
+	//====================
+	// Local variables
+	//====================
+	static DebugLog log("logs/engine_log.txt");
+
+	static const unsigned char PLACEHOLDER_PIXEL[] = { 255, 255, 255, 255 }; // The colour of the placeholder texture.
+	static const GLsizeiptr    STAGING_ALIGNMENT   = 16;                     // The alignment of each staged image.
+
+	//====================
+	// Ctor
+	//====================
+	////////////////////////////////////////////////////////////
+	TextureUploader::TextureUploader()
+		: Singleton<TextureUploader>(), m_uploads(), m_buffer(), m_placeholder(0), m_budget(0), m_mutex()
+	{
+	}
+
+	//====================
+	// Private methods
+	//====================
+	////////////////////////////////////////////////////////////
+	void TextureUploader::drain()
+	{
+		// Held while uploading, so a texture can't be destroyed part way through its upload.
+		std::lock_guard<std::mutex> guard(m_mutex);
+		if (m_uploads.empty())
+		{
+			return;
+		}
+
+		m_buffer.beginFrame();
+
+		GLsizeiptr spent = 0;
+		GLsizeiptr staged = 0;
+
+		while (!m_uploads.empty())
+		{
+			const Upload_t& upload = m_uploads.front();
+			GLsizeiptr bytes = static_cast<GLsizeiptr>(upload.pixels.size());
+			GLsizeiptr padding = STAGING_ALIGNMENT * (upload.pFile ? upload.last - upload.first : 1);
+
+			if (upload.pFile)
+			{
+				const auto& levels = upload.pFile->getLevels();
+				for (int i = upload.first; i < upload.last; ++i)
+				{
+					bytes += static_cast<GLsizeiptr>(levels[i].bytes);
+				}
+			}
+
+			if (m_budget > 0 && spent > 0 && spent + bytes > static_cast<GLsizeiptr>(m_budget))
+			{
+				break;
+			}
+
+			bool stage = m_buffer.getID() && staged + bytes + padding <= m_buffer.getSize();
+			this->upload(upload, stage);
+
+			staged += stage ? bytes + padding : 0;
+			spent += bytes;
+
+			m_uploads.pop_front();
+		}
+
+		m_buffer.endFrame();
+	}
+
+	////////////////////////////////////////////////////////////
+	void TextureUploader::upload(const Upload_t& upload, bool staged)
+	{
+		Texture& texture = *upload.pTexture;
+
+		eTextureFormat format = upload.pFile ? upload.pFile->getFormat() : eTextureFormat::RGBA8;
+		if (!TextureFile::isSupported(format))
+		{
+			log.warning(log.function(__FUNCTION__, texture.getImage()), "The driver cannot sample the format of the cooked texture.");
+			return;
+		}
+
+		// Decoded images are a single level, the remaining levels are generated once uploaded.
+		std::vector<TextureFile::Level_t> levels;
+		if (upload.pFile)
+		{
+			const auto& fileLevels = upload.pFile->getLevels();
+			levels.assign(fileLevels.begin() + upload.first, fileLevels.begin() + upload.last);
+		}
+		else
+		{
+			levels.push_back({ upload.size, upload.pixels.data(), upload.pixels.size() });
+		}
+
+		// Packed images are uploaded into a layer of a shared array, which already holds the sampling parameters.
+		GLenum target = GL_TEXTURE_2D;
+		TextureArray* pArray = nullptr;
+		int layer = 0;
+		GLint previous = 0;
+
+		if (texture.isPacked())
+		{
+			// Materials skip binding the array they last bound, so the binding must be restored afterwards.
+			glGetIntegerv(GL_TEXTURE_BINDING_2D_ARRAY, &previous);
+
+			const Vector2i& size = levels.front().size;
+
+			// Decoded images generate every level down to 1x1.
+			int mipLevels = static_cast<int>(levels.size());
+			if (!upload.pFile)
+			{
+				mipLevels = static_cast<int>(std::floor(std::log2(std::max(size.x, size.y)))) + 1;
+			}
+
+			pArray = TexturePacker::getInstance().pack(size, format, mipLevels, texture.getWrapMode(), texture.getFilter(), layer);
+			if (!pArray)
+			{
+				log.warning(log.function(__FUNCTION__, texture.getImage()), "Failed to pack the image into an array texture.");
+				return;
+			}
+
+			target = GL_TEXTURE_2D_ARRAY;
+			glBindTexture(target, pArray->getID());
+		}
+		else
+		{
+			GLenum wrapMode = static_cast<GLenum>(texture.getWrapMode());
+			GLenum filtering = static_cast<GLenum>(texture.getFilter());
+			GLenum mipFiltering = texture.getFilter() == eFilter::NEAREST ? GL_NEAREST_MIPMAP_NEAREST : GL_LINEAR_MIPMAP_LINEAR;
+
+			glBindTexture(target, texture.getID());
+
+			glTexParameteri(target, GL_TEXTURE_MIN_FILTER, mipFiltering);
+			glTexParameteri(target, GL_TEXTURE_MAG_FILTER, filtering);
+			glTexParameteri(target, GL_TEXTURE_WRAP_S, wrapMode);
+			glTexParameteri(target, GL_TEXTURE_WRAP_T, wrapMode);
+
+			if (upload.pFile)
+			{
+				// Cooked files may stop short of a 1x1 level, the chain is complete at the last level stored.
+				glTexParameteri(target, GL_TEXTURE_BASE_LEVEL, upload.first);
+				glTexParameteri(target, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(upload.pFile->getLevels().size()) - 1);
+			}
+		}
+
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+		if (staged)
+		{
+			StreamBuffer::bind(m_buffer);
+		}
+
+		GLenum internalFormat = TextureFile::getInternalFormat(format);
+		for (std::size_t i = 0; i < levels.size(); ++i)
+		{
+			const TextureFile::Level_t& level = levels[i];
+
+			const void* pData = level.pData;
+			if (staged)
+			{
+				GLintptr offset = m_buffer.write(level.pData, level.bytes, STAGING_ALIGNMENT);
+				m_buffer.flush();
+
+				// With a pixel buffer object bound, the pointer is an offset into the buffer.
+				pData = reinterpret_cast<const void*>(offset);
+			}
+			else
+			{
+				RenderStatistics::getInstance().add(eRenderCounter::BUFFER_BYTES, level.bytes);
+			}
+
+			GLint mip = static_cast<GLint>(upload.first + i);
+			GLsizei bytes = static_cast<GLsizei>(level.bytes);
+
+			if (pArray && format == eTextureFormat::RGBA8)
+			{
+				glTexSubImage3D(target, mip, 0, 0, layer, level.size.x, level.size.y, 1, GL_RGBA, GL_UNSIGNED_BYTE, pData);
+			}
+			else if (pArray)
+			{
+				glCompressedTexSubImage3D(target, mip, 0, 0, layer, level.size.x, level.size.y, 1, internalFormat, bytes, pData);
+			}
+			else if (format == eTextureFormat::RGBA8)
+			{
+				glTexImage2D(target, mip, internalFormat, level.size.x, level.size.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, pData);
+			}
+			else
+			{
+				glCompressedTexImage2D(target, mip, internalFormat, level.size.x, level.size.y, 0, bytes, pData);
+			}
+		}
+
+		if (staged)
+		{
+			StreamBuffer::unbind(m_buffer);
+		}
+
+		// Generating the mipmaps of an array regenerates every layer, which is wasted on the layers already uploaded but still correct.
+		if (!upload.pFile)
+		{
+			glGenerateMipmap(target);
+		}
+
+		glBindTexture(target, static_cast<GLuint>(previous));
+
+		if (pArray)
+		{
+			texture.onPacked(pArray, layer);
+		}
+
+		// Streamed textures are only partly resident, the size is always that of the whole image.
+		if (texture.isStreamed())
+		{
+			TextureStreamer::getInstance().onUploaded(texture, upload.first);
+		}
+
+		texture.onUploaded(upload.size);
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	////////////////////////////////////////////////////////////
+	GLuint TextureUploader::getPlaceholder() const
+	{
+		return m_placeholder;
+	}
+
+	////////////////////////////////////////////////////////////
+	std::size_t TextureUploader::getPending()
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		return m_uploads.size();
+	}
+
+	//====================
+	// Methods
+	//====================
+	////////////////////////////////////////////////////////////
+	void TextureUploader::create(const ConfigFile& config)
+	{
+		m_budget = config.get<unsigned int>("TextureUpload.budget");
+
+		RenderThread::getInstance().invoke([this]() {
+			if (!m_placeholder)
+			{
+				glGenTextures(1, &m_placeholder);
+				glBindTexture(GL_TEXTURE_2D, m_placeholder);
+
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+				glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, PLACEHOLDER_PIXEL);
+
+				glBindTexture(GL_TEXTURE_2D, 0);
+			}
+
+			// Without a budget there is no bound on the size of a frame, images are uploaded from client memory.
+			if (m_budget > 0 && !m_buffer.create(eStreamTarget::PIXEL_UNPACK, m_budget))
+			{
+				log.warning(log.function(__FUNCTION__, m_budget), "Failed to create the pixel buffer object, uploading from client memory.");
+			}
+		});
+	}
+
+	////////////////////////////////////////////////////////////
+	void TextureUploader::destroy()
+	{
+		{
+			std::lock_guard<std::mutex> guard(m_mutex);
+			m_uploads.clear();
+		}
+
+		RenderThread::getInstance().invoke([this]() {
+			m_buffer.destroy();
+
+			if (m_placeholder)
+			{
+				glDeleteTextures(1, &m_placeholder);
+				m_placeholder = 0;
+			}
+		});
+	}
+
+	////////////////////////////////////////////////////////////
+	void TextureUploader::queue(Texture& texture, const Vector2i& size, std::vector<unsigned char> pixels)
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		m_uploads.push_back({ &texture, size, std::move(pixels), nullptr, 0, 1 });
+	}
+
+	////////////////////////////////////////////////////////////
+	void TextureUploader::queue(Texture& texture, std::shared_ptr<const TextureFile> pFile)
+	{
+		int levels = static_cast<int>(pFile->getLevels().size());
+		this->queue(texture, std::move(pFile), 0, levels);
+	}
+
+	////////////////////////////////////////////////////////////
+	void TextureUploader::queue(Texture& texture, std::shared_ptr<const TextureFile> pFile, int first, int last)
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		m_uploads.push_back({ &texture, pFile->getSize(), std::vector<unsigned char>(), std::move(pFile), first, last });
+	}
+
+	////////////////////////////////////////////////////////////
+	void TextureUploader::cancel(const Texture& texture)
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		m_uploads.erase(std::remove_if(m_uploads.begin(), m_uploads.end(), [&texture](const Upload_t& upload) {
+			return upload.pTexture == &texture;
+		}), m_uploads.end());
+	}
+
+	////////////////////////////////////////////////////////////
+	void TextureUploader::update()
+	{
+		RenderThread::getInstance().enqueue([this]() {
+			this->drain();
+		});
+	}
+
+} // namespace jackal
@@ -44,11 +44,23 @@ namespace jackal
 	const std::string Uniforms::MATERIAL_SPECULAR_TEXTURE = "u_material.specular";
 	const std::string Uniforms::MATERIAL_DIFFUSE_COLOUR   = "u_material.diffuse_colour";
 	const std::string Uniforms::MATERIAL_SHININESS        = "u_material.shininess";
+	const std::string Uniforms::MATERIAL_DIFFUSE_LAYER    = "u_material.diffuse_layer";
+	const std::string Uniforms::MATERIAL_SPECULAR_LAYER   = "u_material.specular_layer";
 	// DirectionalLight
 	const std::string Uniforms::DIRECTIONAL_LIGHT_COLOUR      = "u_dir_light.light.colour";
 	const std::string Uniforms::DIRECTIONAL_LIGHT_SPECULARITY = "u_dir_light.light.specularity";
 	const std::string Uniforms::DIRECTIONAL_LIGHT_INTENSITY   = "u_dir_light.light.intensity";
 	const std::string Uniforms::DIRECTIONAL_LIGHT_DIRECTION   = "u_dir_light.direction";
+	// Camera
+	const std::string Uniforms::VIEW          = "u_view";
+	const std::string Uniforms::VIEW_POSITION = "u_view_position";
+	// ClusteredLighting
+	const std::string Uniforms::CLUSTER_LIGHTS      = "u_clusters.lights";
+	const std::string Uniforms::CLUSTER_GRID        = "u_clusters.grid";
+	const std::string Uniforms::CLUSTER_INDICES     = "u_clusters.indices";
+	const std::string Uniforms::CLUSTER_SCREEN_SIZE = "u_clusters.screen_size";
+	const std::string Uniforms::CLUSTER_NEAR        = "u_clusters.near";
+	const std::string Uniforms::CLUSTER_SLICE_SCALE = "u_clusters.slice_scale";
 
 	//====================
 	// Ctor and dtor
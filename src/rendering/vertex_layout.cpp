@@ -0,0 +1,480 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//====================
+// C++ includes
+//====================
+#include <algorithm> // Clamping the normalised values.
+#include <cmath>     // Rounding the normalised values.
+#include <cstring>   // Copying the encoded values into the output.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/rendering/vertex_layout.hpp> // VertexLayout class declaration.
+#include <jackal/utils/log.hpp>               // Logging warnings and errors.
+
+namespace jackal
+{
+	//====================
+	// Local variables
+	//====================
+	static DebugLog log("logs/engine_log.txt");
+
+	struct Format_t
+	{
+		GLint     components; ///< The number of components the shader reads.
+		GLenum    type;       ///< The type of each component.
+		GLboolean normalised; ///< Whether integer components are normalised.
+		GLuint    size;       ///< The size of the attribute in bytes.
+	};
+
+	////////////////////////////////////////////////////////////
+	static Format_t getFormatInfo(eVertexFormat format)
+	{
+		switch (format)
+		{
+		case eVertexFormat::FLOAT2:          return { 2, GL_FLOAT, GL_FALSE, 8 };
+		case eVertexFormat::FLOAT3:          return { 3, GL_FLOAT, GL_FALSE, 12 };
+		case eVertexFormat::FLOAT4:          return { 4, GL_FLOAT, GL_FALSE, 16 };
+		case eVertexFormat::HALF2:           return { 2, GL_HALF_FLOAT, GL_FALSE, 4 };
+		case eVertexFormat::HALF4:           return { 4, GL_HALF_FLOAT, GL_FALSE, 8 };
+		case eVertexFormat::SNORM16_2:       return { 2, GL_SHORT, GL_TRUE, 4 };
+		case eVertexFormat::SNORM16_4:       return { 4, GL_SHORT, GL_TRUE, 8 };
+		case eVertexFormat::SNORM10_10_10_2: return { 4, GL_INT_2_10_10_10_REV, GL_TRUE, 4 };
+		case eVertexFormat::UNORM8_4:        return { 4, GL_UNSIGNED_BYTE, GL_TRUE, 4 };
+		default:                             return { 0, GL_FLOAT, GL_FALSE, 0 };
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	static bool isSupported(eVertexAttribute attribute, eVertexFormat format)
+	{
+		if (format == eVertexFormat::NONE)
+		{
+			return true;
+		}
+
+		switch (attribute)
+		{
+		case eVertexAttribute::POSITION:
+			return format == eVertexFormat::FLOAT3 || format == eVertexFormat::HALF4 || format == eVertexFormat::SNORM16_4;
+
+		case eVertexAttribute::NORMAL:
+			return format == eVertexFormat::FLOAT3 || format == eVertexFormat::HALF4 || format == eVertexFormat::SNORM16_2 ||
+				format == eVertexFormat::SNORM10_10_10_2;
+
+		case eVertexAttribute::UV:
+			return format == eVertexFormat::FLOAT2 || format == eVertexFormat::HALF2;
+
+		case eVertexAttribute::TANGENT:
+			return format == eVertexFormat::FLOAT4 || format == eVertexFormat::HALF4 || format == eVertexFormat::SNORM10_10_10_2;
+
+		case eVertexAttribute::COLOUR:
+			return format == eVertexFormat::FLOAT4 || format == eVertexFormat::HALF4 || format == eVertexFormat::UNORM8_4;
+
+		default:
+			return false;
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	static std::uint16_t toHalf(float value)
+	{
+		std::uint32_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+
+		std::uint16_t sign = static_cast<std::uint16_t>((bits >> 16) & 0x8000);
+		std::int32_t exponent = static_cast<std::int32_t>((bits >> 23) & 0xFF) - 127 + 15;
+		std::uint32_t mantissa = bits & 0x7FFFFF;
+
+		if (((bits >> 23) & 0xFF) == 0xFF)
+		{
+			return sign | 0x7C00 | (mantissa ? 0x200 : 0);
+		}
+
+		if (exponent >= 31)
+		{
+			return sign | 0x7C00;
+		}
+
+		// Too small for a normal half, the implicit bit is shifted into the mantissa.
+		if (exponent <= 0)
+		{
+			if (exponent < -10)
+			{
+				return sign;
+			}
+
+			mantissa |= 0x800000;
+			std::uint32_t shift = 14 - exponent;
+			std::uint32_t half = mantissa >> shift;
+
+			if ((mantissa >> (shift - 1)) & 1)
+			{
+				half++;
+			}
+
+			return sign | static_cast<std::uint16_t>(half);
+		}
+
+		// Rounding may carry into the exponent, which is still the correctly rounded value.
+		std::uint32_t half = (static_cast<std::uint32_t>(exponent) << 10) | (mantissa >> 13);
+		if (mantissa & 0x1000)
+		{
+			half++;
+		}
+
+		return sign | static_cast<std::uint16_t>(half);
+	}
+
+	////////////////////////////////////////////////////////////
+	static std::int32_t toSnorm(float value, int bits)
+	{
+		float maximum = static_cast<float>((1 << (bits - 1)) - 1);
+		return static_cast<std::int32_t>(std::round(std::max(-1.0f, std::min(1.0f, value)) * maximum));
+	}
+
+	////////////////////////////////////////////////////////////
+	static std::uint32_t toSnorm10_10_10_2(float x, float y, float z, float w)
+	{
+		return (static_cast<std::uint32_t>(toSnorm(x, 10)) & 0x3FF) | ((static_cast<std::uint32_t>(toSnorm(y, 10)) & 0x3FF) << 10) |
+			((static_cast<std::uint32_t>(toSnorm(z, 10)) & 0x3FF) << 20) | ((static_cast<std::uint32_t>(toSnorm(w, 2)) & 0x3) << 30);
+	}
+
+	////////////////////////////////////////////////////////////
+	static void toOctahedral(const Vector3f& normal, float& x, float& y)
+	{
+		// The normal is projected onto an octahedron, the lower half is folded over the upper half.
+		float length = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+		if (length <= 0.0f)
+		{
+			x = y = 0.0f;
+			return;
+		}
+
+		x = normal.x / length;
+		y = normal.y / length;
+
+		if (normal.z < 0.0f)
+		{
+			float foldedX = (1.0f - std::abs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+			float foldedY = (1.0f - std::abs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+
+			x = foldedX;
+			y = foldedY;
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	static void write(unsigned char* pOutput, eVertexFormat format, float x, float y, float z, float w)
+	{
+		switch (format)
+		{
+		case eVertexFormat::FLOAT2:
+		case eVertexFormat::FLOAT3:
+		case eVertexFormat::FLOAT4:
+		{
+			float values[] = { x, y, z, w };
+			std::memcpy(pOutput, values, getFormatInfo(format).size);
+			break;
+		}
+
+		case eVertexFormat::HALF2:
+		case eVertexFormat::HALF4:
+		{
+			std::uint16_t values[] = { toHalf(x), toHalf(y), toHalf(z), toHalf(w) };
+			std::memcpy(pOutput, values, getFormatInfo(format).size);
+			break;
+		}
+
+		case eVertexFormat::SNORM16_2:
+		case eVertexFormat::SNORM16_4:
+		{
+			std::int16_t values[] = { static_cast<std::int16_t>(toSnorm(x, 16)), static_cast<std::int16_t>(toSnorm(y, 16)),
+				static_cast<std::int16_t>(toSnorm(z, 16)), static_cast<std::int16_t>(toSnorm(w, 16)) };
+			std::memcpy(pOutput, values, getFormatInfo(format).size);
+			break;
+		}
+
+		case eVertexFormat::SNORM10_10_10_2:
+		{
+			std::uint32_t value = toSnorm10_10_10_2(x, y, z, w);
+			std::memcpy(pOutput, &value, sizeof(value));
+			break;
+		}
+
+		case eVertexFormat::UNORM8_4:
+		{
+			unsigned char values[4];
+			float components[] = { x, y, z, w };
+
+			for (int i = 0; i < 4; ++i)
+			{
+				values[i] = static_cast<unsigned char>(std::round(std::max(0.0f, std::min(1.0f, components[i])) * 255.0f));
+			}
+
+			std::memcpy(pOutput, values, sizeof(values));
+			break;
+		}
+
+		default:
+			break;
+		}
+	}
+
+	//====================
+	// Static variables
+	//====================
+	const int VertexLayout::ATTRIBUTE_COUNT;
+	const GLuint VertexLayout::DECODE_LOCATION;
+
+	//====================
+	// Ctor and dtor
+	//====================
+	////////////////////////////////////////////////////////////
+	VertexLayout::VertexLayout()
+		: m_formats(), m_offsets(), m_stride(0)
+	{
+		m_formats.fill(eVertexFormat::NONE);
+		m_offsets.fill(0);
+	}
+
+	//====================
+	// Operators
+	//====================
+	////////////////////////////////////////////////////////////
+	bool VertexLayout::operator==(const VertexLayout& layout) const
+	{
+		return m_formats == layout.m_formats;
+	}
+
+	////////////////////////////////////////////////////////////
+	bool VertexLayout::operator!=(const VertexLayout& layout) const
+	{
+		return !(*this == layout);
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	////////////////////////////////////////////////////////////
+	bool VertexLayout::set(eVertexAttribute attribute, eVertexFormat format)
+	{
+		if (attribute == eVertexAttribute::COUNT || !isSupported(attribute, format))
+		{
+			log.warning(log.function(__FUNCTION__, static_cast<int>(attribute), static_cast<int>(format)), "Unsupported vertex attribute format.");
+			return false;
+		}
+
+		m_formats[static_cast<int>(attribute)] = format;
+
+		// Every attribute is a multiple of 4 bytes, so each stays aligned.
+		m_stride = 0;
+		for (int i = 0; i < ATTRIBUTE_COUNT; ++i)
+		{
+			m_offsets[i] = m_stride;
+			m_stride += getFormatInfo(m_formats[i]).size;
+		}
+
+		return true;
+	}
+
+	////////////////////////////////////////////////////////////
+	eVertexFormat VertexLayout::getFormat(eVertexAttribute attribute) const
+	{
+		return attribute == eVertexAttribute::COUNT ? eVertexFormat::NONE : m_formats[static_cast<int>(attribute)];
+	}
+
+	////////////////////////////////////////////////////////////
+	GLsizei VertexLayout::getStride() const
+	{
+		return m_stride;
+	}
+
+	////////////////////////////////////////////////////////////
+	VertexLayout::Decode_t VertexLayout::getDecode(const BoundingBox& frame) const
+	{
+		Decode_t decode = { Vector3f(1.0f, 1.0f, 1.0f), Vector3f(), 0.0f };
+
+		if (this->isQuantised() && frame.isValid())
+		{
+			decode.scale = frame.getExtents();
+			decode.offset = frame.getCentre();
+		}
+
+		if (this->getFormat(eVertexAttribute::NORMAL) == eVertexFormat::SNORM16_2)
+		{
+			decode.octahedral = 1.0f;
+		}
+
+		return decode;
+	}
+
+	////////////////////////////////////////////////////////////
+	bool VertexLayout::isQuantised() const
+	{
+		return this->getFormat(eVertexAttribute::POSITION) == eVertexFormat::SNORM16_4;
+	}
+
+	//====================
+	// Methods
+	//====================
+	////////////////////////////////////////////////////////////
+	void VertexLayout::apply() const
+	{
+		for (int i = 0; i < ATTRIBUTE_COUNT; ++i)
+		{
+			if (m_formats[i] == eVertexFormat::NONE)
+			{
+				glDisableVertexAttribArray(i);
+				continue;
+			}
+
+			Format_t info = getFormatInfo(m_formats[i]);
+			const GLvoid* pOffset = reinterpret_cast<const GLvoid*>(static_cast<std::size_t>(m_offsets[i]));
+
+			glEnableVertexAttribArray(i);
+			glVertexAttribPointer(i, info.components, info.type, info.normalised, m_stride, pOffset);
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void VertexLayout::encode(const Vertex_t* pVertices, int count, const BoundingBox& frame, void* pOutput) const
+	{
+		Vector3f centre = frame.isValid() ? frame.getCentre() : Vector3f();
+		Vector3f extents = frame.isValid() ? frame.getExtents() : Vector3f();
+
+		// A flat box has no extent along an axis, every position on it is the centre.
+		Vector3f inverse(extents.x > 0.0f ? 1.0f / extents.x : 0.0f, extents.y > 0.0f ? 1.0f / extents.y : 0.0f,
+			extents.z > 0.0f ? 1.0f / extents.z : 0.0f);
+
+		unsigned char* pVertex = static_cast<unsigned char*>(pOutput);
+		for (int i = 0; i < count; ++i, pVertex += m_stride)
+		{
+			const Vertex_t& vertex = pVertices[i];
+
+			eVertexFormat format = m_formats[static_cast<int>(eVertexAttribute::POSITION)];
+			if (format == eVertexFormat::SNORM16_4)
+			{
+				write(pVertex + m_offsets[0], format, (vertex.position.x - centre.x) * inverse.x, (vertex.position.y - centre.y) * inverse.y,
+					(vertex.position.z - centre.z) * inverse.z, 1.0f);
+			}
+			else
+			{
+				write(pVertex + m_offsets[0], format, vertex.position.x, vertex.position.y, vertex.position.z, 1.0f);
+			}
+
+			format = m_formats[static_cast<int>(eVertexAttribute::NORMAL)];
+			if (format == eVertexFormat::SNORM16_2)
+			{
+				float x, y;
+				toOctahedral(vertex.normal, x, y);
+				write(pVertex + m_offsets[1], format, x, y, 0.0f, 0.0f);
+			}
+			else
+			{
+				write(pVertex + m_offsets[1], format, vertex.normal.x, vertex.normal.y, vertex.normal.z, 0.0f);
+			}
+
+			write(pVertex + m_offsets[2], m_formats[2], vertex.uv.x, vertex.uv.y, 0.0f, 0.0f);
+			write(pVertex + m_offsets[3], m_formats[3], vertex.tangent.x, vertex.tangent.y, vertex.tangent.z, vertex.tangent.w < 0.0f ? -1.0f : 1.0f);
+			write(pVertex + m_offsets[4], m_formats[4], vertex.colour.r, vertex.colour.g, vertex.colour.b, vertex.colour.a);
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	std::uint32_t VertexLayout::pack() const
+	{
+		std::uint32_t packed = 0;
+		for (int i = 0; i < ATTRIBUTE_COUNT; ++i)
+		{
+			packed |= static_cast<std::uint32_t>(m_formats[i]) << (i * 4);
+		}
+
+		return packed;
+	}
+
+	////////////////////////////////////////////////////////////
+	bool VertexLayout::unpack(std::uint32_t packed, VertexLayout& layout)
+	{
+		if (packed >> (ATTRIBUTE_COUNT * 4))
+		{
+			return false;
+		}
+
+		VertexLayout unpacked;
+		for (int i = 0; i < ATTRIBUTE_COUNT; ++i)
+		{
+			std::uint32_t format = (packed >> (i * 4)) & 0xF;
+			if (format > static_cast<std::uint32_t>(eVertexFormat::UNORM8_4) ||
+				!unpacked.set(static_cast<eVertexAttribute>(i), static_cast<eVertexFormat>(format)))
+			{
+				return false;
+			}
+		}
+
+		layout = unpacked;
+		return true;
+	}
+
+	////////////////////////////////////////////////////////////
+	void VertexLayout::applyDecode(const Decode_t& decode)
+	{
+		glVertexAttrib3f(DECODE_LOCATION, decode.scale.x, decode.scale.y, decode.scale.z);
+		glVertexAttrib3f(DECODE_LOCATION + 1, decode.offset.x, decode.offset.y, decode.offset.z);
+		glVertexAttrib1f(DECODE_LOCATION + 2, decode.octahedral);
+	}
+
+	////////////////////////////////////////////////////////////
+	const VertexLayout& VertexLayout::standard()
+	{
+		static const VertexLayout layout = []() {
+			VertexLayout standard;
+			standard.set(eVertexAttribute::POSITION, eVertexFormat::FLOAT3);
+			standard.set(eVertexAttribute::NORMAL, eVertexFormat::FLOAT3);
+			standard.set(eVertexAttribute::UV, eVertexFormat::FLOAT2);
+
+			return standard;
+		}();
+
+		return layout;
+	}
+
+	////////////////////////////////////////////////////////////
+	const VertexLayout& VertexLayout::compressed()
+	{
+		static const VertexLayout layout = []() {
+			VertexLayout compressed;
+			compressed.set(eVertexAttribute::POSITION, eVertexFormat::SNORM16_4);
+			compressed.set(eVertexAttribute::NORMAL, eVertexFormat::SNORM16_2);
+			compressed.set(eVertexAttribute::UV, eVertexFormat::HALF2);
+
+			return compressed;
+		}();
+
+		return layout;
+	}
+
+} // namespace jackal
@@ -0,0 +1,82 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/scripting/rendering_wrapper.hpp> // RenderingWrapper class declaration.
+#include <jackal/rendering/render_statistics.hpp> // Binding the RenderStatistics object.
+
+namespace jackal
+{
+	//====================
+	// Private methods
+	//====================
+	////////////////////////////////////////////////////////////
+	void RenderingWrapper::bindRenderCounter(sol::state& state)
+	{
+		state.new_enum("RenderCounter",
+			"DRAW_CALLS", eRenderCounter::DRAW_CALLS,
+			"TRIANGLES", eRenderCounter::TRIANGLES,
+			"PROGRAM_BINDS", eRenderCounter::PROGRAM_BINDS,
+			"TEXTURE_BINDS", eRenderCounter::TEXTURE_BINDS,
+			"BUFFER_BYTES", eRenderCounter::BUFFER_BYTES,
+			"UNIFORM_CALLS", eRenderCounter::UNIFORM_CALLS
+		);
+	}
+
+	////////////////////////////////////////////////////////////
+	void RenderingWrapper::bindRenderStatistics(sol::state& state)
+	{
+		state.new_usertype<RenderStatistics>("RenderStatistics",
+			// Constructors
+			sol::no_constructor,
+			// Properties
+			"draw_calls", sol::property(&RenderStatistics::getDrawCalls),
+			"triangles", sol::property(&RenderStatistics::getTriangles),
+			"program_binds", sol::property(&RenderStatistics::getProgramBinds),
+			"texture_binds", sol::property(&RenderStatistics::getTextureBinds),
+			"buffer_bytes", sol::property(&RenderStatistics::getBufferBytes),
+			"uniform_calls", sol::property(&RenderStatistics::getUniformCalls),
+			"exceeded_frames", sol::property(&RenderStatistics::getExceededFrames),
+			// Methods
+			"get", &RenderStatistics::getInstance,
+			"get_counter", &RenderStatistics::get,
+			"get_budget", &RenderStatistics::getBudget,
+			"set_budget", &RenderStatistics::setBudget,
+			"exceeds_budget", &RenderStatistics::exceedsBudget
+		);
+	}
+
+	//====================
+	// Methods
+	//====================
+	////////////////////////////////////////////////////////////
+	void RenderingWrapper::bind(sol::state& state)
+	{
+		this->bindRenderCounter(state);
+		this->bindRenderStatistics(state);
+	}
+
+} // namespace jackal
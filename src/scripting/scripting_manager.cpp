@@ -28,6 +28,7 @@
 #include <jackal/scripting/scripting_manager.hpp> // ScriptingManager class declaration.
 #include <jackal/scripting/core_wrapper.hpp>      // Wrapping classes within the jackal_core library.
 #include <jackal/scripting/math_wrapper.hpp>      // Wrapping classes within the jackal_math library.
+#include <jackal/scripting/rendering_wrapper.hpp> // Wrapping classes within the jackal_rendering library.
 
 namespace jackal
 {
@@ -60,6 +61,8 @@ namespace jackal
 		CoreWrapper core; core.bind(m_state);
 		// Creating the Math lua library and binding all of the necessary classes.
 		MathWrapper math; math.bind(m_state);
+		// Creating the Rendering lua library and binding all of the necessary classes.
+		RenderingWrapper rendering; rendering.bind(m_state);
 	}
 
 } // namespace jackal
\ No newline at end of file
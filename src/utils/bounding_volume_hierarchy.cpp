@@ -0,0 +1,764 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//====================
+// C++ includes
+//====================
+#include <algorithm>                                  // Partitioning the objects when building.
+#include <limits>                                     // The initial cost of each split.
+#include <numeric>                                    // Numbering the objects when building.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/utils/bounding_volume_hierarchy.hpp> // BoundingVolumeHierarchy class declaration.
+#include <jackal/utils/thread_pool.hpp>               // Building large subtrees in parallel.
+
+namespace jackal
+{
+	//====================
+	// Local variables
+	//====================
+	////////////////////////////////////////////////////////////
+	/// @brief Creates the box that contains two boxes.
+	///
+	/// @param lhs  The first box.
+	/// @param rhs  The second box.
+	///
+	/// @returns    The box that contains both boxes.
+	///
+	////////////////////////////////////////////////////////////
+	static BoundingBox combine(const BoundingBox& lhs, const BoundingBox& rhs)
+	{
+		BoundingBox box = lhs;
+		box.merge(rhs);
+
+		return box;
+	}
+
+	//====================
+	// Static variables
+	//====================
+	const int BoundingVolumeHierarchy::NULL_NODE;
+	const int BoundingVolumeHierarchy::BINS;
+	const int BoundingVolumeHierarchy::PARALLEL_THRESHOLD;
+
+	//====================
+	// Ctor and dtor
+	//====================
+	////////////////////////////////////////////////////////////
+	BoundingVolumeHierarchy::Node_t::Node_t()
+		: box(), pData(nullptr), parent(NULL_NODE), left(NULL_NODE), right(NULL_NODE), height(-1)
+	{
+	}
+
+	////////////////////////////////////////////////////////////
+	BoundingVolumeHierarchy::BoundingVolumeHierarchy(float margin /*= 0.1f*/)
+		: m_nodes(), m_root(NULL_NODE), m_free(NULL_NODE), m_count(0), m_margin(margin)
+	{
+	}
+
+	//====================
+	// Private methods
+	//====================
+	////////////////////////////////////////////////////////////
+	bool BoundingVolumeHierarchy::Node_t::isLeaf() const
+	{
+		return left == NULL_NODE;
+	}
+
+	////////////////////////////////////////////////////////////
+	int BoundingVolumeHierarchy::allocateNode()
+	{
+		if (m_free == NULL_NODE)
+		{
+			int first = static_cast<int>(m_nodes.size());
+			m_nodes.resize(std::max<std::size_t>(m_nodes.size() * 2, 16));
+
+			// The new nodes are threaded onto the free list, through their parents.
+			for (int i = first; i < static_cast<int>(m_nodes.size()); ++i)
+			{
+				m_nodes[i].parent = i + 1 < static_cast<int>(m_nodes.size()) ? i + 1 : NULL_NODE;
+				m_nodes[i].height = -1;
+			}
+
+			m_free = first;
+		}
+
+		int node = m_free;
+		m_free = m_nodes[node].parent;
+
+		m_nodes[node] = Node_t();
+		m_nodes[node].height = 0;
+
+		return node;
+	}
+
+	////////////////////////////////////////////////////////////
+	void BoundingVolumeHierarchy::freeNode(int node)
+	{
+		m_nodes[node] = Node_t();
+		m_nodes[node].parent = m_free;
+		m_free = node;
+	}
+
+	////////////////////////////////////////////////////////////
+	void BoundingVolumeHierarchy::insertLeaf(int leaf)
+	{
+		if (m_root == NULL_NODE)
+		{
+			m_root = leaf;
+			m_nodes[leaf].parent = NULL_NODE;
+			return;
+		}
+
+		// Descends towards the sibling that least increases the total surface area.
+		const BoundingBox& box = m_nodes[leaf].box;
+		int index = m_root;
+
+		while (!m_nodes[index].isLeaf())
+		{
+			const Node_t& node = m_nodes[index];
+
+			float area = node.box.getSurfaceArea();
+			float combinedArea = combine(node.box, box).getSurfaceArea();
+
+			float cost = 2.0f * combinedArea;
+			float inheritance = 2.0f * (combinedArea - area);
+
+			auto descend = [this, &box, inheritance](int child) {
+				const Node_t& node = m_nodes[child];
+				float enlarged = combine(node.box, box).getSurfaceArea();
+
+				return (node.isLeaf() ? enlarged : enlarged - node.box.getSurfaceArea()) + inheritance;
+			};
+
+			float leftCost = descend(node.left);
+			float rightCost = descend(node.right);
+
+			if (cost < leftCost && cost < rightCost)
+			{
+				break;
+			}
+
+			index = leftCost < rightCost ? node.left : node.right;
+		}
+
+		int sibling = index;
+		int oldParent = m_nodes[sibling].parent;
+		int newParent = this->allocateNode();
+
+		m_nodes[newParent].parent = oldParent;
+		m_nodes[newParent].box = combine(m_nodes[sibling].box, box);
+		m_nodes[newParent].height = m_nodes[sibling].height + 1;
+		m_nodes[newParent].left = sibling;
+		m_nodes[newParent].right = leaf;
+
+		if (oldParent == NULL_NODE)
+		{
+			m_root = newParent;
+		}
+		else if (m_nodes[oldParent].left == sibling)
+		{
+			m_nodes[oldParent].left = newParent;
+		}
+		else
+		{
+			m_nodes[oldParent].right = newParent;
+		}
+
+		m_nodes[sibling].parent = newParent;
+		m_nodes[leaf].parent = newParent;
+
+		this->refitAncestors(m_nodes[leaf].parent);
+	}
+
+	////////////////////////////////////////////////////////////
+	void BoundingVolumeHierarchy::removeLeaf(int leaf)
+	{
+		if (leaf == m_root)
+		{
+			m_root = NULL_NODE;
+			return;
+		}
+
+		int parent = m_nodes[leaf].parent;
+		int grandParent = m_nodes[parent].parent;
+		int sibling = m_nodes[parent].left == leaf ? m_nodes[parent].right : m_nodes[parent].left;
+
+		if (grandParent == NULL_NODE)
+		{
+			m_root = sibling;
+			m_nodes[sibling].parent = NULL_NODE;
+			this->freeNode(parent);
+			return;
+		}
+
+		if (m_nodes[grandParent].left == parent)
+		{
+			m_nodes[grandParent].left = sibling;
+		}
+		else
+		{
+			m_nodes[grandParent].right = sibling;
+		}
+
+		m_nodes[sibling].parent = grandParent;
+		this->freeNode(parent);
+
+		this->refitAncestors(grandParent);
+	}
+
+	////////////////////////////////////////////////////////////
+	void BoundingVolumeHierarchy::refitAncestors(int node)
+	{
+		while (node != NULL_NODE)
+		{
+			node = this->balance(node);
+
+			Node_t& current = m_nodes[node];
+			const Node_t& left = m_nodes[current.left];
+			const Node_t& right = m_nodes[current.right];
+
+			current.height = 1 + std::max(left.height, right.height);
+			current.box = combine(left.box, right.box);
+
+			node = current.parent;
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	int BoundingVolumeHierarchy::balance(int a)
+	{
+		Node_t& nodeA = m_nodes[a];
+		if (nodeA.isLeaf() || nodeA.height < 2)
+		{
+			return a;
+		}
+
+		int b = nodeA.left;
+		int c = nodeA.right;
+		Node_t& nodeB = m_nodes[b];
+		Node_t& nodeC = m_nodes[c];
+
+		int difference = nodeC.height - nodeB.height;
+
+		// The taller child is rotated up to replace the node.
+		auto rotate = [this, a, &nodeA](int up, Node_t& nodeUp, Node_t& nodeOther, bool right) {
+			int first = nodeUp.left;
+			int second = nodeUp.right;
+			Node_t& nodeFirst = m_nodes[first];
+			Node_t& nodeSecond = m_nodes[second];
+
+			nodeUp.left = a;
+			nodeUp.parent = nodeA.parent;
+			nodeA.parent = up;
+
+			if (nodeUp.parent == NULL_NODE)
+			{
+				m_root = up;
+			}
+			else if (m_nodes[nodeUp.parent].left == a)
+			{
+				m_nodes[nodeUp.parent].left = up;
+			}
+			else
+			{
+				m_nodes[nodeUp.parent].right = up;
+			}
+
+			// The taller grandchild stays with the rotated node, the other moves down to the old node.
+			int keep = nodeFirst.height > nodeSecond.height ? first : second;
+			int give = keep == first ? second : first;
+
+			nodeUp.right = keep;
+			(right ? nodeA.right : nodeA.left) = give;
+			m_nodes[give].parent = a;
+
+			nodeA.box = combine(nodeOther.box, m_nodes[give].box);
+			nodeUp.box = combine(nodeA.box, m_nodes[keep].box);
+
+			nodeA.height = 1 + std::max(nodeOther.height, m_nodes[give].height);
+			nodeUp.height = 1 + std::max(nodeA.height, m_nodes[keep].height);
+		};
+
+		if (difference > 1)
+		{
+			rotate(c, nodeC, nodeB, true);
+			return c;
+		}
+
+		if (difference < -1)
+		{
+			rotate(b, nodeB, nodeC, false);
+			return b;
+		}
+
+		return a;
+	}
+
+	////////////////////////////////////////////////////////////
+	void BoundingVolumeHierarchy::refitNode(int node)
+	{
+		Node_t& current = m_nodes[node];
+		if (current.isLeaf())
+		{
+			return;
+		}
+
+		this->refitNode(current.left);
+		this->refitNode(current.right);
+
+		current.box = combine(m_nodes[current.left].box, m_nodes[current.right].box);
+	}
+
+	////////////////////////////////////////////////////////////
+	void BoundingVolumeHierarchy::buildNode(int node, int parent, int* pFirst, int* pLast, const std::vector<BoundingBox>& boxes,
+		const std::vector<void*>& data, std::vector<int>& proxies)
+	{
+		Node_t& current = m_nodes[node];
+		current.parent = parent;
+
+		int count = static_cast<int>(pLast - pFirst);
+		if (count == 1)
+		{
+			current.box = boxes[*pFirst];
+			current.pData = data[*pFirst];
+			current.height = 0;
+			proxies[*pFirst] = node;
+			return;
+		}
+
+		BoundingBox centres;
+		for (int* pObject = pFirst; pObject != pLast; ++pObject)
+		{
+			current.box.merge(boxes[*pObject]);
+			centres.expand(boxes[*pObject].getCentre());
+		}
+
+		// The objects are split along the axis their centres are most spread across.
+		Vector3f spread = centres.maximum - centres.minimum;
+		int axis = spread.x > spread.y ? (spread.x > spread.z ? 0 : 2) : (spread.y > spread.z ? 1 : 2);
+
+		auto component = [axis](const Vector3f& vector) {
+			return axis == 0 ? vector.x : (axis == 1 ? vector.y : vector.z);
+		};
+
+		float minimum = component(centres.minimum);
+		float extent = component(centres.maximum) - minimum;
+
+		int* pMiddle = pFirst + count / 2;
+
+		if (extent > 0.0f)
+		{
+			auto bin = [&boxes, &component, minimum, extent](int object) {
+				int index = static_cast<int>(BINS * (component(boxes[object].getCentre()) - minimum) / extent);
+				return std::min(index, BINS - 1);
+			};
+
+			int counts[BINS] = {};
+			BoundingBox bounds[BINS];
+
+			for (int* pObject = pFirst; pObject != pLast; ++pObject)
+			{
+				int index = bin(*pObject);
+				counts[index]++;
+				bounds[index].merge(boxes[*pObject]);
+			}
+
+			// The cost of each split is the area of each side weighted by the objects within it.
+			float rightAreas[BINS];
+			int rightCounts[BINS];
+			BoundingBox right;
+			int rightCount = 0;
+
+			for (int i = BINS - 1; i > 0; --i)
+			{
+				right.merge(bounds[i]);
+				rightCount += counts[i];
+				rightAreas[i] = right.getSurfaceArea();
+				rightCounts[i] = rightCount;
+			}
+
+			BoundingBox left;
+			int leftCount = 0;
+			float bestCost = std::numeric_limits<float>::max();
+			int bestSplit = 0;
+
+			for (int i = 1; i < BINS; ++i)
+			{
+				left.merge(bounds[i - 1]);
+				leftCount += counts[i - 1];
+
+				if (leftCount == 0 || rightCounts[i] == 0)
+				{
+					continue;
+				}
+
+				float cost = leftCount * left.getSurfaceArea() + rightCounts[i] * rightAreas[i];
+				if (cost < bestCost)
+				{
+					bestCost = cost;
+					bestSplit = i;
+				}
+			}
+
+			if (bestSplit > 0)
+			{
+				pMiddle = std::partition(pFirst, pLast, [&bin, bestSplit](int object) {
+					return bin(object) < bestSplit;
+				});
+			}
+		}
+
+		// Objects with identical centres cannot be binned, they are split by count instead.
+		if (pMiddle == pFirst || pMiddle == pLast || extent <= 0.0f)
+		{
+			pMiddle = pFirst + count / 2;
+			std::nth_element(pFirst, pMiddle, pLast, [&boxes, &component](int lhs, int rhs) {
+				return component(boxes[lhs].getCentre()) < component(boxes[rhs].getCentre());
+			});
+		}
+
+		int leftCount = static_cast<int>(pMiddle - pFirst);
+		int left = node + 1;
+		int right = node + 2 * leftCount;
+
+		if (count > PARALLEL_THRESHOLD)
+		{
+			ThreadPool::getInstance().parallelFor(2, 1, [&](std::size_t begin, std::size_t end) {
+				for (std::size_t i = begin; i < end; ++i)
+				{
+					if (i == 0)
+					{
+						this->buildNode(left, node, pFirst, pMiddle, boxes, data, proxies);
+					}
+					else
+					{
+						this->buildNode(right, node, pMiddle, pLast, boxes, data, proxies);
+					}
+				}
+			});
+		}
+		else
+		{
+			this->buildNode(left, node, pFirst, pMiddle, boxes, data, proxies);
+			this->buildNode(right, node, pMiddle, pLast, boxes, data, proxies);
+		}
+
+		Node_t& built = m_nodes[node];
+		built.left = left;
+		built.right = right;
+		built.height = 1 + std::max(m_nodes[left].height, m_nodes[right].height);
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	////////////////////////////////////////////////////////////
+	void* BoundingVolumeHierarchy::getData(int proxy) const
+	{
+		return m_nodes[proxy].pData;
+	}
+
+	////////////////////////////////////////////////////////////
+	const BoundingBox& BoundingVolumeHierarchy::getBox(int proxy) const
+	{
+		return m_nodes[proxy].box;
+	}
+
+	////////////////////////////////////////////////////////////
+	int BoundingVolumeHierarchy::getCount() const
+	{
+		return m_count;
+	}
+
+	////////////////////////////////////////////////////////////
+	int BoundingVolumeHierarchy::getHeight() const
+	{
+		return m_root == NULL_NODE ? 0 : m_nodes[m_root].height;
+	}
+
+	//====================
+	// Methods
+	//====================
+	////////////////////////////////////////////////////////////
+	int BoundingVolumeHierarchy::insert(const BoundingBox& box, void* pData)
+	{
+		int proxy = this->allocateNode();
+
+		Vector3f margin(m_margin, m_margin, m_margin);
+		m_nodes[proxy].box = BoundingBox(box.minimum - margin, box.maximum + margin);
+		m_nodes[proxy].pData = pData;
+
+		this->insertLeaf(proxy);
+		m_count++;
+
+		return proxy;
+	}
+
+	////////////////////////////////////////////////////////////
+	void BoundingVolumeHierarchy::remove(int proxy)
+	{
+		this->removeLeaf(proxy);
+		this->freeNode(proxy);
+		m_count--;
+	}
+
+	////////////////////////////////////////////////////////////
+	bool BoundingVolumeHierarchy::move(int proxy, const BoundingBox& box)
+	{
+		if (m_nodes[proxy].box.contains(box))
+		{
+			return false;
+		}
+
+		this->removeLeaf(proxy);
+
+		Vector3f margin(m_margin, m_margin, m_margin);
+		m_nodes[proxy].box = BoundingBox(box.minimum - margin, box.maximum + margin);
+
+		this->insertLeaf(proxy);
+		return true;
+	}
+
+	////////////////////////////////////////////////////////////
+	void BoundingVolumeHierarchy::update(int proxy, const BoundingBox& box)
+	{
+		m_nodes[proxy].box = box;
+	}
+
+	////////////////////////////////////////////////////////////
+	void BoundingVolumeHierarchy::refit()
+	{
+		if (m_root != NULL_NODE)
+		{
+			this->refitNode(m_root);
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void BoundingVolumeHierarchy::build(const std::vector<BoundingBox>& boxes, const std::vector<void*>& data, std::vector<int>& proxies)
+	{
+		this->clear();
+		proxies.clear();
+
+		if (boxes.empty() || boxes.size() != data.size())
+		{
+			return;
+		}
+
+		std::vector<int> objects(boxes.size());
+		std::iota(objects.begin(), objects.end(), 0);
+
+		m_nodes.resize(2 * boxes.size() - 1);
+		proxies.resize(boxes.size());
+
+		this->buildNode(0, NULL_NODE, objects.data(), objects.data() + objects.size(), boxes, data, proxies);
+
+		m_root = 0;
+		m_count = static_cast<int>(boxes.size());
+	}
+
+	////////////////////////////////////////////////////////////
+	void BoundingVolumeHierarchy::clear()
+	{
+		m_nodes.clear();
+		m_root = NULL_NODE;
+		m_free = NULL_NODE;
+		m_count = 0;
+	}
+
+	////////////////////////////////////////////////////////////
+	void BoundingVolumeHierarchy::query(const BoundingBox& box, std::vector<int>& results) const
+	{
+		std::vector<int> stack;
+		if (m_root != NULL_NODE)
+		{
+			stack.push_back(m_root);
+		}
+
+		while (!stack.empty())
+		{
+			const Node_t& node = m_nodes[stack.back()];
+			int index = stack.back();
+			stack.pop_back();
+
+			if (!node.box.intersects(box))
+			{
+				continue;
+			}
+
+			if (node.isLeaf())
+			{
+				results.push_back(index);
+			}
+			else
+			{
+				stack.push_back(node.left);
+				stack.push_back(node.right);
+			}
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void BoundingVolumeHierarchy::query(const BoundingSphere& sphere, std::vector<int>& results) const
+	{
+		std::vector<int> stack;
+		if (m_root != NULL_NODE && sphere.isValid())
+		{
+			stack.push_back(m_root);
+		}
+
+		while (!stack.empty())
+		{
+			const Node_t& node = m_nodes[stack.back()];
+			int index = stack.back();
+			stack.pop_back();
+
+			// The distance from the centre to the closest point of the box.
+			Vector3f closest = Vector3f::maximum(node.box.minimum, Vector3f::minimum(sphere.centre, node.box.maximum));
+			if (Vector3f::distanceSqr(closest, sphere.centre) > sphere.radius * sphere.radius)
+			{
+				continue;
+			}
+
+			if (node.isLeaf())
+			{
+				results.push_back(index);
+			}
+			else
+			{
+				stack.push_back(node.left);
+				stack.push_back(node.right);
+			}
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void BoundingVolumeHierarchy::query(const Frustum& frustum, std::vector<int>& results) const
+	{
+		std::vector<int> stack;
+		if (m_root != NULL_NODE)
+		{
+			stack.push_back(m_root);
+		}
+
+		while (!stack.empty())
+		{
+			const Node_t& node = m_nodes[stack.back()];
+			int index = stack.back();
+			stack.pop_back();
+
+			if (!frustum.intersects(node.box))
+			{
+				continue;
+			}
+
+			if (node.isLeaf())
+			{
+				results.push_back(index);
+			}
+			else
+			{
+				stack.push_back(node.left);
+				stack.push_back(node.right);
+			}
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void BoundingVolumeHierarchy::query(const Ray& ray, float maxDistance, std::vector<int>& results) const
+	{
+		std::vector<int> stack;
+		if (m_root != NULL_NODE)
+		{
+			stack.push_back(m_root);
+		}
+
+		while (!stack.empty())
+		{
+			const Node_t& node = m_nodes[stack.back()];
+			int index = stack.back();
+			stack.pop_back();
+
+			float distance;
+			if (!ray.intersects(node.box, distance) || distance > maxDistance)
+			{
+				continue;
+			}
+
+			if (node.isLeaf())
+			{
+				results.push_back(index);
+			}
+			else
+			{
+				stack.push_back(node.left);
+				stack.push_back(node.right);
+			}
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	int BoundingVolumeHierarchy::raycast(const Ray& ray, float maxDistance, float& distance) const
+	{
+		int nearest = NULL_NODE;
+		distance = maxDistance;
+
+		std::vector<int> stack;
+		if (m_root != NULL_NODE)
+		{
+			stack.push_back(m_root);
+		}
+
+		while (!stack.empty())
+		{
+			const Node_t& node = m_nodes[stack.back()];
+			int index = stack.back();
+			stack.pop_back();
+
+			// Nodes further than the nearest hit so far cannot contain a nearer hit.
+			float hit;
+			if (!ray.intersects(node.box, hit) || hit > distance)
+			{
+				continue;
+			}
+
+			if (node.isLeaf())
+			{
+				nearest = index;
+				distance = hit;
+			}
+			else
+			{
+				stack.push_back(node.left);
+				stack.push_back(node.right);
+			}
+		}
+
+		return nearest;
+	}
+
+} // namespace jackal
@@ -25,6 +25,7 @@
 //====================
 // C++ includes
 //====================
+#include <filesystem>                   // Checking the existence of files on other platforms.
 #include <vector>                       // Storing subsequent extensions of file.
 
 //====================
@@ -50,8 +51,10 @@ namespace jackal
 #ifdef WIN32
 		DWORD result = GetFileAttributes(filename.c_str());
 		return !(result == INVALID_FILE_ATTRIBUTES && GetLastError() == ERROR_FILE_NOT_FOUND);
+#else
+		std::error_code error;
+		return std::filesystem::exists(filename, error);
 #endif
-		return false;
 	}
 
 	////////////////////////////////////////////////////////////
@@ -0,0 +1,308 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//====================
+// C++ includes
+//====================
+#include <algorithm>  // Finding the next pending change to settle.
+#include <filesystem> // Normalising paths and checking write times.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/utils/file_watcher.hpp>       // FileWatcher class declaration.
+#include <jackal/core/virtual_file_system.hpp> // Resolving virtual paths.
+#include <jackal/utils/log.hpp>                // Logging failures to watch files.
+
+//====================
+// Additional includes
+//====================
+#ifdef __linux__
+#include <poll.h>        // Sleeping until a change is reported.
+#include <sys/inotify.h> // Watching the directories of each file.
+#include <unistd.h>      // Reading events and the wake pipe.
+#endif
+
+namespace jackal
+{
+	//====================
+	// Local variables
+	//====================
+	static DebugLog log("logs/engine_log.txt");
+
+	//====================
+	// Ctor and dtor
+	//====================
+	////////////////////////////////////////////////////////////
+	FileWatcher::FileWatcher()
+		: NonCopyable(), m_files(), m_directories(), m_pending(), m_changes(), m_debounce(100), m_mutex(), m_thread(), m_running(false),
+		  m_descriptor(-1), m_wake{ -1, -1 }
+	{
+	}
+
+	////////////////////////////////////////////////////////////
+	FileWatcher::~FileWatcher()
+	{
+		this->destroy();
+	}
+
+	//====================
+	// Private methods
+	//====================
+#ifdef __linux__
+	////////////////////////////////////////////////////////////
+	void FileWatcher::listen()
+	{
+		// Large enough for many events, each name is at most NAME_MAX bytes.
+		alignas(inotify_event) char buffer[16 * 1024];
+
+		while (m_running)
+		{
+			int timeout = -1;
+			{
+				std::lock_guard<std::mutex> guard(m_mutex);
+
+				// Sleep until the oldest pending change has settled, or forever when nothing is pending.
+				auto now = Clock::now();
+				for (const auto& pending : m_pending)
+				{
+					auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(pending.second + m_debounce - now).count();
+					int wait = static_cast<int>(std::max<long long>(remaining, 0));
+
+					timeout = timeout < 0 ? wait : std::min(timeout, wait);
+				}
+			}
+
+			pollfd descriptors[2] = { { m_descriptor, POLLIN, 0 }, { m_wake[0], POLLIN, 0 } };
+			if (poll(descriptors, 2, timeout) < 0)
+			{
+				continue;
+			}
+
+			std::lock_guard<std::mutex> guard(m_mutex);
+			auto now = Clock::now();
+
+			if (descriptors[0].revents & POLLIN)
+			{
+				ssize_t length = read(m_descriptor, buffer, sizeof(buffer));
+				for (ssize_t offset = 0; offset < length;)
+				{
+					const inotify_event* pEvent = reinterpret_cast<const inotify_event*>(buffer + offset);
+					offset += sizeof(inotify_event) + pEvent->len;
+
+					auto itr = m_directories.find(pEvent->wd);
+					if (pEvent->len == 0 || itr == m_directories.end())
+					{
+						continue;
+					}
+
+					std::string path = itr->second + '/' + pEvent->name;
+					if (m_files.count(path))
+					{
+						m_pending[path] = now;
+					}
+				}
+			}
+
+			for (auto itr = m_pending.begin(); itr != m_pending.end();)
+			{
+				if (now - itr->second >= m_debounce)
+				{
+					m_changes.push_back(itr->first);
+					itr = m_pending.erase(itr);
+				}
+				else
+				{
+					++itr;
+				}
+			}
+		}
+	}
+#else
+	////////////////////////////////////////////////////////////
+	void FileWatcher::listen()
+	{
+		using namespace std::chrono_literals;
+		std::unordered_map<std::string, std::filesystem::file_time_type> times;
+
+		while (m_running)
+		{
+			std::unordered_set<std::string> files;
+			{
+				std::lock_guard<std::mutex> guard(m_mutex);
+				files = m_files;
+			}
+
+			std::vector<std::string> changes;
+			for (const auto& file : files)
+			{
+				std::error_code error;
+				auto time = std::filesystem::last_write_time(file, error);
+
+				auto itr = times.find(file);
+				if (itr != times.end() && !error && itr->second < time)
+				{
+					changes.push_back(file);
+				}
+
+				times[file] = time;
+			}
+
+			{
+				std::lock_guard<std::mutex> guard(m_mutex);
+				m_changes.insert(m_changes.end(), changes.begin(), changes.end());
+			}
+
+			std::this_thread::sleep_for(1s);
+		}
+	}
+#endif
+
+	//====================
+	// Getters and setters
+	//====================
+	////////////////////////////////////////////////////////////
+	std::vector<std::string> FileWatcher::getChanges()
+	{
+		std::vector<std::string> changes;
+
+		std::lock_guard<std::mutex> guard(m_mutex);
+		changes.swap(m_changes);
+
+		return changes;
+	}
+
+	//====================
+	// Methods
+	//====================
+	////////////////////////////////////////////////////////////
+	bool FileWatcher::create(unsigned int debounce/*= 100*/)
+	{
+		if (m_running)
+		{
+			log.warning(log.function(__FUNCTION__, debounce), "Already created.");
+			return true;
+		}
+
+		m_debounce = std::chrono::milliseconds(debounce);
+
+#ifdef __linux__
+		m_descriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (m_descriptor < 0 || pipe(m_wake) != 0)
+		{
+			log.warning(log.function(__FUNCTION__, debounce), "Failed to create the inotify instance.");
+			this->destroy();
+
+			return false;
+		}
+#endif
+
+		m_running = true;
+		m_thread = std::thread(&FileWatcher::listen, this);
+
+		return true;
+	}
+
+	////////////////////////////////////////////////////////////
+	void FileWatcher::destroy()
+	{
+		if (m_running)
+		{
+			m_running = false;
+
+#ifdef __linux__
+			// Wake the thread from poll, it would otherwise sleep until the next change.
+			char wake = 0;
+			ssize_t written = write(m_wake[1], &wake, 1);
+			static_cast<void>(written);
+#endif
+			m_thread.join();
+		}
+
+#ifdef __linux__
+		for (int* pDescriptor : { &m_descriptor, &m_wake[0], &m_wake[1] })
+		{
+			if (*pDescriptor >= 0)
+			{
+				close(*pDescriptor);
+				*pDescriptor = -1;
+			}
+		}
+#endif
+
+		std::lock_guard<std::mutex> guard(m_mutex);
+		m_files.clear();
+		m_directories.clear();
+		m_pending.clear();
+		m_changes.clear();
+	}
+
+	////////////////////////////////////////////////////////////
+	bool FileWatcher::watch(const std::string& filename)
+	{
+		if (!m_running || filename.empty())
+		{
+			return false;
+		}
+
+		std::lock_guard<std::mutex> guard(m_mutex);
+		if (m_files.count(filename))
+		{
+			return true;
+		}
+
+#ifdef __linux__
+		std::string directory = std::filesystem::path(filename).parent_path().string();
+
+		// Watching a directory twice returns the existing descriptor.
+		int watch = inotify_add_watch(m_descriptor, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+		if (watch < 0)
+		{
+			log.warning(log.function(__FUNCTION__, filename), "Failed to watch the directory of the file.");
+			return false;
+		}
+
+		m_directories[watch] = directory;
+#endif
+
+		m_files.insert(filename);
+		return true;
+	}
+
+	////////////////////////////////////////////////////////////
+	std::string FileWatcher::resolve(const std::string& filename)
+	{
+		std::string path;
+		if (!VirtualFileSystem::getInstance().resolve(filename, path) || path.empty())
+		{
+			return std::string();
+		}
+
+		std::error_code error;
+		std::filesystem::path absolute = std::filesystem::absolute(path, error);
+
+		return error ? std::string() : absolute.lexically_normal().string();
+	}
+
+} // namespace jackal
@@ -0,0 +1,141 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//====================
+// C++ includes
+//====================
+#include <algorithm>                     // Sorting the frame times.
+#include <fstream>                       // Writing the csv file.
+#include <numeric>                       // Summing the frame times.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/utils/frame_timer.hpp>  // FrameTimer class declaration.
+#include <jackal/utils/log.hpp>          // Logging warnings and errors.
+
+namespace jackal
+{
+	//====================
+	// Local variables
+	//====================
+	static DebugLog log("logs/engine_log.txt");
+
+	//====================
+	// Ctor and dtor
+	//====================
+	////////////////////////////////////////////////////////////
+	FrameStatistics_t::FrameStatistics_t()
+		: frames(0), minimum(0.0), average(0.0), median(0.0), p95(0.0), p99(0.0), maximum(0.0)
+	{
+	}
+
+	////////////////////////////////////////////////////////////
+	FrameTimer::FrameTimer()
+		: m_times(), m_last(), m_started(false)
+	{
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	////////////////////////////////////////////////////////////
+	std::size_t FrameTimer::getCount() const
+	{
+		return m_times.size();
+	}
+
+	////////////////////////////////////////////////////////////
+	FrameStatistics_t FrameTimer::getStatistics() const
+	{
+		FrameStatistics_t statistics;
+		if (m_times.empty())
+		{
+			return statistics;
+		}
+
+		std::vector<double> sorted(m_times);
+		std::sort(sorted.begin(), sorted.end());
+
+		auto percentile = [&sorted](double p) {
+			std::size_t rank = static_cast<std::size_t>(p * (sorted.size() - 1) + 0.5);
+			return sorted[rank];
+		};
+
+		statistics.frames = sorted.size();
+		statistics.minimum = sorted.front();
+		statistics.average = std::accumulate(sorted.begin(), sorted.end(), 0.0) / sorted.size();
+		statistics.median = percentile(0.5);
+		statistics.p95 = percentile(0.95);
+		statistics.p99 = percentile(0.99);
+		statistics.maximum = sorted.back();
+
+		return statistics;
+	}
+
+	//====================
+	// Methods
+	//====================
+	////////////////////////////////////////////////////////////
+	void FrameTimer::reset(std::size_t reserve /*= 0*/)
+	{
+		m_times.clear();
+		m_times.reserve(reserve);
+		m_started = false;
+	}
+
+	////////////////////////////////////////////////////////////
+	void FrameTimer::tick()
+	{
+		auto now = std::chrono::steady_clock::now();
+
+		if (m_started)
+		{
+			m_times.push_back(std::chrono::duration<double, std::milli>(now - m_last).count());
+		}
+
+		m_last = now;
+		m_started = true;
+	}
+
+	////////////////////////////////////////////////////////////
+	bool FrameTimer::writeCSV(const std::string& filename) const
+	{
+		std::ofstream file(filename, std::ios::out | std::ios::trunc);
+		if (!file.is_open())
+		{
+			log.warning(log.function(__FUNCTION__, filename), "Failed to open the csv file.");
+			return false;
+		}
+
+		file << "frame,milliseconds\n";
+		for (std::size_t i = 0; i < m_times.size(); ++i)
+		{
+			file << i << "," << m_times[i] << "\n";
+		}
+
+		return true;
+	}
+
+} // namespace jackal
@@ -0,0 +1,180 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//====================
+// C++ includes
+//====================
+#include <fstream>                             // Reading the file when mapping is unsupported.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/utils/mapped_file.hpp>        // MappedFile class declaration.
+#include <jackal/core/virtual_file_system.hpp> // Resolving virtual paths.
+#include <jackal/utils/log.hpp>                // Logging failures to map files.
+
+//====================
+// Additional includes
+//====================
+#ifdef __linux__
+#include <fcntl.h>    // Opening the file descriptor.
+#include <sys/mman.h> // Mapping the file into memory.
+#include <sys/stat.h> // Retrieving the size of the file.
+#include <unistd.h>   // Closing the file descriptor.
+#endif
+
+namespace jackal
+{
+	//====================
+	// Local variables
+	//====================
+	static DebugLog log("logs/engine_log.txt");
+
+	//====================
+	// Ctor and dtor
+	//====================
+	////////////////////////////////////////////////////////////
+	MappedFile::MappedFile()
+		: NonCopyable(), m_pData(nullptr), m_size(0), m_mapped(false), m_contents()
+	{
+	}
+
+	////////////////////////////////////////////////////////////
+	MappedFile::~MappedFile()
+	{
+		this->close();
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	////////////////////////////////////////////////////////////
+	const unsigned char* MappedFile::getData() const
+	{
+		return m_pData;
+	}
+
+	////////////////////////////////////////////////////////////
+	std::size_t MappedFile::getSize() const
+	{
+		return m_size;
+	}
+
+	////////////////////////////////////////////////////////////
+	bool MappedFile::isOpen() const
+	{
+		return m_pData != nullptr;
+	}
+
+	//====================
+	// Methods
+	//====================
+	////////////////////////////////////////////////////////////
+	bool MappedFile::open(const std::string& filename)
+	{
+		this->close();
+
+		std::string path;
+		if (!VirtualFileSystem::getInstance().resolve(filename, path))
+		{
+			log.warning(log.function(__FUNCTION__, filename), "Failed. Could not find file.");
+			return false;
+		}
+
+#ifdef __linux__
+		int descriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (descriptor < 0)
+		{
+			log.warning(log.function(__FUNCTION__, filename), "Failed to open file.");
+			return false;
+		}
+
+		struct stat status;
+		if (fstat(descriptor, &status) != 0 || status.st_size <= 0)
+		{
+			log.warning(log.function(__FUNCTION__, filename), "Failed to map an empty file.");
+			::close(descriptor);
+
+			return false;
+		}
+
+		void* pMemory = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+
+		// The mapping keeps its own reference to the file.
+		::close(descriptor);
+
+		if (pMemory == MAP_FAILED)
+		{
+			log.warning(log.function(__FUNCTION__, filename), "Failed to map file.");
+			return false;
+		}
+
+		m_pData = static_cast<const unsigned char*>(pMemory);
+		m_size = static_cast<std::size_t>(status.st_size);
+		m_mapped = true;
+#else
+		std::ifstream file(path, std::ios::in | std::ios::binary | std::ios::ate);
+		if (!file.is_open() || file.tellg() <= 0)
+		{
+			log.warning(log.function(__FUNCTION__, filename), "Failed to read file.");
+			return false;
+		}
+
+		m_contents.resize(static_cast<std::size_t>(file.tellg()));
+		file.seekg(0);
+
+		if (!file.read(reinterpret_cast<char*>(m_contents.data()), m_contents.size()))
+		{
+			log.warning(log.function(__FUNCTION__, filename), "Failed to read file.");
+			m_contents.clear();
+
+			return false;
+		}
+
+		m_pData = m_contents.data();
+		m_size = m_contents.size();
+#endif
+
+		return true;
+	}
+
+	////////////////////////////////////////////////////////////
+	void MappedFile::close()
+	{
+#ifdef __linux__
+		if (m_mapped)
+		{
+			munmap(const_cast<unsigned char*>(m_pData), m_size);
+		}
+#endif
+
+		m_pData = nullptr;
+		m_size = 0;
+		m_mapped = false;
+
+		m_contents.clear();
+		m_contents.shrink_to_fit();
+	}
+
+} // namespace jackal
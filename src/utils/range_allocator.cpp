@@ -0,0 +1,174 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//====================
+// C++ includes
+//====================
+#include <algorithm>                         // Finding the insertion point of freed blocks.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/utils/range_allocator.hpp> // RangeAllocator class declaration.
+
+namespace jackal
+{
+	//====================
+	// Ctor and dtor
+	//====================
+	////////////////////////////////////////////////////////////
+	RangeAllocator::RangeAllocator()
+		: m_capacity(0), m_used(0), m_free()
+	{
+	}
+
+	////////////////////////////////////////////////////////////
+	RangeAllocator::RangeAllocator(int capacity)
+		: m_capacity(0), m_used(0), m_free()
+	{
+		this->reset(capacity);
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	////////////////////////////////////////////////////////////
+	int RangeAllocator::getCapacity() const
+	{
+		return m_capacity;
+	}
+
+	////////////////////////////////////////////////////////////
+	int RangeAllocator::getUsed() const
+	{
+		return m_used;
+	}
+
+	////////////////////////////////////////////////////////////
+	int RangeAllocator::getLargestBlock() const
+	{
+		int largest = 0;
+		for (const auto& block : m_free)
+		{
+			largest = std::max(largest, block.count);
+		}
+
+		return largest;
+	}
+
+	//====================
+	// Methods
+	//====================
+	////////////////////////////////////////////////////////////
+	void RangeAllocator::reset(int capacity)
+	{
+		m_capacity = capacity;
+		m_used = 0;
+		m_free.clear();
+
+		if (capacity > 0)
+		{
+			m_free.push_back({ 0, capacity });
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	bool RangeAllocator::allocate(int count, int& offset, int alignment /*= 1*/)
+	{
+		if (count <= 0)
+		{
+			return false;
+		}
+
+		for (std::size_t i = 0; i < m_free.size(); i++)
+		{
+			Block_t block = m_free[i];
+
+			int aligned = ((block.offset + alignment - 1) / alignment) * alignment;
+			int padding = aligned - block.offset;
+
+			if (block.count < count + padding)
+			{
+				continue;
+			}
+
+			m_free.erase(std::begin(m_free) + i);
+
+			// Keep whatever remains either side of the range in the free list.
+			int remaining = block.count - count - padding;
+			if (remaining > 0)
+			{
+				m_free.insert(std::begin(m_free) + i, { aligned + count, remaining });
+			}
+
+			if (padding > 0)
+			{
+				m_free.insert(std::begin(m_free) + i, { block.offset, padding });
+			}
+
+			offset = aligned;
+			m_used += count;
+
+			return true;
+		}
+
+		return false;
+	}
+
+	////////////////////////////////////////////////////////////
+	void RangeAllocator::free(int offset, int count)
+	{
+		if (count <= 0)
+		{
+			return;
+		}
+
+		auto it = std::lower_bound(std::begin(m_free), std::end(m_free), offset, [](const Block_t& block, int value) {
+			return block.offset < value;
+		});
+
+		it = m_free.insert(it, { offset, count });
+		m_used -= count;
+
+		// Merge with the following block.
+		auto next = it + 1;
+		if (next != std::end(m_free) && it->offset + it->count == next->offset)
+		{
+			it->count += next->count;
+			m_free.erase(next);
+		}
+
+		// Merge with the preceding block.
+		if (it != std::begin(m_free))
+		{
+			auto prev = it - 1;
+			if (prev->offset + prev->count == it->offset)
+			{
+				prev->count += it->count;
+				m_free.erase(it);
+			}
+		}
+	}
+
+} // namespace jackal
@@ -68,4 +68,16 @@ namespace jackal
 		--m_references;
 	}
 
+	////////////////////////////////////////////////////////////
+	bool Resource::prepare(const std::string& filename)
+	{
+		return true;
+	}
+
+	////////////////////////////////////////////////////////////
+	bool Resource::hasPendingDependencies() const
+	{
+		return false;
+	}
+
 } // namespace jackal
\ No newline at end of file
@@ -25,32 +25,41 @@
 //====================
 // C++ includes
 //====================
-#include <filesystem>                         // C++17 file system reading.
+#include <chrono> // Polling the resources being prepared.
 
 //====================
 // Jackal includes
 //====================
-#include <jackal/utils/resource_manager.hpp>  // ResourceManager class declaration.
+#include <jackal/utils/resource_manager.hpp>   // ResourceManager class declaration.
+#include <jackal/rendering/render_thread.hpp> // Loading OpenGL resources on the render thread.
+#include <jackal/utils/thread_pool.hpp>       // Preparing the resources loaded in the background.
+#include <jackal/utils/log.hpp>               // Logging the resources that fail to load.
+#include <jackal/utils/constants.hpp>         // Using the constant log location.
 
 namespace jackal
 {
+	//====================
+	// Local variables
+	//====================
+	static DebugLog log("logs/engine_log.txt");
+
+	//====================
+	// Static variables
+	//====================
+	const int ResourceManager::LOADS_PER_FRAME;
+
 	//====================
 	// Ctor and dtor
 	//====================
 	////////////////////////////////////////////////////////////
-#if _DEBUG
 	ResourceManager::ResourceManager()
 		: Singleton<ResourceManager>(), m_materials(), m_shaders(), m_textures(), m_models(), m_scripts(),
-			m_timeStamps(), m_changedShaders(), m_listening(true), m_mutex(), 
-				m_listener(&ResourceManager::fileChangeListener, this)
-	{
-	}
-#else
-	ResourceManager::ResourceManager()
-		: Singleton<ResourceManager>(), m_materials(), m_shaders(), m_textures(), m_models(), m_scripts()
+			m_dependents(), m_watched(), m_mutex(), m_watcher(), m_loads(), m_loadMutex()
 	{
-	}
+#if _DEBUG
+		m_watcher.create();
 #endif
+	}
 
 	//====================
 	// Getters and setters
@@ -59,71 +68,288 @@ namespace jackal
 	template <>
 	ResourceHandle<Material> ResourceManager::get(const std::string& filename)
 	{
-		return ResourceHandle<Material>(m_materials.get(filename));
+		Material* pResource = nullptr;
+		RenderThread::getInstance().invoke([this, &pResource, &filename]() {
+			pResource = m_materials.get(filename);
+		});
+
+		if (pResource)
+		{
+			this->watchResource(pResource, filename);
+		}
+
+		return ResourceHandle<Material>(pResource);
 	}
 
 	////////////////////////////////////////////////////////////
 	template <>
 	ResourceHandle<Shader> ResourceManager::get(const std::string& filename)
 	{
-		return ResourceHandle<Shader>(m_shaders.get(filename));
+		Shader* pResource = nullptr;
+		RenderThread::getInstance().invoke([this, &pResource, &filename]() {
+			pResource = m_shaders.get(filename);
+		});
+
+		if (pResource)
+		{
+			this->watchResource(pResource, filename);
+		}
+
+		return ResourceHandle<Shader>(pResource);
 	}
 
 	////////////////////////////////////////////////////////////
 	template <>
 	ResourceHandle<Texture> ResourceManager::get(const std::string& filename)
 	{
-		return ResourceHandle<Texture>(m_textures.get(filename));
+		Texture* pResource = nullptr;
+		RenderThread::getInstance().invoke([this, &pResource, &filename]() {
+			pResource = m_textures.get(filename);
+		});
+
+		if (pResource)
+		{
+			this->watchResource(pResource, filename);
+		}
+
+		return ResourceHandle<Texture>(pResource);
 	}
 
 	////////////////////////////////////////////////////////////
 	template <>
 	ResourceHandle<Model> ResourceManager::get(const std::string& filename)
 	{
-		return ResourceHandle<Model>(m_models.get(filename));
+		Model* pResource = nullptr;
+		RenderThread::getInstance().invoke([this, &pResource, &filename]() {
+			pResource = m_models.get(filename);
+		});
+
+		return ResourceHandle<Model>(pResource);
 	}
 
 	////////////////////////////////////////////////////////////
 	template <>
 	ResourceHandle<Script> ResourceManager::get(const std::string& filename)
 	{
-		return ResourceHandle<Script>(m_scripts.get(filename));
+		Script* pResource = m_scripts.get(filename);
+
+		if (pResource)
+		{
+			this->watchResource("script:" + filename, { filename }, [pResource, filename]() {
+				pResource->load(filename);
+			});
+		}
+
+		return ResourceHandle<Script>(pResource);
+	}
+
+	////////////////////////////////////////////////////////////
+	template <>
+	AsyncHandle<Material> ResourceManager::getAsync(const std::string& filename)
+	{
+		return this->queueLoad<Material>(m_materials, "material:", filename, [this, filename](Material* pResource) {
+			this->watchResource(pResource, filename);
+		});
+	}
+
+	////////////////////////////////////////////////////////////
+	template <>
+	AsyncHandle<Shader> ResourceManager::getAsync(const std::string& filename)
+	{
+		return this->queueLoad<Shader>(m_shaders, "shader:", filename, [this, filename](Shader* pResource) {
+			this->watchResource(pResource, filename);
+		});
+	}
+
+	////////////////////////////////////////////////////////////
+	template <>
+	AsyncHandle<Texture> ResourceManager::getAsync(const std::string& filename)
+	{
+		return this->queueLoad<Texture>(m_textures, "texture:", filename, [this, filename](Texture* pResource) {
+			this->watchResource(pResource, filename);
+		});
+	}
+
+	////////////////////////////////////////////////////////////
+	template <>
+	AsyncHandle<Model> ResourceManager::getAsync(const std::string& filename)
+	{
+		return this->queueLoad<Model>(m_models, "model:", filename, nullptr);
 	}
 
 	//====================
 	// Private methods
 	//====================
 	////////////////////////////////////////////////////////////
-#if _DEBUG
-	void ResourceManager::fileChangeListener()
+	void ResourceManager::watchResource(const std::string& name, const std::vector<std::string>& files, const std::function<void()>& reload)
+	{
+		{
+			std::lock_guard<std::mutex> guard(m_mutex);
+			if (!m_watched.insert(name).second)
+			{
+				return;
+			}
+		}
+
+		for (const auto& file : files)
+		{
+			this->watch(file, reload);
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void ResourceManager::watchResource(Material* pResource, const std::string& filename)
+	{
+		this->watchResource("material:" + filename, { filename }, [pResource, filename]() {
+			RenderThread::getInstance().invoke([pResource, &filename]() {
+				pResource->load(filename);
+			});
+		});
+	}
+
+	////////////////////////////////////////////////////////////
+	void ResourceManager::watchResource(Shader* pResource, const std::string& filename)
+	{
+		std::vector<std::string> files = { pResource->getFilename() };
+		for (const auto& object : pResource->getShaders())
+		{
+			files.push_back(object.getFilename());
+		}
+
+		this->watchResource("shader:" + filename, files, [pResource]() {
+			RenderThread::getInstance().invoke([pResource]() {
+				pResource->recompile();
+			});
+		});
+	}
+
+	////////////////////////////////////////////////////////////
+	void ResourceManager::watchResource(Texture* pResource, const std::string& filename)
+	{
+		this->watchResource("texture:" + filename, { filename, pResource->getImage() }, [pResource, filename]() {
+			RenderThread::getInstance().invoke([pResource, &filename]() {
+				pResource->load(filename);
+			});
+		});
+	}
+
+	////////////////////////////////////////////////////////////
+	template <typename T>
+	AsyncHandle<T> ResourceManager::queueLoad(ResourceCache<T>& cache, const std::string& type, const std::string& filename,
+		const std::function<void(T*)>& loaded)
 	{
-		namespace fs = std::experimental::filesystem;
-		using namespace std::chrono_literals;
+		std::lock_guard<std::mutex> guard(m_loadMutex);
 
-		while (m_listening)
+		// Requesting the same resource again, e.g. a texture shared by several materials, shares the load.
+		for (const auto& load : m_loads)
 		{
-			for (const auto& shader : m_shaders.getResources())
+			if (load.name == type + filename)
 			{
-				TimeArray& array = m_timeStamps[shader.first];
-				auto& objects = shader.second->getShaders();
+				return AsyncHandle<T>(load.pState);
+			}
+		}
 
-				int index = 0;
-				for (const auto& object : objects)
-				{
-					auto time = fs::last_write_time(fs::path(object.getFilename())).time_since_epoch().count();
-					int64_t timeStamp = array[index];
+		AsyncLoad_t load;
+		load.pState = std::make_shared<AsyncState_t>();
+		load.name = type + filename;
+		load.filename = filename;
+		load.pResource = nullptr;
+
+		// The caches are only accessed on the render thread, so these are never invoked elsewhere.
+		load.find = [&cache, filename]() -> Resource* {
+			return cache.find(filename);
+		};
+
+		load.create = []() -> Resource* {
+			return new T();
+		};
 
-					if (timeStamp != 0 && timeStamp < time)
+		load.store = [&cache, filename, loaded](Resource* pResource) -> Resource* {
+			T* pCached = cache.insert(filename, static_cast<T*>(pResource));
+			if (loaded)
+			{
+				loaded(pCached);
+			}
+
+			return pCached;
+		};
+
+		AsyncHandle<T> handle(load.pState);
+		m_loads.push_back(std::move(load));
+
+		return handle;
+	}
+
+	////////////////////////////////////////////////////////////
+	void ResourceManager::processLoads()
+	{
+		std::vector<AsyncLoad_t> prepared;
+		{
+			std::lock_guard<std::mutex> guard(m_loadMutex);
+			for (auto itr = m_loads.begin(); itr != m_loads.end();)
+			{
+				// Resources are constructed on the render thread, as textures and shaders create their objects straight away.
+				if (!itr->pResource)
+				{
+					if (Resource* pCached = itr->find())
 					{
-						m_changedShaders.push_back(shader.second);
+						itr->pState->resource = ResourceHandle<Resource>(pCached);
+						itr->pState->state = eResourceState::READY;
+						itr = m_loads.erase(itr);
+						continue;
 					}
-					array[index] = time;
-					index++;
+
+					Resource* pResource = itr->pResource = itr->create();
+					std::shared_ptr<AsyncState_t> pState = itr->pState;
+					std::string filename = itr->filename;
+
+					itr->prepared = ThreadPool::getInstance().submit([pResource, pState, filename]() {
+						if (!pResource->prepare(filename))
+						{
+							pState->state = eResourceState::FAILED;
+						}
+					});
+
+					++itr;
+					continue;
+				}
+
+				bool ready = itr->prepared.wait_for(std::chrono::seconds(0)) == std::future_status::ready &&
+					(itr->pState->state == eResourceState::FAILED || !itr->pResource->hasPendingDependencies());
+
+				if (ready && prepared.size() < static_cast<std::size_t>(LOADS_PER_FRAME))
+				{
+					prepared.push_back(std::move(*itr));
+					itr = m_loads.erase(itr);
+				}
+				else
+				{
+					++itr;
 				}
 			}
+		}
 
-			std::this_thread::sleep_for(1s);
+		// Loading may retrieve other resources, so the loads are finished without the lock.
+		for (auto& load : prepared)
+		{
+			this->finishLoad(load);
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void ResourceManager::finishLoad(AsyncLoad_t& load)
+	{
+		if (load.pState->state != eResourceState::FAILED && load.pResource->load(load.filename))
+		{
+			// The resource must be stored before the state is set, the handles only read it once the load is ready.
+			load.pState->resource = ResourceHandle<Resource>(load.store(load.pResource));
+			load.pState->state = eResourceState::READY;
+			return;
 		}
+
+		log.warning(log.function(__FUNCTION__, load.filename), "Failed to load resource in the background.");
+		delete load.pResource;
+		load.pState->state = eResourceState::FAILED;
 	}
 
 	//====================
@@ -132,28 +358,82 @@ namespace jackal
 	////////////////////////////////////////////////////////////
 	void ResourceManager::reload()
 	{
-		std::lock_guard<std::mutex> guard(m_mutex);
-		for (auto& shader : m_changedShaders)
+		ReloadList callbacks;
 		{
-			shader->recompile();
+			std::lock_guard<std::mutex> guard(m_mutex);
+			for (const auto& file : m_watcher.getChanges())
+			{
+				auto itr = m_dependents.find(file);
+				if (itr != m_dependents.end())
+				{
+					callbacks.insert(callbacks.end(), itr->second.begin(), itr->second.end());
+				}
+			}
 		}
 
-		m_changedShaders.clear();
+		// The callbacks are invoked without the lock, reloading a resource may retrieve other resources.
+		for (const auto& callback : callbacks)
+		{
+			callback();
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void ResourceManager::update()
+	{
+		RenderThread::getInstance().enqueue([this]() {
+			this->processLoads();
+		});
+	}
+
+	////////////////////////////////////////////////////////////
+	bool ResourceManager::watch(const std::string& filename, const std::function<void()>& callback)
+	{
+		std::string path = FileWatcher::resolve(filename);
+		if (!m_watcher.watch(path))
+		{
+			return false;
+		}
+
+		std::lock_guard<std::mutex> guard(m_mutex);
+		m_dependents[path].push_back(callback);
+
+		return true;
 	}
-#endif
 
 	////////////////////////////////////////////////////////////
 	void ResourceManager::destroy()
 	{
+		m_watcher.destroy();
+
+		std::vector<AsyncLoad_t> loads;
+		{
+			std::lock_guard<std::mutex> guard(m_loadMutex);
+			loads = std::move(m_loads);
+			m_loads.clear();
+		}
+
+		// Preparing a resource may request other resources, so the workers are waited upon without the lock.
+		for (auto& load : loads)
+		{
+			if (load.prepared.valid())
+			{
+				load.prepared.wait();
+			}
+		}
+
+		RenderThread::getInstance().invoke([&loads]() {
+			for (auto& load : loads)
+			{
+				delete load.pResource;
+				load.pState->state = eResourceState::FAILED;
+			}
+		});
+
 		m_materials.empty();
 		m_shaders.empty();
 		m_textures.empty();
 		m_models.empty();
 		m_scripts.empty();
-
-#if _DEBUG
-		m_listening = false;
-		m_listener.join();
-#endif
 	}
 }
\ No newline at end of file
@@ -0,0 +1,190 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//====================
+// C++ includes
+//====================
+#include <algorithm>                    // Clamping the number of workers and chunks.
+#include <atomic>                       // Claiming the chunks of a parallel loop.
+#include <memory>                       // Sharing the state of a parallel loop with the workers.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/utils/thread_pool.hpp> // ThreadPool class declaration.
+
+namespace jackal
+{
+	//====================
+	// Ctor and dtor
+	//====================
+	////////////////////////////////////////////////////////////
+	ThreadPool::ThreadPool()
+		: Singleton<ThreadPool>(), m_workers(), m_tasks(), m_stopping(false), m_mutex(), m_condition()
+	{
+		unsigned int threads = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+		for (unsigned int i = 0; i < threads; ++i)
+		{
+			m_workers.emplace_back(&ThreadPool::run, this);
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	ThreadPool::~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> guard(m_mutex);
+			m_stopping = true;
+		}
+
+		m_condition.notify_all();
+
+		for (auto& worker : m_workers)
+		{
+			worker.join();
+		}
+	}
+
+	//====================
+	// Private methods
+	//====================
+	////////////////////////////////////////////////////////////
+	void ThreadPool::run()
+	{
+		while (true)
+		{
+			std::packaged_task<void()> task;
+
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_condition.wait(lock, [this]() { return m_stopping || !m_tasks.empty(); });
+
+				if (m_tasks.empty())
+				{
+					return;
+				}
+
+				task = std::move(m_tasks.front());
+				m_tasks.pop();
+			}
+
+			task();
+		}
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	////////////////////////////////////////////////////////////
+	std::size_t ThreadPool::getWorkerCount() const
+	{
+		return m_workers.size();
+	}
+
+	//====================
+	// Methods
+	//====================
+	////////////////////////////////////////////////////////////
+	std::future<void> ThreadPool::submit(std::function<void()> task)
+	{
+		std::packaged_task<void()> packaged(std::move(task));
+		std::future<void> future = packaged.get_future();
+
+		{
+			std::lock_guard<std::mutex> guard(m_mutex);
+			m_tasks.push(std::move(packaged));
+		}
+
+		m_condition.notify_one();
+		return future;
+	}
+
+	////////////////////////////////////////////////////////////
+	void ThreadPool::parallelFor(std::size_t count, std::size_t grain, const std::function<void(std::size_t, std::size_t)>& function)
+	{
+		if (count == 0)
+		{
+			return;
+		}
+
+		grain = std::max<std::size_t>(grain, 1);
+		std::size_t chunks = (count + grain - 1) / grain;
+
+		if (chunks == 1 || m_workers.empty())
+		{
+			function(0, count);
+			return;
+		}
+
+		struct Loop_t
+		{
+			std::function<void(std::size_t, std::size_t)> function;
+			std::size_t                                   count;
+			std::size_t                                   grain;
+			std::size_t                                   chunks;
+			std::atomic<std::size_t>                      next;
+			std::atomic<std::size_t>                      done;
+			std::mutex                                    mutex;
+			std::condition_variable                       condition;
+		};
+
+		auto pLoop = std::make_shared<Loop_t>();
+		pLoop->function = function;
+		pLoop->count = count;
+		pLoop->grain = grain;
+		pLoop->chunks = chunks;
+		pLoop->next = 0;
+		pLoop->done = 0;
+
+		// Claims chunks until none remain, helpers that start after the loop has finished do nothing.
+		auto execute = [](Loop_t& loop) {
+			std::size_t chunk;
+			while ((chunk = loop.next.fetch_add(1)) < loop.chunks)
+			{
+				std::size_t begin = chunk * loop.grain;
+				loop.function(begin, std::min(begin + loop.grain, loop.count));
+
+				if (loop.done.fetch_add(1) + 1 == loop.chunks)
+				{
+					std::lock_guard<std::mutex> guard(loop.mutex);
+					loop.condition.notify_all();
+				}
+			}
+		};
+
+		std::size_t helpers = std::min(m_workers.size(), chunks - 1);
+		for (std::size_t i = 0; i < helpers; ++i)
+		{
+			this->submit([pLoop, execute]() { execute(*pLoop); });
+		}
+
+		execute(*pLoop);
+
+		// Other threads may still be executing the chunks they claimed.
+		std::unique_lock<std::mutex> lock(pLoop->mutex);
+		pLoop->condition.wait(lock, [&pLoop]() { return pLoop->done == pLoop->chunks; });
+	}
+
+} // namespace jackal
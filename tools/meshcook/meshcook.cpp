@@ -0,0 +1,281 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//====================
+// C++ includes
+//====================
+#include <iostream> // Reporting usage and progress.
+#include <string>   // Parsing the command line.
+#include <vector>   // Storing the vertices and indices of every sub-mesh.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/rendering/mesh_file.hpp>       // Writing the .jmesh container.
+#include <jackal/rendering/mesh_optimiser.hpp>  // Reordering each sub-mesh for the vertex cache, overdraw and vertex fetch.
+#include <jackal/rendering/mesh_simplifier.hpp> // Generating the levels of detail of each sub-mesh.
+#include <jackal/rendering/geometry_heap.hpp>   // Reporting which sub-meshes are stored with 16-bit indices.
+#include <jackal/rendering/vertex_layout.hpp>   // Choosing the layout the vertices are stored with.
+
+//====================
+// Additional includes
+//====================
+#include <assimp/Importer.hpp>  // Importing the source model.
+#include <assimp/scene.h>       // Walking the nodes and meshes of the scene.
+#include <assimp/postprocess.h> // Triangulating the faces and flipping the uv's.
+
+using namespace jackal;
+
+////////////////////////////////////////////////////////////
+/// @brief Prints the usage of the tool.
+////////////////////////////////////////////////////////////
+static void printUsage()
+{
+	std::cout << "Usage: jackal_meshcook <input model> <output.jmesh> [options]\n"
+	          << "  Any format Assimp can import is accepted, the meshes are triangulated,\n"
+	          << "  optimised and stored in the layout Model uploads, one sub-mesh per mesh.\n"
+	          << "  By default the vertices are compressed: quantised positions, octahedral\n"
+	          << "  normals and half float uv's. Each sub-mesh is given up to "
+	          << MeshSimplifier::MAX_LODS << " levels of detail.\n"
+	          << "Options:\n"
+	          << "  --standard  Store the attributes as full precision floats.\n"
+	          << "  --tangents  Store the tangent of each vertex.\n"
+	          << "  --colours   Store the colour of each vertex.\n"
+	          << "  --no-lods   Store only the full detail sub-meshes.\n";
+}
+
+////////////////////////////////////////////////////////////
+/// @brief Appends a mesh of the scene as a sub-mesh.
+///
+/// The vertices are converted the same way Model::convert converts
+/// them, then the mesh is optimised and its cache efficiency before
+/// and after is reported. The indices of the levels of detail are
+/// appended after the indices of the full detail mesh.
+///
+/// @param pMesh     The mesh to append.
+/// @param lods      Whether to generate the levels of detail.
+/// @param vertices  The vertices of every sub-mesh.
+/// @param indices   The indices of every sub-mesh.
+/// @param meshes    The sub-mesh table.
+///
+////////////////////////////////////////////////////////////
+static void appendMesh(const aiMesh* pMesh, bool lods, std::vector<Vertex_t>& vertices, std::vector<GLuint>& indices,
+	std::vector<MeshFile::SubMesh_t>& meshes)
+{
+	std::vector<Vertex_t> meshVertices;
+	std::vector<GLuint> meshIndices;
+
+	for (unsigned int i = 0; i < pMesh->mNumVertices; ++i)
+	{
+		Vertex_t vertex;
+		vertex.position = Vector3f(pMesh->mVertices[i].x, pMesh->mVertices[i].y, pMesh->mVertices[i].z);
+
+		if (pMesh->mTextureCoords[0])
+		{
+			vertex.uv = Vector2f(pMesh->mTextureCoords[0][i].x, pMesh->mTextureCoords[0][i].y);
+		}
+
+		if (pMesh->mNormals)
+		{
+			vertex.normal = Vector3f(pMesh->mNormals[i].x, pMesh->mNormals[i].y, pMesh->mNormals[i].z);
+		}
+
+		if (pMesh->mTangents && pMesh->mBitangents)
+		{
+			Vector3f tangent(pMesh->mTangents[i].x, pMesh->mTangents[i].y, pMesh->mTangents[i].z);
+			Vector3f bitangent(pMesh->mBitangents[i].x, pMesh->mBitangents[i].y, pMesh->mBitangents[i].z);
+
+			float handedness = Vector3f::dot(Vector3f::cross(vertex.normal, tangent), bitangent) < 0.0f ? -1.0f : 1.0f;
+			vertex.tangent = Vector4f(tangent.x, tangent.y, tangent.z, handedness);
+		}
+
+		if (pMesh->mColors[0])
+		{
+			vertex.colour = Colour(pMesh->mColors[0][i].r, pMesh->mColors[0][i].g, pMesh->mColors[0][i].b, pMesh->mColors[0][i].a);
+		}
+
+		meshVertices.push_back(vertex);
+	}
+
+	// The indices stay relative to the first vertex of the sub-mesh, as each sub-mesh is allocated separately.
+	for (unsigned int i = 0; i < pMesh->mNumFaces; ++i)
+	{
+		const aiFace& face = pMesh->mFaces[i];
+		for (unsigned int j = 0; j < face.mNumIndices; ++j)
+		{
+			meshIndices.push_back(face.mIndices[j]);
+		}
+	}
+
+	MeshOptimiser::Statistics_t before = MeshOptimiser::analyse(meshIndices, meshVertices.size());
+	MeshOptimiser::optimise(meshVertices, meshIndices);
+	MeshOptimiser::Statistics_t after = MeshOptimiser::analyse(meshIndices, meshVertices.size());
+
+	std::cout << "  sub-mesh " << meshes.size() << ": " << meshVertices.size() << " vertices, " << meshIndices.size() / 3 << " triangles, "
+	          << (meshVertices.size() <= static_cast<std::size_t>(GeometryHeap::MAX_SHORT_VERTICES) ? "16" : "32") << "-bit indices, "
+	          << "ACMR " << before.acmr << " -> " << after.acmr << ", ATVR " << before.atvr << " -> " << after.atvr << "\n";
+
+	MeshFile::SubMesh_t mesh;
+	if (lods)
+	{
+		std::vector<GLuint> lodIndices;
+		MeshSimplifier::generateLods(meshVertices, meshIndices, lodIndices, mesh.lods);
+
+		std::cout << "    levels of detail:";
+		for (const auto& lod : mesh.lods)
+		{
+			std::cout << " " << lod.indexCount / 3 << " triangles (error " << lod.error << ")";
+		}
+
+		std::cout << "\n";
+		meshIndices.insert(meshIndices.end(), lodIndices.begin(), lodIndices.end());
+	}
+
+	mesh.firstVertex = static_cast<std::uint32_t>(vertices.size());
+	mesh.vertexCount = static_cast<std::uint32_t>(meshVertices.size());
+	mesh.firstIndex = static_cast<std::uint32_t>(indices.size());
+	mesh.indexCount = static_cast<std::uint32_t>(meshIndices.size());
+
+	vertices.insert(vertices.end(), meshVertices.begin(), meshVertices.end());
+	indices.insert(indices.end(), meshIndices.begin(), meshIndices.end());
+	meshes.push_back(mesh);
+}
+
+////////////////////////////////////////////////////////////
+/// @brief Appends the meshes of a node and its children.
+///
+/// The nodes are walked in the same order as Model::loadNode, so the
+/// sub-meshes keep the order of the meshes of an imported model.
+///
+/// @param pNode     The node to append.
+/// @param pScene    The imported scene.
+/// @param lods      Whether to generate the levels of detail.
+/// @param vertices  The vertices of every sub-mesh.
+/// @param indices   The indices of every sub-mesh.
+/// @param meshes    The sub-mesh table.
+///
+////////////////////////////////////////////////////////////
+static void appendNode(const aiNode* pNode, const aiScene* pScene, bool lods, std::vector<Vertex_t>& vertices,
+	std::vector<GLuint>& indices, std::vector<MeshFile::SubMesh_t>& meshes)
+{
+	for (unsigned int i = 0; i < pNode->mNumMeshes; ++i)
+	{
+		appendMesh(pScene->mMeshes[pNode->mMeshes[i]], lods, vertices, indices, meshes);
+	}
+
+	for (unsigned int i = 0; i < pNode->mNumChildren; ++i)
+	{
+		appendNode(pNode->mChildren[i], pScene, lods, vertices, indices, meshes);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 3)
+	{
+		printUsage();
+		return 1;
+	}
+
+	std::string input = argv[1];
+	std::string output = argv[2];
+
+	bool standard = false;
+	bool tangents = false;
+	bool colours = false;
+	bool lods = true;
+
+	for (int i = 3; i < argc; ++i)
+	{
+		std::string option = argv[i];
+		if (option == "--standard")
+		{
+			standard = true;
+		}
+		else if (option == "--tangents")
+		{
+			tangents = true;
+		}
+		else if (option == "--colours")
+		{
+			colours = true;
+		}
+		else if (option == "--no-lods")
+		{
+			lods = false;
+		}
+		else
+		{
+			printUsage();
+			return 1;
+		}
+	}
+
+	VertexLayout layout = standard ? VertexLayout::standard() : VertexLayout::compressed();
+	if (tangents)
+	{
+		layout.set(eVertexAttribute::TANGENT, standard ? eVertexFormat::FLOAT4 : eVertexFormat::SNORM10_10_10_2);
+	}
+
+	if (colours)
+	{
+		layout.set(eVertexAttribute::COLOUR, standard ? eVertexFormat::FLOAT4 : eVertexFormat::UNORM8_4);
+	}
+
+	// Tangents are only calculated when they are stored, the import is slower with them.
+	unsigned int flags = aiProcess_Triangulate | aiProcess_FlipUVs | (tangents ? aiProcess_CalcTangentSpace : 0);
+
+	Assimp::Importer importer;
+	const aiScene* pScene = importer.ReadFile(input, flags);
+
+	if (!pScene || pScene->mFlags == AI_SCENE_FLAGS_INCOMPLETE || !pScene->mRootNode)
+	{
+		std::cerr << "Failed to import " << input << ": " << importer.GetErrorString() << "\n";
+		return 1;
+	}
+
+	std::vector<Vertex_t> vertices;
+	std::vector<GLuint> indices;
+	std::vector<MeshFile::SubMesh_t> meshes;
+
+	appendNode(pScene->mRootNode, pScene, lods, vertices, indices, meshes);
+
+	if (!MeshFile::write(output, vertices, indices, meshes, layout))
+	{
+		std::cerr << "Failed to write " << output << "\n";
+		return 1;
+	}
+
+	std::size_t triangles = 0;
+	for (const auto& mesh : meshes)
+	{
+		triangles += (mesh.lods.empty() ? mesh.indexCount : mesh.lods[0].indexCount) / 3;
+	}
+
+	std::cout << input << " -> " << output << ": " << meshes.size() << " sub-meshes, " << vertices.size() << " vertices, "
+	          << triangles << " triangles, " << layout.getStride() << " bytes per vertex ("
+	          << vertices.size() * layout.getStride() << " bytes of vertices).\n";
+
+	return 0;
+}
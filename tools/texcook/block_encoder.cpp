@@ -0,0 +1,491 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//====================
+// C++ includes
+//====================
+#include <algorithm>                     // Clamping endpoints and texel coordinates.
+#include <cmath>                         // Rounding the quantised endpoints.
+#include <cstdint>                       // Packing the encoded blocks.
+#include <cstring>                       // Clearing the encoded blocks.
+#include <limits>                        // Searching for the nearest palette entry.
+
+//====================
+// Jackal includes
+//====================
+#include "block_encoder.hpp"             // Block encoder declarations.
+#include <jackal/utils/thread_pool.hpp>  // Encoding rows of blocks in parallel.
+
+namespace jackal
+{
+	//====================
+	// Local variables
+	//====================
+	static const int TEXELS = 16; // The number of texels within a block.
+
+	static const int BC7_WEIGHTS[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 }; // Mode 6 interpolation weights.
+
+	////////////////////////////////////////////////////////////
+	/// @brief Finds the endpoints of the line that best fits a block.
+	///
+	/// The principal axis of the texels is found with a few power
+	/// iterations of their covariance, the endpoints are the extreme
+	/// texels projected onto the axis.
+	///
+	/// @param pTexels   The 16 RGBA texels of the block.
+	/// @param channels  The number of channels to fit, starting with red.
+	/// @param start     Receives the first endpoint.
+	/// @param end       Receives the second endpoint.
+	///
+	////////////////////////////////////////////////////////////
+	static void findEndpoints(const unsigned char* pTexels, int channels, float start[4], float end[4])
+	{
+		float mean[4] = {};
+		for (int i = 0; i < TEXELS; ++i)
+		{
+			for (int c = 0; c < channels; ++c)
+			{
+				mean[c] += pTexels[i * 4 + c] / static_cast<float>(TEXELS);
+			}
+		}
+
+		float covariance[4][4] = {};
+		for (int i = 0; i < TEXELS; ++i)
+		{
+			for (int a = 0; a < channels; ++a)
+			{
+				for (int b = 0; b < channels; ++b)
+				{
+					covariance[a][b] += (pTexels[i * 4 + a] - mean[a]) * (pTexels[i * 4 + b] - mean[b]);
+				}
+			}
+		}
+
+		// Starting from the channel with the most variance, the axis can't begin orthogonal to the fit.
+		int widest = 0;
+		for (int c = 1; c < channels; ++c)
+		{
+			widest = covariance[c][c] > covariance[widest][widest] ? c : widest;
+		}
+
+		float axis[4] = {};
+		axis[widest] = 1.0f;
+
+		for (int iteration = 0; iteration < 8; ++iteration)
+		{
+			float next[4] = {};
+			float length = 0.0f;
+
+			for (int a = 0; a < channels; ++a)
+			{
+				for (int b = 0; b < channels; ++b)
+				{
+					next[a] += covariance[a][b] * axis[b];
+				}
+
+				length = std::max(length, std::fabs(next[a]));
+			}
+
+			// A flat block has no axis, any direction reproduces it.
+			if (length < 1e-6f)
+			{
+				break;
+			}
+
+			for (int c = 0; c < channels; ++c)
+			{
+				axis[c] = next[c] / length;
+			}
+		}
+
+		float minimum = std::numeric_limits<float>::max();
+		float maximum = std::numeric_limits<float>::lowest();
+		for (int i = 0; i < TEXELS; ++i)
+		{
+			float projection = 0.0f;
+			for (int c = 0; c < channels; ++c)
+			{
+				projection += (pTexels[i * 4 + c] - mean[c]) * axis[c];
+			}
+
+			minimum = std::min(minimum, projection);
+			maximum = std::max(maximum, projection);
+		}
+
+		float squared = 0.0f;
+		for (int c = 0; c < channels; ++c)
+		{
+			squared += axis[c] * axis[c];
+		}
+
+		for (int c = 0; c < channels; ++c)
+		{
+			float direction = squared > 0.0f ? axis[c] / squared : 0.0f;
+
+			start[c] = std::min(std::max(mean[c] + direction * minimum, 0.0f), 255.0f);
+			end[c] = std::min(std::max(mean[c] + direction * maximum, 0.0f), 255.0f);
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	/// @brief Finds the palette entry closest to a texel.
+	///
+	/// @param pTexel    The RGBA texel.
+	/// @param palette   The RGBA palette entries.
+	/// @param count     The number of palette entries.
+	/// @param channels  The number of channels to compare, starting with red.
+	///
+	/// @returns         The index of the closest entry.
+	///
+	////////////////////////////////////////////////////////////
+	static int findNearest(const unsigned char* pTexel, const int palette[][4], int count, int channels)
+	{
+		int nearest = 0;
+		int best = std::numeric_limits<int>::max();
+
+		for (int i = 0; i < count; ++i)
+		{
+			int error = 0;
+			for (int c = 0; c < channels; ++c)
+			{
+				int difference = pTexel[c] - palette[i][c];
+				error += difference * difference;
+			}
+
+			if (error < best)
+			{
+				best = error;
+				nearest = i;
+			}
+		}
+
+		return nearest;
+	}
+
+	////////////////////////////////////////////////////////////
+	/// @brief Packs an RGB colour into 5:6:5 bits.
+	///
+	/// @param colour  The RGB colour, from 0 to 255.
+	///
+	/// @returns       The packed colour.
+	///
+	////////////////////////////////////////////////////////////
+	static std::uint16_t packColour(const float colour[4])
+	{
+		int r = static_cast<int>(std::lround(colour[0] * 31.0f / 255.0f));
+		int g = static_cast<int>(std::lround(colour[1] * 63.0f / 255.0f));
+		int b = static_cast<int>(std::lround(colour[2] * 31.0f / 255.0f));
+
+		return static_cast<std::uint16_t>((r << 11) | (g << 5) | b);
+	}
+
+	////////////////////////////////////////////////////////////
+	/// @brief Expands a 5:6:5 colour into 8 bit channels.
+	///
+	/// @param packed  The packed colour.
+	/// @param colour  Receives the RGB colour.
+	///
+	////////////////////////////////////////////////////////////
+	static void unpackColour(std::uint16_t packed, int colour[4])
+	{
+		int r = (packed >> 11) & 31;
+		int g = (packed >> 5) & 63;
+		int b = packed & 31;
+
+		colour[0] = (r << 3) | (r >> 2);
+		colour[1] = (g << 2) | (g >> 4);
+		colour[2] = (b << 3) | (b >> 2);
+		colour[3] = 255;
+	}
+
+	////////////////////////////////////////////////////////////
+	/// @brief Encodes a single channel of a block as BC4.
+	///
+	/// BC3 alpha and both BC5 channels use this encoding.
+	///
+	/// @param pTexels  The 16 RGBA texels of the block.
+	/// @param channel  The channel to encode.
+	/// @param pOutput  Receives the 8 byte block.
+	///
+	////////////////////////////////////////////////////////////
+	static void encodeChannel(const unsigned char* pTexels, int channel, unsigned char* pOutput)
+	{
+		int minimum = 255;
+		int maximum = 0;
+		for (int i = 0; i < TEXELS; ++i)
+		{
+			minimum = std::min<int>(minimum, pTexels[i * 4 + channel]);
+			maximum = std::max<int>(maximum, pTexels[i * 4 + channel]);
+		}
+
+		std::memset(pOutput, 0, 8);
+		pOutput[0] = static_cast<unsigned char>(maximum);
+		pOutput[1] = static_cast<unsigned char>(minimum);
+
+		if (maximum == minimum)
+		{
+			return;
+		}
+
+		// The first endpoint is larger, so six values are interpolated between them.
+		int palette[8][4] = {};
+		palette[0][0] = maximum;
+		palette[1][0] = minimum;
+		for (int i = 2; i < 8; ++i)
+		{
+			palette[i][0] = ((8 - i) * maximum + (i - 1) * minimum) / 7;
+		}
+
+		std::uint64_t indices = 0;
+		for (int i = 0; i < TEXELS; ++i)
+		{
+			unsigned char texel[4] = { pTexels[i * 4 + channel] };
+			indices |= static_cast<std::uint64_t>(findNearest(texel, palette, 8, 1)) << (i * 3);
+		}
+
+		for (int i = 0; i < 6; ++i)
+		{
+			pOutput[2 + i] = static_cast<unsigned char>(indices >> (i * 8));
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	/// @brief Appends bits to a BC7 block.
+	///
+	/// @param pOutput   The 16 byte block, cleared before the first write.
+	/// @param position  The bit to write from, advanced past the written bits.
+	/// @param value     The bits to write.
+	/// @param count     The number of bits to write.
+	///
+	////////////////////////////////////////////////////////////
+	static void writeBits(unsigned char* pOutput, int& position, unsigned int value, int count)
+	{
+		for (int i = 0; i < count; ++i, ++position)
+		{
+			if (value & (1u << i))
+			{
+				pOutput[position / 8] |= static_cast<unsigned char>(1u << (position % 8));
+			}
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void encodeBC1(const unsigned char* pTexels, unsigned char* pOutput)
+	{
+		float start[4];
+		float end[4];
+		findEndpoints(pTexels, 3, start, end);
+
+		std::uint16_t colour0 = packColour(end);
+		std::uint16_t colour1 = packColour(start);
+
+		// The first colour must be larger, otherwise the block is decoded with three colours.
+		if (colour0 < colour1)
+		{
+			std::swap(colour0, colour1);
+		}
+
+		std::uint32_t indices = 0;
+		if (colour0 != colour1)
+		{
+			int palette[4][4];
+			unpackColour(colour0, palette[0]);
+			unpackColour(colour1, palette[1]);
+
+			for (int c = 0; c < 3; ++c)
+			{
+				palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+				palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+			}
+
+			for (int i = 0; i < TEXELS; ++i)
+			{
+				indices |= static_cast<std::uint32_t>(findNearest(pTexels + i * 4, palette, 4, 3)) << (i * 2);
+			}
+		}
+
+		pOutput[0] = static_cast<unsigned char>(colour0);
+		pOutput[1] = static_cast<unsigned char>(colour0 >> 8);
+		pOutput[2] = static_cast<unsigned char>(colour1);
+		pOutput[3] = static_cast<unsigned char>(colour1 >> 8);
+
+		for (int i = 0; i < 4; ++i)
+		{
+			pOutput[4 + i] = static_cast<unsigned char>(indices >> (i * 8));
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	void encodeBC3(const unsigned char* pTexels, unsigned char* pOutput)
+	{
+		encodeChannel(pTexels, 3, pOutput);
+		encodeBC1(pTexels, pOutput + 8);
+	}
+
+	////////////////////////////////////////////////////////////
+	void encodeBC5(const unsigned char* pTexels, unsigned char* pOutput)
+	{
+		encodeChannel(pTexels, 0, pOutput);
+		encodeChannel(pTexels, 1, pOutput + 8);
+	}
+
+	////////////////////////////////////////////////////////////
+	void encodeBC7(const unsigned char* pTexels, unsigned char* pOutput)
+	{
+		float endpoints[2][4];
+		findEndpoints(pTexels, 4, endpoints[0], endpoints[1]);
+
+		// Each endpoint is 7 bits per channel plus a shared low bit, the low bit with the least error is chosen.
+		int quantised[2][4];
+		int bits[2];
+		int palette[16][4];
+
+		for (int e = 0; e < 2; ++e)
+		{
+			int best = std::numeric_limits<int>::max();
+			for (int p = 0; p < 2; ++p)
+			{
+				int candidate[4];
+				int error = 0;
+
+				for (int c = 0; c < 4; ++c)
+				{
+					candidate[c] = std::min(std::max(static_cast<int>(std::lround((endpoints[e][c] - p) / 2.0f)), 0), 127);
+
+					int difference = ((candidate[c] << 1) | p) - static_cast<int>(std::lround(endpoints[e][c]));
+					error += difference * difference;
+				}
+
+				if (error < best)
+				{
+					best = error;
+					bits[e] = p;
+					std::copy(candidate, candidate + 4, quantised[e]);
+				}
+			}
+		}
+
+		for (int i = 0; i < 16; ++i)
+		{
+			for (int c = 0; c < 4; ++c)
+			{
+				int start = (quantised[0][c] << 1) | bits[0];
+				int end = (quantised[1][c] << 1) | bits[1];
+
+				palette[i][c] = ((64 - BC7_WEIGHTS[i]) * start + BC7_WEIGHTS[i] * end + 32) >> 6;
+			}
+		}
+
+		int indices[TEXELS];
+		for (int i = 0; i < TEXELS; ++i)
+		{
+			indices[i] = findNearest(pTexels + i * 4, palette, 16, 4);
+		}
+
+		// The top bit of the first index isn't stored, so the endpoints are swapped to clear it.
+		if (indices[0] >= 8)
+		{
+			std::swap(quantised[0], quantised[1]);
+			std::swap(bits[0], bits[1]);
+
+			for (int i = 0; i < TEXELS; ++i)
+			{
+				indices[i] = 15 - indices[i];
+			}
+		}
+
+		std::memset(pOutput, 0, 16);
+		int position = 0;
+
+		writeBits(pOutput, position, 1u << 6, 7);
+		for (int c = 0; c < 4; ++c)
+		{
+			writeBits(pOutput, position, quantised[0][c], 7);
+			writeBits(pOutput, position, quantised[1][c], 7);
+		}
+
+		writeBits(pOutput, position, bits[0], 1);
+		writeBits(pOutput, position, bits[1], 1);
+
+		for (int i = 0; i < TEXELS; ++i)
+		{
+			writeBits(pOutput, position, indices[i], i == 0 ? 3 : 4);
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	std::vector<unsigned char> encodeImage(eTextureFormat format, const Vector2i& size, const std::vector<unsigned char>& pixels)
+	{
+		if (format == eTextureFormat::RGBA8)
+		{
+			return pixels;
+		}
+
+		void (*encode)(const unsigned char*, unsigned char*) = nullptr;
+		std::size_t blockSize = 16;
+
+		switch (format)
+		{
+		case eTextureFormat::BC1:
+			encode = encodeBC1;
+			blockSize = 8;
+			break;
+		case eTextureFormat::BC3:
+			encode = encodeBC3;
+			break;
+		case eTextureFormat::BC5:
+			encode = encodeBC5;
+			break;
+		default:
+			encode = encodeBC7;
+			break;
+		}
+
+		std::size_t columns = (size.x + 3) / 4;
+		std::size_t rows = (size.y + 3) / 4;
+		std::vector<unsigned char> output(TextureFile::getLevelSize(format, size));
+
+		ThreadPool::getInstance().parallelFor(rows, 1, [&](std::size_t begin, std::size_t end) {
+			unsigned char texels[TEXELS * 4];
+			for (std::size_t row = begin; row < end; ++row)
+			{
+				for (std::size_t column = 0; column < columns; ++column)
+				{
+					for (int i = 0; i < TEXELS; ++i)
+					{
+						int x = std::min(static_cast<int>(column * 4) + i % 4, size.x - 1);
+						int y = std::min(static_cast<int>(row * 4) + i / 4, size.y - 1);
+
+						std::memcpy(texels + i * 4, pixels.data() + (static_cast<std::size_t>(y) * size.x + x) * 4, 4);
+					}
+
+					encode(texels, output.data() + (row * columns + column) * blockSize);
+				}
+			}
+		});
+
+		return output;
+	}
+
+} // namespace jackal
@@ -0,0 +1,103 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __JACKAL_BLOCK_ENCODER_HPP__
+#define __JACKAL_BLOCK_ENCODER_HPP__
+
+//====================
+// C++ includes
+//====================
+#include <vector>                            // Storing the pixels and encoded blocks.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/rendering/texture_file.hpp> // The formats that can be encoded.
+#include <jackal/math/vector2.hpp>           // Storing the size of each image.
+
+namespace jackal
+{
+	////////////////////////////////////////////////////////////
+	/// @brief Encodes a block of 4x4 texels as BC1.
+	///
+	/// Alpha is ignored, the block always uses four colours.
+	///
+	/// @param pTexels  The 16 RGBA texels of the block, row by row.
+	/// @param pOutput  Receives the 8 byte block.
+	///
+	////////////////////////////////////////////////////////////
+	void encodeBC1(const unsigned char* pTexels, unsigned char* pOutput);
+
+	////////////////////////////////////////////////////////////
+	/// @brief Encodes a block of 4x4 texels as BC3.
+	///
+	/// @param pTexels  The 16 RGBA texels of the block, row by row.
+	/// @param pOutput  Receives the 16 byte block.
+	///
+	////////////////////////////////////////////////////////////
+	void encodeBC3(const unsigned char* pTexels, unsigned char* pOutput);
+
+	////////////////////////////////////////////////////////////
+	/// @brief Encodes a block of 4x4 texels as BC5.
+	///
+	/// Only the red and green channels are encoded.
+	///
+	/// @param pTexels  The 16 RGBA texels of the block, row by row.
+	/// @param pOutput  Receives the 16 byte block.
+	///
+	////////////////////////////////////////////////////////////
+	void encodeBC5(const unsigned char* pTexels, unsigned char* pOutput);
+
+	////////////////////////////////////////////////////////////
+	/// @brief Encodes a block of 4x4 texels as BC7.
+	///
+	/// Every block is encoded with mode 6, a single RGBA line with
+	/// 16 interpolated values. It is a fraction of the cost of searching
+	/// every mode and partition, and is still noticeably better than
+	/// BC3 on smooth gradients.
+	///
+	/// @param pTexels  The 16 RGBA texels of the block, row by row.
+	/// @param pOutput  Receives the 16 byte block.
+	///
+	////////////////////////////////////////////////////////////
+	void encodeBC7(const unsigned char* pTexels, unsigned char* pOutput);
+
+	////////////////////////////////////////////////////////////
+	/// @brief Encodes an RGBA image.
+	///
+	/// Partial blocks at the right and bottom edges are padded by
+	/// repeating the last row and column.
+	///
+	/// @param format  The format to encode the image in.
+	/// @param size    The width and height of the image.
+	/// @param pixels  The tightly packed RGBA pixels of the image.
+	///
+	/// @returns       The encoded image.
+	///
+	////////////////////////////////////////////////////////////
+	std::vector<unsigned char> encodeImage(eTextureFormat format, const Vector2i& size, const std::vector<unsigned char>& pixels);
+
+} // namespace jackal
+
+#endif//__JACKAL_BLOCK_ENCODER_HPP__
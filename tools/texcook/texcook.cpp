@@ -0,0 +1,272 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Jackal Engine
+// 2017 - Benjamin Carter (bencarterdev@outlook.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgement
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//====================
+// C++ includes
+//====================
+#include <algorithm>                         // Clamping the coordinates of each mip level.
+#include <cstring>                           // Copying the rows of the decoded image.
+#include <iostream>                          // Reporting usage and progress.
+#include <string>                            // Parsing the command line.
+#include <utility>                           // Pairing the size and data of each level.
+#include <vector>                            // Storing the pixels of each level.
+
+//====================
+// Jackal includes
+//====================
+#include <jackal/rendering/texture_file.hpp> // Writing the .jtex container.
+#include "block_encoder.hpp"                 // Encoding each level.
+
+//====================
+// Additional includes
+//====================
+#include <SDL2/SDL_image.h>                  // Decoding the source image.
+
+using namespace jackal;
+
+//====================
+// Local variables
+//====================
+using Level = std::pair<Vector2i, std::vector<unsigned char>>;
+
+////////////////////////////////////////////////////////////
+/// @brief Prints the usage of the tool.
+////////////////////////////////////////////////////////////
+static void printUsage()
+{
+	std::cout << "Usage: jackal_texcook <input image> <output.jtex> [--format auto|rgba8|bc1|bc3|bc5|bc7] [--no-mips]\n"
+	          << "  auto   BC1 for opaque images, BC3 for images with alpha. (default)\n"
+	          << "  rgba8  Uncompressed, 4 bytes per texel.\n"
+	          << "  bc1    Opaque colour, 0.5 bytes per texel.\n"
+	          << "  bc3    Colour and alpha, 1 byte per texel.\n"
+	          << "  bc5    Red and green only, for normal maps, 1 byte per texel.\n"
+	          << "  bc7    High quality colour and alpha, 1 byte per texel.\n";
+}
+
+////////////////////////////////////////////////////////////
+/// @brief Decodes an image into tightly packed RGBA pixels.
+///
+/// @param filename  The path of the image.
+/// @param level     Receives the size and pixels of the image.
+///
+/// @returns         True if the image was decoded.
+///
+////////////////////////////////////////////////////////////
+static bool loadImage(const std::string& filename, Level& level)
+{
+	SDL_Surface* pSurface = IMG_Load(filename.c_str());
+	if (!pSurface)
+	{
+		std::cerr << "Failed to load " << filename << ": " << IMG_GetError() << "\n";
+		return false;
+	}
+
+	SDL_Surface* pConverted = SDL_ConvertSurfaceFormat(pSurface, SDL_PIXELFORMAT_RGBA32, 0);
+	SDL_FreeSurface(pSurface);
+
+	if (!pConverted)
+	{
+		std::cerr << "Failed to convert " << filename << ": " << SDL_GetError() << "\n";
+		return false;
+	}
+
+	level.first = Vector2i(pConverted->w, pConverted->h);
+
+	std::size_t row = static_cast<std::size_t>(pConverted->w) * 4;
+	level.second.resize(row * pConverted->h);
+
+	const unsigned char* pSource = static_cast<const unsigned char*>(pConverted->pixels);
+	for (int y = 0; y < pConverted->h; ++y)
+	{
+		std::memcpy(level.second.data() + y * row, pSource + y * pConverted->pitch, row);
+	}
+
+	SDL_FreeSurface(pConverted);
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+/// @brief Halves the size of a level with a box filter.
+///
+/// Odd dimensions repeat their last row or column, so every level
+/// down to 1x1 can be generated.
+///
+/// @param level  The level to halve.
+///
+/// @returns      The next mip level.
+///
+////////////////////////////////////////////////////////////
+static Level halve(const Level& level)
+{
+	const Vector2i& size = level.first;
+	Vector2i half(std::max(size.x / 2, 1), std::max(size.y / 2, 1));
+
+	Level next(half, std::vector<unsigned char>(static_cast<std::size_t>(half.x) * half.y * 4));
+	for (int y = 0; y < half.y; ++y)
+	{
+		for (int x = 0; x < half.x; ++x)
+		{
+			int x0 = std::min(x * 2, size.x - 1);
+			int x1 = std::min(x * 2 + 1, size.x - 1);
+			int y0 = std::min(y * 2, size.y - 1);
+			int y1 = std::min(y * 2 + 1, size.y - 1);
+
+			for (int c = 0; c < 4; ++c)
+			{
+				auto texel = [&level, &size, c](int tx, int ty) {
+					return static_cast<int>(level.second[(static_cast<std::size_t>(ty) * size.x + tx) * 4 + c]);
+				};
+
+				int sum = texel(x0, y0) + texel(x1, y0) + texel(x0, y1) + texel(x1, y1);
+				next.second[(static_cast<std::size_t>(y) * half.x + x) * 4 + c] = static_cast<unsigned char>((sum + 2) / 4);
+			}
+		}
+	}
+
+	return next;
+}
+
+////////////////////////////////////////////////////////////
+/// @brief Parses the name of a format.
+///
+/// @param name       The name passed on the command line.
+/// @param format     Receives the format.
+/// @param automatic  Receives whether the format is chosen from the image.
+///
+/// @returns          True if the name is a known format.
+///
+////////////////////////////////////////////////////////////
+static bool parseFormat(const std::string& name, eTextureFormat& format, bool& automatic)
+{
+	static const std::pair<const char*, eTextureFormat> FORMATS[] = {
+		{ "rgba8", eTextureFormat::RGBA8 }, { "bc1", eTextureFormat::BC1 }, { "bc3", eTextureFormat::BC3 },
+		{ "bc5", eTextureFormat::BC5 }, { "bc7", eTextureFormat::BC7 }
+	};
+
+	automatic = name == "auto";
+	if (automatic)
+	{
+		return true;
+	}
+
+	for (const auto& entry : FORMATS)
+	{
+		if (name == entry.first)
+		{
+			format = entry.second;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+////////////////////////////////////////////////////////////
+int main(int argc, char** argv)
+{
+	if (argc < 3)
+	{
+		printUsage();
+		return 1;
+	}
+
+	std::string input = argv[1];
+	std::string output = argv[2];
+
+	eTextureFormat format = eTextureFormat::BC1;
+	bool automatic = true;
+	bool mips = true;
+
+	for (int i = 3; i < argc; ++i)
+	{
+		std::string argument = argv[i];
+		if (argument == "--format" && i + 1 < argc)
+		{
+			if (!parseFormat(argv[++i], format, automatic))
+			{
+				std::cerr << "Unknown format " << argv[i] << "\n";
+				printUsage();
+
+				return 1;
+			}
+		}
+		else if (argument == "--no-mips")
+		{
+			mips = false;
+		}
+		else
+		{
+			std::cerr << "Unknown argument " << argument << "\n";
+			printUsage();
+
+			return 1;
+		}
+	}
+
+	Level image;
+	if (!loadImage(input, image))
+	{
+		return 1;
+	}
+
+	if (automatic)
+	{
+		bool opaque = true;
+		for (std::size_t i = 3; i < image.second.size() && opaque; i += 4)
+		{
+			opaque = image.second[i] == 255;
+		}
+
+		format = opaque ? eTextureFormat::BC1 : eTextureFormat::BC3;
+	}
+
+	std::vector<Level> levels;
+	levels.push_back(std::move(image));
+
+	while (mips && levels.size() < TextureFile::MAX_LEVELS && (levels.back().first.x > 1 || levels.back().first.y > 1))
+	{
+		levels.push_back(halve(levels.back()));
+	}
+
+	std::size_t original = 0;
+	std::size_t encoded = 0;
+
+	for (auto& level : levels)
+	{
+		original += level.second.size();
+		level.second = encodeImage(format, level.first, level.second);
+		encoded += level.second.size();
+	}
+
+	if (!TextureFile::write(output, format, levels))
+	{
+		std::cerr << "Failed to write " << output << "\n";
+		return 1;
+	}
+
+	std::cout << input << " -> " << output << ": " << levels.front().first.x << "x" << levels.front().first.y << ", "
+	          << levels.size() << " levels, " << original << " bytes as RGBA8, " << encoded << " bytes encoded.\n";
+
+	return 0;
+}